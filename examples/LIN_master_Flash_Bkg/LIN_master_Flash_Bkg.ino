@@ -0,0 +1,196 @@
+/*********************
+
+Example code for bulk download of a firmware image via LIN diagnostics with background operation
+
+This code periodically downloads a small image from flash to a slave bootloader via the services RequestDownload
+(SID 0x34), TransferData (SID 0x36) and RequestTransferExit (SID 0x37) using LIN_Master_Flash on top of
+LIN_Master_Transport. Image data is copied from flash block-wise by a source callback. Flash.handler() is only
+called at its next deadline. Progress and effective download rate are printed once per second.
+Optional Tx direction switching for RS485 interface (e.g. MAX485) is by defining 'PIN_TXEN'.
+In this case, permanently enable Rx (REN=GND) for receiving echo
+
+Supported boards:
+  - Arduino Mega 2560       https://docs.arduino.cc/hardware/mega-2560/
+  - Arduino Due             https://docs.arduino.cc/hardware/due/
+  - Arduino Nano Every      https://docs.arduino.cc/hardware/nano-every/
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "LIN_master_Flash.h"
+
+// pause [ms] between downloads
+#define FLASH_PERIOD          5000
+
+// pause [ms] between progress outputs
+#define PRINT_PERIOD          1000
+
+// node address of slave bootloader
+#define SLAVE_NAD             0x0A
+
+// target address of image in slave
+#define IMAGE_ADDRESS         0x00008000
+
+// size of block buffer incl. SID and sequence counter. Limits block length, if slave accepts longer blocks
+#define SIZE_BUFFER           130
+
+
+////////////////////
+// Arduino Mega and Due settings
+////////////////////
+#if defined(ARDUINO_AVR_MEGA2560) || defined(ARDUINO_SAM_DUE)
+
+  //#define PIN_TXEN            17                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F
+  #define PIN_TOGGLE          30                        // pin to show CPU idle
+  #define PIN_ERROR           32                        // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+
+////////////////////
+// Arduino Nano Every settings
+////////////////////
+#elif defined(ARDUINO_AVR_NANO_EVERY)
+
+  //#define PIN_TXEN            7                         // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F
+  #define PIN_TOGGLE          4                         // pin to show CPU idle
+  #define PIN_ERROR           6                         // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+
+// board not yet included
+#else
+  #error board not yet supported, exit!
+#endif
+
+
+// setup LIN node. Parameters: interface, name, TxEN
+#if defined(PIN_TXEN)
+  LIN_Master_HardwareSerial   LIN(Serial1, "Flash", PIN_TXEN);
+#else
+  LIN_Master_HardwareSerial   LIN(Serial1, "Flash");
+#endif
+
+// diagnostic transport layer and download on top of LIN node
+LIN_Master_Transport          TP(LIN);
+LIN_Master_Flash              Flash(TP);
+
+// image to download (dummy data). Stored in flash, see copyImage()
+const uint8_t Image[1024] PROGMEM = { 0x12, 0x34, 0x56, 0x78 };
+
+// block buffer for TransferData. Must remain valid during download
+uint8_t       Buffer[SIZE_BUFFER];
+
+
+// source callback: copy image data from flash to block buffer
+uint16_t copyImage(uint32_t Offset, uint8_t Data[], uint16_t Length, void *Arg)
+{
+  (void) Arg;
+  memcpy_P(Data, Image + Offset, Length);
+  return Length;
+
+} // copyImage()
+
+
+// call once
+void setup()
+{
+  // open optional console
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.begin(115200);
+  #endif // SERIAL_CONSOLE
+
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // open LIN interface
+  LIN.begin(19200);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t           lastFlash = 0;
+  static uint32_t           lastPrint = 0;
+  static uint32_t           deadlineFlash = 0;
+  static bool               pendingFlash = false;
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call download handler only at its next deadline. Services transport layer and LIN node
+  if ((pendingFlash) && ((int32_t) (micros() - deadlineFlash) >= 0))
+  {
+    // download ongoing -> get next deadline
+    if (Flash.handler() != LIN_Master_Flash::FLASH_DONE)
+      pendingFlash = Flash.getDeadline(deadlineFlash);
+
+    // download finished -> indicate and print result
+    else
+    {
+      LIN_Master_Flash::error_t error = Flash.getError();
+      pendingFlash = false;
+
+      // indicate status via pin
+      digitalWrite(PIN_ERROR, (error != LIN_Master_Flash::FLASH_NO_ERROR));
+
+      // print result
+      #if defined(SERIAL_CONSOLE)
+        SERIAL_CONSOLE.print(LIN.nameLIN);
+        if (error != LIN_Master_Flash::FLASH_NO_ERROR)
+        {
+          SERIAL_CONSOLE.print(", download err=0x");
+          SERIAL_CONSOLE.print(error, HEX);
+          SERIAL_CONSOLE.print(", NRC=0x");
+          SERIAL_CONSOLE.println(Flash.getNRC(), HEX);
+        }
+        else
+        {
+          SERIAL_CONSOLE.print(", download done, ");
+          SERIAL_CONSOLE.print(Flash.getRate());
+          SERIAL_CONSOLE.println("B/s");
+        }
+      #endif // SERIAL_CONSOLE
+
+    } // download finished
+
+  } // deadline reached
+
+
+  ///////////////
+  // print progress of ongoing download
+  ///////////////
+  #if defined(SERIAL_CONSOLE)
+    if ((millis() - lastPrint > PRINT_PERIOD) && (pendingFlash))
+    {
+      lastPrint = millis();
+      SERIAL_CONSOLE.print(LIN.nameLIN);
+      SERIAL_CONSOLE.print(", ");
+      SERIAL_CONSOLE.print(Flash.getProgress());
+      SERIAL_CONSOLE.print("/");
+      SERIAL_CONSOLE.print(sizeof(Image));
+      SERIAL_CONSOLE.print("B, ");
+      SERIAL_CONSOLE.print(Flash.getRate());
+      SERIAL_CONSOLE.println("B/s");
+    }
+  #else
+    (void) lastPrint;
+  #endif // SERIAL_CONSOLE
+
+
+  ///////////////
+  // periodically start download
+  ///////////////
+  if ((millis() - lastFlash > FLASH_PERIOD) && (!pendingFlash))
+  {
+    lastFlash = millis();
+    if (Flash.begin(SLAVE_NAD, IMAGE_ADDRESS, sizeof(Image), copyImage, NULL, Buffer, sizeof(Buffer)))
+      pendingFlash = Flash.getDeadline(deadlineFlash);
+  }
+
+} // loop()
@@ -0,0 +1,138 @@
+/*********************
+
+Example code for two LIN master nodes serviced by a LIN_Master_Group
+
+This code runs a schedule table on each of two LIN buses using HardwareSerial interfaces. Instead of calling handler()
+of each node, loop() only calls LIN_Master_Group::handler() at the earliest deadline of all nodes, which services only
+the nodes with a reached deadline. Results are reported via completion callbacks
+
+Supported (=successfully tested) boards:
+ - Arduino Mega 2560      https://store.arduino.cc/products/arduino-mega-2560-rev3
+ - Arduino Due            https://store.arduino.cc/products/arduino-due
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "LIN_master_Group.h"
+
+
+// pin to demonstrate background operation
+#define PIN_TOGGLE    30
+
+// indicate LIN1 return status
+#define PIN_ERROR1    31
+
+// indicate LIN2 return status
+#define PIN_ERROR2    32
+
+// serial I/F for console output (comment for no output)
+#define SERIAL_CONSOLE  Serial
+//#define SERIAL_CONSOLE  SerialUSB         // Arduino Due native USB port
+
+
+// setup 2 LIN nodes. Parameters: interface, name, TxEN
+LIN_Master_HardwareSerial   LIN1(Serial1, "Master_1");
+LIN_Master_HardwareSerial   LIN2(Serial2, "Master_2");
+
+// coordinator for both nodes
+LIN_Master_Group            Group;
+
+// master request data
+uint8_t                     Tx1[4] = {0x01, 0x02, 0x03, 0x04};
+uint8_t                     Tx2[3] = {0x0A, 0x0B, 0x0C};
+
+// schedule tables. Parameters: type, version, ID, number of data, request data, slot [us]
+const LIN_Master_Base::schedule_t Schedule1[] = {
+  { LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, 4, Tx1, 200000 },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x05, 6, NULL, 300000 }
+};
+const LIN_Master_Base::schedule_t Schedule2[] = {
+  { LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V1, 0x1A, 3, Tx2, 250000 },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V1, 0x06, 8, NULL, 250000 }
+};
+
+
+// completion callback of both nodes. Is called from Group.handler()
+void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  // indicate status via pin passed as argument
+  digitalWrite((int) (intptr_t) Arg, (Result.error != LIN_Master_Base::NO_ERROR));
+
+  // print result
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.print(LIN.nameLIN);
+    SERIAL_CONSOLE.print((Result.type == LIN_Master_Base::MASTER_REQUEST) ? ", request, ID=0x" : ", response, ID=0x");
+    SERIAL_CONSOLE.print(Result.id, HEX);
+    if (Result.error != LIN_Master_Base::NO_ERROR)
+    { 
+      SERIAL_CONSOLE.print(", err=0x");
+      SERIAL_CONSOLE.println(Result.error, HEX);
+    }
+    else
+    {
+      SERIAL_CONSOLE.print(", data=");        
+      for (uint8_t i=0; (i < Result.numData); i++)
+      {
+        SERIAL_CONSOLE.print("0x");
+        SERIAL_CONSOLE.print((int) Result.data[i], HEX);
+        SERIAL_CONSOLE.print(" ");
+      }
+      SERIAL_CONSOLE.println();
+    }
+  #else
+    (void) LIN;
+  #endif // SERIAL_CONSOLE
+
+} // onFrame()
+
+
+// call once
+void setup()
+{
+  // open console
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.begin(115200);
+  #endif // SERIAL_CONSOLE
+
+  // indicate background operation and LIN status
+  pinMode(PIN_TOGGLE, OUTPUT);
+  pinMode(PIN_ERROR1, OUTPUT);
+  pinMode(PIN_ERROR2, OUTPUT);
+
+  // open LIN interfaces
+  LIN1.begin(19200);  
+  LIN2.begin(9600);  
+
+  // report results via callback
+  LIN1.attachCallback(onFrame, (void*) (intptr_t) PIN_ERROR1);
+  LIN2.attachCallback(onFrame, (void*) (intptr_t) PIN_ERROR2);
+
+  // start schedule tables. Are executed by handler()
+  LIN1.setSchedule(Schedule1, sizeof(Schedule1)/sizeof(Schedule1[0]));
+  LIN2.setSchedule(Schedule2, sizeof(Schedule2)/sizeof(Schedule2[0]));
+
+  // service both nodes via group
+  Group.add(LIN1);
+  Group.add(LIN2);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t           deadline = 0;
+  static bool               pending = true;
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // service nodes with reached deadline, then get earliest deadline of all nodes
+  if ((!pending) || ((int32_t) (micros() - deadline) >= 0))
+  {
+    Group.handler();
+    pending = Group.getDeadline(deadline);
+  }
+
+} // loop()
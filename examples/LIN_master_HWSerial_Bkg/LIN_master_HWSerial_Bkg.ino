@@ -5,7 +5,8 @@ Example code for LIN master node with background operation using HardwareSerial
 Optional Tx direction switching for RS485 interface (e.g. MAX485) is by defining 'PIN_TXEN'. 
 In this case, permanently enable Rx (REN=GND) for receiving echo
 
-Note: during frame send/receive, LIN.handler() must be called every <=500us at least until state has changed from STATE_BREAK to STATE_BODY
+Note: during frame send/receive, LIN.handler() must be called at its deadline, which is returned by LIN.handler(deadline).
+In between, the CPU is free for other tasks or may sleep
 
 Tested boards:
   - Arduino Mega 2560       https://docs.arduino.cc/hardware/mega-2560/
@@ -24,9 +25,6 @@ Tested boards:
 // pause [ms] between LIN frames
 #define LIN_FRAME_PERIOD      200
 
-// LIN handler update period [us]
-#define LIN_HANDLER_PERIOD    300
-
 
 ////////////////////
 // Arduino Mega settings
@@ -254,7 +252,8 @@ void setup()
 void loop()
 {
   static uint32_t           lastLINFrame = 0;
-  static uint32_t           lastLINHandler = 0;
+  static uint32_t           deadlineLIN = 0;
+  static bool               pendingLIN = false;
   static uint8_t            count = 0;
   uint8_t                   Tx[4] = {0x01, 0x02, 0x03, 0x04};
   LIN_Master_Base::frame_t  Type;
@@ -267,12 +266,9 @@ void loop()
   // toggle pin to show background operation
   digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
 
-  // periodically call LIN background handler
-  if (micros() - lastLINHandler > LIN_HANDLER_PERIOD)
-  {
-    lastLINHandler = micros();
-    LIN.handler();
-  }
+  // call LIN background handler only at its next deadline
+  if ((pendingLIN) && ((int32_t) (micros() - deadlineLIN) >= 0))
+    pendingLIN = LIN.handler(deadlineLIN);
 
 
   ///////////////
@@ -363,6 +359,9 @@ void loop()
       count = 0;
       LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, 6);
     }
+
+    // get 1st deadline of new frame
+    pendingLIN = LIN.getDeadline(deadlineLIN);
     
   } // SW scheduler
 
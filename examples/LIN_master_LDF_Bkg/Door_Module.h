@@ -0,0 +1,320 @@
+/**
+  \file     Door_Module.h
+  \brief    LIN tables generated from Door_Module.ldf by LIN_ldf_gen. Do not edit
+  \details  Frames, signals, encodings and schedule tables are stored in flash (PROGMEM), see LIN_master_LDF.h.
+            Frame data buffers are defined static, i.e. include this header in only one source file.
+*/
+
+#ifndef _LDF_DOOR_MODULE_H_
+#define _LDF_DOOR_MODULE_H_
+
+#include <LIN_master_LDF.h>
+
+namespace Door_Module
+{
+  // bus properties
+  constexpr LIN_Master_Base::version_t  VERSION  = LIN_Master_Base::LIN_V2;   //!< LIN protocol version
+  constexpr uint32_t                    BAUDRATE = 19200;   //!< baudrate [Baud]
+
+  // frame indices
+  enum : uint8_t
+  {
+    FRAME_MirrorControl = 0,   //!< ID 0x10, master request, 3 bytes
+    FRAME_WindowControl = 1,   //!< ID 0x11, master request, 2 bytes
+    FRAME_MirrorStatus = 2,   //!< ID 0x20, slave response, 4 bytes
+    FRAME_WindowStatus = 3,   //!< ID 0x21, slave response, 6 bytes
+    FRAME_MasterReq = 4,   //!< ID 0x3C, master request, 8 bytes
+    FRAME_SlaveResp = 5,   //!< ID 0x3D, slave response, 8 bytes
+    NUM_FRAMES = 6
+  };
+
+  // frame descriptors with precomputed PID, checksum seed, lengths and timeout
+  constexpr LIN_Master_Base::descriptor_t FRAMES[NUM_FRAMES] PROGMEM =
+  {
+    LIN_Master_LDF::frame(LIN_Master_Base::MASTER_REQUEST, VERSION, 0x10, 3, BAUDRATE),   // MirrorControl
+    LIN_Master_LDF::frame(LIN_Master_Base::MASTER_REQUEST, VERSION, 0x11, 2, BAUDRATE),   // WindowControl
+    LIN_Master_LDF::frame(LIN_Master_Base::SLAVE_RESPONSE, VERSION, 0x20, 4, BAUDRATE),   // MirrorStatus
+    LIN_Master_LDF::frame(LIN_Master_Base::SLAVE_RESPONSE, VERSION, 0x21, 6, BAUDRATE),   // WindowStatus
+    LIN_Master_LDF::frame(LIN_Master_Base::MASTER_REQUEST, VERSION, 0x3C, 8, BAUDRATE),   // MasterReq
+    LIN_Master_LDF::frame(LIN_Master_Base::SLAVE_RESPONSE, VERSION, 0x3D, 8, BAUDRATE),   // SlaveResp
+  };
+
+  // frame data buffers (RAM) with signal init values. Unused bits are recessive
+  static uint8_t data_MirrorControl[3] = { 0xF8, 0x80, 0x80 };
+  static uint8_t data_WindowControl[2] = { 0xF8, 0xE4 };
+  static uint8_t data_MirrorStatus[4] = { 0x00, 0x00, 0x00, 0xF8 };
+  static uint8_t data_WindowStatus[6] = { 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00 };
+  static uint8_t data_MasterReq[8] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+  static uint8_t data_SlaveResp[8] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+  constexpr uint8_t * DATA[NUM_FRAMES] PROGMEM =
+  {
+    data_MirrorControl,
+    data_WindowControl,
+    data_MirrorStatus,
+    data_WindowStatus,
+    data_MasterReq,
+    data_SlaveResp,
+  };
+
+  // encoding indices
+  enum : uint8_t
+  {
+    ENC_MirrorCmdEnc = 0,
+    ENC_PercentEnc = 1,
+    ENC_TempEnc = 2,
+    NUM_ENCODINGS = 3
+  };
+
+  // physical encodings: physical = offset + scale * raw for raw in [min, max]
+  constexpr LIN_Master_LDF::encoding_t ENCODINGS[NUM_ENCODINGS] PROGMEM =
+  {
+    { 0, 0, 1.0f, 0.0f },   // MirrorCmdEnc
+    { 0, 100, 1.0f, 0.0f },   // PercentEnc [%]
+    { 0, 1000, 0.1f, -40.0f },   // TempEnc [degC]
+  };
+
+  // logical values
+  constexpr uint32_t MirrorCmdEnc_stop = 0;
+  constexpr uint32_t MirrorCmdEnc_move = 1;
+  constexpr uint32_t MirrorCmdEnc_fold = 2;
+  constexpr uint32_t MirrorCmdEnc_unfold = 3;
+  constexpr uint32_t PercentEnc_invalid = 127;
+
+  // signal indices
+  enum : uint8_t
+  {
+    SIG_MirrorCmd = 0,
+    SIG_MirrorX = 1,
+    SIG_MirrorY = 2,
+    SIG_MirrorHeat = 3,
+    SIG_WindowCmd = 4,
+    SIG_WindowTarget = 5,
+    SIG_MirrorPosX = 6,
+    SIG_MirrorPosY = 7,
+    SIG_MirrorTemp = 8,
+    SIG_MirrorError = 9,
+    SIG_WindowPos = 10,
+    SIG_WindowPinch = 11,
+    SIG_WindowSerial = 12,
+    SIG_MasterReqB0 = 13,
+    SIG_MasterReqB1 = 14,
+    SIG_MasterReqB2 = 15,
+    SIG_MasterReqB3 = 16,
+    SIG_MasterReqB4 = 17,
+    SIG_MasterReqB5 = 18,
+    SIG_MasterReqB6 = 19,
+    SIG_MasterReqB7 = 20,
+    SIG_SlaveRespB0 = 21,
+    SIG_SlaveRespB1 = 22,
+    SIG_SlaveRespB2 = 23,
+    SIG_SlaveRespB3 = 24,
+    SIG_SlaveRespB4 = 25,
+    SIG_SlaveRespB5 = 26,
+    SIG_SlaveRespB6 = 27,
+    SIG_SlaveRespB7 = 28,
+    NUM_SIGNALS = 29
+  };
+
+  // signals: frame, bit offset, width, encoding, init value. Unmapped signals use frame 0xFF
+  constexpr LIN_Master_LDF::signal_t SIGNALS[NUM_SIGNALS] PROGMEM =
+  {
+    { FRAME_MirrorControl, 0, 2, ENC_MirrorCmdEnc, 0 },
+    { FRAME_MirrorControl, 8, 8, LIN_MASTER_LDF_NO_ENCODING, 128 },
+    { FRAME_MirrorControl, 16, 8, LIN_MASTER_LDF_NO_ENCODING, 128 },
+    { FRAME_MirrorControl, 2, 1, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_WindowControl, 0, 3, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_WindowControl, 8, 7, ENC_PercentEnc, 100 },
+    { FRAME_MirrorStatus, 0, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_MirrorStatus, 8, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_MirrorStatus, 16, 10, ENC_TempEnc, 0 },
+    { FRAME_MirrorStatus, 26, 1, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_WindowStatus, 0, 7, ENC_PercentEnc, 0 },
+    { FRAME_WindowStatus, 7, 1, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_WindowStatus, 16, 32, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_MasterReq, 0, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_MasterReq, 8, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_MasterReq, 16, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_MasterReq, 24, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_MasterReq, 32, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_MasterReq, 40, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_MasterReq, 48, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_MasterReq, 56, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_SlaveResp, 0, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_SlaveResp, 8, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_SlaveResp, 16, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_SlaveResp, 24, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_SlaveResp, 32, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_SlaveResp, 40, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_SlaveResp, 48, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+    { FRAME_SlaveResp, 56, 8, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  };
+
+  // schedule table Normal: type, version, ID, number of data, data, slot [us]
+  constexpr LIN_Master_Base::schedule_t SCHEDULE_Normal[] PROGMEM =
+  {
+    { LIN_Master_Base::MASTER_REQUEST, VERSION, 0x10, 3, data_MirrorControl, 10000 },
+    { LIN_Master_Base::SLAVE_RESPONSE, VERSION, 0x20, 4, NULL, 10000 },
+    { LIN_Master_Base::MASTER_REQUEST, VERSION, 0x11, 2, data_WindowControl, 10000 },
+    { LIN_Master_Base::SLAVE_RESPONSE, VERSION, 0x21, 6, NULL, 10000 },
+  };
+  constexpr uint8_t NUM_SCHEDULE_Normal = 4;
+
+  // schedule table Diagnostic: type, version, ID, number of data, data, slot [us]
+  constexpr LIN_Master_Base::schedule_t SCHEDULE_Diagnostic[] PROGMEM =
+  {
+    { LIN_Master_Base::MASTER_REQUEST, VERSION, 0x3C, 8, data_MasterReq, 10000 },
+    { LIN_Master_Base::SLAVE_RESPONSE, VERSION, 0x3D, 8, NULL, 10000 },
+  };
+  constexpr uint8_t NUM_SCHEDULE_Diagnostic = 2;
+
+  // signal layouts for compile-time packing, see LIN_master_Signal.h
+  typedef LIN_Master_Signal<0, 2> Signal_MirrorCmd;
+  typedef LIN_Master_Signal<8, 8> Signal_MirrorX;
+  typedef LIN_Master_Signal<16, 8> Signal_MirrorY;
+  typedef LIN_Master_Signal<2, 1> Signal_MirrorHeat;
+  typedef LIN_Master_Signal<0, 3> Signal_WindowCmd;
+  typedef LIN_Master_Signal<8, 7> Signal_WindowTarget;
+  typedef LIN_Master_Signal<0, 8> Signal_MirrorPosX;
+  typedef LIN_Master_Signal<8, 8> Signal_MirrorPosY;
+  typedef LIN_Master_Signal<16, 10> Signal_MirrorTemp;
+  typedef LIN_Master_Signal<26, 1> Signal_MirrorError;
+  typedef LIN_Master_Signal<0, 7> Signal_WindowPos;
+  typedef LIN_Master_Signal<7, 1> Signal_WindowPinch;
+  typedef LIN_Master_Signal<0, 8> Signal_MasterReqB0;
+  typedef LIN_Master_Signal<8, 8> Signal_MasterReqB1;
+  typedef LIN_Master_Signal<16, 8> Signal_MasterReqB2;
+  typedef LIN_Master_Signal<24, 8> Signal_MasterReqB3;
+  typedef LIN_Master_Signal<32, 8> Signal_MasterReqB4;
+  typedef LIN_Master_Signal<40, 8> Signal_MasterReqB5;
+  typedef LIN_Master_Signal<48, 8> Signal_MasterReqB6;
+  typedef LIN_Master_Signal<56, 8> Signal_MasterReqB7;
+  typedef LIN_Master_Signal<0, 8> Signal_SlaveRespB0;
+  typedef LIN_Master_Signal<8, 8> Signal_SlaveRespB1;
+  typedef LIN_Master_Signal<16, 8> Signal_SlaveRespB2;
+  typedef LIN_Master_Signal<24, 8> Signal_SlaveRespB3;
+  typedef LIN_Master_Signal<32, 8> Signal_SlaveRespB4;
+  typedef LIN_Master_Signal<40, 8> Signal_SlaveRespB5;
+  typedef LIN_Master_Signal<48, 8> Signal_SlaveRespB6;
+  typedef LIN_Master_Signal<56, 8> Signal_SlaveRespB7;
+
+  // raw signals of frame MirrorControl for bulk unpack() and pack()
+  struct Frame_MirrorControl
+  {
+    uint8_t    MirrorCmd;
+    uint8_t    MirrorX;
+    uint8_t    MirrorY;
+    uint8_t    MirrorHeat;
+  };
+  typedef LIN_Master_Layout<Frame_MirrorControl,
+    LIN_MASTER_FIELD(Frame_MirrorControl, MirrorCmd, 0, 2),
+    LIN_MASTER_FIELD(Frame_MirrorControl, MirrorX, 8, 8),
+    LIN_MASTER_FIELD(Frame_MirrorControl, MirrorY, 16, 8),
+    LIN_MASTER_FIELD(Frame_MirrorControl, MirrorHeat, 2, 1)> Layout_MirrorControl;
+  static inline void unpack(const uint8_t Data[], Frame_MirrorControl &Values) { Layout_MirrorControl::unpack(Data, Values); }
+  static inline void pack(uint8_t Data[], const Frame_MirrorControl &Values) { Layout_MirrorControl::pack(Data, Values); }
+
+  // raw signals of frame WindowControl for bulk unpack() and pack()
+  struct Frame_WindowControl
+  {
+    uint8_t    WindowCmd;
+    uint8_t    WindowTarget;
+  };
+  typedef LIN_Master_Layout<Frame_WindowControl,
+    LIN_MASTER_FIELD(Frame_WindowControl, WindowCmd, 0, 3),
+    LIN_MASTER_FIELD(Frame_WindowControl, WindowTarget, 8, 7)> Layout_WindowControl;
+  static inline void unpack(const uint8_t Data[], Frame_WindowControl &Values) { Layout_WindowControl::unpack(Data, Values); }
+  static inline void pack(uint8_t Data[], const Frame_WindowControl &Values) { Layout_WindowControl::pack(Data, Values); }
+
+  // raw signals of frame MirrorStatus for bulk unpack() and pack()
+  struct Frame_MirrorStatus
+  {
+    uint8_t    MirrorPosX;
+    uint8_t    MirrorPosY;
+    uint16_t   MirrorTemp;
+    uint8_t    MirrorError;
+  };
+  typedef LIN_Master_Layout<Frame_MirrorStatus,
+    LIN_MASTER_FIELD(Frame_MirrorStatus, MirrorPosX, 0, 8),
+    LIN_MASTER_FIELD(Frame_MirrorStatus, MirrorPosY, 8, 8),
+    LIN_MASTER_FIELD(Frame_MirrorStatus, MirrorTemp, 16, 10),
+    LIN_MASTER_FIELD(Frame_MirrorStatus, MirrorError, 26, 1)> Layout_MirrorStatus;
+  static inline void unpack(const uint8_t Data[], Frame_MirrorStatus &Values) { Layout_MirrorStatus::unpack(Data, Values); }
+  static inline void pack(uint8_t Data[], const Frame_MirrorStatus &Values) { Layout_MirrorStatus::pack(Data, Values); }
+
+  // raw signals of frame WindowStatus for bulk unpack() and pack()
+  struct Frame_WindowStatus
+  {
+    uint8_t    WindowPos;
+    uint8_t    WindowPinch;
+  };
+  typedef LIN_Master_Layout<Frame_WindowStatus,
+    LIN_MASTER_FIELD(Frame_WindowStatus, WindowPos, 0, 7),
+    LIN_MASTER_FIELD(Frame_WindowStatus, WindowPinch, 7, 1)> Layout_WindowStatus;
+  static inline void unpack(const uint8_t Data[], Frame_WindowStatus &Values) { Layout_WindowStatus::unpack(Data, Values); }
+  static inline void pack(uint8_t Data[], const Frame_WindowStatus &Values) { Layout_WindowStatus::pack(Data, Values); }
+
+  // raw signals of frame MasterReq for bulk unpack() and pack()
+  struct Frame_MasterReq
+  {
+    uint8_t    MasterReqB0;
+    uint8_t    MasterReqB1;
+    uint8_t    MasterReqB2;
+    uint8_t    MasterReqB3;
+    uint8_t    MasterReqB4;
+    uint8_t    MasterReqB5;
+    uint8_t    MasterReqB6;
+    uint8_t    MasterReqB7;
+  };
+  typedef LIN_Master_Layout<Frame_MasterReq,
+    LIN_MASTER_FIELD(Frame_MasterReq, MasterReqB0, 0, 8),
+    LIN_MASTER_FIELD(Frame_MasterReq, MasterReqB1, 8, 8),
+    LIN_MASTER_FIELD(Frame_MasterReq, MasterReqB2, 16, 8),
+    LIN_MASTER_FIELD(Frame_MasterReq, MasterReqB3, 24, 8),
+    LIN_MASTER_FIELD(Frame_MasterReq, MasterReqB4, 32, 8),
+    LIN_MASTER_FIELD(Frame_MasterReq, MasterReqB5, 40, 8),
+    LIN_MASTER_FIELD(Frame_MasterReq, MasterReqB6, 48, 8),
+    LIN_MASTER_FIELD(Frame_MasterReq, MasterReqB7, 56, 8)> Layout_MasterReq;
+  static inline void unpack(const uint8_t Data[], Frame_MasterReq &Values) { Layout_MasterReq::unpack(Data, Values); }
+  static inline void pack(uint8_t Data[], const Frame_MasterReq &Values) { Layout_MasterReq::pack(Data, Values); }
+
+  // raw signals of frame SlaveResp for bulk unpack() and pack()
+  struct Frame_SlaveResp
+  {
+    uint8_t    SlaveRespB0;
+    uint8_t    SlaveRespB1;
+    uint8_t    SlaveRespB2;
+    uint8_t    SlaveRespB3;
+    uint8_t    SlaveRespB4;
+    uint8_t    SlaveRespB5;
+    uint8_t    SlaveRespB6;
+    uint8_t    SlaveRespB7;
+  };
+  typedef LIN_Master_Layout<Frame_SlaveResp,
+    LIN_MASTER_FIELD(Frame_SlaveResp, SlaveRespB0, 0, 8),
+    LIN_MASTER_FIELD(Frame_SlaveResp, SlaveRespB1, 8, 8),
+    LIN_MASTER_FIELD(Frame_SlaveResp, SlaveRespB2, 16, 8),
+    LIN_MASTER_FIELD(Frame_SlaveResp, SlaveRespB3, 24, 8),
+    LIN_MASTER_FIELD(Frame_SlaveResp, SlaveRespB4, 32, 8),
+    LIN_MASTER_FIELD(Frame_SlaveResp, SlaveRespB5, 40, 8),
+    LIN_MASTER_FIELD(Frame_SlaveResp, SlaveRespB6, 48, 8),
+    LIN_MASTER_FIELD(Frame_SlaveResp, SlaveRespB7, 56, 8)> Layout_SlaveResp;
+  static inline void unpack(const uint8_t Data[], Frame_SlaveResp &Values) { Layout_SlaveResp::unpack(Data, Values); }
+  static inline void pack(uint8_t Data[], const Frame_SlaveResp &Values) { Layout_SlaveResp::pack(Data, Values); }
+
+  /// raw value of scalar signal in its frame data buffer
+  static inline uint32_t getSignal(uint8_t Signal)
+  {
+    LIN_Master_LDF::signal_t sig = LIN_Master_LDF::read_P(&(SIGNALS[Signal]));
+    return LIN_Master_LDF::getRaw(sig, LIN_Master_LDF::read_P(&(DATA[sig.frame])));
+  }
+
+  /// set raw value of scalar signal in its frame data buffer
+  static inline void setSignal(uint8_t Signal, uint32_t Value)
+  {
+    LIN_Master_LDF::signal_t sig = LIN_Master_LDF::read_P(&(SIGNALS[Signal]));
+    LIN_Master_LDF::setRaw(sig, LIN_Master_LDF::read_P(&(DATA[sig.frame])), Value);
+  }
+
+} // namespace Door_Module
+
+#endif // _LDF_DOOR_MODULE_H_
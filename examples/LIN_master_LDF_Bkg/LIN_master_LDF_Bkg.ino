@@ -0,0 +1,149 @@
+/*********************
+
+Example code for LIN master node with frame, signal and schedule tables generated from a LIN Description File (LDF)
+
+The header Door_Module.h was generated from Door_Module.ldf in this folder via the host tool in ./extras/host/tools:
+  extras/host/build/LIN_ldf_gen Door_Module.ldf -o Door_Module.h
+All tables are stored in flash (PROGMEM on AVR). The schedule table "Normal" is executed by LIN.handler() via
+setSchedule_P(), i.e. loop() only calls LIN.handler() at its deadline. The completion callback copies slave responses
+to the generated frame buffers, from which signals are read and converted to physical values. Mirror command and
+window target are changed periodically via the generated signal setters.
+Optional Tx direction switching for RS485 interface (e.g. MAX485) is by defining 'PIN_TXEN'. 
+In this case, permanently enable Rx (REN=GND) for receiving echo
+
+Supported boards:
+  - Arduino Mega 2560       https://docs.arduino.cc/hardware/mega-2560/
+  - Arduino Due             https://docs.arduino.cc/hardware/due/
+  - Arduino Nano Every      https://docs.arduino.cc/hardware/nano-every/
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "Door_Module.h"                                // generated from Door_Module.ldf
+
+// period [ms] for changing the mirror and window commands
+#define CMD_PERIOD            2000
+
+
+////////////////////
+// Arduino Mega and Due settings
+////////////////////
+#if defined(ARDUINO_AVR_MEGA2560) || defined(ARDUINO_SAM_DUE)
+
+  //#define PIN_TXEN            17                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F 
+  #define PIN_TOGGLE          30                        // pin to show CPU idle
+  #define PIN_ERROR           32                        // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+
+////////////////////
+// Arduino Nano Every settings
+////////////////////
+#elif defined(ARDUINO_AVR_NANO_EVERY)
+
+  //#define PIN_TXEN            7                         // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F 
+  #define PIN_TOGGLE          4                         // pin to show CPU idle
+  #define PIN_ERROR           6                         // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+
+// board not yet included
+#else
+  #error board not yet supported, exit!
+#endif
+
+
+// setup LIN node. Parameters: interface, name, TxEN
+#if defined(PIN_TXEN)
+  LIN_Master_HardwareSerial   LIN(Serial1, "Door", PIN_TXEN);
+#else
+  LIN_Master_HardwareSerial   LIN(Serial1, "Door");
+#endif
+
+
+// completion callback. Is called from LIN.handler()
+void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, (Result.error != LIN_Master_Base::NO_ERROR));
+
+  // copy slave response to generated frame buffer
+  if ((Result.error == LIN_Master_Base::NO_ERROR) && (Result.type == LIN_Master_Base::SLAVE_RESPONSE))
+  {
+    uint8_t idx = (Result.id == 0x20) ? Door_Module::FRAME_MirrorStatus : Door_Module::FRAME_WindowStatus;
+    memcpy(LIN_Master_LDF::read_P(&(Door_Module::DATA[idx])), Result.data, Result.numData);
+  }
+
+} // onFrame()
+
+
+// call once
+void setup()
+{
+  // open optional console
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.begin(115200);
+  #endif // SERIAL_CONSOLE
+
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // open LIN interface with baudrate from LDF
+  LIN.begin(Door_Module::BAUDRATE);
+
+  // run schedule table "Normal" from flash
+  LIN.attachCallback(onFrame);
+  LIN.setSchedule_P(Door_Module::SCHEDULE_Normal, Door_Module::NUM_SCHEDULE_Normal);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t           deadlineLIN = 0;
+  static bool               pendingLIN = true;
+  static uint32_t           lastCmd = 0;
+  static bool               fold = false;
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call LIN background handler only at its next deadline. Schedule table always has a deadline
+  if ((!pendingLIN) || ((int32_t) (micros() - deadlineLIN) >= 0))
+    pendingLIN = LIN.handler(deadlineLIN);
+
+
+  ///////////////
+  // periodically change commands and print status signals
+  ///////////////
+  if (millis() - lastCmd > CMD_PERIOD)
+  {
+    lastCmd = millis();
+
+    // set master request signals. Are sent with next slot of the respective frame
+    fold = !fold;
+    Door_Module::setSignal(Door_Module::SIG_MirrorCmd, fold ? Door_Module::MirrorCmdEnc_fold : Door_Module::MirrorCmdEnc_unfold);
+    Door_Module::setSignal(Door_Module::SIG_WindowTarget, fold ? 0 : 100);
+
+    // print received signals as physical values
+    #if defined(SERIAL_CONSOLE)
+      LIN_Master_LDF::encoding_t tempEnc = LIN_Master_LDF::read_P(&(Door_Module::ENCODINGS[Door_Module::ENC_TempEnc]));
+      SERIAL_CONSOLE.print("MirrorTemp=");
+      SERIAL_CONSOLE.print(LIN_Master_LDF::toPhysical(tempEnc, Door_Module::getSignal(Door_Module::SIG_MirrorTemp)), 1);
+      SERIAL_CONSOLE.print("degC, WindowPos=");
+      SERIAL_CONSOLE.print(Door_Module::getSignal(Door_Module::SIG_WindowPos));
+      SERIAL_CONSOLE.print("%, WindowPinch=");
+      SERIAL_CONSOLE.println(Door_Module::getSignal(Door_Module::SIG_WindowPinch));
+    #endif // SERIAL_CONSOLE
+
+  } // change commands
+
+} // loop()
@@ -0,0 +1,158 @@
+/*********************
+
+Example code for LIN master node with background operation using the per-byte Rx interrupt of NeoHWSerial on AVR
+
+Each received byte is passed from the UART Rx ISR of NeoHWSerial directly to the LIN state machine, i.e. the frame
+is completed at the stop bit of the checksum instead of at the next LIN.handler() call. LIN.handler() only checks
+the frame timeout and calls the completion callback.
+On AVR, NeoHWSerial can't be used together with HardwareSerial. Therefore the console uses NeoSerial, and library
+debug output must be disabled or use NeoSerial, see LIN_MASTER_DEBUG_SERIAL. Requires library NeoHWSerial.
+Optional Tx direction switching for RS485 interface (e.g. MAX485) is by defining 'PIN_TXEN'.
+In this case, permanently enable Rx (REN=GND) for receiving echo
+
+Note: during frame send/receive, LIN.handler() must be called at its deadline, which is returned by LIN.handler(deadline).
+In between, the CPU is free for other tasks or may sleep
+
+Supported boards:
+  - Arduino Mega 2560       https://docs.arduino.cc/hardware/mega-2560/
+
+**********************/
+
+// include files
+#include <LIN_master_NeoHWSerial_AVR.h>
+
+// pause [ms] between LIN frames
+#define LIN_FRAME_PERIOD      200
+
+
+////////////////////
+// Arduino Mega settings
+////////////////////
+#if defined(ARDUINO_AVR_MEGA2560)
+
+  //#define PIN_TXEN            17                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F
+  #define PIN_TOGGLE          30                        // pin to show CPU idle
+  #define PIN_ERROR           32                        // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      NeoSerial                 // serial I/F for console output (comment for no output). Don't use Serial, see above
+
+  // setup LIN node. Parameters: interface, index N of NeoSerialN, name, TxEN
+  #if defined(PIN_TXEN)
+    LIN_Master_NeoHWSerial_AVR  LIN(NeoSerial1, 1, "ISR", PIN_TXEN);
+  #else
+    LIN_Master_NeoHWSerial_AVR  LIN(NeoSerial1, 1, "ISR");
+  #endif
+
+
+// board not yet included
+#else
+  #error board not yet supported, exit!
+#endif
+
+
+// completion callback. Is called from LIN.handler() in loop()
+void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) Arg;
+
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, (Result.error != LIN_Master_Base::NO_ERROR));
+
+  // print result
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.print(LIN.nameLIN);
+    SERIAL_CONSOLE.print((Result.type == LIN_Master_Base::MASTER_REQUEST) ? ", request, ID=0x" : ", response, ID=0x");
+    SERIAL_CONSOLE.print(Result.id, HEX);
+    if (Result.error != LIN_Master_Base::NO_ERROR)
+    {
+      SERIAL_CONSOLE.print(", err=0x");
+      SERIAL_CONSOLE.println(Result.error, HEX);
+    }
+    else
+    {
+      SERIAL_CONSOLE.print(", data=");
+      for (uint8_t i=0; (i < Result.numData); i++)
+      {
+        SERIAL_CONSOLE.print("0x");
+        SERIAL_CONSOLE.print((int) Result.data[i], HEX);
+        SERIAL_CONSOLE.print(" ");
+      }
+      SERIAL_CONSOLE.println();
+    }
+  #else
+    (void) LIN;
+  #endif // SERIAL_CONSOLE
+
+} // onFrame()
+
+
+// call once
+void setup()
+{
+  // open optional console
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.begin(115200);
+  #endif // SERIAL_CONSOLE
+
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // open LIN interface and attach Rx ISR
+  LIN.begin(19200);
+
+  // print results via callback
+  LIN.attachCallback(onFrame);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t           lastLINFrame = 0;
+  static uint32_t           deadlineLIN = 0;
+  static bool               pendingLIN = false;
+  static uint8_t            count = 0;
+  static uint8_t            Tx[4] = {0x01, 0x02, 0x03, 0x04};
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call LIN background handler only at its next deadline. Frame is checked in Rx ISR, i.e. only timeout and callback
+  if ((pendingLIN) && ((int32_t) (micros() - deadlineLIN) >= 0))
+    pendingLIN = LIN.handler(deadlineLIN);
+
+
+  ///////////////
+  // SW scheduler for sending/receiving LIN frames
+  ///////////////
+  if ((millis() - lastLINFrame > LIN_FRAME_PERIOD) && (!pendingLIN))
+  {
+    lastLINFrame = millis();
+
+    // reset state machine & error of previous frame, which was reported via callback
+    LIN.resetStateMachine();
+    LIN.resetError();
+
+    // send master request frame (background)
+    if (count == 0)
+    {
+      count++;
+      LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, 4, Tx);
+    }
+
+    // send slave response frame (background)
+    else
+    {
+      count = 0;
+      LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, 6);
+    }
+
+    // get 1st deadline of new frame
+    pendingLIN = LIN.getDeadline(deadlineLIN);
+
+  } // SW scheduler
+
+} // loop()
@@ -0,0 +1,221 @@
+/*********************
+
+Example code for LIN master node with background operation using DMA of STM32 USART
+
+Frames are sent via HAL_UART_Transmit_DMA() and received via HAL_UARTEx_ReceiveToIdle_DMA(). Echo, checksum and
+frame completion are checked in the UART reception event callback, i.e. a few interrupts per frame instead of one
+per byte, and LIN.handler() only checks the frame timeout and calls the completion callback.
+The DMA channels are initialized by the application in normal mode and passed via setDMA() before begin(). Their
+IRQ handlers must call HAL_DMA_IRQHandler(). Optionally the BREAK is generated by the LIN mode of the USART.
+Optional Tx direction switching for RS485 interface (e.g. MAX485) is by defining 'PIN_TXEN'.
+In this case, permanently enable Rx (REN=GND) for receiving echo
+
+Supported boards:
+  - Nucleo-STM32L432KC      https://www.st.com/en/evaluation-tools/nucleo-l432kc.html
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial_STM32.h>
+
+// pause [ms] between LIN frames
+#define LIN_FRAME_PERIOD      200
+
+
+////////////////////
+// Nucleo-STM32L432KC settings
+////////////////////
+#if defined(ARDUINO_NUCLEO_L432KC)
+
+  //#define PIN_TXEN            D5                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F
+  #define PIN_TOGGLE          D3                        // pin to show CPU idle
+  #define PIN_ERROR           D4                        // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+  // DMA channels of USART1 (Tx=D1=PA9, Rx=D0=PA10), see reference manual RM0394, table "DMA1 requests for each channel"
+  #define DMA_TX_CHANNEL      DMA1_Channel4
+  #define DMA_TX_IRQ          DMA1_Channel4_IRQn
+  #define DMA_TX_HANDLER      DMA1_Channel4_IRQHandler
+  #define DMA_RX_CHANNEL      DMA1_Channel5
+  #define DMA_RX_IRQ          DMA1_Channel5_IRQn
+  #define DMA_RX_HANDLER      DMA1_Channel5_IRQHandler
+  #define DMA_REQUEST_USART   DMA_REQUEST_2
+
+  HWSERIAL                        Serial1(D1, D0);          // Serial1 not always instantiated by default
+
+  // setup LIN node. Parameters: interface, Rx, Tx, name, TxEN
+  #if defined(PIN_TXEN)
+    LIN_Master_HardwareSerial_STM32   LIN(Serial1, D0, D1, "DMA", PIN_TXEN);
+  #else
+    LIN_Master_HardwareSerial_STM32   LIN(Serial1, D0, D1, "DMA");
+  #endif
+
+
+// board not yet included
+#else
+  #error board not yet supported, exit!
+#endif
+
+
+// DMA handles for sending and receiving. Must remain valid while LIN interface is open
+DMA_HandleTypeDef             DmaTx;
+DMA_HandleTypeDef             DmaRx;
+
+
+// DMA interrupt handlers. Call HAL, which calls the UART and LIN callbacks
+extern "C" void DMA_TX_HANDLER(void)
+{
+  HAL_DMA_IRQHandler(&DmaTx);
+}
+
+extern "C" void DMA_RX_HANDLER(void)
+{
+  HAL_DMA_IRQHandler(&DmaRx);
+}
+
+
+// initialize DMA channel in normal mode with byte transfers
+void initDMA(DMA_HandleTypeDef &Dma, DMA_Channel_TypeDef *Channel, uint32_t Direction, IRQn_Type Irq)
+{
+  // configure channel
+  Dma.Instance                 = Channel;
+  Dma.Init.Request             = DMA_REQUEST_USART;
+  Dma.Init.Direction           = Direction;
+  Dma.Init.PeriphInc           = DMA_PINC_DISABLE;
+  Dma.Init.MemInc              = DMA_MINC_ENABLE;
+  Dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  Dma.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+  Dma.Init.Mode                = DMA_NORMAL;
+  Dma.Init.Priority            = DMA_PRIORITY_LOW;
+  HAL_DMA_Init(&Dma);
+
+  // enable interrupt with same priority as UART, i.e. DMA and UART callbacks don't interrupt each other
+  HAL_NVIC_SetPriority(Irq, UART_IRQ_PRIO, UART_IRQ_SUBPRIO);
+  HAL_NVIC_EnableIRQ(Irq);
+
+} // initDMA()
+
+
+// completion callback. Is called from LIN.handler() in loop()
+void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) Arg;
+
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, (Result.error != LIN_Master_Base::NO_ERROR));
+
+  // print result
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.print(LIN.nameLIN);
+    SERIAL_CONSOLE.print((Result.type == LIN_Master_Base::MASTER_REQUEST) ? ", request, ID=0x" : ", response, ID=0x");
+    SERIAL_CONSOLE.print(Result.id, HEX);
+    if (Result.error != LIN_Master_Base::NO_ERROR)
+    {
+      SERIAL_CONSOLE.print(", err=0x");
+      SERIAL_CONSOLE.println(Result.error, HEX);
+    }
+    else
+    {
+      SERIAL_CONSOLE.print(", data=");
+      for (uint8_t i=0; (i < Result.numData); i++)
+      {
+        SERIAL_CONSOLE.print("0x");
+        SERIAL_CONSOLE.print((int) Result.data[i], HEX);
+        SERIAL_CONSOLE.print(" ");
+      }
+      SERIAL_CONSOLE.println();
+    }
+  #else
+    (void) LIN;
+  #endif // SERIAL_CONSOLE
+
+} // onFrame()
+
+
+// call once
+void setup()
+{
+  // open optional console
+  #if defined(SERIAL_CONSOLE)
+
+    // Nucleo-STM32L432KC, if solder bridges for VCP via STLink have been removed
+    #if defined(ARDUINO_NUCLEO_L432KC) && (1)
+      Serial2.setTx(PA_2_ALT1);   // pin A7 on Nucleo-STM32L432KC / uC pin 8
+      Serial2.setRx(PA_3_ALT1);   // pin A2 on Nucleo-STM32L432KC / uC pin 9. Optional Rx pin
+    #endif
+
+    SERIAL_CONSOLE.begin(115200);
+  #endif // SERIAL_CONSOLE
+
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // initialize DMA channels for USART
+  __HAL_RCC_DMA1_CLK_ENABLE();
+  initDMA(DmaTx, DMA_TX_CHANNEL, DMA_MEMORY_TO_PERIPH, DMA_TX_IRQ);
+  initDMA(DmaRx, DMA_RX_CHANNEL, DMA_PERIPH_TO_MEMORY, DMA_RX_IRQ);
+
+  // send and receive frames via DMA and generate BREAK via LIN mode of USART. Must be set before begin()
+  LIN.setDMA(&DmaTx, &DmaRx);
+  LIN.setNativeBreak(true);
+
+  // open LIN interface
+  LIN.begin(19200);
+
+  // print results via callback
+  LIN.attachCallback(onFrame);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t           lastLINFrame = 0;
+  static uint32_t           deadlineLIN = 0;
+  static bool               pendingLIN = false;
+  static uint8_t            count = 0;
+  static uint8_t            Tx[4] = {0x01, 0x02, 0x03, 0x04};
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call LIN background handler only at its next deadline. Frame is checked via DMA, i.e. only timeout and callback
+  if ((pendingLIN) && ((int32_t) (micros() - deadlineLIN) >= 0))
+    pendingLIN = LIN.handler(deadlineLIN);
+
+
+  ///////////////
+  // SW scheduler for sending/receiving LIN frames
+  ///////////////
+  if ((millis() - lastLINFrame > LIN_FRAME_PERIOD) && (!pendingLIN))
+  {
+    lastLINFrame = millis();
+
+    // reset state machine & error of previous frame, which was reported via callback
+    LIN.resetStateMachine();
+    LIN.resetError();
+
+    // send master request frame (background)
+    if (count == 0)
+    {
+      count++;
+      LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, 4, Tx);
+    }
+
+    // send slave response frame (background)
+    else
+    {
+      count = 0;
+      LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, 6);
+    }
+
+    // get 1st deadline of new frame
+    pendingLIN = LIN.getDeadline(deadlineLIN);
+
+  } // SW scheduler
+
+} // loop()
@@ -0,0 +1,169 @@
+/*********************
+
+Example code for LIN master node with background operation using the native BREAK of STM32 USART
+
+The BREAK is generated by the LIN mode of the USART (13 low bits via send break request) instead of sending 0x00
+at 1/2 baudrate. SYNC and PID are queued immediately after the BREAK, i.e. the baudrate is not changed within a
+frame. The native BREAK is enabled via setNativeBreak() before begin(). If the USART has no LIN mode, begin()
+falls back to the emulated BREAK.
+Optional Tx direction switching for RS485 interface (e.g. MAX485) is by defining 'PIN_TXEN'.
+In this case, permanently enable Rx (REN=GND) for receiving echo
+
+Note: during frame send/receive, LIN.handler() must be called at its deadline, which is returned by LIN.handler(deadline).
+In between, the CPU is free for other tasks or may sleep
+
+Supported boards:
+  - Nucleo-STM32L432KC      https://www.st.com/en/evaluation-tools/nucleo-l432kc.html
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial_STM32.h>
+
+// pause [ms] between LIN frames
+#define LIN_FRAME_PERIOD      200
+
+
+////////////////////
+// Nucleo-STM32L432KC settings
+////////////////////
+#if defined(ARDUINO_NUCLEO_L432KC)
+
+  //#define PIN_TXEN            D5                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F
+  #define PIN_TOGGLE          D3                        // pin to show CPU idle
+  #define PIN_ERROR           D4                        // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+  HWSERIAL                        Serial1(D1, D0);          // Serial1 not always instantiated by default
+
+  // setup LIN node. Parameters: interface, Rx, Tx, name, TxEN
+  #if defined(PIN_TXEN)
+    LIN_Master_HardwareSerial_STM32   LIN(Serial1, D0, D1, "Native", PIN_TXEN);
+  #else
+    LIN_Master_HardwareSerial_STM32   LIN(Serial1, D0, D1, "Native");
+  #endif
+
+
+// board not yet included
+#else
+  #error board not yet supported, exit!
+#endif
+
+
+// completion callback. Is called from LIN.handler() in loop()
+void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) Arg;
+
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, (Result.error != LIN_Master_Base::NO_ERROR));
+
+  // print result
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.print(LIN.nameLIN);
+    SERIAL_CONSOLE.print((Result.type == LIN_Master_Base::MASTER_REQUEST) ? ", request, ID=0x" : ", response, ID=0x");
+    SERIAL_CONSOLE.print(Result.id, HEX);
+    if (Result.error != LIN_Master_Base::NO_ERROR)
+    {
+      SERIAL_CONSOLE.print(", err=0x");
+      SERIAL_CONSOLE.println(Result.error, HEX);
+    }
+    else
+    {
+      SERIAL_CONSOLE.print(", data=");
+      for (uint8_t i=0; (i < Result.numData); i++)
+      {
+        SERIAL_CONSOLE.print("0x");
+        SERIAL_CONSOLE.print((int) Result.data[i], HEX);
+        SERIAL_CONSOLE.print(" ");
+      }
+      SERIAL_CONSOLE.println();
+    }
+  #else
+    (void) LIN;
+  #endif // SERIAL_CONSOLE
+
+} // onFrame()
+
+
+// call once
+void setup()
+{
+  // open optional console
+  #if defined(SERIAL_CONSOLE)
+
+    // Nucleo-STM32L432KC, if solder bridges for VCP via STLink have been removed
+    #if defined(ARDUINO_NUCLEO_L432KC) && (1)
+      Serial2.setTx(PA_2_ALT1);   // pin A7 on Nucleo-STM32L432KC / uC pin 8
+      Serial2.setRx(PA_3_ALT1);   // pin A2 on Nucleo-STM32L432KC / uC pin 9. Optional Rx pin
+    #endif
+
+    SERIAL_CONSOLE.begin(115200);
+  #endif // SERIAL_CONSOLE
+
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // generate BREAK via LIN mode of USART. Must be set before begin()
+  LIN.setNativeBreak(true);
+
+  // open LIN interface
+  LIN.begin(19200);
+
+  // print results via callback
+  LIN.attachCallback(onFrame);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t           lastLINFrame = 0;
+  static uint32_t           deadlineLIN = 0;
+  static bool               pendingLIN = false;
+  static uint8_t            count = 0;
+  static uint8_t            Tx[4] = {0x01, 0x02, 0x03, 0x04};
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call LIN background handler only at its next deadline. Calls onFrame() when frame is finished
+  if ((pendingLIN) && ((int32_t) (micros() - deadlineLIN) >= 0))
+    pendingLIN = LIN.handler(deadlineLIN);
+
+
+  ///////////////
+  // SW scheduler for sending/receiving LIN frames
+  ///////////////
+  if ((millis() - lastLINFrame > LIN_FRAME_PERIOD) && (!pendingLIN))
+  {
+    lastLINFrame = millis();
+
+    // reset state machine & error of previous frame, which was reported via callback
+    LIN.resetStateMachine();
+    LIN.resetError();
+
+    // send master request frame (background)
+    if (count == 0)
+    {
+      count++;
+      LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, 4, Tx);
+    }
+
+    // send slave response frame (background)
+    else
+    {
+      count = 0;
+      LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, 6);
+    }
+
+    // get 1st deadline of new frame
+    pendingLIN = LIN.getDeadline(deadlineLIN);
+
+  } // SW scheduler
+
+} // loop()
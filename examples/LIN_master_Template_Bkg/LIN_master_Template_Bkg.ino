@@ -0,0 +1,174 @@
+/*********************
+
+Example code for LIN master node with background operation using LIN_Master_Template
+
+The compile-time LIN_Master_Template has no virtual methods and its buffers are sized via template parameters, which
+saves flash and RAM compared to LIN_Master_HardwareSerial. Here max. 6 data bytes per frame and no request queue are
+used, and frames are prepared once. There is no schedule table, callback or debug output.
+Optional Tx direction switching for RS485 interface (e.g. MAX485) is by defining 'PIN_TXEN'. 
+In this case, permanently enable Rx (REN=GND) for receiving echo
+
+Note: after starting a frame, LIN.handler() must be called every <=500us at least until state has changed from STATE_BREAK to STATE_BODY
+
+Supported boards (BREAK via reduced baudrate):
+  - Arduino Mega 2560       https://docs.arduino.cc/hardware/mega-2560/
+  - Arduino Due             https://docs.arduino.cc/hardware/due/
+  - Arduino Nano Every      https://docs.arduino.cc/hardware/nano-every/
+
+**********************/
+
+// include files
+#include "LIN_master_Template.h"
+
+// pause [ms] between LIN frames
+#define LIN_FRAME_PERIOD      200
+
+
+////////////////////
+// Arduino Mega and Due settings
+////////////////////
+#if defined(ARDUINO_AVR_MEGA2560) || defined(ARDUINO_SAM_DUE)
+
+  //#define PIN_TXEN            17                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F 
+  #define PIN_TOGGLE          30                        // pin to show CPU idle
+  #define PIN_ERROR           32                        // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+
+////////////////////
+// Arduino Nano Every settings
+////////////////////
+#elif defined(ARDUINO_AVR_NANO_EVERY)
+
+  //#define PIN_TXEN            7                         // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F 
+  #define PIN_TOGGLE          4                         // pin to show CPU idle
+  #define PIN_ERROR           6                         // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+
+// board not yet included
+#else
+  #error board not yet supported, exit!
+#endif
+
+
+// setup LIN node. Template parameters: serial type, max. data bytes, queue size. Parameters: interface, TxEN
+#if defined(PIN_TXEN)
+  LIN_Master_Template<HardwareSerial, 6, 0>   LIN(Serial1, PIN_TXEN);
+#else
+  LIN_Master_Template<HardwareSerial, 6, 0>   LIN(Serial1);
+#endif
+
+// prepared frames with precomputed PID, checksum seed and timeout
+LIN_Master_Base::descriptor_t   Request, Response;
+
+
+// call once
+void setup()
+{
+  // open optional console
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.begin(115200);
+  #endif // SERIAL_CONSOLE
+
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // open LIN interface
+  LIN.begin(19200);
+
+  // prepare frames once. Parameters: frame, type, version, ID, number of data
+  LIN.prepareFrame(Request, LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, 4);
+  LIN.prepareFrame(Response, LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x05, 6);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t           lastLINFrame = 0;
+  static uint8_t            count = 0;
+  uint8_t                   Tx[4] = {0x01, 0x02, 0x03, 0x04};
+  LIN_Master_Base::frame_t  Type;
+  LIN_Master_Base::error_t  error;  
+  uint8_t                   Id;
+  uint8_t                   NumData;
+  uint8_t                   Data[6];
+  
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call LIN background handler
+  LIN.handler();
+
+
+  ///////////////
+  // check if LIN frame has finished
+  ///////////////
+  if (LIN.getState() == LIN_Master_Base::STATE_DONE)
+  {
+    // get frame data & error status
+    LIN.getFrame(Type, Id, NumData, Data);
+    error = LIN.getError();
+
+    // indicate status via pin
+    digitalWrite(PIN_ERROR, error);
+
+    // print result
+    #if defined(SERIAL_CONSOLE)
+      SERIAL_CONSOLE.print((Type == LIN_Master_Base::MASTER_REQUEST) ? "request, ID=0x" : "response, ID=0x");
+      SERIAL_CONSOLE.print(Id, HEX);
+      if (error != LIN_Master_Base::NO_ERROR)
+      { 
+        SERIAL_CONSOLE.print(", err=0x");
+        SERIAL_CONSOLE.println(error, HEX);
+      }
+      else
+      {
+        SERIAL_CONSOLE.print(", data=");        
+        for (uint8_t i=0; (i < NumData); i++)
+        {
+          SERIAL_CONSOLE.print("0x");
+          SERIAL_CONSOLE.print((int) Data[i], HEX);
+          SERIAL_CONSOLE.print(" ");
+        }
+        SERIAL_CONSOLE.println();
+      }
+    #endif // SERIAL_CONSOLE
+
+    // reset state machine & error
+    LIN.resetStateMachine();
+    LIN.resetError();
+
+  } // if LIN frame finished
+
+
+  ///////////////
+  // SW scheduler for sending/receiving prepared LIN frames
+  ///////////////
+  if (millis() - lastLINFrame > LIN_FRAME_PERIOD)
+  {
+    lastLINFrame = millis();
+
+    // send master request frame (background)
+    if (count == 0)
+    {
+      count++;
+      LIN.startFrame(Request, Tx);
+    }
+
+    // send slave response frame (background)
+    else
+    {
+      count = 0;
+      LIN.startFrame(Response);
+    }
+    
+  } // SW scheduler
+
+} // loop()
@@ -0,0 +1,238 @@
+/*********************
+
+Example code for LIN master node with background operation driven by a hardware timer
+
+This code runs a schedule table, which is serviced by LIN_Master_Timer from a one-shot hardware timer instead of
+calling LIN.handler() from loop(). Frames are thus completed in time, although loop() blocks via delay().
+The completion callback is called in interrupt context and only stores the result. loop() copies the result
+within Timer.lock() and Timer.unlock() and prints it.
+Optional Tx direction switching for RS485 interface (e.g. MAX485) is by defining 'PIN_TXEN'.
+In this case, permanently enable Rx (REN=GND) for receiving echo
+
+Supported boards:
+  - Arduino Mega 2560       https://docs.arduino.cc/hardware/mega-2560/   (Timer1)
+  - Arduino Nano ESP32-S3   https://docs.arduino.cc/hardware/nano-esp32/   (esp_timer)
+  - ESP32 WROOM-32UE        https://documentation.espressif.com/esp32-wroom-32e_esp32-wroom-32ue_datasheet_en.pdf   (esp_timer)
+  - Nucleo-STM32L432KC      https://www.st.com/en/evaluation-tools/nucleo-l432kc.html   (TIM2)
+
+**********************/
+
+// include files
+#include "LIN_master_Timer.h"
+
+// blocking time [ms] of loop()
+#define LOOP_BLOCKING         500
+
+
+////////////////////
+// Arduino Mega settings
+////////////////////
+#if defined(ARDUINO_AVR_MEGA2560)
+
+  #include <LIN_master_HardwareSerial.h>                // matching LIN master header
+
+  //#define PIN_TXEN            17                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F
+  #define PIN_ERROR           32                        // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+  // setup LIN node. Parameters: interface, name, TxEN
+  #if defined(PIN_TXEN)
+    LIN_Master_HardwareSerial   LIN(Serial1, "Timer", PIN_TXEN);
+  #else
+    LIN_Master_HardwareSerial   LIN(Serial1, "Timer");
+  #endif
+
+
+////////////////////
+// Arduino Nano ESP32 board settings (using Arduino ESP32 core)
+////////////////////
+#elif defined(ARDUINO_NANO_ESP32)
+
+  #include <LIN_master_HardwareSerial_ESP32.h>          // matching LIN master header
+
+  //#define PIN_TXEN            10                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F
+  #define PIN_LIN_TX          3                         // LIN transmit pin
+  #define PIN_LIN_RX          4                         // LIN receive pin
+  #define PIN_ERROR           6                         // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+  // setup LIN node. Parameters: interface, Rx, Tx, name, TxEN
+  #if defined(PIN_TXEN)
+    LIN_Master_HardwareSerial_ESP32   LIN(Serial2, PIN_LIN_RX, PIN_LIN_TX, "Timer", PIN_TXEN);
+  #else
+    LIN_Master_HardwareSerial_ESP32   LIN(Serial2, PIN_LIN_RX, PIN_LIN_TX, "Timer");
+  #endif
+
+
+////////////////////
+// Espressif ESP32-WROOM-32UE board settings (using Espressif ESP32 core)
+////////////////////
+#elif defined(ARDUINO_ESP32_WROOM_DA)
+
+  #include <LIN_master_HardwareSerial_ESP32.h>          // matching LIN master header
+
+  //#define PIN_TXEN            21                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F
+  #define PIN_LIN_TX          17                        // LIN transmit pin
+  #define PIN_LIN_RX          16                        // LIN receive pin
+  #define PIN_ERROR           18                        // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+  // setup LIN node. Parameters: interface, Rx, Tx, name, TxEN
+  #if defined(PIN_TXEN)
+    LIN_Master_HardwareSerial_ESP32   LIN(Serial2, PIN_LIN_RX, PIN_LIN_TX, "Timer", PIN_TXEN);
+  #else
+    LIN_Master_HardwareSerial_ESP32   LIN(Serial2, PIN_LIN_RX, PIN_LIN_TX, "Timer");
+  #endif
+
+
+////////////////////
+// Nucleo-STM32L432KC settings
+////////////////////
+#elif defined(ARDUINO_NUCLEO_L432KC)
+
+  #include <LIN_master_HardwareSerial_STM32.h>          // matching LIN master header
+
+  //#define PIN_TXEN            D5                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F
+  #define PIN_ERROR           D4                        // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+  HWSERIAL                        Serial1(D1, D0);          // Serial1 not always instantiated by default
+
+  // setup LIN node. Parameters: interface, Rx, Tx, name, TxEN
+  #if defined(PIN_TXEN)
+    LIN_Master_HardwareSerial_STM32   LIN(Serial1, D0, D1, "Timer", PIN_TXEN);
+  #else
+    LIN_Master_HardwareSerial_STM32   LIN(Serial1, D0, D1, "Timer");
+  #endif
+
+
+// board not yet included
+#else
+  #error board not yet supported, exit!
+#endif
+
+
+// timer servicing the LIN node
+LIN_Master_Timer              Timer(LIN);
+
+// master request data
+uint8_t                       Tx[4] = {0x01, 0x02, 0x03, 0x04};
+
+// schedule table. Parameters: type, version, ID, number of data, request data, slot [us]
+const LIN_Master_Base::schedule_t Schedule[] = {
+  { LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, 4, Tx, 100000 },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x05, 6, NULL, 100000 }
+};
+
+// last slave response and frame statistics. Written by callback in interrupt context, read within Timer.lock()
+uint8_t                       Rx[8];
+uint8_t                       numRx = 0;
+uint16_t                      numFrames = 0;
+uint16_t                      numErrors = 0;
+LIN_Master_Base::error_t      lastError = LIN_Master_Base::NO_ERROR;
+
+
+// completion callback. Is called from timer ISR, therefore only store result
+void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  // count frames and errors
+  numFrames++;
+  if (Result.error != LIN_Master_Base::NO_ERROR)
+  {
+    numErrors++;
+    lastError = Result.error;
+  }
+
+  // store slave response
+  else if (Result.type == LIN_Master_Base::SLAVE_RESPONSE)
+  {
+    numRx = Result.numData;
+    memcpy(Rx, Result.data, Result.numData);
+  }
+
+} // onFrame()
+
+
+// call once
+void setup()
+{
+  // open optional console
+  #if defined(SERIAL_CONSOLE)
+
+    // Nucleo-STM32L432KC, if solder bridges for VCP via STLink have been removed
+    #if defined(ARDUINO_NUCLEO_L432KC) && (1)
+      Serial2.setTx(PA_2_ALT1);   // pin A7 on Nucleo-STM32L432KC / uC pin 8
+      Serial2.setRx(PA_3_ALT1);   // pin A2 on Nucleo-STM32L432KC / uC pin 9. Optional Rx pin
+    #endif
+
+    SERIAL_CONSOLE.begin(115200);
+  #endif // SERIAL_CONSOLE
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // open LIN interface
+  LIN.begin(19200);
+
+  // attach callback and start schedule table before timer is active, i.e. w/o lock()
+  LIN.attachCallback(onFrame);
+  LIN.setSchedule(Schedule, sizeof(Schedule)/sizeof(Schedule[0]));
+
+  // start timer operation. From now on LIN.handler() is called from timer ISR
+  Timer.begin();
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  uint8_t                   Data[8];
+  uint8_t                   NumData;
+  uint16_t                  Frames, Errors;
+  LIN_Master_Base::error_t  Error;
+
+  // copy result consistently, as callback may interrupt loop()
+  Timer.lock();
+  NumData   = numRx;
+  memcpy(Data, Rx, NumData);
+  Frames    = numFrames;
+  Errors    = numErrors;
+  Error     = lastError;
+  Timer.unlock();
+
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, (Errors != 0));
+
+  // print result
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.print(LIN.nameLIN);
+    SERIAL_CONSOLE.print(", frames=");
+    SERIAL_CONSOLE.print(Frames);
+    SERIAL_CONSOLE.print(", errors=");
+    SERIAL_CONSOLE.print(Errors);
+    if (Errors != 0)
+    {
+      SERIAL_CONSOLE.print(", last err=0x");
+      SERIAL_CONSOLE.print(Error, HEX);
+    }
+    SERIAL_CONSOLE.print(", response=");
+    for (uint8_t i=0; i < NumData; i++)
+    {
+      SERIAL_CONSOLE.print("0x");
+      SERIAL_CONSOLE.print((int) Data[i], HEX);
+      SERIAL_CONSOLE.print(" ");
+    }
+    SERIAL_CONSOLE.println();
+  #else
+    (void) Frames;
+    (void) Error;
+  #endif // SERIAL_CONSOLE
+
+  // block loop(). Frames are still sent and received in time by timer ISR
+  delay(LOOP_BLOCKING);
+
+} // loop()
@@ -0,0 +1,152 @@
+/*********************
+
+Example code for LIN diagnostics via the transport layer with background operation
+
+This code periodically reads the product identification of a slave via the LIN 2.x diagnostic service
+ReadByIdentifier (SID 0xB2, identifier 0) using LIN_Master_Transport. Requests (ID 0x3C) and responses (ID 0x3D)
+are segmented and reassembled by TP.handler(), which is only called at its next deadline.
+Optional Tx direction switching for RS485 interface (e.g. MAX485) is by defining 'PIN_TXEN'. 
+In this case, permanently enable Rx (REN=GND) for receiving echo
+
+Supported boards:
+  - Arduino Mega 2560       https://docs.arduino.cc/hardware/mega-2560/
+  - Arduino Due             https://docs.arduino.cc/hardware/due/
+  - Arduino Nano Every      https://docs.arduino.cc/hardware/nano-every/
+
+**********************/
+
+// include files
+#include "LIN_master_HardwareSerial.h"
+#include "LIN_master_Transport.h"
+
+// pause [ms] between diagnostic requests
+#define DIAG_PERIOD           1000
+
+// node address of slave (0x7F = wildcard)
+#define SLAVE_NAD             0x0A
+
+
+////////////////////
+// Arduino Mega and Due settings
+////////////////////
+#if defined(ARDUINO_AVR_MEGA2560) || defined(ARDUINO_SAM_DUE)
+
+  //#define PIN_TXEN            17                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F 
+  #define PIN_TOGGLE          30                        // pin to show CPU idle
+  #define PIN_ERROR           32                        // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+
+////////////////////
+// Arduino Nano Every settings
+////////////////////
+#elif defined(ARDUINO_AVR_NANO_EVERY)
+
+  //#define PIN_TXEN            7                         // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F 
+  #define PIN_TOGGLE          4                         // pin to show CPU idle
+  #define PIN_ERROR           6                         // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+
+// board not yet included
+#else
+  #error board not yet supported, exit!
+#endif
+
+
+// setup LIN node. Parameters: interface, name, TxEN
+#if defined(PIN_TXEN)
+  LIN_Master_HardwareSerial   LIN(Serial1, "Diag", PIN_TXEN);
+#else
+  LIN_Master_HardwareSerial   LIN(Serial1, "Diag");
+#endif
+
+// diagnostic transport layer on top of LIN node
+LIN_Master_Transport          TP(LIN);
+
+
+// call once
+void setup()
+{
+  // open optional console
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.begin(115200);
+  #endif // SERIAL_CONSOLE
+
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // open LIN interface
+  LIN.begin(19200);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t           lastDiag = 0;
+  static uint32_t           deadlineTP = 0;
+  static bool               pendingTP = false;
+  static uint8_t            Response[8];
+  static const uint8_t      Request[] = {0xB2, 0x00, 0xFF, 0x7F, 0xFF, 0xFF};   // ReadByIdentifier(0), wildcard supplier and function ID. Must remain valid during transfer
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call transport layer handler only at its next deadline. Services the LIN node
+  if ((pendingTP) && ((int32_t) (micros() - deadlineTP) >= 0))
+  {
+    // transfer ongoing -> get next deadline
+    if (TP.handler() != LIN_Master_Transport::TP_DONE)
+      pendingTP = TP.getDeadline(deadlineTP);
+
+    // transfer finished -> indicate and print result
+    else
+    {
+      LIN_Master_Transport::error_t error = TP.getError();
+      pendingTP = false;
+
+      // indicate status via pin
+      digitalWrite(PIN_ERROR, (error != LIN_Master_Transport::TP_NO_ERROR));
+
+      // print result. Positive response: RSID 0xF2, supplier ID, function ID, variant
+      #if defined(SERIAL_CONSOLE)
+        SERIAL_CONSOLE.print(LIN.nameLIN);
+        if (error != LIN_Master_Transport::TP_NO_ERROR)
+        {
+          SERIAL_CONSOLE.print(", TP err=0x");
+          SERIAL_CONSOLE.println(error, HEX);
+        }
+        else
+        {
+          SERIAL_CONSOLE.print(", response=");
+          for (uint16_t i=0; i < TP.getLength(); i++)
+          {
+            SERIAL_CONSOLE.print("0x");
+            SERIAL_CONSOLE.print((int) Response[i], HEX);
+            SERIAL_CONSOLE.print(" ");
+          }
+          SERIAL_CONSOLE.println();
+        }
+      #endif // SERIAL_CONSOLE
+
+    } // transfer finished
+
+  } // deadline reached
+
+
+  ///////////////
+  // periodically start diagnostic request
+  ///////////////
+  if ((millis() - lastDiag > DIAG_PERIOD) && (!pendingTP))
+  {
+    lastDiag = millis();
+    if (TP.request(SLAVE_NAD, Request, sizeof(Request), Response, sizeof(Response)))
+      pendingTP = TP.getDeadline(deadlineTP);
+  }
+
+} // loop()
@@ -0,0 +1,179 @@
+/*********************
+
+Example code for LIN master node with background operation using the ESP-IDF UART driver of ESP32
+
+Unlike LIN_Master_HardwareSerial_ESP32, received bytes are taken from the UART events of the ESP-IDF driver with
+Rx FIFO threshold and timeout of 1 byte, i.e. they are available ~immediately instead of >1ms later. The UART port
+must not be used via HardwareSerial (e.g. Serial2) at the same time.
+Optional Tx direction switching for RS485 interface (e.g. MAX485) is by defining 'PIN_TXEN'.
+In this case, permanently enable Rx (REN=GND) for receiving echo
+
+Note: during frame send/receive, LIN.handler() must be called at its deadline, which is returned by LIN.handler(deadline).
+In between, the CPU is free for other tasks or may sleep
+
+Supported boards:
+  - Arduino Nano ESP32-S3   https://docs.arduino.cc/hardware/nano-esp32/
+  - ESP32 WROOM-32UE        https://documentation.espressif.com/esp32-wroom-32e_esp32-wroom-32ue_datasheet_en.pdf
+
+**********************/
+
+// include files
+#include <LIN_master_UART_ESP32.h>
+
+// pause [ms] between LIN frames
+#define LIN_FRAME_PERIOD      200
+
+
+////////////////////
+// Arduino Nano ESP32 board settings (using Arduino ESP32 core)
+////////////////////
+#if defined(ARDUINO_NANO_ESP32)
+
+  //#define PIN_TXEN            10                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F
+  #define PIN_LIN_TX          3                         // LIN transmit pin
+  #define PIN_LIN_RX          4                         // LIN receive pin
+  #define PIN_TOGGLE          5                         // pin to show CPU idle
+  #define PIN_ERROR           6                         // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+  // setup LIN node. Parameters: UART port, Rx, Tx, name, TxEN
+  #if defined(PIN_TXEN)
+    LIN_Master_UART_ESP32   LIN(UART_NUM_1, PIN_LIN_RX, PIN_LIN_TX, "UART", PIN_TXEN);
+  #else
+    LIN_Master_UART_ESP32   LIN(UART_NUM_1, PIN_LIN_RX, PIN_LIN_TX, "UART");
+  #endif
+
+
+////////////////////
+// Espressif ESP32-WROOM-32UE board settings (using Espressif ESP32 core)
+////////////////////
+#elif defined(ARDUINO_ESP32_WROOM_DA)
+
+  //#define PIN_TXEN            21                        // optional Tx direction pin (=DE) for RS485 physical I/F. Comment out for LIN I/F
+  #define PIN_LIN_TX          17                        // LIN transmit pin
+  #define PIN_LIN_RX          16                        // LIN receive pin
+  #define PIN_TOGGLE          19                        // pin to show CPU idle
+  #define PIN_ERROR           18                        // LIN error status pin (high=error)
+  #define SERIAL_CONSOLE      Serial                    // serial I/F for console output (comment for no output)
+
+  // setup LIN node. Parameters: UART port, Rx, Tx, name, TxEN
+  #if defined(PIN_TXEN)
+    LIN_Master_UART_ESP32   LIN(UART_NUM_2, PIN_LIN_RX, PIN_LIN_TX, "UART", PIN_TXEN);
+  #else
+    LIN_Master_UART_ESP32   LIN(UART_NUM_2, PIN_LIN_RX, PIN_LIN_TX, "UART");
+  #endif
+
+
+// board not yet included
+#else
+  #error board not yet supported, exit!
+#endif
+
+
+// completion callback. Is called from LIN.handler() in loop()
+void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) Arg;
+
+  // indicate status via pin
+  digitalWrite(PIN_ERROR, (Result.error != LIN_Master_Base::NO_ERROR));
+
+  // print result
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.print(LIN.nameLIN);
+    SERIAL_CONSOLE.print((Result.type == LIN_Master_Base::MASTER_REQUEST) ? ", request, ID=0x" : ", response, ID=0x");
+    SERIAL_CONSOLE.print(Result.id, HEX);
+    if (Result.error != LIN_Master_Base::NO_ERROR)
+    {
+      SERIAL_CONSOLE.print(", err=0x");
+      SERIAL_CONSOLE.println(Result.error, HEX);
+    }
+    else
+    {
+      SERIAL_CONSOLE.print(", data=");
+      for (uint8_t i=0; (i < Result.numData); i++)
+      {
+        SERIAL_CONSOLE.print("0x");
+        SERIAL_CONSOLE.print((int) Result.data[i], HEX);
+        SERIAL_CONSOLE.print(" ");
+      }
+      SERIAL_CONSOLE.println();
+    }
+  #else
+    (void) LIN;
+  #endif // SERIAL_CONSOLE
+
+} // onFrame()
+
+
+// call once
+void setup()
+{
+  // open optional console
+  #if defined(SERIAL_CONSOLE)
+    SERIAL_CONSOLE.begin(115200);
+  #endif // SERIAL_CONSOLE
+
+  // indicate background operation
+  pinMode(PIN_TOGGLE, OUTPUT);
+
+  // indicate LIN status via pin
+  pinMode(PIN_ERROR, OUTPUT);
+
+  // install UART driver and open LIN interface
+  LIN.begin(19200);
+
+  // print results via callback
+  LIN.attachCallback(onFrame);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t           lastLINFrame = 0;
+  static uint32_t           deadlineLIN = 0;
+  static bool               pendingLIN = false;
+  static uint8_t            count = 0;
+  static uint8_t            Tx[4] = {0x01, 0x02, 0x03, 0x04};
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call LIN background handler only at its next deadline. Calls onFrame() when frame is finished
+  if ((pendingLIN) && ((int32_t) (micros() - deadlineLIN) >= 0))
+    pendingLIN = LIN.handler(deadlineLIN);
+
+
+  ///////////////
+  // SW scheduler for sending/receiving LIN frames
+  ///////////////
+  if ((millis() - lastLINFrame > LIN_FRAME_PERIOD) && (!pendingLIN))
+  {
+    lastLINFrame = millis();
+
+    // reset state machine & error of previous frame, which was reported via callback
+    LIN.resetStateMachine();
+    LIN.resetError();
+
+    // send master request frame (background)
+    if (count == 0)
+    {
+      count++;
+      LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, 4, Tx);
+    }
+
+    // send slave response frame (background)
+    else
+    {
+      count = 0;
+      LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, 6);
+    }
+
+    // get 1st deadline of new frame
+    pendingLIN = LIN.getDeadline(deadlineLIN);
+
+  } // SW scheduler
+
+} // loop()
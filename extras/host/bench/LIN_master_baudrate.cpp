@@ -0,0 +1,137 @@
+/*********************
+
+Host benchmark for high baudrates and the fast-mode profile
+
+Keeps the request queue filled with master requests and slave responses (8 data bytes) on a simulated bus (virtual
+time) from 19.2kBaud up to 500kBaud, i.e. beyond the former 16-bit limit of 65535 Baud (max. 500kBaud due to 1us
+resolution of the bit-level bus). The slave answers after a fixed latency plus jitter like an interrupt-driven slave,
+which does not scale with the baudrate. Every 2nd slave response is not answered (absent slave), i.e. times out.
+Compares the standard profile (frame timeout 200% nominal) with the fast profile (140% nominal plus latency, max.
+200%) and prints achieved frame rates relative to the bus maximum w/o timeouts.
+Returns 1 if the baudrate is not stored correctly, on any error except the timeouts of the absent slave, or if the
+fast profile has a longer timeout than the standard profile.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_sim.h>
+
+// benchmark parameters
+#define NUM_FRAMES        2000            // number of frames per run
+#define SLAVE_LATENCY     30              // min. slave response space [us]
+#define SLAVE_JITTER      120             // max. additional slave response space [us]
+
+
+// LIN master
+LIN_Master_HardwareSerial   LIN(Serial1, "Fast");
+
+// frame data
+uint8_t   Tx[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+uint8_t   Rx[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+// frame statistics
+uint32_t  numFrames, numErr, numTimeout;
+
+// frame sequence: request, response, request, response of absent slave
+#define NUM_SEQUENCE      4
+#define ID_ABSENT         0x06
+
+
+// completion callback
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  numFrames++;
+  if (Result.id == ID_ABSENT)
+  {
+    numTimeout += (Result.error == LIN_Master_Base::ERROR_TIMEOUT);
+    numErr += (Result.error != LIN_Master_Base::ERROR_TIMEOUT);
+  }
+  else
+    numErr += (Result.error != LIN_Master_Base::NO_ERROR);
+}
+
+
+// run frames at baudrate with profile. Return number of errors and timeout of slave response
+static uint32_t run(uint32_t Baudrate, LIN_Master_Base::profile_t Profile, uint32_t &Timeout)
+{
+  LIN_Bus_Host                  bus(Baudrate);
+  LIN_Slave_Sim                 slave(1);
+  LIN_Master_Base::descriptor_t frame[NUM_SEQUENCE];
+  uint32_t                      start, elapsed, deadline;
+  uint8_t                       count = 0;
+
+  // connect simulated bus with slave
+  bus.addSlave(slave);
+  slave.setResponseSpace(SLAVE_LATENCY, SLAVE_JITTER);
+  slave.setResponse(0x05, sizeof(Rx), Rx);
+  Serial1.connect(&bus);
+
+  // open interface with profile and prepare frames
+  LIN.setProfile(Profile);
+  LIN.begin(Baudrate);
+  LIN.prepareFrame(frame[0], LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, sizeof(Tx));
+  LIN.prepareFrame(frame[1], LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x05, sizeof(Rx));
+  LIN.prepareFrame(frame[2], LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1B, sizeof(Tx));
+  LIN.prepareFrame(frame[3], LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, ID_ABSENT, sizeof(Rx));
+  LIN.attachCallback(onFrame);
+
+  // keep queue filled
+  numFrames = numErr = numTimeout = 0;
+  start = micros();
+  while (numFrames < NUM_FRAMES)
+  {
+    while (LIN.queueFrame(frame[count % NUM_SEQUENCE], Tx))
+      count++;
+    LIN.handler();
+    if (LIN.getDeadline(deadline))
+      scheduleTime(deadline);
+    yield();
+  }
+  elapsed = micros() - start;
+  while (LIN.queueCount() > 0)
+    LIN.handler();
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  LIN.attachCallback(NULL);
+
+  // bus maximum: BREAK (2 bytes at half baudrate) + SYNC + PID + 8 DATA + CHK w/o gaps
+  double fpsMax = Baudrate / (10.0 * (2 + 2 + 8 + 1));
+  double fps = 1000000.0 * numFrames / elapsed;
+  printf("%6u Baud  %-8s  frames=%-5u errors=%-3u timeouts=%-4u %7.1f frames/s (%5.1f%% of bus maximum)  timeout=%5uus\n",
+    (unsigned) LIN.getBaudrate(), (Profile == LIN_Master_Base::PROFILE_FAST) ? "fast" : "standard", (unsigned) numFrames,
+    (unsigned) numErr, (unsigned) numTimeout, fps, 100.0 * fps / fpsMax, (unsigned) frame[3].timeout);
+  Timeout = frame[3].timeout;
+  LIN.end();
+  Serial1.connect(NULL);
+
+  // return errors incl. truncated baudrate
+  return numErr + (LIN.getBaudrate() != Baudrate);
+}
+
+
+int main(void)
+{
+  const uint32_t  baud[] = { 19200, 115200, 250000, 500000 };
+  uint32_t        errors = 0;
+  uint32_t        timeoutStandard, timeoutFast;
+
+  // virtual time for fast simulation
+  setVirtualTime(true);
+  printf("slave response space %u..%uus\n", (unsigned) SLAVE_LATENCY, (unsigned) (SLAVE_LATENCY + SLAVE_JITTER));
+
+  // all baudrates with both profiles
+  for (uint8_t i = 0; i < sizeof(baud) / sizeof(baud[0]); i++)
+  {
+    errors += run(baud[i], LIN_Master_Base::PROFILE_STANDARD, timeoutStandard);
+    errors += run(baud[i], LIN_Master_Base::PROFILE_FAST, timeoutFast);
+    errors += (timeoutFast > timeoutStandard);
+  }
+
+  // return error code
+  return (errors != 0);
+
+} // main()
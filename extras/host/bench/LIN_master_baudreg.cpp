@@ -0,0 +1,175 @@
+/*********************
+
+Host benchmark for BREAK generation via the UART baudrate register
+
+Sends master requests back-to-back on a simulated bus (virtual time) and compares switching to 1/2 baudrate for the
+BREAK via a) the baudrate register of the mock HardwareSerial (like UBRRn on AVR, USARTn.BAUD on megaAVR, UART_BRGR
+on SAM) and b) Serial.begin(). Cycles can't be counted on the host, therefore the execution time of Serial.begin()
+is modelled (baudrate calculation and UART re-initialization on a 16MHz AVR), while the register write is ~free.
+An observer checks the baudrate of each sent byte, and the gap between BREAK and SYNC is measured.
+Returns 1 on any frame error, if the BREAK is not sent at exactly 1/2 baudrate, the nominal baudrate is not restored,
+or if register switching is not faster than Serial.begin().
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_sim.h>
+
+// benchmark parameters
+#define NUM_FRAMES        500             // number of frames per run
+#define BEGIN_TIME        40              // modelled execution time [us] of Serial.begin()
+
+
+// LIN master
+LIN_Master_HardwareSerial   LIN(Serial1, "BaudReg");
+
+// frame data
+uint8_t   Tx[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+// frame statistics
+uint32_t  numFrames, numErr;
+uint64_t  sumDuration;
+
+
+// observer of sent bytes: check baudrate of BREAK and following bytes, measure gap between BREAK and SYNC
+class Observer : public HardwareSerial_Listener
+{
+  public:
+
+    uint32_t  baudrate;                   // nominal baudrate [Baud]
+    uint32_t  numBaudErr;                 // number of bytes with wrong baudrate
+    uint32_t  timeBreakEnd;               // end of last BREAK [us]
+    bool      afterBreak;                 // last sent byte was BREAK
+    uint64_t  sumGap;                     // sum of gaps between BREAK and SYNC [us]
+    uint32_t  maxGap;                     // max. gap between BREAK and SYNC [us]
+    uint32_t  numGap;                     // number of gaps
+
+    void reset(uint32_t Baudrate)
+    {
+      baudrate = Baudrate;
+      numBaudErr = numGap = maxGap = 0;
+      sumGap = 0;
+      afterBreak = false;
+    }
+
+    void onTransmit(HardwareSerial &Port, uint8_t Data, uint32_t Baudrate, uint32_t TimeEnd)
+    {
+      (void) Port;
+
+      // BREAK is 0x00 at exactly 1/2 baudrate
+      if ((Data == 0x00) && (Baudrate != baudrate))
+      {
+        numBaudErr += (Baudrate != (baudrate >> 1));
+        timeBreakEnd = TimeEnd;
+        afterBreak = true;
+        return;
+      }
+
+      // other bytes at nominal baudrate
+      numBaudErr += (Baudrate != baudrate);
+
+      // SYNC after BREAK: gap between end of BREAK and start of SYNC
+      if (afterBreak)
+      {
+        uint32_t gap = (TimeEnd - (10000000L + baudrate/2) / baudrate) - timeBreakEnd;
+        sumGap += gap;
+        if (gap > maxGap)
+          maxGap = gap;
+        numGap++;
+        afterBreak = false;
+      }
+    }
+
+} observer;
+
+
+// completion callback
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  numFrames++;
+  sumDuration += Result.duration;
+  numErr += (Result.error != LIN_Master_Base::NO_ERROR);
+}
+
+
+// run frames with register switching or Serial.begin(). Return avg. frame duration [us]
+static double run(uint32_t Baudrate, bool Register, uint32_t &Errors)
+{
+  LIN_Bus_Host                  bus(Baudrate);
+  LIN_Slave_Sim                 slave(1);
+  LIN_Master_Base::descriptor_t frame;
+
+  // connect simulated bus and observer
+  bus.addSlave(slave);
+  Serial1.connect(&bus);
+  Serial1.attach(&observer);
+  observer.reset(Baudrate);
+
+  // model Serial.begin() and optionally hide baudrate register. Before LIN.begin(), which gets the register
+  Serial1.setBaudRegister(Register);
+  Serial1.setBeginTime(BEGIN_TIME);
+
+  // open interface and keep queue filled. Call handler() at each bus event, i.e. like fast polling
+  LIN.begin(Baudrate);
+  LIN.prepareFrame(frame, LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, sizeof(Tx));
+  LIN.attachCallback(onFrame);
+  numFrames = numErr = 0;
+  sumDuration = 0;
+  while (numFrames < NUM_FRAMES)
+  {
+    while (LIN.queueFrame(frame, Tx));
+    LIN.handler();
+    yield();
+  }
+  while (LIN.queueCount() > 0)
+    LIN.handler();
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  LIN.attachCallback(NULL);
+
+  // errors incl. wrong baudrate of sent bytes and not restored baudrate
+  Errors = numErr + observer.numBaudErr + (Serial1.getBaudrate() != Baudrate);
+  double duration = (double) sumDuration / numFrames;
+  printf("%6u Baud  %-8s  frames=%u errors=%u  baudrate errors=%u  BREAK->SYNC gap avg=%5.1fus max=%3uus  avg. frame=%6.1fus\n",
+    (unsigned) Baudrate, Register ? "register" : "begin()", (unsigned) numFrames, (unsigned) numErr,
+    (unsigned) observer.numBaudErr, (double) observer.sumGap / observer.numGap, (unsigned) observer.maxGap, duration);
+
+  // close interface
+  LIN.end();
+  Serial1.attach(NULL);
+  Serial1.connect(NULL);
+  Serial1.setBaudRegister(true);
+  Serial1.setBeginTime(0);
+
+  return duration;
+}
+
+
+int main(void)
+{
+  const uint32_t  baud[] = { 9600, 19200, 115200 };
+  uint32_t        errors = 0, err;
+  double          durationReg, durationBegin;
+
+  // virtual time for fast simulation
+  setVirtualTime(true);
+  printf("modelled Serial.begin() %uus\n", (unsigned) BEGIN_TIME);
+
+  // all baudrates with both variants
+  for (uint8_t i = 0; i < sizeof(baud) / sizeof(baud[0]); i++)
+  {
+    durationBegin = run(baud[i], false, err);
+    errors += err;
+    durationReg = run(baud[i], true, err);
+    errors += err;
+    errors += (durationReg >= durationBegin);
+  }
+
+  // return error code
+  return (errors != 0);
+
+} // main()
@@ -0,0 +1,172 @@
+/*********************
+
+Host benchmark on a bit-level simulated LIN bus
+
+A LIN_Master_HardwareSerial and a LIN_master_SoftwareSerial each run on an own simulated bus (see LIN_bus_host.h)
+with 32 simulated slaves. Slave n answers frame ID n with 1..8 data bytes after a response space with random jitter.
+The request queue is kept filled with slave response frames for all IDs, i.e. frames are sent back-to-back.
+Reports throughput and frame latency (start until completion detected by handler()) vs. the nominal frame duration.
+Finally two slaves answer the same ID, which must be detected as error by the master due to the wired-AND bus.
+Returns 1 on any echo/checksum error or data mismatch (or a missing error for the collision).
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_master_SoftwareSerial.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_sim.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NUM_SLAVES        32              // number of slaves per bus
+#define DURATION          1000            // duration [ms] per master
+#define RESPONSE_SPACE    40              // min. slave response space [us]
+#define RESPONSE_JITTER   100             // max. random jitter of response space [us]
+#define INTERBYTE_SPACE   10              // space between response bytes [us]
+#define PIN_SW_RX         10              // SoftwareSerial Rx pin
+#define PIN_SW_TX         11              // SoftwareSerial Tx pin
+
+
+// simulated buses with slaves
+LIN_Bus_Host                BusHW(LIN_BAUDRATE), BusSW(LIN_BAUDRATE);
+LIN_Slave_Sim               *SlavesHW[NUM_SLAVES], *SlavesSW[NUM_SLAVES];
+
+// LIN masters on HardwareSerial and SoftwareSerial
+LIN_Master_HardwareSerial   LIN_HW(Serial1, "HW");
+LIN_master_SoftwareSerial   LIN_SW(PIN_SW_RX, PIN_SW_TX, false, "SW");
+
+// frame statistics
+uint32_t  numFrames;
+uint32_t  numErr;
+uint32_t  numTimeout;
+uint64_t  sumLatency;
+uint32_t  maxLatency;
+uint64_t  sumNominal;
+
+
+// response data of slave n
+static void responseData(uint8_t Id, uint8_t Data[8])
+{
+  for (uint8_t i = 0; i < 8; i++)
+    Data[i] = (uint8_t) (Id * 16 + i);
+}
+
+
+// completion callback
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+  uint8_t data[8];
+
+  // check error and data
+  bool err = ((Result.error & ~LIN_Master_Base::ERROR_TIMEOUT) != 0);
+  responseData(Result.id, data);
+  if ((Result.error == LIN_Master_Base::NO_ERROR) && ((Result.numData != 1 + (Result.id % 8)) || (memcmp(Result.data, data, Result.numData) != 0)))
+    err = true;
+  numFrames++;
+  numErr += err;
+  numTimeout += ((Result.error & LIN_Master_Base::ERROR_TIMEOUT) != 0);
+
+  // latency vs. nominal: BREAK (13bit) + delimiter (1bit) + SYNC + PID + DATA + CHK + response and inter-byte space
+  if (Result.error == LIN_Master_Base::NO_ERROR)
+  {
+    sumLatency += Result.duration;
+    if (Result.duration > maxLatency)
+      maxLatency = Result.duration;
+    sumNominal += (uint32_t) ((14 + 10 * (Result.numData + 3)) * 1000000ULL / LIN_BAUDRATE) + RESPONSE_SPACE + RESPONSE_JITTER/2 + INTERBYTE_SPACE * Result.numData;
+  }
+
+  // erroneous frame (e.g. timeout due to OS preemption) -> wait until rest of frame has passed the bus
+  if (Result.error != LIN_Master_Base::NO_ERROR)
+    delay(10);
+}
+
+
+// create slaves on a bus. Slave n answers ID n with 1..8 bytes
+static void addSlaves(LIN_Bus_Host &Bus, LIN_Slave_Sim *Slaves[])
+{
+  uint8_t data[8];
+
+  for (uint8_t id = 0; id < NUM_SLAVES; id++)
+  {
+    responseData(id, data);
+    Slaves[id] = new LIN_Slave_Sim(id + 1);
+    Slaves[id]->setResponse(id, 1 + (id % 8), data);
+    Slaves[id]->setResponseSpace(RESPONSE_SPACE, RESPONSE_JITTER);
+    Slaves[id]->setInterByteSpace(INTERBYTE_SPACE);
+    Bus.addSlave(*(Slaves[id]));
+  }
+}
+
+
+// keep request queue filled with slave responses for all IDs. Return errors
+static uint32_t run(const char *Name, LIN_Master_Base &LIN)
+{
+  LIN_Master_Base::descriptor_t frame[NUM_SLAVES];
+  uint8_t                       id = 0;
+  uint32_t                      start, elapsed;
+
+  // prepare frames
+  LIN.begin(LIN_BAUDRATE);
+  LIN.attachCallback(onFrame);
+  for (uint8_t i = 0; i < NUM_SLAVES; i++)
+    LIN.prepareFrame(frame[i], LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, i, 1 + (i % 8));
+
+  // send frames back-to-back
+  numFrames = numErr = numTimeout = maxLatency = 0;
+  sumLatency = sumNominal = 0;
+  start = millis();
+  while (millis() - start < DURATION)
+  {
+    while (LIN.queueFrame(frame[id]))
+      id = (id + 1) % NUM_SLAVES;
+    LIN.handler();
+  }
+  while (LIN.queueCount() > 0)
+    LIN.handler();
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  elapsed = millis() - start;
+  LIN.attachCallback(NULL);
+  LIN.end();
+
+  // print results
+  uint32_t numOk = numFrames - numErr - numTimeout;
+  printf("%-3s slaves=%u frames=%-4u errors=%-3u timeouts=%-3u %6.1f frames/s  latency avg/max=%5u/%5uus (nominal avg %5uus)\n",
+    Name, (unsigned) NUM_SLAVES, (unsigned) numFrames, (unsigned) numErr, (unsigned) numTimeout, 1000.0 * numFrames / elapsed,
+    (unsigned) (numOk ? sumLatency / numOk : 0), (unsigned) maxLatency, (unsigned) (numOk ? sumNominal / numOk : 0));
+
+  return numErr;
+
+} // run()
+
+
+int main(void)
+{
+  uint32_t  errors = 0;
+
+  // connect masters and slaves to simulated buses
+  addSlaves(BusHW, SlavesHW);
+  addSlaves(BusSW, SlavesSW);
+  Serial1.connect(&BusHW);
+  BusSW.connectPin(PIN_SW_TX);
+  printf("simulated LIN bus @ %u Baud, response space %u+%uus, inter-byte space %uus\n", (unsigned) LIN_BAUDRATE,
+    (unsigned) RESPONSE_SPACE, (unsigned) RESPONSE_JITTER, (unsigned) INTERBYTE_SPACE);
+
+  // throughput and latency
+  errors += run("HW", LIN_HW);
+  errors += run("SW", LIN_SW);
+
+  // collision: 2nd slave answers ID 0x05 with other data -> error expected
+  uint8_t data[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+  SlavesHW[6]->setResponse(0x05, 6, data);
+  LIN_HW.begin(LIN_BAUDRATE);
+  LIN_Master_Base::error_t err = LIN_HW.receiveSlaveResponseBlocking(LIN_Master_Base::LIN_V2, 0x05, 6, data);
+  printf("collision of 2 slaves on ID 0x05: err=0x%02X\n", (int) err);
+  errors += (err == LIN_Master_Base::NO_ERROR);
+
+  // return error code
+  return (errors != 0);
+
+} // main()
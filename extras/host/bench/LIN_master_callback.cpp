@@ -0,0 +1,151 @@
+/*********************
+
+Host benchmark for completion callbacks
+
+Runs alternating master request and slave response frames a) with polling of getState() after every handler()
+call like in the examples and b) with a completion callback attached via attachCallback(). Reports how often the
+application code is executed per frame and the frame latency reported to the callback.
+Returns 1 on any echo/checksum error, data mismatch or if the callback is not called exactly once per frame.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_slave_host.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NUM_FRAMES        100             // number of frames per type and variant
+
+
+// LIN master and simulated slave on Serial1
+LIN_Master_HardwareSerial   LIN(Serial1, "Master");
+LIN_Slave_Host              Slave(LIN_BAUDRATE);
+
+// frame data
+uint8_t   Tx[4] = {0x01, 0x02, 0x03, 0x04};
+uint8_t   Rx[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+
+
+/// application statistics
+typedef struct
+{
+  uint32_t  numFrames;                    // number of finished frames
+  uint32_t  numErr;                       // number of erroneous frames (excl. timeout)
+  uint32_t  numCalls;                     // number of application calls (poll or callback)
+  uint64_t  sumDuration;                  // sum of reported frame durations [us]
+} app_t;
+
+
+// check frame result, count errors
+static void checkResult(app_t &App, LIN_Master_Base::frame_t Type, uint8_t NumData, const uint8_t Data[], LIN_Master_Base::error_t Error)
+{
+  bool err = ((Error & ~LIN_Master_Base::ERROR_TIMEOUT) != 0);
+  if ((Type == LIN_Master_Base::SLAVE_RESPONSE) && (Error == LIN_Master_Base::NO_ERROR) && ((NumData != 6) || (memcmp(Data, Rx, 6) != 0)))
+    err = true;
+  App.numFrames++;
+  App.numErr += err;
+}
+
+
+// completion callback
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  app_t &app = *((app_t *) Arg);
+
+  app.numCalls++;
+  app.sumDuration += Result.duration;
+  checkResult(app, Result.type, Result.numData, Result.data, Result.error);
+}
+
+
+// run frames and call handler as fast as possible
+static void runFrames(app_t &App, bool Poll)
+{
+  LIN_Master_Base::frame_t  Type;
+  LIN_Master_Base::error_t  error;
+  uint8_t                   Id;
+  uint8_t                   NumData;
+  uint8_t                   Data[8];
+
+  for (uint16_t i = 0; i < 2*NUM_FRAMES; i++)
+  {
+    // start frame
+    uint32_t tStart = micros();
+    if (i & 0x01)
+      LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, 6);
+    else
+      LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, 4, Tx);
+
+    // poll state after every handler() call, like in examples
+    if (Poll)
+    {
+      while (true)
+      {
+        LIN.handler();
+        App.numCalls++;
+        if (LIN.getState() == LIN_Master_Base::STATE_DONE)
+        {
+          LIN.getFrame(Type, Id, NumData, Data);
+          error = LIN.getError();
+          App.sumDuration += micros() - tStart;
+          checkResult(App, Type, NumData, Data, error);
+          break;
+        }
+      }
+    }
+
+    // application is only called via callback
+    else
+    {
+      while (LIN.handler() != LIN_Master_Base::STATE_DONE);
+    }
+
+    // erroneous frame (e.g. timeout due to OS preemption) -> wait until rest of frame has passed the bus
+    if (LIN.getError() != LIN_Master_Base::NO_ERROR)
+      delay(10);
+
+    // prepare next frame
+    LIN.resetStateMachine();
+    LIN.resetError();
+  }
+
+} // runFrames()
+
+
+// print statistics
+static void printApp(const char *Name, const app_t &App)
+{
+  printf("%-10s frames=%-4u errors=%-3u application calls=%-8u (%6.1f per frame)  avg. frame duration=%5uus\n",
+    Name, (unsigned) App.numFrames, (unsigned) App.numErr, (unsigned) App.numCalls, (double) App.numCalls / App.numFrames,
+    (unsigned) (App.sumDuration / App.numFrames));
+
+} // printApp()
+
+
+int main(void)
+{
+  app_t   poll = app_t();
+  app_t   callback = app_t();
+
+  // attach slave model and open LIN interface
+  Slave.setResponse(0x05, 6, Rx);
+  Serial1.attach(&Slave);
+  LIN.begin(LIN_BAUDRATE);
+  printf("completion notification @ %u Baud\n", (unsigned) LIN_BAUDRATE);
+
+  // a) polling via getState()
+  runFrames(poll, true);
+  printApp("polling", poll);
+
+  // b) completion callback
+  LIN.attachCallback(onFrame, &callback);
+  runFrames(callback, false);
+  LIN.attachCallback(NULL);
+  printApp("callback", callback);
+
+  // return error code
+  return ((poll.numErr + callback.numErr) != 0) || (callback.numCalls != 2*NUM_FRAMES) || (callback.numFrames != 2*NUM_FRAMES);
+
+} // main()
@@ -0,0 +1,217 @@
+/*********************
+
+Host benchmark for change subscriptions
+
+Runs a schedule table with 3 slave responses on a simulated bus (virtual time). Slave scripts change the data
+like typical ECUs, i.e. an alive counter every frame and status signals only rarely. Compares how often the
+application is called a) via the completion callback (every frame) and b) via change subscriptions of a complete
+frame, of single signals and of a frame with an alive counter. Also measures the cost of the change check per response.
+Returns 1 on any frame error or if the number of change callbacks differs from the number of scripted changes.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_sim.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NUM_SLOTS         3000            // number of schedule slots
+#define NUM_LOOPS         2000000         // number of change checks for cost measurement
+
+
+/// LIN master with access to change check (for measurement only)
+class LIN_Master_Bench : public LIN_Master_Base
+{
+  public:
+
+    LIN_Master_Bench(const char NameLIN[]) : LIN_Master_Base(NameLIN) { }
+
+    // simulate finished slave response and check changes
+    __attribute__((noinline)) void response(uint8_t Id, uint8_t NumData, const uint8_t Data[])
+    {
+      this->id    = Id;
+      this->lenRx = NumData + 4;
+      this->error = LIN_Master_Base::NO_ERROR;
+      memcpy(this->bufRx+3, Data, NumData);
+      this->_checkChanges();
+    }
+};
+
+
+// simulated bus with one slave
+LIN_Bus_Host                Bus(LIN_BAUDRATE);
+LIN_Slave_Sim               Slave(1);
+
+// LIN master
+LIN_Master_HardwareSerial   LIN(Serial1, "Change");
+
+// schedule table with slave responses: type, version, ID, number of data, data, slot [us]
+const LIN_Master_Base::schedule_t Table[] = {
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x20, 8, NULL, 10000 },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x21, 8, NULL, 10000 },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x22, 4, NULL, 10000 }
+};
+#define NUM_ENTRIES   (sizeof(Table) / sizeof(Table[0]))
+
+// slave data: 0x20 temperature changes every 16th response, 0x21 alive counter in byte 0 and
+// 2-bit status (bits 8..9) every 25th response, 0x22 is constant
+uint8_t   Temp[8]   = { 20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+uint8_t   Status[8] = { 0x00, 0xFC, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC };
+uint8_t   Const[4]  = { 0x11, 0x22, 0x33, 0x44 };
+
+// scripted changes and headers per ID
+uint32_t  numHeaders[64];
+uint32_t  changesTemp, changesStatus, changesAlive;
+
+// application statistics
+uint32_t  numFrames, numErr, callsFrame, callsChange, callsStatus;
+bool      statusOk = true;
+
+
+// slave script: change data before response
+static bool script(LIN_Slave_Sim &Slave, uint8_t Id, void *Arg)
+{
+  (void) Arg;
+
+  uint32_t n = numHeaders[Id]++;
+  if ((Id == 0x20) && (n > 0) && ((n % 16) == 0))
+  {
+    Temp[0]++;
+    changesTemp++;
+    Slave.setResponse(0x20, sizeof(Temp), Temp);
+  }
+  else if ((Id == 0x21) && (n > 0))
+  {
+    Status[0]++;
+    changesAlive++;
+    if ((n % 25) == 0)
+    {
+      Status[1] = (uint8_t) ((Status[1] & ~0x03) | ((Status[1] + 1) & 0x03));
+      changesStatus++;
+    }
+    Slave.setResponse(0x21, sizeof(Status), Status);
+  }
+  return true;
+}
+
+
+// completion callback: application would process every frame
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  numErr += (Result.error != LIN_Master_Base::NO_ERROR);
+  numFrames++;
+  callsFrame++;
+}
+
+
+// change callback: application processes only changed frames or signals
+static void onChange(LIN_Master_Base &LIN, const LIN_Master_Base::subscription_t &Sub, void *Arg)
+{
+  (void) LIN;
+  (void) Sub;
+  (void) Arg;
+
+  callsChange++;
+}
+
+
+// change callback for status signal: must only be called for status changes
+static void onStatus(LIN_Master_Base &LIN, const LIN_Master_Base::subscription_t &Sub, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  callsStatus++;
+  statusOk &= LIN_Master_Base::hasChanged(Sub, 8, 2) && !LIN_Master_Base::hasChanged(Sub, 0, 8);
+  statusOk &= ((Sub.last.byte[1] & 0x03) == (Status[1] & 0x03));
+}
+
+
+// measure cost of change check per unchanged response
+static void measure(void)
+{
+  LIN_Master_Bench                  bench("Bench");
+  LIN_Master_Base::subscription_t   sub[4];
+  uint32_t                          start;
+
+  bench.subscribe(sub[0], 0x20, onChange);
+  bench.subscribe(sub[1], 0x21, onChange, NULL, 8, 2);
+  bench.subscribe(sub[2], 0x22, onChange);
+  bench.subscribe(sub[3], 0x23, onChange);
+  callsChange = 0;
+  start = micros();
+  for (uint32_t i = 0; i < NUM_LOOPS; i++)
+  {
+    Status[0] = (uint8_t) i;
+    bench.response(0x21, sizeof(Status), Status);
+  }
+  printf("change check: %5.1f ns/response incl. copy to receive buffer (4 subscriptions, watched signal unchanged, %u callback)\n",
+    1000.0 * (micros() - start) / NUM_LOOPS, (unsigned) callsChange);
+}
+
+
+int main(void)
+{
+  LIN_Master_Base::subscription_t   subTemp, subStatus, subAlive, subConst;
+  uint32_t                          deadline;
+  uint32_t                          errors = 0;
+
+  // measure with system clock
+  measure();
+
+  // virtual time for fast simulation. Before connecting bus, which stores time stamps
+  setVirtualTime(true);
+  Bus.addSlave(Slave);
+  Serial1.connect(&Bus);
+  Slave.setResponse(0x20, sizeof(Temp), Temp);
+  Slave.setResponse(0x21, sizeof(Status), Status);
+  Slave.setResponse(0x22, sizeof(Const), Const);
+  Slave.attachScript(script);
+
+  // subscribe complete frames, status signal (bits 8..9) only and frame with alive counter
+  LIN.subscribe(subTemp, 0x20, onChange);
+  LIN.subscribe(subStatus, 0x21, onStatus, NULL, 8, 2);
+  LIN.subscribe(subAlive, 0x21);
+  LIN.subscribe(subConst, 0x22, onChange);
+
+  // run schedule table
+  callsChange = 0;
+  LIN.begin(LIN_BAUDRATE);
+  LIN.attachCallback(onFrame);
+  LIN.setSchedule(Table, NUM_ENTRIES);
+  while (numFrames < NUM_SLOTS)
+  {
+    LIN.handler();
+    if (LIN.getDeadline(deadline))
+      scheduleTime(deadline);
+    yield();
+  }
+  LIN.stopSchedule();
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  LIN.attachCallback(NULL);
+  LIN.end();
+
+  // compare with scripted changes. 1st response is always a change
+  errors += numErr;
+  errors += (subTemp.numChanges != changesTemp + 1);
+  errors += (subStatus.numChanges != changesStatus + 1) || (callsStatus != changesStatus + 1) || (!statusOk);
+  errors += (subAlive.numChanges != changesAlive + 1) || (subAlive.numChanges != subAlive.numFrames);
+  errors += (subConst.numChanges != 1);
+  errors += (callsChange != subTemp.numChanges + subConst.numChanges);
+  printf("change subscriptions @ %u Baud: frames=%u errors=%u\n", (unsigned) LIN_BAUDRATE, (unsigned) numFrames, (unsigned) errors);
+  printf("  temperature frame  responses=%-5u changes=%u\n", (unsigned) subTemp.numFrames, (unsigned) subTemp.numChanges);
+  printf("  status signal      responses=%-5u changes=%u\n", (unsigned) subStatus.numFrames, (unsigned) subStatus.numChanges);
+  printf("  alive counter      responses=%-5u changes=%u\n", (unsigned) subAlive.numFrames, (unsigned) subAlive.numChanges);
+  printf("  constant frame     responses=%-5u changes=%u\n", (unsigned) subConst.numFrames, (unsigned) subConst.numChanges);
+  printf("application calls: completion callback=%u  change callbacks=%u (%.1fx less)\n", (unsigned) callsFrame,
+    (unsigned) (callsChange + callsStatus), (double) callsFrame / (callsChange + callsStatus));
+
+  // return error code
+  return (errors != 0);
+
+} // main()
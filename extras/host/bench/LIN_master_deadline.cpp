@@ -0,0 +1,155 @@
+/*********************
+
+Host benchmark for deadline-driven handler calls
+
+Starts alternating master request, slave response and slave response of an absent slave (timeout) every 10ms on a
+simulated bus (virtual time). The slave answers after a response space with jitter. Compares the number of handler()
+calls per frame of a) fixed-period polling every 300us like the examples and b) calling handler() only at the deadline
+returned by handler(Deadline), i.e. sleeping in between. Also compares the delay until frame completion is detected.
+Returns 1 on any unexpected frame error or if the deadline variant needs more calls or detects completion >1/4 byte later
+(re-check of an overdue frame every 1/2 byte vs. polling every 300us).
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_sim.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NUM_FRAMES        300             // number of frames per variant
+#define FRAME_PERIOD      10000           // frame period [us]
+#define HANDLER_PERIOD    300             // polling period [us] like examples
+#define DURATION_TOL      130             // tolerated later completion detection [us], ~1/4 byte
+#define ID_ABSENT         0x06            // slave response w/o slave
+
+
+// simulated bus with one slave
+LIN_Bus_Host                Bus(LIN_BAUDRATE);
+LIN_Slave_Sim               Slave(1);
+
+// LIN master
+LIN_Master_HardwareSerial   LIN(Serial1, "Sleep");
+
+// frame data
+uint8_t   Tx[4] = {0x01, 0x02, 0x03, 0x04};
+uint8_t   Rx[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+
+// statistics
+uint32_t  numFrames, numErr, numCalls;
+uint64_t  sumDuration;
+
+
+// completion callback
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  numFrames++;
+  sumDuration += Result.duration;
+  if (Result.id == ID_ABSENT)
+    numErr += (Result.error != LIN_Master_Base::ERROR_TIMEOUT);
+  else
+    numErr += (Result.error != LIN_Master_Base::NO_ERROR);
+}
+
+
+// start next frame of sequence
+static void startFrame(uint8_t Count)
+{
+  LIN.resetStateMachine();
+  LIN.resetError();
+  if ((Count % 3) == 0)
+    LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, sizeof(Tx), Tx);
+  else
+    LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, ((Count % 3) == 1) ? 0x05 : ID_ABSENT, sizeof(Rx));
+}
+
+
+// run frames with fixed-period polling or deadline-driven handler calls. Return calls per frame
+static double run(bool Deadline, double &Duration)
+{
+  uint32_t  nextFrame, lastHandler, deadline = 0;
+  bool      pending = false;
+  uint8_t   count = 0;
+
+  numFrames = numErr = numCalls = 0;
+  sumDuration = 0;
+  LIN.begin(LIN_BAUDRATE);
+  LIN.attachCallback(onFrame);
+  nextFrame = lastHandler = micros();
+  while (numFrames < NUM_FRAMES)
+  {
+    // SW scheduler: start next frame
+    if ((int32_t) (micros() - nextFrame) >= 0)
+    {
+      nextFrame += FRAME_PERIOD;
+      startFrame(count++);
+      if (Deadline)
+        pending = LIN.getDeadline(deadline);
+    }
+
+    // a) fixed-period polling like examples
+    if (!Deadline)
+    {
+      if (micros() - lastHandler >= HANDLER_PERIOD)
+      {
+        lastHandler = micros();
+        LIN.handler();
+        numCalls++;
+      }
+      scheduleTime(lastHandler + HANDLER_PERIOD);
+    }
+
+    // b) handler only at its deadline
+    else
+    {
+      if ((pending) && ((int32_t) (micros() - deadline) >= 0))
+      {
+        pending = LIN.handler(deadline);
+        numCalls++;
+      }
+      if (pending)
+        scheduleTime(deadline);
+    }
+
+    // sleep until next event
+    scheduleTime(nextFrame);
+    yield();
+  }
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  LIN.attachCallback(NULL);
+  LIN.end();
+
+  Duration = (double) sumDuration / numFrames;
+  return (double) numCalls / numFrames;
+}
+
+
+int main(void)
+{
+  double  callsPoll, callsDeadline, durationPoll, durationDeadline;
+
+  // virtual time for fast simulation. Before connecting bus, which stores time stamps
+  setVirtualTime(true);
+  Bus.addSlave(Slave);
+  Serial1.connect(&Bus);
+  Slave.setResponse(0x05, sizeof(Rx), Rx);
+  Slave.setResponseSpace(100, 1000);
+
+  // compare both variants
+  callsPoll = run(false, durationPoll);
+  uint32_t errPoll = numErr;
+  printf("polling %3uus  frames=%u errors=%u  handler calls/frame=%5.1f  avg. frame duration=%6.0fus\n", (unsigned) HANDLER_PERIOD,
+    (unsigned) numFrames, (unsigned) errPoll, callsPoll, durationPoll);
+  callsDeadline = run(true, durationDeadline);
+  printf("deadline      frames=%u errors=%u  handler calls/frame=%5.1f  avg. frame duration=%6.0fus\n",
+    (unsigned) numFrames, (unsigned) numErr, callsDeadline, durationDeadline);
+  printf("%.1fx less handler calls\n", callsPoll / callsDeadline);
+
+  // return error code
+  return ((errPoll + numErr) != 0) || (callsDeadline >= callsPoll) || (durationDeadline > durationPoll + DURATION_TOL);
+
+} // main()
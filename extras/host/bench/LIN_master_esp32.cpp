@@ -0,0 +1,192 @@
+/*********************
+
+Host benchmark for ESP32 via ESP-IDF UART driver with event queue
+
+Runs LIN_Master_UART_ESP32 against the mocked ESP-IDF UART driver, connected to a simulated bus (virtual time) with one
+slave. Alternates master requests and slave responses every 20ms and calls handler() at each bus or driver event,
+i.e. like an event driven task. Compares the frame completion latency (frame duration from the timing instrumentation
+minus nominal duration) for a) Rx FIFO full threshold 120 and Rx timeout 2 symbols, i.e. received bytes are only
+delivered after >1ms like via Serial.available(), and b) both set to 1 by LIN_Master_UART_ESP32::begin().
+The callback checks the received data.
+Finally checks driver failures: a) Rx events of a complete frame pointing to a flushed ring buffer must end in a
+timeout, not in an echo error from dummy data, and b) a BREAK with the transmitter still busy must fail after the
+bounded wait time (max. 2 bytes + 1 tick) instead of blocking.
+Returns 1 on any frame error or wrong data, if the event driven latency is not below 100us, if the delayed
+variant is not >1ms late (i.e. the benchmark is meaningless), or if a driver failure is not reported as expected.
+
+**********************/
+
+// include files
+#include <LIN_master_UART_ESP32.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_sim.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NUM_FRAMES        200             // number of frames per variant
+#define FRAME_PERIOD      20000           // frame period [us]
+#define SLAVE_SPACE       100             // slave response space [us]
+#define DELAY_THRESH      120             // Rx FIFO full threshold [bytes] of delayed variant
+#define DELAY_TIMEOUT     2               // Rx timeout [symbols] of delayed variant
+
+
+// simulated bus with one slave
+LIN_Bus_Host            Bus(LIN_BAUDRATE);
+LIN_Slave_Sim           Slave(1);
+
+// LIN master via mocked ESP-IDF UART driver on Serial1 (pins are ignored)
+LIN_Master_UART_ESP32   LIN(UART_NUM_1, 0, 1, "ESP32");
+
+// frame data
+uint8_t   Tx[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+uint8_t   Rx[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+// nominal frame duration [us]: BREAK (2 bytes at half baudrate) + SYNC + PID + 8 DATA + CHK w/o gaps
+const uint32_t  Nominal = (2 + 2 + 8 + 1) * ((10000000L + LIN_BAUDRATE/2) / LIN_BAUDRATE);
+
+// frame statistics
+uint32_t  numFrames, numErr, maxLatency;
+uint64_t  sumLatency;
+
+
+// completion callback
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  // completion latency after last byte. Slave response includes response space
+  uint32_t nominal = Nominal + ((Result.type == LIN_Master_Base::SLAVE_RESPONSE) ? SLAVE_SPACE : 0);
+  uint32_t latency = (Result.duration > nominal) ? Result.duration - nominal : 0;
+
+  numFrames++;
+  numErr += (Result.error != LIN_Master_Base::NO_ERROR);
+  if (Result.type == LIN_Master_Base::SLAVE_RESPONSE)
+    numErr += (memcmp(Result.data, Rx, sizeof(Rx)) != 0);
+  sumLatency += latency;
+  if (latency > maxLatency)
+    maxLatency = latency;
+}
+
+
+// run frames with delayed or immediate Rx events. Return avg. latency [us]
+static double run(bool Delayed, uint32_t &Errors)
+{
+  uint32_t  nextFrame;
+  uint8_t   count = 0;
+
+  // open interface. Optionally restore slow Rx thresholds
+  LIN.begin(LIN_BAUDRATE);
+  LIN.attachCallback(onFrame);
+  if (Delayed)
+  {
+    uart_set_rx_full_threshold(UART_NUM_1, DELAY_THRESH);
+    uart_set_rx_timeout(UART_NUM_1, DELAY_TIMEOUT);
+  }
+
+  // start frame every period, call handler at each event
+  numFrames = numErr = maxLatency = 0;
+  sumLatency = 0;
+  nextFrame = micros();
+  while (numFrames < NUM_FRAMES)
+  {
+    if ((int32_t) (micros() - nextFrame) >= 0)
+    {
+      nextFrame += FRAME_PERIOD;
+      LIN.resetStateMachine();
+      LIN.resetError();
+      if ((count++ & 0x01) == 0)
+        LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, sizeof(Tx), Tx);
+      else
+        LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, sizeof(Rx));
+    }
+    LIN.handler();
+    scheduleTime(nextFrame);
+    yield();
+  }
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  LIN.attachCallback(NULL);
+
+  // print result
+  Errors = numErr;
+  double latency = (double) sumLatency / numFrames;
+  printf("%-7s  Rx threshold=%3u timeout=%u  frames=%u errors=%u  completion latency avg=%6.1fus max=%4uus\n",
+    Delayed ? "delayed" : "event", Delayed ? DELAY_THRESH : 1, Delayed ? DELAY_TIMEOUT : 1, (unsigned) numFrames,
+    (unsigned) numErr, latency, (unsigned) maxLatency);
+  LIN.end();
+
+  return latency;
+}
+
+
+// run frames with driver failures. Return number of unexpected results
+static uint32_t runFailures(void)
+{
+  uint32_t  errors = 0, start;
+  uint8_t   junk[64];
+  size_t    len;
+
+  LIN.begin(LIN_BAUDRATE);
+
+  // complete frame received, but ring buffer flushed before read -> read fails, frame times out w/o echo error
+  LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, sizeof(Tx), Tx);
+  while (LIN.handler() == LIN_Master_Base::STATE_BREAK)
+    delayMicroseconds(50);
+  delayMicroseconds(12 * 521);
+  uart_get_buffered_data_len(UART_NUM_1, &len);
+  uart_flush_input(UART_NUM_1);
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY))
+    delayMicroseconds(50);
+  printf("flushed  pending bytes=%u  error=0x%02X\n", (unsigned) len, (int) LIN.getError());
+  errors += (len == 0);
+  errors += (LIN.getError() != LIN_Master_Base::ERROR_TIMEOUT);
+  LIN.resetStateMachine();
+  LIN.resetError();
+
+  // transmitter still busy -> BREAK fails after bounded wait
+  memset(junk, 0xFF, sizeof(junk));
+  uart_write_bytes(UART_NUM_1, junk, sizeof(junk));
+  start = micros();
+  LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, sizeof(Tx), Tx);
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY))
+    delayMicroseconds(50);
+  printf("Tx busy  wait=%uus  error=0x%02X\n", (unsigned) (micros() - start), (int) LIN.getError());
+  errors += ((micros() - start) > 4000);
+  errors += (LIN.getError() != LIN_Master_Base::ERROR_STATE);
+  delay(50);
+  LIN.end();
+
+  return errors;
+}
+
+
+int main(void)
+{
+  uint32_t  errors = 0, err;
+  double    latencyDelayed;
+
+  // virtual time for fast simulation. Before connecting bus, which stores time stamps
+  setVirtualTime(true);
+  Bus.addSlave(Slave);
+  Serial1.connect(&Bus);
+  Slave.setResponse(0x05, sizeof(Rx), Rx);
+  Slave.setResponseSpace(SLAVE_SPACE);
+  printf("nominal frame %uus, handler() at each event\n", (unsigned) Nominal);
+
+  // Rx bytes delivered by Rx timeout -> must be >1ms late
+  latencyDelayed = run(true, err);
+  errors += err;
+  errors += (latencyDelayed <= 1000);
+
+  // Rx bytes delivered per byte -> must be below 100us
+  run(false, err);
+  errors += err;
+  errors += (maxLatency >= 100);
+
+  // driver failures
+  errors += runFailures();
+
+  // return error code
+  return (errors != 0);
+
+} // main()
@@ -0,0 +1,214 @@
+/*********************
+
+Host benchmark for bulk download via LIN diagnostics
+
+Downloads a 32kB image to a simulated slave with transport layer on a simulated bus (virtual time). The slave
+implements RequestDownload, TransferData and RequestTransferExit with a max. block length and a processing time
+per block. Measures the effective download rate for different block buffer sizes from RAM and from a file, compared
+to the theoretical bus bandwidth of the transport layer (6 data bytes per frame with 8 data bytes). Also checks
+the negative response for a too large image.
+Returns 1 on any download error, image mismatch or if the largest block size reaches <80% of the bus bandwidth.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_master_Flash.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_tp.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NAD               0x0A            // node address of slave
+#define IMAGE_SIZE        32768           // image size [B]
+#define ADDRESS           0x00008000      // target address of image
+#define PROCESS_TIME      5000            // slave processing time per service [us]
+
+
+// simulated bus with one slave
+LIN_Bus_Host                Bus(LIN_BAUDRATE);
+LIN_Slave_TP                Slave(NAD);
+
+// LIN master, transport layer and download pipeline
+LIN_Master_HardwareSerial   LIN(Serial1, "Flash");
+LIN_Master_Transport        TP(LIN);
+LIN_Master_Flash            Flash(TP);
+
+// image, copy in slave and block buffer
+uint8_t   Image[IMAGE_SIZE];
+uint8_t   Memory[IMAGE_SIZE];
+uint8_t   Buffer[LIN_MASTER_TP_MAX_LEN];
+
+// state of slave bootloader
+uint32_t  slaveAddress, slaveSize, slaveOffset;
+uint8_t   slaveSeq;
+bool      slaveDone;
+
+
+// negative response of slave
+static uint16_t negative(const uint8_t Request[], uint8_t Response[], uint8_t NRC)
+{
+  Response[0] = 0x7F;
+  Response[1] = Request[0];
+  Response[2] = NRC;
+  return 3;
+}
+
+
+// slave bootloader with download services
+static uint16_t bootloader(LIN_Slave_TP &Slave, const uint8_t Request[], uint16_t Length, uint8_t Response[], void *Arg)
+{
+  uint16_t  maxBlock = *((uint16_t*) Arg);
+
+  (void) Slave;
+
+  // RequestDownload: check range and announce max. block length incl. SID and counter
+  if ((Request[0] == 0x34) && (Length == 11) && (Request[2] == 0x44))
+  {
+    slaveAddress = ((uint32_t) Request[3] << 24) | ((uint32_t) Request[4] << 16) | ((uint32_t) Request[5] << 8) | Request[6];
+    slaveSize    = ((uint32_t) Request[7] << 24) | ((uint32_t) Request[8] << 16) | ((uint32_t) Request[9] << 8) | Request[10];
+    if ((slaveAddress != ADDRESS) || (slaveSize > IMAGE_SIZE))
+      return negative(Request, Response, 0x70);
+    slaveOffset = 0;
+    slaveSeq    = 1;
+    slaveDone   = false;
+    Response[0] = 0x74;
+    Response[1] = 0x20;
+    Response[2] = (uint8_t) (maxBlock >> 8);
+    Response[3] = (uint8_t) maxBlock;
+    return 4;
+  }
+
+  // TransferData: check counter and length, then store block
+  if ((Request[0] == 0x36) && (Length >= 3))
+  {
+    if (Request[1] != slaveSeq)
+      return negative(Request, Response, 0x73);
+    if ((Length > maxBlock) || (slaveOffset + Length - 2 > slaveSize))
+      return negative(Request, Response, 0x71);
+    memcpy(Memory + slaveOffset, Request+2, Length-2);
+    slaveOffset += Length-2;
+    slaveSeq++;
+    Response[0] = 0x76;
+    Response[1] = Request[1];
+    return 2;
+  }
+
+  // RequestTransferExit: all data received?
+  if ((Request[0] == 0x37) && (slaveOffset == slaveSize))
+  {
+    slaveDone   = true;
+    Response[0] = 0x77;
+    return 1;
+  }
+
+  // conditions not correct
+  return negative(Request, Response, 0x22);
+}
+
+
+// source: read image from file
+static uint16_t readFile(uint32_t Offset, uint8_t Data[], uint16_t Length, void *Arg)
+{
+  FILE *fp = (FILE*) Arg;
+
+  if (fseek(fp, Offset, SEEK_SET) != 0)
+    return 0;
+  return (uint16_t) fread(Data, 1, Length, fp);
+}
+
+
+// run download until done
+static void run(void)
+{
+  uint32_t  deadline;
+
+  while (Flash.handler() != LIN_Master_Flash::FLASH_DONE)
+  {
+    if (Flash.getDeadline(deadline))
+      scheduleTime(deadline);
+    yield();
+  }
+}
+
+
+int main(void)
+{
+  const uint16_t    sizes[] = { 64, 256, 1024, LIN_MASTER_TP_MAX_LEN };
+  uint16_t          maxBlock = LIN_MASTER_TP_MAX_LEN;
+  uint32_t          errors = 0, err, rate = 0;
+  FILE              *fp;
+
+  // virtual time for fast simulation. Before connecting bus, which stores time stamps
+  setVirtualTime(true);
+  Bus.addSlave(Slave);
+  Serial1.connect(&Bus);
+  Slave.attachService(bootloader, &maxBlock);
+  Slave.setProcessTime(PROCESS_TIME);
+  LIN.begin(LIN_BAUDRATE);
+
+  // pseudo random image
+  uint32_t x = 1;
+  for (uint32_t i = 0; i < IMAGE_SIZE; i++)
+  {
+    x = x * 1103515245 + 12345;
+    Image[i] = (uint8_t) (x >> 16);
+  }
+
+  // theoretical bandwidth: 6 bytes per frame (34 bit header + 9 bytes of 10 bit)
+  double limit = 6.0 * LIN_BAUDRATE / (34 + 9 * 10);
+  printf("download of %u bytes @ %u Baud, slave processing %ums, bus bandwidth %.0f B/s\n", (unsigned) IMAGE_SIZE,
+    (unsigned) LIN_BAUDRATE, (unsigned) (PROCESS_TIME / 1000), limit);
+
+  // download from RAM with different block buffer sizes
+  for (uint8_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+  {
+    memset(Memory, 0, sizeof(Memory));
+    Flash.begin(NAD, ADDRESS, Image, IMAGE_SIZE, Buffer, sizes[i]);
+    run();
+    rate = Flash.getRate();
+    err = (Flash.getError() != LIN_Master_Flash::FLASH_NO_ERROR) || (!slaveDone) || (memcmp(Image, Memory, IMAGE_SIZE) != 0);
+    errors += err;
+    printf("  RAM   block=%4u  error=0x%02X  %5.1fs  %4u B/s (%.1f%%)\n", (unsigned) Flash.getBlockLength(),
+      (int) Flash.getError(), IMAGE_SIZE / (double) rate, (unsigned) rate, 100.0 * rate / limit);
+  }
+  errors += (rate < 0.8 * limit);
+
+  // download from file with largest block
+  fp = tmpfile();
+  fwrite(Image, 1, IMAGE_SIZE, fp);
+  memset(Memory, 0, sizeof(Memory));
+  Flash.begin(NAD, ADDRESS, IMAGE_SIZE, readFile, fp, Buffer, sizeof(Buffer));
+  run();
+  rate = Flash.getRate();
+  err = (Flash.getError() != LIN_Master_Flash::FLASH_NO_ERROR) || (!slaveDone) || (memcmp(Image, Memory, IMAGE_SIZE) != 0);
+  errors += err;
+  printf("  file  block=%4u  error=0x%02X  %5.1fs  %4u B/s (%.1f%%)\n", (unsigned) Flash.getBlockLength(),
+    (int) Flash.getError(), IMAGE_SIZE / (double) rate, (unsigned) rate, 100.0 * rate / limit);
+
+  // file shorter than image -> source error
+  fclose(fp);
+  fp = tmpfile();
+  fwrite(Image, 1, IMAGE_SIZE / 2, fp);
+  Flash.begin(NAD, ADDRESS, IMAGE_SIZE, readFile, fp, Buffer, sizeof(Buffer));
+  run();
+  errors += (Flash.getError() != LIN_Master_Flash::FLASH_ERROR_SOURCE);
+  printf("  file too short:      error=0x%02X  progress=%u\n", (int) Flash.getError(), (unsigned) Flash.getProgress());
+  fclose(fp);
+
+  // image too large -> negative response 0x70 (uploadDownloadNotAccepted)
+  Flash.begin(NAD, ADDRESS, Image, 2 * IMAGE_SIZE, Buffer, sizeof(Buffer));
+  run();
+  errors += (Flash.getError() != LIN_Master_Flash::FLASH_ERROR_NEGATIVE) || (Flash.getNRC() != 0x70);
+  printf("  image too large:     error=0x%02X  NRC=0x%02X\n", (int) Flash.getError(), (int) Flash.getNRC());
+  LIN.end();
+
+  // slave statistics
+  errors += Slave.numDiagErrors;
+  printf("slave: requests=%u responses=%u unanswered polls=%u PCI errors=%u -> errors=%u\n", (unsigned) Slave.numDiagRequests,
+    (unsigned) Slave.numDiagResponses, (unsigned) Slave.numNotReady, (unsigned) Slave.numDiagErrors, (unsigned) errors);
+
+  // return error code
+  return (errors != 0);
+
+} // main()
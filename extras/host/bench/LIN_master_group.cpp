@@ -0,0 +1,173 @@
+/*********************
+
+Host benchmark for LIN_Master_Group
+
+Runs a schedule table on 1..4 LIN buses and services them a) by calling handler() of every bus in turn like in
+LIN_master_Dual_HWSerial_Bkg and b) via LIN_Master_Group::handler(), which only services buses with a reached deadline.
+Between LIN service calls a fixed application workload is executed. Reports handler() calls and CPU time spent
+in LIN service calls per frame (corrected by the overhead of the time measurement).
+Returns 1 on any echo/checksum error or data mismatch.
+
+**********************/
+
+// include files
+#include <time.h>
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_master_Group.h>
+#include <LIN_slave_host.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define DURATION          1000            // duration [ms] per variant and number of buses
+#define MAX_BUS           4               // max. number of buses
+#define WORK_LOOPS        200             // size of application workload between LIN service calls
+
+
+// LIN masters and simulated slaves on Serial1..4
+HardwareSerial             *Port[MAX_BUS] = {&Serial1, &Serial2, &Serial3, &Serial4};
+LIN_Master_HardwareSerial   LIN1(Serial1, "LIN1"), LIN2(Serial2, "LIN2"), LIN3(Serial3, "LIN3"), LIN4(Serial4, "LIN4");
+LIN_Master_HardwareSerial  *Bus[MAX_BUS] = {&LIN1, &LIN2, &LIN3, &LIN4};
+LIN_Slave_Host              Slave[MAX_BUS];
+
+// frame data
+uint8_t   Tx[4] = {0x01, 0x02, 0x03, 0x04};
+uint8_t   Rx[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+
+// schedule table: type, version, ID, number of data, data, slot [us]
+const LIN_Master_Base::schedule_t Table[] = {
+  { LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, 4, Tx,   10000 },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x05, 6, NULL, 10000 }
+};
+
+// frame statistics
+uint32_t  numFrames;
+uint32_t  numErr;
+
+
+// completion callback
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  bool err = ((Result.error & ~LIN_Master_Base::ERROR_TIMEOUT) != 0);
+  if ((Result.type == LIN_Master_Base::SLAVE_RESPONSE) && (Result.error == LIN_Master_Base::NO_ERROR) && (memcmp(Result.data, Rx, 6) != 0))
+    err = true;
+  numFrames++;
+  numErr += err;
+
+  // erroneous frame (e.g. timeout due to OS preemption) -> wait until stale slave response has passed
+  if (Result.error != LIN_Master_Base::NO_ERROR)
+    delay(10);
+}
+
+
+// application workload
+static void appWork(void)
+{
+  for (volatile uint32_t i = 0; i < WORK_LOOPS; i++);
+}
+
+
+// time stamp [ns]
+static inline uint64_t nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+
+// overhead of time measurement [ns]
+static double overhead;
+
+
+// run schedule on NumBus buses, either via group or round-robin. Return errors
+static uint32_t run(uint8_t NumBus, bool UseGroup)
+{
+  LIN_Master_Group  group;
+  uint64_t          busy = 0;
+  uint64_t          loops = 0;
+  uint64_t          calls = 0;
+  uint32_t          start;
+
+  // start schedules
+  numFrames = 0;
+  numErr    = 0;
+  for (uint8_t i = 0; i < NumBus; i++)
+  {
+    Bus[i]->begin(LIN_BAUDRATE);
+    Bus[i]->attachCallback(onFrame);
+    Bus[i]->setSchedule(Table, 2);
+    group.add(*(Bus[i]));
+  }
+
+  // service buses
+  start = millis();
+  while (millis() - start < DURATION)
+  {
+    uint64_t t0 = nanos();
+    if (UseGroup)
+      calls += group.handler();
+    else
+    {
+      for (uint8_t i = 0; i < NumBus; i++)
+        Bus[i]->handler();
+      calls += NumBus;
+    }
+    busy += nanos() - t0;
+    loops++;
+    appWork();
+  }
+  busy -= (uint64_t) (overhead * loops);
+
+  // stop schedules
+  for (uint8_t i = 0; i < NumBus; i++)
+  {
+    Bus[i]->attachCallback(NULL);
+    Bus[i]->end();
+  }
+
+  // print results
+  printf("%-12s buses=%u frames=%-4u errors=%-3u handler calls/frame=%-8u CPU/frame=%7.1fus (%4.1f%% of CPU)\n",
+    UseGroup ? "group" : "round-robin", (unsigned) NumBus, (unsigned) numFrames, (unsigned) numErr,
+    (unsigned) (calls / numFrames), 0.001 * busy / numFrames, 0.0001 * busy / DURATION);
+
+  return numErr;
+
+} // run()
+
+
+int main(void)
+{
+  uint32_t  errors = 0;
+
+  // attach slave models
+  for (uint8_t i = 0; i < MAX_BUS; i++)
+  {
+    Slave[i].setResponse(0x05, 6, Rx);
+    Port[i]->attach(&Slave[i]);
+  }
+  printf("LIN group @ %u Baud, schedule with 2x 10ms slots per bus\n", (unsigned) LIN_BAUDRATE);
+
+  // calibrate overhead of time measurement
+  uint64_t busy = 0;
+  for (uint32_t i = 0; i < 100000; i++)
+  {
+    uint64_t t0 = nanos();
+    busy += nanos() - t0;
+    appWork();
+  }
+  overhead = busy / 100000.0;
+
+  // increasing number of buses
+  for (uint8_t num = 1; num <= MAX_BUS; num++)
+  {
+    errors += run(num, false);
+    errors += run(num, true);
+  }
+
+  // return error code
+  return (errors != 0);
+
+} // main()
@@ -0,0 +1,123 @@
+/*********************
+
+Host benchmark for per-frame timing statistics
+
+Runs a schedule table with master requests and slave responses (with response space) and prints the timing
+histograms recorded by handler() per node and per frame ID. Requires LIN_MASTER_TIMING, see Makefile.
+Returns 1 on any echo/checksum error, data mismatch or if the number of recorded frames doesn't match.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_slave_host.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define DURATION          1000            // duration [ms]
+#define RESPONSE_SPACE    300             // slave response space [us]
+
+
+// LIN master and simulated slave on Serial1
+LIN_Master_HardwareSerial   LIN(Serial1, "Master");
+LIN_Slave_Host              Slave(LIN_BAUDRATE);
+
+// frame data
+uint8_t   Tx[4] = {0x01, 0x02, 0x03, 0x04};
+uint8_t   Rx[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+
+// schedule table: type, version, ID, number of data, data, slot [us]
+const LIN_Master_Base::schedule_t Table[] = {
+  { LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, 4, Tx,   8000 },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x05, 6, NULL, 8000 }
+};
+
+// frame statistics
+uint32_t  numFrames;
+uint32_t  numErr;
+uint32_t  numTimeout;
+
+
+// completion callback
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  bool err = ((Result.error & ~LIN_Master_Base::ERROR_TIMEOUT) != 0);
+  if ((Result.type == LIN_Master_Base::SLAVE_RESPONSE) && (Result.error == LIN_Master_Base::NO_ERROR) && (memcmp(Result.data, Rx, 6) != 0))
+    err = true;
+  numFrames++;
+  numErr += err;
+  numTimeout += ((Result.error & LIN_Master_Base::ERROR_TIMEOUT) != 0);
+}
+
+
+#if defined(LIN_MASTER_TIMING)
+
+// print histogram in one line
+static void printHistogram(const char *Name, const LIN_Master_Base::histogram_t &Histogram)
+{
+  printf("%-16s num=%-5u min/max=%5u/%5uus ", Name, (unsigned) Histogram.num, (unsigned) Histogram.min, (unsigned) Histogram.max);
+  for (uint8_t i = 0; i < LIN_MASTER_TIMING_BUCKETS; i++)
+  {
+    if (Histogram.bucket[i] > 0)
+      printf(" <%uus:%u", (unsigned) (1UL << i), (unsigned) Histogram.bucket[i]);
+  }
+  printf("\n");
+}
+
+#endif // LIN_MASTER_TIMING
+
+
+int main(void)
+{
+  uint32_t  start;
+
+  // attach slave model and open LIN interface
+  Slave.setResponse(0x05, 6, Rx);
+  Slave.setResponseSpace(RESPONSE_SPACE);
+  Serial1.attach(&Slave);
+  LIN.begin(LIN_BAUDRATE);
+  LIN.attachCallback(onFrame);
+  printf("LIN timing statistics @ %u Baud, response space %uus\n", (unsigned) LIN_BAUDRATE, (unsigned) RESPONSE_SPACE);
+
+  // run schedule
+  LIN.setSchedule(Table, 2);
+  start = millis();
+  while (millis() - start < DURATION)
+    LIN.handler();
+  LIN.stopSchedule();
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  printf("frames=%u errors=%u timeouts=%u\n", (unsigned) numFrames, (unsigned) numErr, (unsigned) numTimeout);
+
+  #if defined(LIN_MASTER_TIMING)
+
+    // print timing statistics of node
+    const LIN_Master_Base::timing_t &timing = LIN.getTiming();
+    printHistogram("break", timing.breakDuration);
+    printHistogram("header", timing.header);
+    printHistogram("response space", timing.responseSpace);
+    printHistogram("frame", timing.frame);
+
+    // print frame duration per ID
+    #if defined(LIN_MASTER_TIMING_PER_ID)
+      printHistogram("frame ID 0x1A", LIN.getTiming(0x1A));
+      printHistogram("frame ID 0x05", LIN.getTiming(0x05));
+    #endif
+
+    // frames w/o error must match recorded frames
+    if ((uint32_t) (timing.frame.num + timing.numErr) != numFrames)
+    {
+      printf("error: recorded %u frames\n", (unsigned) (timing.frame.num + timing.numErr));
+      return 1;
+    }
+
+  #else
+    printf("timing statistics disabled (LIN_MASTER_TIMING)\n");
+  #endif // LIN_MASTER_TIMING
+
+  // return error code
+  return (numErr != 0);
+
+} // main()
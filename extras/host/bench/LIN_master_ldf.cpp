@@ -0,0 +1,216 @@
+/*********************
+
+Host benchmark for tables generated from a LIN Description File
+
+The header Door_Module.h is generated from Door_Module.ldf by tools/LIN_ldf_gen.cpp during the build. Checks:
+  - PIDs and frame descriptors computed at compile time equal prepareFrame() at runtime
+  - signal init values, packing and unpacking w/o side effects on other signals of the same frame
+  - schedule table "Normal" from flash (setSchedule_P()) runs on a simulated bus (virtual time) w/o errors,
+    and slave response signals are unpacked and converted to physical values as sent by the slaves
+  - bulk unpack() of generated frame structs (compile-time layouts) equals runtime getSignal()
+Returns 1 on any error.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_sim.h>
+#include <Door_Module.h>
+
+// benchmark parameters
+#define NUM_SLOTS         400             // number of schedule slots
+#define RESPONSE_SPACE    40              // min. slave response space [us]
+#define RESPONSE_JITTER   100             // max. random jitter of response space [us]
+
+
+// PIDs and checksum seeds are available at compile time
+static_assert(LIN_Master_LDF::pid(0x3C) == 0x3C, "PID of MasterReq");
+static_assert(LIN_Master_LDF::pid(0x3D) == 0x7D, "PID of SlaveResp");
+static_assert(Door_Module::FRAMES[Door_Module::FRAME_MirrorStatus].pid == 0x20, "PID of MirrorStatus");
+static_assert(Door_Module::FRAMES[Door_Module::FRAME_MasterReq].chkSeed == 0x00, "classic checksum for diagnostics");
+
+// simulated bus with one slave for mirror and window
+LIN_Bus_Host                Bus(Door_Module::BAUDRATE);
+LIN_Slave_Sim               Slave(1);
+
+// LIN master
+LIN_Master_HardwareSerial   LIN(Serial1, "LDF");
+
+// frame statistics
+uint32_t  numFrames;
+uint32_t  numErr;
+
+
+// compare frame descriptors
+static bool equal(const LIN_Master_Base::descriptor_t &A, const LIN_Master_Base::descriptor_t &B)
+{
+  return (A.type == B.type) && (A.version == B.version) && (A.id == B.id) && (A.pid == B.pid) &&
+    (A.chkSeed == B.chkSeed) && (A.lenTx == B.lenTx) && (A.lenRx == B.lenRx) && (A.timeout == B.timeout);
+}
+
+
+// compare generated frames and all PIDs with prepareFrame(). Return errors
+static uint32_t checkFrames(void)
+{
+  LIN_Master_Base::descriptor_t frame;
+  uint32_t                      errors = 0;
+
+  LIN.begin(Door_Module::BAUDRATE);
+  for (uint8_t i = 0; i < Door_Module::NUM_FRAMES; i++)
+  {
+    LIN_Master_Base::descriptor_t gen = LIN_Master_LDF::read_P(&(Door_Module::FRAMES[i]));
+    LIN.prepareFrame(frame, gen.type, gen.version, gen.id, gen.lenRx - 4);
+    errors += !equal(gen, frame);
+  }
+  for (uint8_t id = 0; id < 64; id++)
+  {
+    LIN.prepareFrame(frame, LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, id, 8);
+    errors += (LIN_Master_LDF::pid(id) != frame.pid);
+  }
+  LIN.end();
+  printf("frames:   %u descriptors and 64 PIDs checked vs. prepareFrame(): errors=%u\n", (unsigned) Door_Module::NUM_FRAMES, (unsigned) errors);
+
+  return errors;
+
+} // checkFrames()
+
+
+// check init values and packing of all scalar signals. Return errors
+static uint32_t checkSignals(void)
+{
+  uint32_t  errors = 0;
+  uint32_t  numChecked = 0;
+
+  for (uint8_t s = 0; s < Door_Module::NUM_SIGNALS; s++)
+  {
+    LIN_Master_LDF::signal_t sig = LIN_Master_LDF::read_P(&(Door_Module::SIGNALS[s]));
+    if (sig.width > 32)
+      continue;
+
+    // init value
+    errors += (Door_Module::getSignal(s) != sig.init);
+
+    // set pattern, other signals of same frame must not change
+    for (uint32_t pattern = 0; pattern < 4; pattern++)
+    {
+      uint32_t value = ((pattern & 0x01) ? 0xFFFFFFFFUL : 0x0UL) ^ ((pattern & 0x02) ? 0xAAAAAAAAUL : 0x0UL);
+      uint32_t mask = (sig.width >= 32) ? 0xFFFFFFFFUL : ((1UL << sig.width) - 1);
+      uint8_t before[8], after[8];
+      uint8_t *data = LIN_Master_LDF::read_P(&(Door_Module::DATA[sig.frame]));
+      uint8_t num = LIN_Master_LDF::read_P(&(Door_Module::FRAMES[sig.frame])).lenRx - 4;
+
+      memcpy(before, data, num);
+      Door_Module::setSignal(s, value);
+      errors += (Door_Module::getSignal(s) != (value & mask));
+      Door_Module::setSignal(s, sig.init);
+      memcpy(after, data, num);
+      errors += (memcmp(before, after, num) != 0);
+      numChecked++;
+    }
+  }
+  printf("signals:  %u patterns checked (init, pack/unpack, neighbours): errors=%u\n", (unsigned) numChecked, (unsigned) errors);
+
+  return errors;
+
+} // checkSignals()
+
+
+// completion callback: copy slave responses to frame data buffers
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  numErr += (Result.error != LIN_Master_Base::NO_ERROR);
+  numFrames++;
+  if ((Result.error == LIN_Master_Base::NO_ERROR) && (Result.type == LIN_Master_Base::SLAVE_RESPONSE))
+  {
+    uint8_t idx = (Result.id == 0x20) ? Door_Module::FRAME_MirrorStatus : Door_Module::FRAME_WindowStatus;
+    memcpy(LIN_Master_LDF::read_P(&(Door_Module::DATA[idx])), Result.data, Result.numData);
+  }
+}
+
+
+// run schedule table from flash. Return errors
+static uint32_t checkSchedule(void)
+{
+  uint8_t   mirror[4], window[6];
+  uint32_t  deadline;
+  uint32_t  errors;
+
+  // slave responses: mirror temperature 21.5degC, window position 42%, serial number
+  LIN_Master_LDF::signal_t temp = LIN_Master_LDF::read_P(&(Door_Module::SIGNALS[Door_Module::SIG_MirrorTemp]));
+  LIN_Master_LDF::signal_t pos  = LIN_Master_LDF::read_P(&(Door_Module::SIGNALS[Door_Module::SIG_WindowPos]));
+  LIN_Master_LDF::encoding_t tempEnc = LIN_Master_LDF::read_P(&(Door_Module::ENCODINGS[Door_Module::ENC_TempEnc]));
+  memset(mirror, 0xFF, sizeof(mirror));
+  memset(window, 0xFF, sizeof(window));
+  LIN_Master_LDF::setRaw(temp, mirror, LIN_Master_LDF::toRaw(tempEnc, 21.5f));
+  LIN_Master_LDF::setRaw(pos, window, 42);
+  memcpy(window + 2, "\x12\x34\x56\x78", 4);
+  Slave.setResponse(0x20, sizeof(mirror), mirror);
+  Slave.setResponse(0x21, sizeof(window), window);
+  Slave.setResponseSpace(RESPONSE_SPACE, RESPONSE_JITTER);
+
+  // run schedule table "Normal" from flash
+  Door_Module::setSignal(Door_Module::SIG_MirrorCmd, Door_Module::MirrorCmdEnc_fold);
+  LIN.begin(Door_Module::BAUDRATE);
+  LIN.attachCallback(onFrame);
+  LIN.setSchedule_P(Door_Module::SCHEDULE_Normal, Door_Module::NUM_SCHEDULE_Normal);
+  while (numFrames < NUM_SLOTS)
+  {
+    LIN.handler();
+    if (LIN.getDeadline(deadline))
+      scheduleTime(deadline);
+    yield();
+  }
+  LIN.stopSchedule();
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  LIN.attachCallback(NULL);
+  LIN.end();
+
+  // unpack received signals
+  float tempPhys = LIN_Master_LDF::toPhysical(tempEnc, Door_Module::getSignal(Door_Module::SIG_MirrorTemp));
+  uint32_t posRaw = Door_Module::getSignal(Door_Module::SIG_WindowPos);
+  uint8_t *serial = LIN_Master_LDF::read_P(&(Door_Module::DATA[Door_Module::FRAME_WindowStatus])) + 2;
+  errors = numErr;
+  errors += ((tempPhys < 21.45f) || (tempPhys > 21.55f));
+  errors += (posRaw != 42);
+  errors += (memcmp(serial, "\x12\x34\x56\x78", 4) != 0);
+  errors += (Bus.numBytes == 0);
+
+  // same via compile-time layouts
+  Door_Module::Frame_MirrorStatus mirrorStatus;
+  Door_Module::Frame_WindowStatus windowStatus;
+  Door_Module::unpack(LIN_Master_LDF::read_P(&(Door_Module::DATA[Door_Module::FRAME_MirrorStatus])), mirrorStatus);
+  Door_Module::unpack(LIN_Master_LDF::read_P(&(Door_Module::DATA[Door_Module::FRAME_WindowStatus])), windowStatus);
+  errors += (mirrorStatus.MirrorTemp != Door_Module::getSignal(Door_Module::SIG_MirrorTemp));
+  errors += (windowStatus.WindowPos != posRaw);
+  printf("schedule: %u frames from flash: errors=%u  MirrorTemp=%.1fdegC WindowPos=%u%% WindowSerial=%02X%02X%02X%02X\n",
+    (unsigned) numFrames, (unsigned) errors, tempPhys, (unsigned) posRaw, serial[0], serial[1], serial[2], serial[3]);
+
+  return errors;
+
+} // checkSchedule()
+
+
+int main(void)
+{
+  uint32_t  errors = 0;
+
+  // virtual time for deterministic slot timing. Before connecting bus, which stores time stamps
+  setVirtualTime(true);
+  Bus.addSlave(Slave);
+  Serial1.connect(&Bus);
+  printf("LDF tables @ %u Baud: %u frames, %u signals, RAM for frame data, rest in flash\n", (unsigned) Door_Module::BAUDRATE,
+    (unsigned) Door_Module::NUM_FRAMES, (unsigned) Door_Module::NUM_SIGNALS);
+
+  // run checks
+  errors += checkFrames();
+  errors += checkSignals();
+  errors += checkSchedule();
+
+  // return error code
+  return (errors != 0);
+
+} // main()
@@ -0,0 +1,185 @@
+/*********************
+
+Host benchmark for the per-byte Rx interrupt of NeoHWSerial on AVR
+
+Runs alternating master requests and slave responses on two simulated buses (virtual time) with one slave each, while
+the application blocks in delay() for longer than a frame after starting it. Compares LIN_Master_HardwareSerial, whose
+frame only progresses in handler(), with LIN_Master_NeoHWSerial_AVR, whose frame is handled byte by byte in the
+(simulated) Rx ISR of the mocked NeoHWSerial during delay(). Counts frames completed before handler() is called again,
+and with LIN_MASTER_TIMING prints the frame duration recorded at completion. The callback checks the received data.
+Polled frames time out, as the rest of the frame is only sent after the blocking.
+Then runs a schedule table via Rx ISR, with handler() only called after each slot boundary. I.e. the previous frame is
+always finished by the ISR before handler() starts the next slot, and its callback must not be lost.
+Returns 1 on any Rx ISR frame error or wrong data, if not all Rx ISR frames are completed before handler() or complete
+>100us after the stop bit of the checksum, if polled frames complete w/o handler() (i.e. the benchmark is meaningless),
+or if a callback of a scheduled frame is lost.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_master_NeoHWSerial_AVR.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_sim.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NUM_FRAMES        200             // number of frames per variant
+#define APP_BLOCKING      8               // blocking time of application after frame start [ms]
+#define SLAVE_SPACE       100             // slave response space [us]
+
+
+// simulated buses with one slave each
+LIN_Bus_Host                Bus1(LIN_BAUDRATE);
+LIN_Bus_Host                Bus2(LIN_BAUDRATE);
+LIN_Slave_Sim               Slave1(1);
+LIN_Slave_Sim               Slave2(2);
+
+// LIN master polled via handler() and via Rx ISR of NeoHWSerial
+LIN_Master_HardwareSerial   LIN_Poll(Serial1, "Poll");
+LIN_Master_NeoHWSerial_AVR  LIN_Isr(NeoSerial1, 1, "ISR");
+
+// frame data
+uint8_t   Tx[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+uint8_t   Rx[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+// schedule table with slot = blocking time, i.e. handler() is called just after each slot boundary
+LIN_Master_Base::schedule_t Schedule[] = {
+  { LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, sizeof(Tx), Tx, APP_BLOCKING*1000L },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x05, sizeof(Rx), NULL, APP_BLOCKING*1000L }
+};
+
+// nominal frame duration [us]: BREAK (2 bytes at half baudrate) + SYNC + PID + 8 DATA + CHK w/o gaps
+const uint32_t  Nominal = (2 + 2 + 8 + 1) * ((10000000L + LIN_BAUDRATE/2) / LIN_BAUDRATE);
+
+// frame statistics
+uint32_t  numFrames, numErr;
+
+
+// completion callback
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  numFrames++;
+  numErr += (Result.error != LIN_Master_Base::NO_ERROR);
+  if (Result.type == LIN_Master_Base::SLAVE_RESPONSE)
+    numErr += (memcmp(Result.data, Rx, sizeof(Rx)) != 0);
+}
+
+
+// run frames with blocking application. Return number of frames completed before handler() call
+static uint32_t run(LIN_Master_Base &LIN, const char *Name, uint32_t &Errors)
+{
+  uint32_t  numDone = 0;
+
+  // open interface
+  LIN.begin(LIN_BAUDRATE);
+  LIN.attachCallback(onFrame);
+  #if defined(LIN_MASTER_TIMING)
+    LIN.resetTiming();
+  #endif
+
+  // start frame, block application, then check state before calling handler()
+  numFrames = numErr = 0;
+  for (uint32_t i = 0; i < NUM_FRAMES; i++)
+  {
+    if ((i & 0x01) == 0)
+      LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, sizeof(Tx), Tx);
+    else
+      LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, sizeof(Rx));
+    delay(APP_BLOCKING);
+    numDone += (LIN.getState() == LIN_Master_Base::STATE_DONE);
+    while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY))
+      yield();
+    LIN.resetStateMachine();
+    LIN.resetError();
+  }
+  LIN.attachCallback(NULL);
+
+  // print result
+  Errors = numErr + (numFrames != NUM_FRAMES);
+  printf("%-7s frames=%u errors=%u  completed before handler()=%u", Name, (unsigned) numFrames,
+    (unsigned) numErr, (unsigned) numDone);
+  #if defined(LIN_MASTER_TIMING)
+    const LIN_Master_Base::histogram_t &frame = LIN.getTiming().frame;
+    printf("  duration min=%5uus max=%5uus", (unsigned) frame.min, (unsigned) frame.max);
+  #endif
+  printf("\n");
+  LIN.end();
+
+  return numDone;
+}
+
+
+// run schedule table with blocking application. Return number of lost callbacks
+static uint32_t runSchedule(LIN_Master_Base &LIN, LIN_Slave_Sim &Slave, const char *Name, uint32_t &Errors)
+{
+  uint32_t  numHeaders;
+
+  // open interface
+  LIN.begin(LIN_BAUDRATE);
+  LIN.attachCallback(onFrame);
+
+  // handler() only after blocking, when frame of previous slot was already finished by ISR
+  numFrames = numErr = 0;
+  numHeaders = Slave.numHeaders;
+  LIN.setSchedule(Schedule, sizeof(Schedule)/sizeof(Schedule[0]));
+  for (uint32_t i = 0; i < NUM_FRAMES; i++)
+  {
+    LIN.handler();
+    delay(APP_BLOCKING);
+  }
+
+  // stop schedule at next slot boundary, which also notifies last frame
+  LIN.stopSchedule();
+  LIN.handler();
+  LIN.attachCallback(NULL);
+  numHeaders = Slave.numHeaders - numHeaders;
+
+  // print result
+  Errors = numErr;
+  printf("%-7s frames=%u errors=%u  callbacks=%u\n", Name, (unsigned) numHeaders, (unsigned) numErr, (unsigned) numFrames);
+  LIN.end();
+
+  return (numHeaders - numFrames);
+}
+
+
+int main(void)
+{
+  uint32_t  errors = 0, err;
+
+  // virtual time for fast simulation. Before connecting bus, which stores time stamps
+  setVirtualTime(true);
+  Bus1.addSlave(Slave1);
+  Bus2.addSlave(Slave2);
+  Serial1.connect(&Bus1);
+  NeoSerial1.connect(&Bus2);
+  Slave1.setResponse(0x05, sizeof(Rx), Rx);
+  Slave2.setResponse(0x05, sizeof(Rx), Rx);
+  Slave1.setResponseSpace(SLAVE_SPACE);
+  Slave2.setResponseSpace(SLAVE_SPACE);
+  printf("nominal frame %uus, application blocks %ums after frame start\n", (unsigned) Nominal, (unsigned) APP_BLOCKING);
+
+  // frames progress only in handler() -> none completed during blocking. Frame errors (timeout) are expected
+  errors += (run(LIN_Poll, "polled", err) != 0);
+
+  // frames handled in Rx ISR -> all completed during blocking
+  errors += (run(LIN_Isr, "Rx ISR", err) != NUM_FRAMES);
+  errors += err;
+
+  // ISR completes frame at stop bit of checksum. Slave response includes response space
+  #if defined(LIN_MASTER_TIMING)
+    errors += (LIN_Isr.getTiming().frame.max >= Nominal + SLAVE_SPACE + 100);
+  #endif
+
+  // schedule via Rx ISR -> one callback per frame, although handler() only runs at slot boundaries
+  errors += (runSchedule(LIN_Isr, Slave2, "sched.", err) != 0);
+  errors += err;
+
+  // return error code
+  return (errors != 0);
+
+} // main()
@@ -0,0 +1,152 @@
+/*********************
+
+Host micro-benchmark for per-frame setup cost
+
+Compares the CPU time for starting a frame
+  - legacy: PID and checksum seed computed from scratch on every frame (as before prepared frames)
+  - sendMasterRequest() / receiveSlaveResponse(), which prepare a descriptor on every call
+  - startFrame() with a descriptor prepared once via prepareFrame()
+The non-functional base class is used, i.e. no serial I/O is included in the measurement. Variants are run
+interleaved several times and the fastest run is reported. Note that only the prepared variants include the optional
+trace entry (LIN_MASTER_TRACE), like in the library.
+
+**********************/
+
+// include files
+#include <LIN_master_Base.h>
+
+// benchmark parameters
+#define NUM_LOOPS         2000000         // number of frames per run and variant
+#define NUM_RUNS          5               // number of runs per variant. Fastest run is reported
+
+
+/// LIN master with frame setup as before prepared frames (for reference only)
+class LIN_Master_Legacy : public LIN_Master_Base
+{
+  public:
+
+    LIN_Master_Legacy(const char NameLIN[]) : LIN_Master_Base(NameLIN) { }
+
+    // former checksum calculation incl. version decision and PID calculation
+    __attribute__((noinline)) uint8_t checksumLegacy(uint8_t NumData, const uint8_t Data[])
+    {
+      uint16_t chk = 0x00;
+      if (!((this->version == LIN_V1) || (this->id == 0x3C) || (this->id == 0x3D)))
+        chk = (uint16_t) this->_calculatePID(this->id);
+      for (uint8_t i = 0; i < NumData; i++)
+      {
+        chk += (uint16_t) (Data[i]);
+        if (chk>255)
+          chk -= 255;
+      }
+      return (uint8_t)(0xFF - ((uint8_t) chk));
+    }
+
+    // former master request setup
+    __attribute__((noinline)) LIN_Master_Base::state_t sendMasterRequestLegacy(LIN_Master_Base::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[])
+    {
+      this->type     = LIN_Master_Base::MASTER_REQUEST;
+      this->version  = Version;
+      this->id       = Id;
+      this->lenTx    = NumData + 4;
+      this->bufTx[0] = 0x00;
+      this->bufTx[1] = 0x55;
+      this->bufTx[2] = this->_calculatePID(this->id);
+      memcpy(this->bufTx+3, Data, NumData);
+      this->bufTx[this->lenTx-1] = this->checksumLegacy(NumData, Data);
+      this->lenRx    = this->lenTx;
+      memset(this->bufRx, 0, 12);
+      this->timeStart    = micros();
+      this->timeoutFrame = ((this->lenRx + 1) * this->timePerByte) * 2;
+      this->_sendBreak();
+      return this->state;
+    }
+
+    // former slave response setup
+    __attribute__((noinline)) LIN_Master_Base::state_t receiveSlaveResponseLegacy(LIN_Master_Base::version_t Version, uint8_t Id, uint8_t NumData)
+    {
+      this->type     = LIN_Master_Base::SLAVE_RESPONSE;
+      this->version  = Version;
+      this->id       = Id;
+      this->lenTx    = 3;
+      this->bufTx[0] = 0x00;
+      this->bufTx[1] = 0x55;
+      this->bufTx[2] = this->_calculatePID(this->id);
+      this->lenRx    = NumData + 4;
+      memset(this->bufRx, 0, 12);
+      this->timeoutFrame = ((this->lenRx + 1) * this->timePerByte) * 2;
+      this->timeStart = micros();
+      this->_sendBreak();
+      return this->state;
+    }
+};
+
+
+// non-functional LIN master, i.e. no serial I/O
+LIN_Master_Legacy   LIN("Bench");
+
+
+// frame setup variants
+enum variant_t { REQUEST_LEGACY, REQUEST_SEND, REQUEST_PREPARED, RESPONSE_LEGACY, RESPONSE_RECEIVE, RESPONSE_PREPARED, NUM_VARIANTS };
+const char *variantName[NUM_VARIANTS] = { "request: legacy", "request: sendMasterRequest()", "request: startFrame() prepared",
+  "response: legacy", "response: receiveSlaveResponse()", "response: startFrame() prepared" };
+
+// frame data and prepared frames
+uint8_t                         Tx[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+LIN_Master_Base::descriptor_t   request, response;
+
+
+// measure CPU time of NUM_LOOPS frame setups [us]
+static uint32_t measure(variant_t Variant)
+{
+  uint32_t  start = micros();
+
+  for (uint32_t i = 0; i < NUM_LOOPS; i++)
+  {
+    LIN.resetStateMachine();
+    switch (Variant)
+    {
+      case REQUEST_LEGACY:    LIN.sendMasterRequestLegacy(LIN_Master_Base::LIN_V2, 0x1A, 8, Tx); break;
+      case REQUEST_SEND:      LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, 8, Tx); break;
+      case REQUEST_PREPARED:  LIN.startFrame(request, Tx); break;
+      case RESPONSE_LEGACY:   LIN.receiveSlaveResponseLegacy(LIN_Master_Base::LIN_V2, 0x05, 8); break;
+      case RESPONSE_RECEIVE:  LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, 8); break;
+      default:                LIN.startFrame(response); break;
+    }
+  }
+
+  return micros() - start;
+
+} // measure()
+
+
+int main(void)
+{
+  uint32_t  best[NUM_VARIANTS];
+
+  // open (dummy) interface and prepare frames once
+  LIN.begin(19200);
+  LIN.prepareFrame(request, LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, 8);
+  LIN.prepareFrame(response, LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x05, 8);
+  printf("frame setup cost (8 data bytes, LIN2.x), best of %d runs\n", NUM_RUNS);
+
+  // interleave variants and keep fastest run, which suppresses OS and frequency scaling noise
+  for (uint8_t v = 0; v < NUM_VARIANTS; v++)
+    best[v] = UINT32_MAX;
+  for (uint8_t run = 0; run < NUM_RUNS; run++)
+  {
+    for (uint8_t v = 0; v < NUM_VARIANTS; v++)
+    {
+      uint32_t time = measure((variant_t) v);
+      if (time < best[v])
+        best[v] = time;
+    }
+  }
+
+  // print time per frame
+  for (uint8_t v = 0; v < NUM_VARIANTS; v++)
+    printf("%-40s %6.1f ns/frame\n", variantName[v], 1000.0 * best[v] / NUM_LOOPS);
+
+  return 0;
+
+} // main()
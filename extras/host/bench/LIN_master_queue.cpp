@@ -0,0 +1,150 @@
+/*********************
+
+Host benchmark for the frame request queue
+
+Keeps the request queue filled with alternating master request and slave response frames and counts frames
+completed within a fixed time window via completion callback. The achieved frame rate is compared to the theoretical
+bus maximum (frames sent back-to-back w/o any gap) and to a sequential loop which starts the next frame only after
+polling STATE_DONE. Both variants run w/o and with application work between polls, i.e. the main loop calls
+handler() only every APP_WORK us. Then the sequential loop starts the next frame one loop later, while handler()
+starts a queued frame in the same call in which the previous frame is completed.
+Uses the virtual clock, i.e. the result doesn't depend on OS scheduling.
+Returns 1 on any frame error (incl. timeout) or data mismatch, if the queue is slower than the sequential loop
+with application work, or if a master request w/o data is queued.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_slave_host.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define DURATION          2000            // duration [ms] per variant
+#define APP_WORK          1000            // application work between polls [us]
+
+
+// LIN master and simulated slave on Serial1
+LIN_Master_HardwareSerial   LIN(Serial1, "Master");
+LIN_Slave_Host              Slave(LIN_BAUDRATE);
+
+// frame data
+uint8_t   Tx[4] = {0x01, 0x02, 0x03, 0x04};
+uint8_t   Rx[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+
+// prepared frames
+LIN_Master_Base::descriptor_t request, response;
+
+// frame statistics
+bool      counting;
+uint32_t  numFrames;
+uint32_t  numErr;
+
+
+// completion callback
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  bool err = (Result.error != LIN_Master_Base::NO_ERROR);
+  if ((Result.type == LIN_Master_Base::SLAVE_RESPONSE) && (Result.error == LIN_Master_Base::NO_ERROR) && (memcmp(Result.data, Rx, 6) != 0))
+    err = true;
+  numErr += err;
+
+  // only count frames completed within time window
+  numFrames += counting;
+
+  // erroneous frame -> wait until rest of frame has passed the bus
+  if (Result.error != LIN_Master_Base::NO_ERROR)
+    delay(10);
+}
+
+
+// run variant for DURATION and print frame rate. Return frames per second
+static double run(const char *Name, bool Queued, uint32_t Work, double Max)
+{
+  uint32_t  start;
+  uint8_t   count = 0;
+
+  numFrames = 0;
+  counting  = true;
+  LIN.resetStateMachine();
+  LIN.resetError();
+  LIN.attachCallback(onFrame);
+  start = millis();
+  while (millis() - start < DURATION)
+  {
+    // application work
+    if (Work > 0)
+      delayMicroseconds(Work);
+
+    // queued: keep queue filled, frames are started back-to-back by handler()
+    if (Queued)
+    {
+      while (LIN.queueFrame((count & 0x01) ? response : request, Tx))
+        count++;
+    }
+
+    // sequential: start next frame after polling STATE_DONE
+    else if (LIN.getState() & (LIN_Master_Base::STATE_IDLE | LIN_Master_Base::STATE_DONE))
+    {
+      LIN.resetStateMachine();
+      LIN.resetError();
+      LIN.startFrame((count++ & 0x01) ? response : request, Tx);
+    }
+
+    // background handler
+    LIN.handler();
+  }
+
+  // finish pending frames w/o counting them
+  counting = false;
+  while (LIN.queueCount() > 0)
+    LIN.handler();
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  LIN.attachCallback(NULL);
+
+  // print frame rate
+  double fps = 1000.0 * numFrames / DURATION;
+  printf("%-24s frames=%-5u %6.1f frames/s (%5.1f%% of bus maximum)\n", Name, (unsigned) numFrames, fps, 100.0 * fps / Max);
+
+  return fps;
+
+} // run()
+
+
+int main(void)
+{
+  // virtual time for deterministic bus timing. Before attaching slave, which stores time stamps
+  setVirtualTime(true);
+
+  // attach slave model and open LIN interface
+  Slave.setResponse(0x05, 6, Rx);
+  Serial1.attach(&Slave);
+  LIN.begin(LIN_BAUDRATE);
+  LIN.prepareFrame(request, LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, 4);
+  LIN.prepareFrame(response, LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x05, 6);
+
+  // theoretical maximum: BREAK (2 bytes at half baudrate) + SYNC + PID + DATA + CHK, alternating 4 and 6 data bytes
+  double bytesPerFrame = ((2 + 2 + 4 + 1) + (2 + 2 + 6 + 1)) / 2.0;
+  double fpsMax = LIN_BAUDRATE / (10.0 * bytesPerFrame);
+  printf("LIN request queue @ %u Baud, queue size %u, bus maximum %.1f frames/s\n", (unsigned) LIN_BAUDRATE,
+    (unsigned) LIN_MASTER_QUEUE_SIZE, fpsMax);
+
+  // w/o and with application work between polls
+  numErr = 0;
+  run("queued", true, 0, fpsMax);
+  run("sequential", false, 0, fpsMax);
+  printf("application work %uus between polls:\n", (unsigned) APP_WORK);
+  double fpsQueue = run("queued", true, APP_WORK, fpsMax);
+  double fpsSeq   = run("sequential", false, APP_WORK, fpsMax);
+
+  // master request w/o data must be rejected, else stale data of queue entry is sent
+  numErr += LIN.queueFrame(request, NULL);
+  printf("errors=%u\n", (unsigned) numErr);
+
+  // return error code
+  return ((numErr != 0) || (fpsQueue <= fpsSeq));
+
+} // main()
@@ -0,0 +1,173 @@
+/*********************
+
+Host benchmark for LIN schedule tables
+
+Runs the same sequence of frames a) via a schedule table executed by handler() and b) via a hand-rolled
+"millis() - lastLINFrame > PERIOD" loop like in the examples. Frame starts (=begin of BREAK) are recorded
+on the bus and compared to the nominal slot grid. Reports slot jitter, drift and bus utilisation.
+Uses the virtual clock, i.e. jitter only results from the polling of handler() and not from OS scheduling.
+Returns 1 on any frame error (incl. timeout) of the schedule table. Jitter is only reported.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_slave_host.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define DURATION          2000            // duration [ms] per variant
+#define MAX_FRAMES        1000            // max. number of recorded frame starts
+
+
+/// record begin of BREAK on bus and forward bytes to slave model
+class Probe : public HardwareSerial_Listener
+{
+  public:
+    HardwareSerial_Listener   *pSlave;
+    uint32_t                  num;
+    uint32_t                  timeStart[MAX_FRAMES];
+
+    void onTransmit(HardwareSerial &Port, uint8_t Data, uint32_t Baudrate, uint32_t TimeEnd)
+    {
+      if ((Baudrate < LIN_BAUDRATE) && (this->num < MAX_FRAMES))
+        this->timeStart[this->num++] = TimeEnd - (uint32_t) ((10000000ULL + Baudrate/2) / Baudrate);
+      this->pSlave->onTransmit(Port, Data, Baudrate, TimeEnd);
+    }
+};
+
+
+// LIN master and simulated slave on Serial1
+LIN_Master_HardwareSerial   LIN(Serial1, "Master");
+LIN_Slave_Host              Slave(LIN_BAUDRATE);
+Probe                       Bus;
+
+// frame data
+uint8_t   Tx1[4] = {0x01, 0x02, 0x03, 0x04};
+uint8_t   Tx2[2] = {0xAA, 0x55};
+
+// schedule table: type, version, ID, number of data, data, slot [us]
+const LIN_Master_Base::schedule_t Table[] = {
+  { LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, 4, Tx1,  6000 },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x05, 6, NULL, 7000 },
+  { LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x10, 2, Tx2,  5000 },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x06, 8, NULL, 8000 }
+};
+#define NUM_ENTRIES   (sizeof(Table) / sizeof(Table[0]))
+
+
+// nominal frame duration [us]: BREAK (2 bytes at half baudrate) + SYNC + PID + DATA + CHK
+static uint32_t frameDuration(const LIN_Master_Base::schedule_t &Entry)
+{
+  return (2 + 2 + Entry.numData + 1) * ((10000000UL + LIN_BAUDRATE/2) / LIN_BAUDRATE);
+}
+
+
+// evaluate recorded frame starts and print results
+static void evaluate(const char *Name, uint32_t NumErr)
+{
+  int32_t   jitterMin = INT32_MAX, jitterMax = INT32_MIN;
+  uint64_t  jitterSum = 0;
+  uint64_t  busy = 0;
+  uint64_t  nominal = 0;
+
+  // compare start intervals with nominal slot durations
+  for (uint32_t i = 1; i < Bus.num; i++)
+  {
+    const LIN_Master_Base::schedule_t &entry = Table[(i-1) % NUM_ENTRIES];
+    int32_t jitter = (int32_t) (Bus.timeStart[i] - Bus.timeStart[i-1]) - (int32_t) entry.slot;
+    jitterMin = (jitter < jitterMin) ? jitter : jitterMin;
+    jitterMax = (jitter > jitterMax) ? jitter : jitterMax;
+    jitterSum += (jitter < 0) ? -jitter : jitter;
+    busy += frameDuration(entry);
+    nominal += entry.slot;
+  }
+  uint32_t elapsed = Bus.timeStart[Bus.num-1] - Bus.timeStart[0];
+
+  // print results
+  printf("%-12s frames=%-4u errors=%-3u jitter min/avg/max=%+6d/%5u/%+6dus  drift=%+7dus  bus utilisation=%5.1f%% (max. %5.1f%%)\n",
+    Name, (unsigned) Bus.num, (unsigned) NumErr, (int) jitterMin, (unsigned) (jitterSum / (Bus.num-1)), (int) jitterMax,
+    (int) (elapsed - nominal), 100.0 * busy / elapsed, 100.0 * busy / nominal);
+
+} // evaluate()
+
+
+int main(void)
+{
+  uint8_t   Rx5[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+  uint8_t   Rx6[8] = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80};
+  uint32_t  numErr;
+  uint32_t  numErrSchedule;
+  uint32_t  start;
+
+  // virtual time for deterministic bus timing. Before attaching slave, which stores time stamps
+  setVirtualTime(true);
+
+  // attach slave model and open LIN interface
+  Slave.setResponse(0x05, 6, Rx5);
+  Slave.setResponse(0x06, 8, Rx6);
+  Bus.pSlave = &Slave;
+  Serial1.attach(&Bus);
+  LIN.begin(LIN_BAUDRATE);
+  printf("LIN schedule @ %u Baud, %u entries\n", (unsigned) LIN_BAUDRATE, (unsigned) NUM_ENTRIES);
+
+
+  ///////////////
+  // a) schedule table executed by handler()
+  ///////////////
+  Bus.num = 0;
+  numErr  = 0;
+  LIN.setSchedule(Table, NUM_ENTRIES);
+  start = millis();
+  while (millis() - start < DURATION)
+  {
+    // count errors once per frame
+    if ((LIN.handler() == LIN_Master_Base::STATE_DONE) && (LIN.getError() != LIN_Master_Base::NO_ERROR))
+    {
+      numErr++;
+      LIN.resetError();
+    }
+  }
+  LIN.stopSchedule();
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  evaluate("schedule", numErr);
+  numErrSchedule = numErr;
+
+
+  ///////////////
+  // b) hand-rolled loop like in examples (period rounded up to ms)
+  ///////////////
+  LIN.resetStateMachine();
+  LIN.resetError();
+  Bus.num = 0;
+  numErr  = 0;
+  uint32_t lastLINFrame = millis();
+  uint8_t  idx = 0;
+  start = millis();
+  while (millis() - start < DURATION)
+  {
+    LIN.handler();
+    if (LIN.getState() == LIN_Master_Base::STATE_DONE)
+    {
+      numErr += (LIN.getError() != LIN_Master_Base::NO_ERROR);
+      LIN.resetStateMachine();
+      LIN.resetError();
+    }
+    if (millis() - lastLINFrame > Table[(idx+NUM_ENTRIES-1) % NUM_ENTRIES].slot / 1000)
+    {
+      lastLINFrame = millis();
+      const LIN_Master_Base::schedule_t &entry = Table[idx];
+      if (entry.type == LIN_Master_Base::MASTER_REQUEST)
+        LIN.sendMasterRequest(entry.version, entry.id, entry.numData, entry.data);
+      else
+        LIN.receiveSlaveResponse(entry.version, entry.id, entry.numData);
+      idx = (idx + 1) % NUM_ENTRIES;
+    }
+  }
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  evaluate("hand-rolled", numErr);
+
+  // return error code
+  return (numErrSchedule != 0);
+
+} // main()
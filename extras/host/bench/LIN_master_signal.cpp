@@ -0,0 +1,241 @@
+/*********************
+
+Host micro-benchmark for signal packing and unpacking
+
+Unpacks and packs a frame with 14 sub-byte signals in 8 data bytes via
+  - bit loop: each signal is copied bit by bit (like hand-written loops)
+  - byte loop: LIN_Master_LDF::getRaw()/setRaw(), which read the layout at runtime
+  - layout: LIN_Master_Layout with compile-time bit offsets and widths, see LIN_master_Signal.h
+All variants are first checked against each other for random frame data. Returns 1 on any mismatch.
+
+**********************/
+
+// include files
+#include <LIN_master_LDF.h>
+
+// benchmark parameters
+#define NUM_LOOPS         2000000         // number of frames per variant
+#define NUM_CHECKS        10000           // number of random frames for comparison
+
+
+// raw signals of a status frame
+struct Status
+{
+  uint8_t   mode;
+  uint8_t   valid;
+  uint8_t   level;
+  uint16_t  current;
+  uint8_t   dir;
+  uint8_t   temp;
+  uint8_t   pos;
+  uint8_t   lock;
+  uint8_t   pinch;
+  uint8_t   count;
+  uint16_t  voltage;
+  uint8_t   fault;
+  uint8_t   speed;
+  uint8_t   parity;
+};
+
+// compile-time layout of status frame
+typedef LIN_Master_Layout<Status,
+  LIN_MASTER_FIELD(Status, mode,     0,  3),
+  LIN_MASTER_FIELD(Status, valid,    3,  1),
+  LIN_MASTER_FIELD(Status, level,    4,  4),
+  LIN_MASTER_FIELD(Status, current,  8, 10),
+  LIN_MASTER_FIELD(Status, dir,     18,  2),
+  LIN_MASTER_FIELD(Status, temp,    20,  5),
+  LIN_MASTER_FIELD(Status, pos,     25,  7),
+  LIN_MASTER_FIELD(Status, lock,    32,  1),
+  LIN_MASTER_FIELD(Status, pinch,   33,  1),
+  LIN_MASTER_FIELD(Status, count,   34,  6),
+  LIN_MASTER_FIELD(Status, voltage, 40, 12),
+  LIN_MASTER_FIELD(Status, fault,   52,  4),
+  LIN_MASTER_FIELD(Status, speed,   56,  7),
+  LIN_MASTER_FIELD(Status, parity,  63,  1)> Layout;
+
+// same layout for runtime access. Frame and encoding are not used
+static const LIN_Master_LDF::signal_t SIGNALS[] =
+{
+  { 0,  0,  3, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0,  3,  1, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0,  4,  4, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0,  8, 10, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0, 18,  2, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0, 20,  5, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0, 25,  7, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0, 32,  1, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0, 33,  1, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0, 34,  6, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0, 40, 12, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0, 52,  4, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0, 56,  7, LIN_MASTER_LDF_NO_ENCODING, 0 },
+  { 0, 63,  1, LIN_MASTER_LDF_NO_ENCODING, 0 },
+};
+
+
+// copy raw values between struct and array in signal order
+#define STATUS_MEMBERS(X) X(mode) X(valid) X(level) X(current) X(dir) X(temp) X(pos) X(lock) X(pinch) X(count) \
+  X(voltage) X(fault) X(speed) X(parity)
+
+static void toArray(const Status &S, uint32_t Raw[])
+{
+  uint8_t i = 0;
+  #define TO_ARRAY(m) Raw[i++] = S.m;
+  STATUS_MEMBERS(TO_ARRAY)
+}
+
+static void fromArray(const uint32_t Raw[], Status &S)
+{
+  uint8_t i = 0;
+  #define FROM_ARRAY(m) S.m = (decltype(S.m)) Raw[i++];
+  STATUS_MEMBERS(FROM_ARRAY)
+}
+
+
+// unpack bit by bit
+__attribute__((noinline)) static void unpackBits(const uint8_t Data[], Status &S)
+{
+  uint32_t raw[14];
+  for (uint8_t s = 0; s < 14; s++)
+  {
+    raw[s] = 0;
+    for (uint8_t b = 0; b < SIGNALS[s].width; b++)
+    {
+      uint8_t bit = SIGNALS[s].start + b;
+      raw[s] |= (uint32_t) ((Data[bit >> 3] >> (bit & 0x07)) & 0x01) << b;
+    }
+  }
+  fromArray(raw, S);
+}
+
+// pack bit by bit
+__attribute__((noinline)) static void packBits(uint8_t Data[], const Status &S)
+{
+  uint32_t raw[14];
+  toArray(S, raw);
+  for (uint8_t s = 0; s < 14; s++)
+  {
+    for (uint8_t b = 0; b < SIGNALS[s].width; b++)
+    {
+      uint8_t bit = SIGNALS[s].start + b;
+      Data[bit >> 3] = (uint8_t) ((Data[bit >> 3] & ~(1 << (bit & 0x07))) | (((raw[s] >> b) & 0x01) << (bit & 0x07)));
+    }
+  }
+}
+
+// unpack via runtime layout
+__attribute__((noinline)) static void unpackBytes(const uint8_t Data[], Status &S)
+{
+  uint32_t raw[14];
+  for (uint8_t s = 0; s < 14; s++)
+    raw[s] = LIN_Master_LDF::getRaw(SIGNALS[s], Data);
+  fromArray(raw, S);
+}
+
+// pack via runtime layout
+__attribute__((noinline)) static void packBytes(uint8_t Data[], const Status &S)
+{
+  uint32_t raw[14];
+  toArray(S, raw);
+  for (uint8_t s = 0; s < 14; s++)
+    LIN_Master_LDF::setRaw(SIGNALS[s], Data, raw[s]);
+}
+
+// unpack via compile-time layout
+__attribute__((noinline)) static void unpackLayout(const uint8_t Data[], Status &S)
+{
+  Layout::unpack(Data, S);
+}
+
+// pack via compile-time layout
+__attribute__((noinline)) static void packLayout(uint8_t Data[], const Status &S)
+{
+  Layout::pack(Data, S);
+}
+
+
+// compare all variants for random frames. Return errors
+static uint32_t check(void)
+{
+  uint32_t  errors = 0;
+
+  srand(1);
+  for (uint32_t i = 0; i < NUM_CHECKS; i++)
+  {
+    uint8_t   data[8], bits[8], bytes[8], layout[8];
+    Status    a, b, c;
+    uint32_t  rawA[14], rawB[14], rawC[14];
+
+    // unpack random frame
+    for (uint8_t j = 0; j < 8; j++)
+      data[j] = (uint8_t) rand();
+    unpackBits(data, a);
+    unpackBytes(data, b);
+    unpackLayout(data, c);
+    toArray(a, rawA);
+    toArray(b, rawB);
+    toArray(c, rawC);
+    errors += (memcmp(rawA, rawB, sizeof(rawA)) != 0) || (memcmp(rawA, rawC, sizeof(rawA)) != 0);
+
+    // pack into cleared and set frame. Signals cover all bits, i.e. must yield original frame
+    memset(bits, 0x00, 8);
+    memset(bytes, 0xFF, 8);
+    memset(layout, (i & 0x01) ? 0x00 : 0xFF, 8);
+    packBits(bits, a);
+    packBytes(bytes, a);
+    packLayout(layout, a);
+    errors += (memcmp(data, bits, 8) != 0) || (memcmp(data, bytes, 8) != 0) || (memcmp(data, layout, 8) != 0);
+  }
+  printf("check: %u random frames, unpack and pack compared: errors=%u\n", (unsigned) NUM_CHECKS, (unsigned) errors);
+
+  return errors;
+
+} // check()
+
+
+// measure unpack and pack. Data changes every loop to avoid hoisting
+static void measure(const char *Name, void (*Unpack)(const uint8_t[], Status &), void (*Pack)(uint8_t[], const Status &))
+{
+  uint8_t           data[8] = { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0 };
+  Status            s;
+  volatile uint32_t sink = 0;
+  uint32_t          start, timeUnpack, timePack;
+
+  start = micros();
+  for (uint32_t i = 0; i < NUM_LOOPS; i++)
+  {
+    data[0] = (uint8_t) i;
+    Unpack(data, s);
+    sink += s.mode + s.current + s.voltage + s.parity;
+  }
+  timeUnpack = micros() - start;
+
+  start = micros();
+  for (uint32_t i = 0; i < NUM_LOOPS; i++)
+  {
+    s.current = (uint16_t) i;
+    Pack(data, s);
+    sink += data[1];
+  }
+  timePack = micros() - start;
+
+  printf("%-10s unpack %6.1f ns/frame   pack %6.1f ns/frame\n", Name, 1000.0 * timeUnpack / NUM_LOOPS, 1000.0 * timePack / NUM_LOOPS);
+
+} // measure()
+
+
+int main(void)
+{
+  uint32_t  errors;
+
+  printf("signal packing (14 signals in 8 data bytes)\n");
+  errors = check();
+  measure("bit loop", unpackBits, packBits);
+  measure("byte loop", unpackBytes, packBytes);
+  measure("layout", unpackLayout, packLayout);
+
+  // return error code
+  return (errors != 0);
+
+} // main()
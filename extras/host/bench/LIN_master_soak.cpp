@@ -0,0 +1,215 @@
+/*********************
+
+Host soak test with virtual time
+
+A LIN_Master_HardwareSerial and a LIN_master_SoftwareSerial each run a schedule table on an own simulated bus
+(see LIN_bus_host.h) for SOAK_HOURS of virtual time (see setVirtualTime()). While idle, the virtual clock jumps
+to the next pending deadline (bus events and LIN_Master_Base::getDeadline()), i.e. 24h take about a minute.
+The virtual clock starts shortly before micros() and millis() wrap around, and micros() wraps every ~71.6min.
+As the virtual time is not affected by OS preemption, results are deterministic and every deviation is an error:
+  - frames answered by a slave must be ok and contain the expected data
+  - the frame w/o slave must time out, i.e. have no other error
+  - frames must start within SLOT_TOLERANCE of the nominal slot grid, and no slot must be lost
+Optional argument: duration in hours of virtual time. Returns 1 on any error.
+
+**********************/
+
+// include files
+#include <time.h>
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_master_SoftwareSerial.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_sim.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define SOAK_HOURS        2               // default duration [h] of virtual time per master. "make soak" runs 24h
+#define TIME_START        (4294967296000ULL - 10000000ULL)  // virtual start time [us]: 10s before micros() and millis() wrap
+#define SLOT_TOLERANCE    500             // max. deviation [us] of frame start from nominal slot grid
+#define RESPONSE_SPACE    40              // min. slave response space [us]
+#define RESPONSE_JITTER   100             // max. random jitter of response space [us]
+#define PIN_SW_RX         10              // SoftwareSerial Rx pin
+#define PIN_SW_TX         11              // SoftwareSerial Tx pin
+
+
+// simulated buses with slaves
+LIN_Bus_Host                BusHW(LIN_BAUDRATE), BusSW(LIN_BAUDRATE);
+LIN_Slave_Sim               SlaveHW(1), SlaveSW(2);
+
+// LIN masters on HardwareSerial and SoftwareSerial
+LIN_Master_HardwareSerial   LIN_HW(Serial1, "HW");
+LIN_master_SoftwareSerial   LIN_SW(PIN_SW_RX, PIN_SW_TX, false, "SW");
+
+// frame data
+uint8_t   Tx[4]  = {0x01, 0x02, 0x03, 0x04};
+uint8_t   Rx5[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+uint8_t   Rx6[8] = {0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7};
+
+// schedule table: type, version, ID, number of data, data, slot [us]. ID 0x07 has no slave -> timeout
+const LIN_Master_Base::schedule_t Table[] = {
+  { LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, 4, Tx,   10000 },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x05, 6, NULL, 10000 },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x06, 8, NULL, 10000 },
+  { LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x07, 2, NULL, 10000 }
+};
+#define NUM_ENTRIES   (sizeof(Table) / sizeof(Table[0]))
+
+// frame statistics
+uint64_t  numFrames;
+uint64_t  numErr;
+uint64_t  numTimeout;
+uint32_t  timeLast;
+int32_t   devMax;
+uint32_t  durMax;
+
+
+// wall clock [ns], independent of virtual time
+static inline uint64_t nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+
+// completion callback: check result and slot grid
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+  bool err;
+
+  // check error and data. Only frame w/o slave must time out
+  if (Result.id == 0x07)
+    err = (Result.error != LIN_Master_Base::ERROR_TIMEOUT);
+  else if (Result.id == 0x05)
+    err = (Result.error != LIN_Master_Base::NO_ERROR) || (memcmp(Result.data, Rx5, sizeof(Rx5)) != 0);
+  else if (Result.id == 0x06)
+    err = (Result.error != LIN_Master_Base::NO_ERROR) || (memcmp(Result.data, Rx6, sizeof(Rx6)) != 0);
+  else
+    err = (Result.error != LIN_Master_Base::NO_ERROR);
+  numTimeout += (Result.error == LIN_Master_Base::ERROR_TIMEOUT);
+
+  // frame start vs. slot grid (all slots have same length) and max. duration
+  if (numFrames > 0)
+  {
+    int32_t dev = (int32_t) (Result.timeStart - timeLast) - (int32_t) Table[0].slot;
+    dev = (dev < 0) ? -dev : dev;
+    devMax = (dev > devMax) ? dev : devMax;
+    err |= (dev > SLOT_TOLERANCE);
+  }
+  timeLast = Result.timeStart;
+  durMax = (Result.duration > durMax) ? Result.duration : durMax;
+  err |= (Result.duration > Table[0].slot);
+
+  // print first errors
+  if (err && (numErr < 5))
+    printf("  error: t=%lluus id=0x%02X err=0x%02X start=%u duration=%uus\n", (unsigned long long) micros64(),
+      (int) Result.id, (int) Result.error, (unsigned) Result.timeStart, (unsigned) Result.duration);
+  numErr += err;
+  numFrames++;
+}
+
+
+// run schedule table for specified virtual time. Return errors
+static uint64_t run(const char *Name, LIN_Master_Base &LIN, uint64_t Duration)
+{
+  uint32_t  wrapMicros = 0, wrapMillis = 0;
+  uint32_t  lastMicros, lastMillis;
+  uint32_t  deadline;
+
+  numFrames = numErr = numTimeout = 0;
+  devMax = durMax = 0;
+  uint64_t wallStart = nanos();
+  uint64_t start = micros64();
+  lastMicros = micros();
+  lastMillis = millis();
+
+  // run schedule table. When idle, virtual clock jumps to next deadline or bus event
+  LIN.begin(LIN_BAUDRATE);
+  LIN.attachCallback(onFrame);
+  #if defined(LIN_MASTER_TIMING)
+    LIN.resetTiming();
+  #endif
+  LIN.setSchedule(Table, NUM_ENTRIES);
+  while (micros64() - start < Duration)
+  {
+    LIN.handler();
+    if (LIN.getDeadline(deadline))
+      scheduleTime(deadline);
+    yield();
+
+    // count wrap-arounds
+    uint32_t now = micros();
+    wrapMicros += (now < lastMicros);
+    lastMicros = now;
+    now = millis();
+    wrapMillis += (now < lastMillis);
+    lastMillis = now;
+  }
+  LIN.stopSchedule();
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  LIN.attachCallback(NULL);
+  LIN.end();
+  double wall = (nanos() - wallStart) * 1e-9;
+  double virt = (micros64() - start) * 1e-6;
+
+  // lost slots (1 slot tolerance for start and stop)
+  uint64_t expected = (uint64_t) (virt * 1e6 / Table[0].slot);
+  if (numFrames + 1 < expected)
+  {
+    printf("  error: %llu slots lost\n", (unsigned long long) (expected - numFrames));
+    numErr++;
+  }
+
+  // print results
+  printf("%-3s %5.1fh virtual in %5.1fs (x%.0f): frames=%-8llu errors=%-3llu timeouts=%-8llu wraps micros/millis=%u/%u  slot dev max=%dus  duration max=%uus\n",
+    Name, virt / 3600.0, wall, virt / wall, (unsigned long long) numFrames, (unsigned long long) numErr,
+    (unsigned long long) numTimeout, (unsigned) wrapMicros, (unsigned) wrapMillis, (int) devMax, (unsigned) durMax);
+
+  // header and response space must be recorded per received byte for all backends
+  #if defined(LIN_MASTER_TIMING)
+    const LIN_Master_Base::timing_t &timing = LIN.getTiming();
+    printf("    header min/max=%u/%uus  response space min/max=%u/%uus\n", (unsigned) timing.header.min,
+      (unsigned) timing.header.max, (unsigned) timing.responseSpace.min, (unsigned) timing.responseSpace.max);
+    numErr += (timing.header.num == 0) || (timing.responseSpace.num == 0);
+  #endif
+
+  return numErr;
+
+} // run()
+
+
+int main(int argc, char *argv[])
+{
+  uint64_t  errors = 0;
+  double    hours = SOAK_HOURS;
+
+  // optional duration [h]
+  if (argc > 1)
+    hours = atof(argv[1]);
+
+  // start virtual time shortly before wrap-around. Before connecting buses, which store time stamps
+  setVirtualTime(true, TIME_START);
+
+  // connect masters and slaves to simulated buses
+  SlaveHW.setResponse(0x05, sizeof(Rx5), Rx5);
+  SlaveHW.setResponse(0x06, sizeof(Rx6), Rx6);
+  SlaveHW.setResponseSpace(RESPONSE_SPACE, RESPONSE_JITTER);
+  SlaveSW.setResponse(0x05, sizeof(Rx5), Rx5);
+  SlaveSW.setResponse(0x06, sizeof(Rx6), Rx6);
+  SlaveSW.setResponseSpace(RESPONSE_SPACE, RESPONSE_JITTER);
+  BusHW.addSlave(SlaveHW);
+  BusSW.addSlave(SlaveSW);
+  Serial1.connect(&BusHW);
+  BusSW.connectPin(PIN_SW_TX);
+  printf("soak test with virtual time @ %u Baud, %.1fh per master\n", (unsigned) LIN_BAUDRATE, hours);
+
+  // run both masters
+  errors += run("HW", LIN_HW, (uint64_t) (hours * 3600e6));
+  errors += run("SW", LIN_SW, (uint64_t) (hours * 3600e6));
+
+  // return error code
+  return (errors != 0);
+
+} // main()
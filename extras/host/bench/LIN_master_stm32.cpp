@@ -0,0 +1,209 @@
+/*********************
+
+Host benchmark for native LIN break and DMA of STM32 USART
+
+Runs LIN_Master_HardwareSerial_STM32 against the mocked USART register block of the host HardwareSerial, connected to
+a simulated bus (virtual time) with one slave. Alternates master requests and slave responses every 10ms and calls
+handler() every 300us like the examples. Compares the BREAK a) emulated via 0x00 at 1/2 baudrate (BRR doubled),
+i.e. the frame body is sent after the BREAK echo was polled, and b) generated natively via LIN mode (CR2.LINEN) and
+HAL_LIN_SendBreak() (RQR.SBKRQ), with SYNC+PID queued immediately. Both are run with Serial.write()/read() and with
+simulated DMA via HAL_UART_Transmit_DMA() and HAL_UARTEx_ReceiveToIdle_DMA(), where the frame is checked and completed
+in HAL_UARTEx_RxEventCallback() and handler() only checks the timeout. The D-cache of STM32F7/H7 is simulated, i.e.
+received bytes are only visible after invalidation and sent bytes must be cleaned before. Per frame prints the
+interrupts (w/o DMA per byte of the core, with DMA per DMA or idle event), and the host CPU time of handler().
+An observer checks the BREAK length and the baudrate of all other bytes, the callback checks the received data.
+Returns 1 on any frame error, wrong BREAK length, baudrate or data, if LIN mode or DMA are not configured, on any
+D-cache maintenance error, if the native break does not save at least 1/2 byte per frame, or if DMA does not need
+less than half of the interrupts per frame.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial_STM32.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_sim.h>
+#include <time.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NUM_FRAMES        200             // number of frames per variant
+#define FRAME_PERIOD      10000           // frame period [us]
+#define HANDLER_PERIOD    300             // polling period [us] like examples
+
+
+// simulated bus with one slave
+LIN_Bus_Host                      Bus(LIN_BAUDRATE);
+LIN_Slave_Sim                     Slave(1);
+
+// LIN master via mocked STM32 USART (pins are ignored)
+LIN_Master_HardwareSerial_STM32   LIN(Serial1, 0, 1, "STM32");
+
+// simulated DMA channels, e.g. DMA1 channel 4 (Tx) and 5 (Rx) for USART1 on STM32L4
+DMA_Channel_TypeDef               DmaChannel[2];
+DMA_HandleTypeDef                 DmaTx = { &DmaChannel[0], HAL_DMA_STATE_READY, NULL };
+DMA_HandleTypeDef                 DmaRx = { &DmaChannel[1], HAL_DMA_STATE_READY, NULL };
+
+// frame data
+uint8_t   Tx[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+uint8_t   Rx[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+// frame statistics
+uint32_t  numFrames, numErr;
+uint64_t  sumDuration;
+
+
+// wall clock [ns], independent of virtual time
+static inline uint64_t nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+
+// observer of sent bytes: BREAK is reported as 0x00 at a lower baudrate with the same low time
+class Observer : public HardwareSerial_Listener
+{
+  public:
+
+    uint32_t  numBreak;                   // number of BREAKs
+    uint32_t  numErr;                     // number of BREAKs with wrong length or bytes with wrong baudrate
+    uint32_t  bitsBreak;                  // expected BREAK low time [bit]
+
+    void reset(uint32_t BitsBreak)
+    {
+      numBreak = numErr = 0;
+      bitsBreak = BitsBreak;
+    }
+
+    void onTransmit(HardwareSerial &Port, uint8_t Data, uint32_t Baudrate, uint32_t TimeEnd)
+    {
+      (void) Port;
+      (void) TimeEnd;
+
+      // BREAK: low time of start bit + 8 data bits at reported baudrate
+      if ((Data == 0x00) && (Baudrate < LIN_BAUDRATE))
+      {
+        uint32_t bits = (9 * LIN_BAUDRATE + Baudrate/2) / Baudrate;
+        numErr += (bits != bitsBreak);
+        numBreak++;
+      }
+
+      // other bytes at nominal baudrate
+      else
+        numErr += (Baudrate != LIN_BAUDRATE);
+    }
+
+} observer;
+
+
+// completion callback
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  numFrames++;
+  sumDuration += Result.duration;
+  numErr += (Result.error != LIN_Master_Base::NO_ERROR);
+  if (Result.type == LIN_Master_Base::SLAVE_RESPONSE)
+    numErr += (memcmp(Result.data, Rx, sizeof(Rx)) != 0);
+}
+
+
+// run frames with emulated or native BREAK, optionally via DMA. Return avg. frame duration [us]
+static double run(bool Native, bool Dma, uint32_t &Errors, uint32_t &IsrBytes)
+{
+  uint32_t  nextFrame, lastHandler;
+  uint64_t  cpuHandler = 0;
+  uint8_t   count = 0;
+
+  // open interface. LIN mode is configured in begin()
+  observer.reset(Native ? 13 : 18);
+  LIN.setNativeBreak(Native);
+  LIN.setDMA(Dma ? &DmaTx : NULL, Dma ? &DmaRx : NULL);
+  LIN.begin(LIN_BAUDRATE);
+  LIN.attachCallback(onFrame);
+  Serial1.resetIsrCount();
+  USART_TypeDef *usart = Serial1.getHandle()->Instance;
+  bool linMode = (usart->CR2 & USART_CR2_LINEN);
+  UART_HandleTypeDef *huart = Serial1.getHandle();
+  bool dmaMode = (huart->hdmatx == &DmaTx) && (huart->hdmarx == &DmaRx) && (!(usart->CR1 & USART_CR1_RXNEIE));
+
+  // start frame every period, poll handler like examples
+  numFrames = numErr = 0;
+  sumDuration = 0;
+  nextFrame = lastHandler = micros();
+  while (numFrames < NUM_FRAMES)
+  {
+    if ((int32_t) (micros() - nextFrame) >= 0)
+    {
+      nextFrame += FRAME_PERIOD;
+      LIN.resetStateMachine();
+      LIN.resetError();
+      if ((count++ & 0x01) == 0)
+        LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, sizeof(Tx), Tx);
+      else
+        LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, sizeof(Rx));
+    }
+    if (micros() - lastHandler >= HANDLER_PERIOD)
+    {
+      lastHandler = micros();
+      uint64_t start = nanos();
+      LIN.handler();
+      cpuHandler += nanos() - start;
+    }
+    scheduleTime(lastHandler + HANDLER_PERIOD);
+    scheduleTime(nextFrame);
+    yield();
+  }
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  LIN.attachCallback(NULL);
+
+  // errors incl. BREAK length, baudrate, LIN mode and DMA
+  IsrBytes = Serial1.getIsrCount();
+  Errors = numErr + observer.numErr + (observer.numBreak < numFrames) + (linMode != Native) + (dmaMode != Dma) + hostDcacheErrors();
+  double duration = (double) sumDuration / numFrames;
+  printf("%-8s %-6s  LINEN=%d DMA=%d  frames=%u errors=%u  BREAK=%ubit (errors=%u)  avg. frame duration=%6.0fus\n",
+    Native ? "native" : "emulated", Dma ? "DMA" : "Serial", (int) linMode, (int) dmaMode, (unsigned) numFrames,
+    (unsigned) numErr, (unsigned) observer.bitsBreak, (unsigned) observer.numErr, duration);
+  printf("                 UART/DMA interrupts=%.1f/frame  host CPU of handler()=%.2fus/frame\n",
+    (double) IsrBytes / numFrames, 1e-3 * cpuHandler / numFrames);
+  LIN.end();
+
+  return duration;
+}
+
+
+int main(void)
+{
+  uint32_t  errors = 0, err, isr[2][2];
+  double    durationEmulated, durationNative;
+
+  // virtual time for fast simulation. Before connecting bus, which stores time stamps
+  setVirtualTime(true);
+  Bus.addSlave(Slave);
+  Serial1.connect(&Bus);
+  Serial1.attach(&observer);
+  Slave.setResponse(0x05, sizeof(Rx), Rx);
+  Slave.setResponseSpace(100, 200);
+  printf("handler() every %uus\n", (unsigned) HANDLER_PERIOD);
+
+  // compare BREAK variants, each w/o and with DMA
+  for (uint8_t dma = 0; dma < 2; dma++)
+  {
+    durationEmulated = run(false, dma, err, isr[dma][0]);
+    errors += err;
+    durationNative = run(true, dma, err, isr[dma][1]);
+    errors += err;
+    printf("native break saves %.0fus per frame\n", durationEmulated - durationNative);
+    errors += (durationNative + (5000000.0 / LIN_BAUDRATE) > durationEmulated);
+  }
+
+  // DMA needs less than half of the interrupts
+  errors += (2 * isr[1][0] >= isr[0][0]) + (2 * isr[1][1] >= isr[0][1]);
+
+  // return error code
+  return (errors != 0);
+
+} // main()
@@ -0,0 +1,226 @@
+/*********************
+
+Host benchmark for compile-time LIN master LIN_Master_Template vs. LIN_Master_HardwareSerial (virtual methods)
+
+For each HardwareSerial example (Blk, Bkg, Dual_Bkg) the same frame sequence (alternating master request and slave
+response) is run with both variants:
+  - Blk:      handler() is called in a tight loop until STATE_DONE, like sendMasterRequestBlocking()
+  - Bkg:      handler() is called between a fixed application workload, like in LIN_master_HWSerial_Bkg
+  - Dual_Bkg: like Bkg, but for 2 buses, like in LIN_master_Dual_HWSerial_Bkg
+Reports CPU time per handler() call and per frame (corrected by the overhead of the time measurement). RAM per node is
+not reported here, as this build enables optional features of the virtual classes (timing statistics, trace), which
+LIN_Master_Template doesn't have. For flash/RAM of the examples w/o these see "make size" and "make size-avr".
+Bus timing uses the virtual clock, CPU time the system clock.
+Finally checks that frames exceeding MaxData, or master requests w/o data, are rejected.
+Returns 1 on any frame error (incl. timeout) or data mismatch, or if an invalid frame is not rejected.
+
+**********************/
+
+// include files
+#include <time.h>
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_master_Template.h>
+#include <LIN_slave_host.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NUM_FRAMES        100             // number of frames per example and variant
+#define WORK_LOOPS        200             // size of application workload between LIN service calls
+
+
+// LIN masters (virtual and template) and simulated slaves on Serial1..2
+LIN_Master_HardwareSerial                 LIN1(Serial1, "LIN1"), LIN2(Serial2, "LIN2");
+LIN_Master_Template<HardwareSerial, 8>    LIN1_T(Serial1), LIN2_T(Serial2);
+LIN_Master_Template<HardwareSerial, 4, 2> LIN_Small(Serial3);
+LIN_Slave_Host                            Slave1, Slave2;
+
+// frame data
+uint8_t   Tx[4] = {0x01, 0x02, 0x03, 0x04};
+uint8_t   Rx[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+
+// overhead of time measurement [ns]
+static double overhead;
+
+
+// application workload
+static void appWork(void)
+{
+  for (volatile uint32_t i = 0; i < WORK_LOOPS; i++);
+}
+
+
+// time stamp [ns]
+static inline uint64_t nanos(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+
+// start next frame of alternating sequence
+template <class LINType> static void startNext(LINType &LIN, uint32_t Count)
+{
+  LIN.resetStateMachine();
+  LIN.resetError();
+  if (Count & 0x01)
+    LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, 6);
+  else
+    LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, 4, Tx);
+}
+
+
+// check completed frame. Return 1 on error
+template <class LINType> static uint32_t checkFrame(LINType &LIN)
+{
+  LIN_Master_Base::frame_t  type;
+  uint8_t                   id, numData, data[8];
+  LIN_Master_Base::error_t  error = LIN.getError();
+
+  // on error wait until stale bytes are received, then discard them
+  if (error != LIN_Master_Base::NO_ERROR)
+  {
+    delay(10);
+    return 1;
+  }
+
+  // check slave response data
+  LIN.getFrame(type, id, numData, data);
+  return ((type == LIN_Master_Base::SLAVE_RESPONSE) && (memcmp(data, Rx, 6) != 0));
+}
+
+
+// example Blk: call handler() in tight loop until frame is done. Return errors
+template <class LINType> static uint32_t runBlk(const char *Name, LINType &LIN)
+{
+  uint64_t  busy = 0;
+  uint64_t  calls = 0;
+  uint32_t  errors = 0;
+
+  LIN.begin(LIN_BAUDRATE);
+  for (uint32_t count = 0; count < NUM_FRAMES; count++)
+  {
+    startNext(LIN, count);
+    uint64_t t0 = nanos();
+    do
+      calls++;
+    while (LIN.handler() != LIN_Master_Base::STATE_DONE);
+    busy += nanos() - t0;
+    errors += checkFrame(LIN);
+  }
+  LIN.end();
+
+  printf("%-9s %-8s errors=%-3u handler=%6.1fns/call\n", "Blk", Name, (unsigned) errors, (double) busy / calls);
+  return errors;
+
+} // runBlk()
+
+
+// examples Bkg and Dual_Bkg: call handler() of 1 or 2 buses between application workload. Return errors
+template <class LINType> static uint32_t runBkg(const char *Name, LINType &LIN_A, LINType &LIN_B, uint8_t NumBus)
+{
+  LINType   *Bus[2] = {&LIN_A, &LIN_B};
+  uint32_t  count[2] = {0, 0};
+  uint64_t  busy = 0;
+  uint64_t  calls = 0;
+  uint32_t  errors = 0;
+
+  // start 1st frame on all buses
+  for (uint8_t i = 0; i < NumBus; i++)
+  {
+    Bus[i]->begin(LIN_BAUDRATE);
+    startNext(*(Bus[i]), count[i]);
+  }
+
+  // service buses until all frames are done
+  while ((count[0] < NUM_FRAMES) || (count[NumBus-1] < NUM_FRAMES))
+  {
+    for (uint8_t i = 0; i < NumBus; i++)
+    {
+      uint64_t t0 = nanos();
+      LIN_Master_Base::state_t state = Bus[i]->handler();
+      busy += nanos() - t0;
+      calls++;
+      if ((state == LIN_Master_Base::STATE_DONE) && (count[i] < NUM_FRAMES))
+      {
+        errors += checkFrame(*(Bus[i]));
+        if (++count[i] < NUM_FRAMES)
+          startNext(*(Bus[i]), count[i]);
+      }
+    }
+    appWork();
+  }
+  busy -= (uint64_t) (overhead * calls);
+  for (uint8_t i = 0; i < NumBus; i++)
+    Bus[i]->end();
+
+  printf("%-9s %-8s errors=%-3u handler=%6.1fns/call, %6.2fus/frame\n", (NumBus == 1) ? "Bkg" : "Dual_Bkg", Name,
+    (unsigned) errors, (double) busy / calls, 0.001 * busy / (NumBus * NUM_FRAMES));
+  return errors;
+
+} // runBkg()
+
+
+// start and queue frames which exceed MaxData=4 or lack master request data. Return number of accepted frames
+static uint32_t runInvalid(void)
+{
+  LIN_Master_Base::descriptor_t   longFrame, request;
+  uint32_t  accepted = 0;
+
+  // descriptors shared with LIN_Master_Base, e.g. from LDF tables
+  LIN1.prepareFrame(longFrame, LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, 8);
+  LIN_Small.prepareFrame(request, LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, 4);
+
+  LIN_Small.begin(LIN_BAUDRATE);
+  LIN_Small.startFrame(longFrame, Tx);
+  accepted += (LIN_Small.getError() != LIN_Master_Base::ERROR_MISC);
+  LIN_Small.resetStateMachine();
+  LIN_Small.resetError();
+  LIN_Small.startFrame(request);
+  accepted += (LIN_Small.getError() != LIN_Master_Base::ERROR_MISC);
+  accepted += LIN_Small.queueFrame(longFrame, Tx);
+  accepted += LIN_Small.queueFrame(request);
+  LIN_Small.end();
+
+  printf("invalid frames accepted=%u\n", (unsigned) accepted);
+  return accepted;
+
+} // runInvalid()
+
+
+int main(void)
+{
+  uint32_t  errors = 0;
+
+  // virtual time for deterministic bus timing. Before attaching slaves, which store time stamps
+  setVirtualTime(true);
+
+  // attach slave models
+  Slave1.setResponse(0x05, 6, Rx);
+  Slave2.setResponse(0x05, 6, Rx);
+  Serial1.attach(&Slave1);
+  Serial2.attach(&Slave2);
+  printf("LIN_Master_Template vs. LIN_Master_HardwareSerial @ %u Baud, %u frames\n", (unsigned) LIN_BAUDRATE, (unsigned) NUM_FRAMES);
+
+  // calibrate overhead of time measurement
+  uint64_t busy = 0;
+  for (uint32_t i = 0; i < 100000; i++)
+  {
+    uint64_t t0 = nanos();
+    busy += nanos() - t0;
+  }
+  overhead = busy / 100000.0;
+
+  // run examples with both variants
+  errors += runBlk("virtual", LIN1);
+  errors += runBlk("template", LIN1_T);
+  errors += runBkg("virtual", LIN1, LIN2, 1);
+  errors += runBkg("template", LIN1_T, LIN2_T, 1);
+  errors += runBkg("virtual", LIN1, LIN2, 2);
+  errors += runBkg("template", LIN1_T, LIN2_T, 2);
+  errors += runInvalid();
+
+  // return error code
+  return (errors != 0);
+
+} // main()
@@ -0,0 +1,173 @@
+/*********************
+
+Host benchmark for timer interrupt driven background operation
+
+Queues alternating master requests and slave responses every 10ms on a simulated bus (virtual time), while the
+application blocks in each loop for a few ms via delay(), e.g. for Serial prints or SD writes. Compares calling
+handler() from loop() with calling it from the simulated one-shot timer of LIN_Master_Timer, which is re-armed at the
+next deadline of the node. The simulated timer ISR is called during delay(), like a hardware timer interrupt.
+Prints errors and frame durations relative to the nominal frame duration.
+Finally checks that nested lock()/unlock() restore the previous interrupt state.
+Returns 1 if timer operation has any frame error, a frame takes >2 bytes longer than nominal plus response space,
+if the loop variant is not affected by the blocking application (i.e. the benchmark is meaningless), or if
+unlock() enables interrupts before the outermost lock is released or if they were disabled before lock().
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_master_Timer.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_sim.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NUM_FRAMES        500             // number of frames per variant
+#define FRAME_PERIOD      10              // frame period [ms]
+#define APP_BLOCKING      3               // blocking time of application per loop [ms]
+#define SLAVE_SPACE       100             // min. slave response space [us]
+#define SLAVE_JITTER      200             // max. additional slave response space [us]
+
+
+// simulated bus with one slave
+LIN_Bus_Host                Bus(LIN_BAUDRATE);
+LIN_Slave_Sim               Slave(1);
+
+// LIN master and timer operation
+LIN_Master_HardwareSerial   LIN(Serial1, "Timer");
+LIN_Master_Timer            Timer(LIN);
+
+// frame data
+uint8_t   Tx[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+uint8_t   Rx[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+// statistics. Updated in ISR context
+volatile uint32_t  numFrames, numErr, maxExcess;
+volatile uint64_t  sumExcess;
+
+// prepared frames (master request, slave response) with same nominal duration [us]
+LIN_Master_Base::descriptor_t   Frame[2];
+uint32_t                        Nominal;
+
+
+// completion callback. Called from timer ISR in timer operation
+static void onFrame(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg)
+{
+  (void) LIN;
+  (void) Arg;
+
+  // excess duration over nominal frame
+  uint32_t excess = (Result.duration > Nominal) ? Result.duration - Nominal : 0;
+
+  numFrames++;
+  numErr += (Result.error != LIN_Master_Base::NO_ERROR);
+  sumExcess += excess;
+  if (excess > maxExcess)
+    maxExcess = excess;
+}
+
+
+// run frames with blocking application. Return max. excess frame duration [us]
+static uint32_t run(bool UseTimer)
+{
+  uint32_t  lastFrame, count = 0;
+
+  numFrames = numErr = maxExcess = 0;
+  sumExcess = 0;
+
+  // open interface and prepare frames
+  LIN.begin(LIN_BAUDRATE);
+  LIN.prepareFrame(Frame[0], LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x1A, sizeof(Tx));
+  LIN.prepareFrame(Frame[1], LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x05, sizeof(Rx));
+  LIN.attachCallback(onFrame);
+  if (UseTimer)
+    Timer.begin();
+
+  // queue frame every period, then block application
+  lastFrame = millis();
+  while (numFrames < NUM_FRAMES)
+  {
+    if (millis() - lastFrame >= FRAME_PERIOD)
+    {
+      lastFrame += FRAME_PERIOD;
+      LIN.queueFrame(Frame[count++ & 0x01], Tx);
+      if (UseTimer)
+        Timer.update();
+    }
+
+    // w/o timer call handler from loop
+    if (!UseTimer)
+      LIN.handler();
+
+    // blocking application
+    delay(APP_BLOCKING);
+  }
+
+  // close interface
+  printf("%-6s  frames=%u errors=%-3u  duration above nominal avg=%5.0fus max=%5uus", UseTimer ? "timer" : "loop",
+    (unsigned) numFrames, (unsigned) numErr, (double) sumExcess / numFrames, (unsigned) maxExcess);
+  if (UseTimer)
+  {
+    printf("  timer ISR calls/frame=%.1f", (double) Timer.numCalls / numFrames);
+    Timer.end();
+  }
+  printf("\n");
+  while (LIN.handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY));
+  LIN.attachCallback(NULL);
+  LIN.end();
+
+  return maxExcess;
+}
+
+
+int main(void)
+{
+  uint32_t  errors = 0, excessLoop, excessTimer;
+
+  // virtual time for fast simulation. Before connecting bus, which stores time stamps
+  setVirtualTime(true);
+  Bus.addSlave(Slave);
+  Serial1.connect(&Bus);
+  Slave.setResponse(0x05, sizeof(Rx), Rx);
+  Slave.setResponseSpace(SLAVE_SPACE, SLAVE_JITTER);
+
+  // nominal frame duration: BREAK (2 bytes at half baudrate) + SYNC + PID + 8 DATA + CHK w/o gaps
+  Nominal = (uint32_t) ((2 + 2 + 8 + 1) * 10 * 1000000.0 / LIN_BAUDRATE);
+  printf("application blocks %ums per loop, frame every %ums, nominal frame %uus\n", (unsigned) APP_BLOCKING,
+    (unsigned) FRAME_PERIOD, (unsigned) Nominal);
+
+  // handler() from loop() -> frames are delayed by blocking application
+  excessLoop = run(false);
+  uint32_t errLoop = numErr;
+
+  // handler() from timer ISR -> frames completed independent of application
+  excessTimer = run(true);
+  errors += numErr;
+
+  // timer: max. 2 bytes delay plus slave response space. Loop must be affected by blocking
+  uint32_t limit = 2 * 10 * 1000000L / LIN_BAUDRATE + SLAVE_SPACE + SLAVE_JITTER;
+  errors += (excessTimer > limit);
+  errors += ((errLoop == 0) && (excessLoop <= limit));
+
+  // nested lock keeps interrupts disabled until outermost unlock()
+  uint32_t errLock = 0;
+  Timer.lock();
+  Timer.lock();
+  Timer.unlock();
+  errLock += interruptsEnabled();
+  Timer.unlock();
+  errLock += !interruptsEnabled();
+
+  // lock with interrupts already disabled, e.g. in other ISR, doesn't enable them
+  noInterrupts();
+  Timer.lock();
+  Timer.unlock();
+  errLock += interruptsEnabled();
+  interrupts();
+  printf("lock/unlock errors=%u\n", (unsigned) errLock);
+  errors += errLock;
+
+  // return error code
+  return (errors != 0);
+
+} // main()
@@ -0,0 +1,160 @@
+/*********************
+
+Host benchmark for LIN master via HardwareSerial in background operation
+
+Sends alternating master request and slave response frames to a simulated slave and measures
+the latency from starting a frame until STATE_DONE, compared to the nominal frame duration.
+handler() is called as fast as possible. Returns 1 on any echo/checksum error or data mismatch.
+Timeouts are only counted, as the wall clock based mock may be preempted by the OS.
+Afterwards every n-th echo byte is corrupted (noisy bus) to measure how early erroneous frames are aborted.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_slave_host.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NUM_FRAMES        200             // number of frames per type
+#define ECHO_ERROR_PERIOD 13              // corrupt every n-th echo byte on noisy bus
+
+
+/// latency statistics for one frame type
+typedef struct
+{
+  uint32_t  num;                          // number of frames
+  uint32_t  numErr;                       // number of erroneous frames (excl. timeout)
+  uint32_t  numTimeout;                   // number of frame timeouts
+  uint32_t  min;                          // min. latency [us]
+  uint32_t  max;                          // max. latency [us]
+  uint64_t  sum;                          // sum of latencies [us]
+  uint64_t  sumErr;                       // sum of latencies of erroneous frames [us]
+  uint64_t  calls;                        // sum of handler() calls
+} stats_t;
+
+
+// LIN master and simulated slave on Serial1
+LIN_Master_HardwareSerial   LIN(Serial1, "Master");
+LIN_Slave_Host              Slave(LIN_BAUDRATE);
+
+
+// run one frame in background operation and update statistics
+static void runFrame(bool Request, stats_t &Stats)
+{
+  uint8_t                   Tx[4] = {0x01, 0x02, 0x03, 0x04};
+  uint8_t                   Rx[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+  LIN_Master_Base::frame_t  Type;
+  uint8_t                   Id;
+  uint8_t                   NumData;
+  uint8_t                   Data[8];
+  uint32_t                  calls = 0;
+
+  // start frame
+  uint32_t tStart = micros();
+  if (Request)
+    LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, 4, Tx);
+  else
+    LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, 6);
+
+  // call handler as fast as possible until frame is done
+  while (LIN.handler() != LIN_Master_Base::STATE_DONE)
+    calls++;
+  uint32_t latency = micros() - tStart;
+
+  // check result
+  LIN.getFrame(Type, Id, NumData, Data);
+  LIN_Master_Base::error_t error = LIN.getError();
+  bool err = ((error & ~LIN_Master_Base::ERROR_TIMEOUT) != 0);
+  if ((!Request) && (error == LIN_Master_Base::NO_ERROR) && ((NumData != 6) || (memcmp(Data, Rx, 6) != 0)))
+    err = true;
+
+  // update statistics
+  Stats.num++;
+  Stats.numErr += err;
+  Stats.numTimeout += ((error & LIN_Master_Base::ERROR_TIMEOUT) != 0);
+  Stats.sum += latency;
+  Stats.sumErr += (err) ? latency : 0;
+  Stats.calls += calls + 1;
+  if ((Stats.num == 1) || (latency < Stats.min))
+    Stats.min = latency;
+  if (latency > Stats.max)
+    Stats.max = latency;
+
+  // aborted frame -> wait until rest of frame has passed the bus
+  if (error != LIN_Master_Base::NO_ERROR)
+    delay(10);
+
+  // prepare next frame
+  LIN.resetStateMachine();
+  LIN.resetError();
+
+} // runFrame()
+
+
+// print statistics for one frame type
+static void printStats(const char *Name, const stats_t &Stats, uint32_t NumBytes)
+{
+  uint32_t nominal = NumBytes * ((10000000UL + LIN_BAUDRATE/2) / LIN_BAUDRATE);
+
+  printf("%-16s frames=%-5u errors=%-3u timeouts=%-3u nominal=%5uus  latency min/avg/max=%5u/%5u/%5uus  handler calls/frame=%u\n",
+    Name, (unsigned) Stats.num, (unsigned) Stats.numErr, (unsigned) Stats.numTimeout, (unsigned) nominal, (unsigned) Stats.min,
+    (unsigned) (Stats.sum / Stats.num), (unsigned) Stats.max, (unsigned) (Stats.calls / Stats.num));
+
+} // printStats()
+
+
+// print latency of erroneous frames for one frame type
+static void printAbort(const char *Name, const stats_t &Stats, uint32_t NumBytes)
+{
+  uint32_t nominal = NumBytes * ((10000000UL + LIN_BAUDRATE/2) / LIN_BAUDRATE);
+
+  printf("%-16s frames=%-5u errors=%-3u nominal=%5uus  latency avg=%5uus  erroneous frames avg=%5uus (%3u%% of nominal)\n",
+    Name, (unsigned) Stats.num, (unsigned) Stats.numErr, (unsigned) nominal, (unsigned) (Stats.sum / Stats.num),
+    (unsigned) ((Stats.numErr > 0) ? Stats.sumErr / Stats.numErr : 0),
+    (unsigned) ((Stats.numErr > 0) ? 100 * Stats.sumErr / Stats.numErr / nominal : 0));
+
+} // printAbort()
+
+
+int main(void)
+{
+  stats_t   request  = stats_t();
+  stats_t   response = stats_t();
+  stats_t   noisyReq = stats_t();
+  stats_t   noisyRes = stats_t();
+  uint8_t   Rx[6]    = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+
+  // attach slave model and open LIN interface
+  Slave.setResponse(0x05, 6, Rx);
+  Serial1.attach(&Slave);
+  LIN.begin(LIN_BAUDRATE);
+
+  // run frames
+  for (uint16_t i = 0; i < NUM_FRAMES; i++)
+  {
+    runFrame(true, request);
+    runFrame(false, response);
+  }
+
+  // print results. Nominal duration: BREAK (2 bytes at half baudrate) + SYNC + PID + DATA + CHK
+  printf("LIN_Master_HardwareSerial @ %u Baud\n", (unsigned) LIN_BAUDRATE);
+  printStats("master request", request, 2 + 2 + 4 + 1);
+  printStats("slave response", response, 2 + 2 + 6 + 1);
+
+  // noisy bus: erroneous frames are aborted on 1st echo mismatch
+  Serial1.setEchoError(ECHO_ERROR_PERIOD);
+  for (uint16_t i = 0; i < NUM_FRAMES; i++)
+  {
+    runFrame(true, noisyReq);
+    runFrame(false, noisyRes);
+  }
+  Serial1.setEchoError(0);
+  printf("noisy bus, every %u. echo byte corrupted\n", (unsigned) ECHO_ERROR_PERIOD);
+  printAbort("master request", noisyReq, 2 + 2 + 4 + 1);
+  printAbort("slave response", noisyRes, 2 + 2 + 6 + 1);
+
+  // return error code (noisy bus excluded)
+  return ((request.numErr + response.numErr) != 0);
+
+} // main()
@@ -0,0 +1,138 @@
+/*********************
+
+Host benchmark for binary trace
+
+Measures the cost of a trace entry compared to formatting a DEBUG_PRINT message via snprintf() (w/o serial output).
+Then runs a master request, a slave response and a frame with echo error, drains the trace via getTrace() and
+stores it in build/LIN_trace.bin. Decode with: build/LIN_trace_decode build/LIN_trace.bin
+Requires LIN_MASTER_TRACE, see Makefile. Returns 1 on unexpected frame result or missing trace events.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_slave_host.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NUM_LOOPS         1000000         // number of loops for cost measurement
+#define TRACE_FILE        "build/LIN_trace.bin"
+
+
+#if defined(LIN_MASTER_TRACE)
+
+/// LIN master with access to trace for cost measurement
+class LIN_Master_Trace : public LIN_Master_HardwareSerial
+{
+  public:
+
+    LIN_Master_Trace(HardwareSerial &Interface, const char NameLIN[]) : LIN_Master_HardwareSerial(Interface, NameLIN) { }
+
+    __attribute__((noinline)) void traceEvent(uint8_t Arg)
+    {
+      LIN_TRACE(LIN_Master_Base::TRACE_RX, Arg, Arg);
+    }
+};
+
+
+// LIN master and simulated slave on Serial1
+LIN_Master_Trace            LIN(Serial1, "Master");
+LIN_Slave_Host              Slave(LIN_BAUDRATE);
+
+// keep result of debug formatting
+volatile int                sink;
+
+
+// format debug message like DEBUG_PRINT (w/o serial output)
+__attribute__((noinline)) static int debugFormat(uint8_t Arg)
+{
+  char debug_buf[LIN_MASTER_DEBUG_BUFSIZE];
+  snprintf(debug_buf, sizeof(debug_buf), "%s: %s: echo error: Tx[%d]=0x%02X, Rx[%d]=0x%02X", LIN.nameLIN, __PRETTY_FUNCTION__,
+    (int) Arg, (int) Arg, (int) Arg, (int) Arg);
+  return debug_buf[0];
+}
+
+
+int main(void)
+{
+  uint8_t                   Tx[4] = {0x01, 0x02, 0x03, 0x04};
+  uint8_t                   Rx[6] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+  LIN_Master_Base::trace_t  trace[LIN_MASTER_TRACE_SIZE];
+  uint32_t                  start;
+  bool                      err = false;
+
+  // attach slave model and open LIN interface
+  Slave.setResponse(0x05, 6, Rx);
+  Serial1.attach(&Slave);
+  LIN.begin(LIN_BAUDRATE);
+
+
+  ///////////////
+  // cost of trace entry vs. formatted debug message
+  ///////////////
+  start = micros();
+  for (uint32_t i = 0; i < NUM_LOOPS; i++)
+    LIN.traceEvent((uint8_t) i);
+  uint32_t timeTrace = micros() - start;
+
+  start = micros();
+  for (uint32_t i = 0; i < NUM_LOOPS; i++)
+    sink = debugFormat((uint8_t) i);
+  uint32_t timeDebug = micros() - start;
+
+  printf("binary trace entry     %6.1f ns\n", 1000.0 * timeTrace / NUM_LOOPS);
+  printf("snprintf debug message %6.1f ns (w/o serial output)\n", 1000.0 * timeDebug / NUM_LOOPS);
+
+  // discard measurement entries
+  while (LIN_Master_Base::getTrace(trace, LIN_MASTER_TRACE_SIZE) > 0);
+
+
+  ///////////////
+  // trace some frames
+  ///////////////
+  err |= (LIN.sendMasterRequestBlocking(LIN_Master_Base::LIN_V2, 0x1A, 4, Tx) != LIN_Master_Base::NO_ERROR);
+  LIN.resetStateMachine();
+  err |= (LIN.receiveSlaveResponseBlocking(LIN_Master_Base::LIN_V2, 0x05, 6, Rx) != LIN_Master_Base::NO_ERROR);
+  LIN.resetStateMachine();
+  Serial1.setEchoError(5);
+  err |= (LIN.sendMasterRequestBlocking(LIN_Master_Base::LIN_V2, 0x1A, 4, Tx) != LIN_Master_Base::ERROR_ECHO);
+  Serial1.setEchoError(0);
+  LIN.resetStateMachine();
+  LIN.resetError();
+
+  // drain trace and store to file
+  uint16_t num = LIN_Master_Base::getTrace(trace, LIN_MASTER_TRACE_SIZE);
+  FILE *fp = fopen(TRACE_FILE, "wb");
+  if (fp != NULL)
+  {
+    fwrite(trace, sizeof(LIN_Master_Base::trace_t), num, fp);
+    fclose(fp);
+  }
+  printf("%u trace entries for 3 frames stored in %s\n", (unsigned) num, TRACE_FILE);
+
+  // check frames and trace: 3x START and 1x echo error expected
+  uint8_t numStart = 0, numEcho = 0;
+  for (uint16_t i = 0; i < num; i++)
+  {
+    numStart += (trace[i].event == LIN_Master_Base::TRACE_START);
+    numEcho  += (trace[i].event == LIN_Master_Base::TRACE_ERR_ECHO);
+  }
+  if (err || (numStart != 3) || (numEcho != 1) || (sizeof(LIN_Master_Base::trace_t) != 8))
+  {
+    printf("error: frame result %d, %u starts, %u echo errors\n", (int) err, (unsigned) numStart, (unsigned) numEcho);
+    return 1;
+  }
+
+  return 0;
+
+} // main()
+
+#else // LIN_MASTER_TRACE
+
+int main(void)
+{
+  printf("binary trace disabled (LIN_MASTER_TRACE)\n");
+  return 0;
+}
+
+#endif // LIN_MASTER_TRACE
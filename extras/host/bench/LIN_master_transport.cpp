@@ -0,0 +1,152 @@
+/*********************
+
+Host benchmark for the diagnostic transport layer
+
+Runs diagnostic transfers against a simulated slave with transport layer on a simulated bus (virtual time):
+single frame request and response, 4095 byte echo with segmented request and response, "response pending",
+slave processing time, functional request without response and a request to a wrong NAD. Also measures the
+request throughput for back-to-back consecutive frames and with a min. separation time, compared to the bus limit.
+Returns 1 on any unexpected transfer result, data mismatch or PCI error detected by the slave.
+
+**********************/
+
+// include files
+#include <LIN_master_HardwareSerial.h>
+#include <LIN_master_Transport.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_tp.h>
+
+// benchmark parameters
+#define LIN_BAUDRATE      19200           // LIN baudrate [Baud]
+#define NAD               0x0A            // node address of slave
+#define STMIN             10000           // separation time for throughput comparison [us]
+
+
+// simulated bus with one slave
+LIN_Bus_Host                Bus(LIN_BAUDRATE);
+LIN_Slave_TP                Slave(NAD);
+
+// LIN master and transport layer
+LIN_Master_HardwareSerial   LIN(Serial1, "Diag");
+LIN_Master_Transport        TP(LIN);
+
+// request and response buffers
+uint8_t   Request[LIN_MASTER_TP_MAX_LEN];
+uint8_t   Response[LIN_MASTER_TP_MAX_LEN];
+
+
+// run transfer until done. Return transport layer error and duration [us]
+static LIN_Master_Transport::error_t transfer(uint8_t Nad, uint16_t Len, uint8_t *Resp, uint16_t Size, uint32_t &Duration)
+{
+  uint32_t  start = micros();
+  uint32_t  deadline;
+
+  if (!TP.request(Nad, Request, Len, Resp, Size))
+    return TP.getError();
+  while (TP.handler() != LIN_Master_Transport::TP_DONE)
+  {
+    if (TP.getDeadline(deadline))
+      scheduleTime(deadline);
+    yield();
+  }
+  Duration = micros() - start;
+  return TP.getError();
+}
+
+
+// check echo response of last transfer
+static bool checkEcho(uint16_t Len)
+{
+  return (TP.getLength() == Len) && (Response[0] == Request[0] + 0x40) && (memcmp(Response+1, Request+1, Len-1) == 0);
+}
+
+
+int main(void)
+{
+  LIN_Master_Transport::timing_t    timing;
+  LIN_Master_Transport::error_t     err;
+  uint32_t                          duration, durationSTmin, deadline;
+  uint32_t                          errors = 0;
+
+  // virtual time for fast simulation. Before connecting bus, which stores time stamps
+  setVirtualTime(true);
+  Bus.addSlave(Slave);
+  Serial1.connect(&Bus);
+  LIN.begin(LIN_BAUDRATE);
+
+  // request pattern with SID 0x36 (transfer data)
+  Request[0] = 0x36;
+  for (uint16_t i = 1; i < LIN_MASTER_TP_MAX_LEN; i++)
+    Request[i] = (uint8_t) (i * 7 + (i >> 8));
+
+  // single frame request and response
+  err = transfer(NAD, 3, Response, sizeof(Response), duration);
+  errors += (err != LIN_Master_Transport::TP_NO_ERROR) || !checkEcho(3);
+  printf("single frame:       error=0x%02X  len=%-4u  %6.1f ms\n", (int) err, (unsigned) TP.getLength(), duration / 1000.0);
+
+  // request while transfer is ongoing is rejected
+  TP.request(NAD, Request, 3, Response, sizeof(Response));
+  errors += TP.request(NAD, Request, 3, Response, sizeof(Response));
+  while (TP.handler() != LIN_Master_Transport::TP_DONE)
+  {
+    if (TP.getDeadline(deadline))
+      scheduleTime(deadline);
+    yield();
+  }
+
+  // max. length echo, i.e. 683 request and response frames
+  err = transfer(NAD, LIN_MASTER_TP_MAX_LEN, Response, sizeof(Response), duration);
+  errors += (err != LIN_Master_Transport::TP_NO_ERROR) || !checkEcho(LIN_MASTER_TP_MAX_LEN);
+  printf("4095 byte echo:     error=0x%02X  len=%-4u  %6.1f ms\n", (int) err, (unsigned) TP.getLength(), duration / 1000.0);
+
+  // response too long for buffer
+  err = transfer(NAD, 100, Response, 50, duration);
+  errors += (err != LIN_Master_Transport::TP_ERROR_LENGTH);
+  printf("buffer too small:   error=0x%02X\n", (int) err);
+
+  // slave processing time 20ms and 2x "response pending"
+  Slave.setProcessTime(20000, 2);
+  err = transfer(NAD, 20, Response, sizeof(Response), duration);
+  errors += (err != LIN_Master_Transport::TP_NO_ERROR) || !checkEcho(20);
+  printf("response pending:   error=0x%02X  len=%-4u  %6.1f ms  (unanswered polls=%u)\n", (int) err,
+    (unsigned) TP.getLength(), duration / 1000.0, (unsigned) Slave.numNotReady);
+  Slave.setProcessTime(0, 0);
+
+  // wrong NAD is not answered -> timeout after P2max (no response pending in slave)
+  timing = TP.getTiming();
+  timing.P2max = 100000;
+  TP.setTiming(timing);
+  err = transfer(NAD+1, 3, Response, sizeof(Response), duration);
+  errors += (err != LIN_Master_Transport::TP_ERROR_TIMEOUT);
+  printf("wrong NAD:          error=0x%02X            %6.1f ms\n", (int) err, duration / 1000.0);
+
+  // functional request to all slaves without response
+  err = transfer(LIN_MASTER_TP_NAD_BROADCAST, 2, NULL, 0, duration);
+  errors += (err != LIN_Master_Transport::TP_NO_ERROR);
+  printf("broadcast:          error=0x%02X            %6.1f ms\n", (int) err, duration / 1000.0);
+
+  // request throughput w/o response, back-to-back and with separation time
+  transfer(NAD, LIN_MASTER_TP_MAX_LEN, NULL, 0, duration);
+  timing.STmin = STMIN;
+  TP.setTiming(timing);
+  transfer(NAD, LIN_MASTER_TP_MAX_LEN, NULL, 0, durationSTmin);
+  LIN.end();
+
+  // bus limit: 6 bytes per frame with 8 data bytes (34 bit header + 9 bytes of 10 bit)
+  double limit = 6.0 * LIN_BAUDRATE / (34 + 9 * 10);
+  double rate = 1000000.0 * LIN_MASTER_TP_MAX_LEN / duration;
+  double rateSTmin = 1000000.0 * LIN_MASTER_TP_MAX_LEN / durationSTmin;
+  errors += (rate < 0.9 * limit);
+  printf("request throughput @ %u Baud: bus limit %.0f B/s\n", (unsigned) LIN_BAUDRATE, limit);
+  printf("  ST_min = 0:      %6.0f B/s (%.1f%%)\n", rate, 100.0 * rate / limit);
+  printf("  ST_min = %2ums:   %6.0f B/s (%.1f%%)\n", (unsigned) (STMIN / 1000), rateSTmin, 100.0 * rateSTmin / limit);
+
+  // slave statistics
+  errors += Slave.numDiagErrors;
+  printf("slave: requests=%u responses=%u PCI errors=%u -> errors=%u\n", (unsigned) Slave.numDiagRequests,
+    (unsigned) Slave.numDiagResponses, (unsigned) Slave.numDiagErrors, (unsigned) errors);
+
+  // return error code
+  return (errors != 0);
+
+} // main()
@@ -0,0 +1,634 @@
+/**
+  \file     Arduino.cpp
+  \brief    Minimal Arduino core for host (Linux) builds of the LIN master library
+  \details  Time functions use the monotonic system clock relative to program start or optionally a virtual clock.
+            The virtual clock is a discrete-event time source: each time query advances it by HOST_CLOCK_STEP (i.e.
+            execution time), delay() jumps to the end of the wait time, and yield() (i.e. idle) jumps to the earliest
+            registered deadline, see scheduleTime(). Waits therefore take no real time, and e.g. 24h of bus traffic
+            can be simulated in about a minute. GPIOs are only stored.
+            The simulated one-shot timer doesn't preempt the program at arbitrary points. Its ISR is called when the
+            program waits, i.e. in yield() and delay(), or when interrupts are enabled again. For the virtual clock,
+            delay() advances time until the timer deadline, calls the ISR and continues, i.e. like a blocking sketch.
+            ISRs of simulated peripherals (e.g. UART receive interrupt) are polled at the same points and check themselves
+            for pending events. For the virtual clock, delay() stops at each registered deadline to poll them.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <Arduino.h>
+#include <time.h>
+
+
+/**************************
+ * LOCAL VARIABLES
+**************************/
+
+static uint8_t    pinLevel[HOST_NUM_PINS];      //!< last written GPIO levels
+static uint8_t    pinModes[HOST_NUM_PINS];      //!< last set GPIO modes
+static pinListener_t  pinListener[HOST_NUM_PINS];   //!< optional callback for output changes
+static void       *pinListenerArg[HOST_NUM_PINS];   //!< argument of optional callback
+
+static bool       virtualTime = false;          //!< use virtual clock instead of system clock
+static uint64_t   timeVirtual = 0;              //!< current virtual time [us]
+static uint32_t   idleVirtual = HOST_CLOCK_MAX_IDLE;    //!< max. virtual time [us] per yield() w/o pending deadline
+static uint16_t   numEvents = 0;                //!< number of pending deadlines
+static uint64_t   events[HOST_CLOCK_MAX_EVENTS];  //!< pending deadlines [us] as binary min-heap
+
+static timerCallback_t  timerCallback = NULL;   //!< ISR of simulated timer
+static void       *timerArg = NULL;             //!< argument of timer ISR
+static bool       timerActive = false;          //!< simulated timer is started
+static uint32_t   timerTime = 0;                //!< micros() at which timer ISR is called
+static bool       irqEnabled = true;            //!< interrupts are enabled, see noInterrupts()
+static bool       irqActive = false;            //!< timer or peripheral ISR is being executed
+static uint8_t    numIrq = 0;                   //!< number of attached peripheral ISRs
+static irqCallback_t  irqCallback[HOST_NUM_IRQ];  //!< ISRs of simulated peripherals
+static void       *irqArg[HOST_NUM_IRQ];        //!< arguments of peripheral ISRs
+
+
+/**************************
+ * LOCAL FUNCTIONS
+**************************/
+
+/**
+  \brief      Nanoseconds since program start
+  \details    Nanoseconds since program start, using the monotonic system clock
+  \return     time [ns] since first call
+*/
+static uint64_t _nanos(void)
+{
+  static uint64_t   timeStart = 0;
+  struct timespec   ts;
+
+  // get monotonic time
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  uint64_t now = (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+
+  // relative to first call
+  if (timeStart == 0)
+    timeStart = now;
+  return now - timeStart;
+
+} // _nanos()
+
+// initialize time base at program start, not at first use
+static const uint64_t timeInit = _nanos();
+
+
+
+/**
+  \brief      Remove earliest deadline of virtual clock
+  \details    Remove earliest deadline from binary min-heap of virtual clock
+*/
+static void _popEvent(void)
+{
+  uint16_t  pos = 0;
+
+  // move last element to root and sift down
+  events[0] = events[--numEvents];
+  while (true)
+  {
+    uint16_t child = 2*pos + 1;
+    if (child >= numEvents)
+      break;
+    if ((child + 1 < numEvents) && (events[child+1] < events[child]))
+      child++;
+    if (events[pos] <= events[child])
+      break;
+    uint64_t tmp = events[pos];
+    events[pos] = events[child];
+    events[child] = tmp;
+    pos = child;
+  }
+
+} // _popEvent()
+
+
+
+/**
+  \brief      Current time in microseconds
+  \details    Current time in microseconds of system clock or virtual clock. Each query advances the virtual clock by
+              HOST_CLOCK_STEP, which models the execution time of code and guarantees progress of busy waits
+  \return     time [us] since program start or virtual start time
+*/
+static uint64_t _micros64(void)
+{
+  // system clock
+  if (!virtualTime)
+    return _nanos() / 1000ULL;
+
+  // virtual clock
+  timeVirtual += HOST_CLOCK_STEP;
+  return timeVirtual;
+
+} // _micros64()
+
+
+
+/**
+  \brief      Call ISR of simulated timer, if due
+  \details    Call ISR of simulated timer, if timer is started, its deadline has passed, interrupts are enabled and
+              the ISR is not already executing. Like on AVR, interrupts are disabled during the ISR
+*/
+static void _serviceTimer(void)
+{
+  // timer stopped, interrupts disabled or nested call -> do nothing
+  if ((!timerActive) || (!irqEnabled) || (irqActive) || (timerCallback == NULL))
+    return;
+
+  // deadline not yet reached. Don't advance virtual clock for this check
+  uint32_t now = virtualTime ? (uint32_t) timeVirtual : (uint32_t) (_nanos() / 1000ULL);
+  if ((int32_t) (now - timerTime) < 0)
+    return;
+
+  // call one-shot ISR with interrupts disabled
+  timerActive = false;
+  irqActive   = true;
+  irqEnabled  = false;
+  timerCallback(timerArg);
+  irqEnabled  = true;
+  irqActive   = false;
+
+} // _serviceTimer()
+
+
+
+/**
+  \brief      Call ISRs of simulated peripherals
+  \details    Call ISRs of simulated peripherals, if interrupts are enabled and no ISR is executing. Each ISR checks
+              itself for pending events, e.g. received bytes. Like on AVR, interrupts are disabled during the ISR
+*/
+static void _serviceIrq(void)
+{
+  // interrupts disabled or nested call -> do nothing
+  if ((!irqEnabled) || (irqActive))
+    return;
+
+  // poll all peripherals with interrupts disabled
+  irqActive  = true;
+  irqEnabled = false;
+  for (uint8_t i = 0; i < numIrq; i++)
+    irqCallback[i](irqArg[i]);
+  irqEnabled = true;
+  irqActive  = false;
+
+} // _serviceIrq()
+
+
+
+/**
+  \brief      Advance virtual clock and call timer ISR on the way
+  \details    Advance virtual clock to the specified time. If the simulated timer expires until then, the clock stops
+              at the timer deadline for calling the ISR, which may restart the timer
+  \param[in]  End     virtual time [us] to advance to
+*/
+static void _advanceTimer(uint64_t End)
+{
+  // call ISR at each timer deadline until end time
+  while ((timerActive) && (irqEnabled) && (!irqActive) && (timerCallback != NULL))
+  {
+    int32_t diff = (int32_t) (timerTime - (uint32_t) timeVirtual);
+    if ((diff > 0) && (timeVirtual + (uint64_t) diff > End))
+      break;
+    if (diff > 0)
+      timeVirtual += (uint64_t) diff;
+    _serviceTimer();
+  }
+
+  // advance to end time
+  if (End > timeVirtual)
+    timeVirtual = End;
+
+} // _advanceTimer()
+
+
+
+/**
+  \brief      Advance virtual clock and call timer and peripheral ISRs on the way
+  \details    Advance virtual clock to the specified time, see _advanceTimer(). If peripheral ISRs are attached, the
+              clock additionally stops at each registered deadline (e.g. reception of a byte) for polling them
+  \param[in]  End     virtual time [us] to advance to
+*/
+static void _advanceVirtual(uint64_t End)
+{
+  // stop at each deadline until end time for peripheral ISRs
+  while ((numIrq > 0) && (irqEnabled) && (!irqActive))
+  {
+    while ((numEvents > 0) && (events[0] <= timeVirtual))
+      _popEvent();
+    if ((numEvents == 0) || (events[0] >= End))
+      break;
+    _advanceTimer(events[0]);
+    _serviceIrq();
+  }
+
+  // advance to end time
+  _advanceTimer(End);
+  _serviceIrq();
+
+} // _advanceVirtual()
+
+
+
+/**************************
+ * GLOBAL FUNCTIONS
+**************************/
+
+/**
+  \brief      Microseconds since program start
+  \details    Microseconds since program start. Truncated to 32-bit like on AVR, i.e. wraps around after ~71.6min
+  \return     time [us]
+*/
+uint32_t micros(void)
+{
+  return (uint32_t) _micros64();
+
+} // micros()
+
+
+
+/**
+  \brief      Milliseconds since program start
+  \details    Milliseconds since program start. Truncated to 32-bit like on AVR
+  \return     time [ms]
+*/
+uint32_t millis(void)
+{
+  return (uint32_t) (_micros64() / 1000ULL);
+
+} // millis()
+
+
+
+/**
+  \brief      Busy wait for specified number of milliseconds
+  \details    Busy wait for specified number of milliseconds. The virtual clock jumps to the end of the wait time.
+              ISRs of simulated timer and peripherals are called on the way
+  \param[in]  ms    wait time [ms]
+*/
+void delay(uint32_t ms)
+{
+  // virtual clock -> jump, but stop for ISRs
+  if (virtualTime)
+  {
+    _advanceVirtual(timeVirtual + (uint64_t) ms * 1000ULL);
+    return;
+  }
+
+  uint32_t start = micros();
+  while (micros() - start < ms * 1000UL)
+  {
+    _serviceTimer();
+    _serviceIrq();
+  }
+
+} // delay()
+
+
+
+/**
+  \brief      Busy wait for specified number of microseconds
+  \details    Busy wait for specified number of microseconds. The virtual clock jumps to the end of the wait time.
+              ISRs of simulated timer and peripherals are called on the way
+  \param[in]  us    wait time [us]
+*/
+void delayMicroseconds(uint32_t us)
+{
+  // virtual clock -> jump, but stop for ISRs
+  if (virtualTime)
+  {
+    _advanceVirtual(timeVirtual + us);
+    return;
+  }
+
+  uint32_t start = micros();
+  while (micros() - start < us)
+  {
+    _serviceTimer();
+    _serviceIrq();
+  }
+
+} // delayMicroseconds()
+
+
+
+/**
+  \brief      Pass control while idle
+  \details    Pass control while idle, e.g. in a main loop while no LIN frame requires handling. For the system clock
+              only a due timer ISR is called. The virtual clock jumps to the earliest pending deadline (see scheduleTime()),
+              but at most by the max. idle time. Deadlines until then are removed. A due timer ISR is called before and after,
+              and peripheral ISRs are polled likewise
+*/
+void yield(void)
+{
+  // call due timer ISR and poll peripherals
+  _serviceTimer();
+  _serviceIrq();
+
+  // system clock
+  if (!virtualTime)
+    return;
+
+  // remove passed deadlines
+  while ((numEvents > 0) && (events[0] <= timeVirtual))
+    _popEvent();
+
+  // jump to next deadline or by max. idle time
+  uint64_t next = timeVirtual + idleVirtual;
+  if ((numEvents > 0) && (events[0] < next))
+    next = events[0];
+  timeVirtual = next;
+
+  // call timer ISR and poll peripherals at new time
+  _serviceTimer();
+  _serviceIrq();
+
+} // yield()
+
+
+
+/**
+  \brief      Set GPIO mode
+  \details    Set GPIO mode. Only stored, as host has no GPIOs
+  \param[in]  pin     pin number
+  \param[in]  mode    INPUT, OUTPUT or INPUT_PULLUP
+*/
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  if (pin < HOST_NUM_PINS)
+    pinModes[pin] = mode;
+
+} // pinMode()
+
+
+
+/**
+  \brief      Set GPIO output level
+  \details    Set GPIO output level. Only stored, as host has no GPIOs
+  \param[in]  pin     pin number
+  \param[in]  val     LOW or HIGH
+*/
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  if (pin < HOST_NUM_PINS)
+  {
+    pinLevel[pin] = (val != LOW);
+    if (pinListener[pin] != NULL)
+      pinListener[pin](pin, pinLevel[pin], pinListenerArg[pin]);
+  }
+
+} // digitalWrite()
+
+
+
+/**
+  \brief      Read GPIO level
+  \details    Read GPIO level. Returns last written level
+  \param[in]  pin     pin number
+  \return     LOW or HIGH
+*/
+int digitalRead(uint8_t pin)
+{
+  if (pin < HOST_NUM_PINS)
+    return pinLevel[pin];
+  return LOW;
+
+} // digitalRead()
+
+
+
+/**
+  \brief      Notify about GPIO output changes
+  \details    Notify about GPIO output changes. Host only, e.g. to drive a simulated LIN bus
+  \param[in]  pin       pin number
+  \param[in]  listener  callback called by digitalWrite() (NULL = none)
+  \param[in]  arg       argument passed to callback
+*/
+void attachPinListener(uint8_t pin, pinListener_t listener, void *arg)
+{
+  if (pin < HOST_NUM_PINS)
+  {
+    pinListener[pin]    = listener;
+    pinListenerArg[pin] = arg;
+  }
+
+} // attachPinListener()
+
+
+
+/**
+  \brief      Switch between system clock and virtual clock
+  \details    Switch between system clock and virtual clock. Host only. Pending deadlines are discarded.
+              A start time close to 2^32us or 2^32ms allows to check micros() or millis() wrap-around early
+  \param[in]  Enable    true = use virtual clock, false = use system clock
+  \param[in]  Start     start time of virtual clock [us]
+  \param[in]  MaxIdle   max. advance [us] per yield() w/o pending deadline, e.g. while polling a timeout (min. 1)
+*/
+void setVirtualTime(bool Enable, uint64_t Start, uint32_t MaxIdle)
+{
+  virtualTime = Enable;
+  timeVirtual = Start;
+  idleVirtual = (MaxIdle > 0) ? MaxIdle : 1;
+  numEvents   = 0;
+
+} // setVirtualTime()
+
+
+
+/**
+  \brief      Virtual clock is active
+  \return     true if virtual clock is used, false if system clock is used
+*/
+bool isVirtualTime(void)
+{
+  return virtualTime;
+
+} // isVirtualTime()
+
+
+
+/**
+  \brief      Register deadline of virtual clock
+  \details    Register deadline, to which the virtual clock jumps in yield(), e.g. reception of a byte or
+              LIN_Master_Base::getDeadline(). Host only. Ignored for system clock, passed deadlines or if
+              HOST_CLOCK_MAX_EVENTS are pending. In the latter case the deadline is detected at most max. idle time late
+  \param[in]  Time      deadline [micros()], max. 2^31us ahead
+*/
+void scheduleTime(uint32_t Time)
+{
+  // system clock or heap full
+  if ((!virtualTime) || (numEvents >= HOST_CLOCK_MAX_EVENTS))
+    return;
+
+  // extend to 64-bit. Ignore passed deadline
+  int32_t diff = (int32_t) (Time - (uint32_t) timeVirtual);
+  if (diff <= 0)
+    return;
+  uint64_t time = timeVirtual + (uint64_t) diff;
+
+  // ignore duplicate, e.g. same LIN_Master_Base::getDeadline() in each loop
+  for (uint16_t i = 0; i < numEvents; i++)
+  {
+    if (events[i] == time)
+      return;
+  }
+
+  // append to heap and sift up
+  uint16_t pos = numEvents++;
+  events[pos] = time;
+  while ((pos > 0) && (events[(pos-1)/2] > events[pos]))
+  {
+    uint64_t tmp = events[pos];
+    events[pos] = events[(pos-1)/2];
+    events[(pos-1)/2] = tmp;
+    pos = (pos-1)/2;
+  }
+
+} // scheduleTime()
+
+
+
+/**
+  \brief      Attach ISR of simulated timer
+  \details    Attach ISR of simulated one-shot hardware timer. Host only. Timer is stopped
+  \param[in]  callback  ISR called at timer deadline (NULL = detach)
+  \param[in]  arg       argument passed to ISR
+*/
+void attachTimer(timerCallback_t callback, void *arg)
+{
+  timerActive   = false;
+  timerCallback = callback;
+  timerArg      = arg;
+
+} // attachTimer()
+
+
+
+/**
+  \brief      Start simulated one-shot timer
+  \details    Start simulated one-shot timer, replacing a pending deadline. Host only. The ISR is called once when the
+              program waits or enables interrupts at or after the deadline. For the virtual clock, the deadline is
+              registered via scheduleTime()
+  \param[in]  Time      deadline [micros()], max. 2^31us ahead. Passed deadline = call ISR as soon as possible
+*/
+void startTimer(uint32_t Time)
+{
+  timerTime   = Time;
+  timerActive = true;
+  scheduleTime(Time);
+
+} // startTimer()
+
+
+
+/**
+  \brief      Stop simulated one-shot timer
+  \details    Stop simulated one-shot timer, i.e. a pending ISR is not called. Host only
+*/
+void stopTimer(void)
+{
+  timerActive = false;
+
+} // stopTimer()
+
+
+
+/**
+  \brief      Attach ISR of simulated peripheral
+  \details    Attach ISR of simulated peripheral, e.g. UART receive interrupt. Host only. The ISR is polled like the
+              timer ISR, i.e. in yield(), delay() and interrupts(), and must check itself for pending events.
+              An ISR with the same argument is replaced. Ignored if HOST_NUM_IRQ ISRs are attached
+  \param[in]  callback  ISR polled for pending events
+  \param[in]  arg       argument passed to ISR, e.g. peripheral instance
+*/
+void attachIrq(irqCallback_t callback, void *arg)
+{
+  uint8_t   i;
+
+  // replace ISR with same argument or append
+  for (i = 0; (i < numIrq) && (irqArg[i] != arg); i++);
+  if (i >= HOST_NUM_IRQ)
+    return;
+  irqCallback[i] = callback;
+  irqArg[i]      = arg;
+  if (i == numIrq)
+    numIrq++;
+
+} // attachIrq()
+
+
+
+/**
+  \brief      Detach ISR of simulated peripheral
+  \details    Detach ISR of simulated peripheral with specified argument. Host only
+  \param[in]  arg       argument of attached ISR
+*/
+void detachIrq(void *arg)
+{
+  for (uint8_t i = 0; i < numIrq; i++)
+  {
+    if (irqArg[i] == arg)
+    {
+      irqCallback[i] = irqCallback[numIrq-1];
+      irqArg[i]      = irqArg[numIrq-1];
+      numIrq--;
+      return;
+    }
+  }
+
+} // detachIrq()
+
+
+
+/**
+  \brief      Disable interrupts
+  \details    Disable interrupts, i.e. ISRs of the simulated timer and peripherals are deferred until interrupts() is called
+*/
+void noInterrupts(void)
+{
+  irqEnabled = false;
+
+} // noInterrupts()
+
+
+
+/**
+  \brief      Enable interrupts
+  \details    Enable interrupts. Like on a real MCU, pending ISRs of the simulated timer and peripherals are called immediately
+*/
+void interrupts(void)
+{
+  irqEnabled = true;
+  _serviceTimer();
+  _serviceIrq();
+
+} // interrupts()
+
+
+
+/**
+  \brief      Interrupts are enabled
+  \details    Interrupts are enabled, i.e. not disabled via noInterrupts() and no ISR is executing. Host only
+  \return     true if interrupts are enabled
+*/
+bool interruptsEnabled(void)
+{
+  return irqEnabled;
+
+} // interruptsEnabled()
+
+
+
+/**
+  \brief      Microseconds without 32-bit wrap-around
+  \details    Microseconds since program start (system clock) or since virtual start time. Host only
+  \return     time [us]
+*/
+uint64_t micros64(void)
+{
+  return _micros64();
+
+} // micros64()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
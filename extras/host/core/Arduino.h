@@ -0,0 +1,159 @@
+/**
+  \file     Arduino.h
+  \brief    Minimal Arduino core for host (Linux) builds of the LIN master library
+  \details  This mock core provides just enough of the Arduino API to compile and run LIN_Master_Base and
+            LIN_Master_HardwareSerial on a plain Linux machine, e.g. for measuring latency or regression testing
+            without real boards. micros()/millis() use the monotonic system clock or optionally a virtual clock
+            (see setVirtualTime()), HardwareSerial models byte timing at the configured baudrate including the 1-wire
+            LIN echo (see HardwareSerial.h). A simulated one-shot hardware timer allows testing ISR-driven operation.
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _ARDUINO_HOST_H_
+#define _ARDUINO_HOST_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// standard C libraries, which are implicitly available on Arduino
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+// digital I/O
+#define LOW             0x0                       //!< pin level low
+#define HIGH            0x1                       //!< pin level high
+#define INPUT           0x0                       //!< pin mode input
+#define OUTPUT          0x1                       //!< pin mode output
+#define INPUT_PULLUP    0x2                       //!< pin mode input with pull-up
+
+// number formats for print()
+#define DEC             10                        //!< print decimal
+#define HEX             16                        //!< print hexadecimal
+#define BIN             2                         //!< print binary
+
+// strings are not stored in separate flash on host
+#define F(string_literal)     (string_literal)    //!< dummy flash string helper
+
+// constant tables are not stored in separate flash on host
+#define PROGMEM                                   //!< dummy flash attribute
+#define memcpy_P(dest, src, num)  memcpy((dest), (src), (num))  //!< dummy copy from flash
+#define pgm_read_byte(addr)   (*(const uint8_t*) (addr))  //!< dummy byte read from flash
+
+// number of emulated digital pins
+#define HOST_NUM_PINS   64                        //!< number of emulated GPIOs
+
+// virtual time
+#define HOST_CLOCK_MAX_EVENTS   256               //!< max. number of pending deadlines of virtual clock
+#define HOST_CLOCK_STEP         1                 //!< virtual time [us] per time query, i.e. execution time
+#define HOST_CLOCK_MAX_IDLE     100               //!< default max. virtual time [us] per yield() w/o pending deadline
+
+// simulated peripheral interrupts
+#define HOST_NUM_IRQ            4                 //!< max. number of attached peripheral ISRs, see attachIrq()
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// @brief Microseconds since program start. 32-bit like on AVR, i.e. wraps around after ~71.6min
+uint32_t micros(void);
+
+/// @brief Milliseconds since program start. 32-bit like on AVR, i.e. wraps around after ~49.7d
+uint32_t millis(void);
+
+/// @brief Busy wait for specified number of milliseconds
+void delay(uint32_t ms);
+
+/// @brief Busy wait for specified number of microseconds
+void delayMicroseconds(uint32_t us);
+
+/// @brief Pass control while idle. Virtual clock jumps to next deadline, see scheduleTime()
+void yield(void);
+
+/// @brief Set GPIO mode (stored only)
+void pinMode(uint8_t pin, uint8_t mode);
+
+/// @brief Set GPIO output level (stored only)
+void digitalWrite(uint8_t pin, uint8_t val);
+
+/// @brief Read GPIO level (last written level)
+int digitalRead(uint8_t pin);
+
+/// @brief Host only: callback for GPIO output changes, see attachPinListener()
+typedef void (*pinListener_t)(uint8_t pin, uint8_t val, void *arg);
+
+/// @brief Host only: notify about GPIO output changes, e.g. to drive a simulated LIN bus (NULL = none)
+void attachPinListener(uint8_t pin, pinListener_t listener, void *arg);
+
+/// @brief Host only: switch between system clock and virtual clock, starting at specified time [us]
+void setVirtualTime(bool Enable, uint64_t Start = 0, uint32_t MaxIdle = HOST_CLOCK_MAX_IDLE);
+
+/// @brief Host only: virtual clock is active
+bool isVirtualTime(void);
+
+/// @brief Host only: register deadline [micros()], to which the virtual clock jumps in yield(). Ignored for system clock
+void scheduleTime(uint32_t Time);
+
+/// @brief Host only: microseconds since program start (system clock) or virtual start, without 32-bit wrap-around
+uint64_t micros64(void);
+
+/// @brief Host only: ISR of simulated hardware timer, see attachTimer()
+typedef void (*timerCallback_t)(void *arg);
+
+/// @brief Host only: attach ISR of simulated one-shot hardware timer (NULL = detach)
+void attachTimer(timerCallback_t callback, void *arg);
+
+/// @brief Host only: start simulated one-shot timer. ISR is called at micros() Time in yield(), delay() or interrupts()
+void startTimer(uint32_t Time);
+
+/// @brief Host only: stop simulated one-shot timer
+void stopTimer(void);
+
+/// @brief Host only: ISR of simulated peripheral, e.g. UART receive interrupt, see attachIrq()
+typedef void (*irqCallback_t)(void *arg);
+
+/// @brief Host only: attach ISR of simulated peripheral. Is polled like the timer ISR and must check itself for pending events
+void attachIrq(irqCallback_t callback, void *arg);
+
+/// @brief Host only: detach ISR of simulated peripheral with specified argument
+void detachIrq(void *arg);
+
+/// @brief Disable interrupts, i.e. defer ISR of simulated timer and peripherals
+void noInterrupts(void);
+
+/// @brief Enable interrupts. Pending ISRs of simulated timer and peripherals are called immediately
+void interrupts(void);
+
+/// @brief Host only: interrupts are enabled, e.g. to restore interrupt state like SREG on AVR
+bool interruptsEnabled(void);
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES (require above definitions)
+-----------------------------------------------------------------------------*/
+
+// serial interfaces Serial, Serial1..3
+#include <HardwareSerial.h>
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _ARDUINO_HOST_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,956 @@
+/**
+  \file     HardwareSerial.cpp
+  \brief    Timing-accurate HardwareSerial mock for host (Linux) builds
+  \details  Each written byte occupies the transmitter for 10 bit times at the baudrate set in begin(). The byte
+            is echoed into the own receive buffer when its stop bit has been sent, like on a 1-wire LIN bus.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <HardwareSerial.h>
+
+
+/**************************
+ * GLOBAL VARIABLES
+**************************/
+
+HardwareSerial   Serial(true);       // console (stdout)
+HardwareSerial   Serial1;            // emulated UART 1
+HardwareSerial   Serial2;            // emulated UART 2
+HardwareSerial   Serial3;            // emulated UART 3
+HardwareSerial   Serial4;            // emulated UART 4
+
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Print unsigned number in specified base
+  \param[in]  Number    number to print
+  \param[in]  Base      number base (2..16)
+  \return     number of printed characters
+*/
+size_t HardwareSerial::_printNumber(unsigned long Number, int Base)
+{
+  char    buf[8 * sizeof(long) + 1];
+  char    *str = &buf[sizeof(buf) - 1];
+
+  // convert to string from least significant digit
+  if ((Base < 2) || (Base > 16))
+    Base = DEC;
+  *str = '\0';
+  do
+  {
+    uint8_t digit = Number % Base;
+    *--str = (char) (digit < 10 ? '0' + digit : 'A' + digit - 10);
+    Number /= Base;
+  } while (Number);
+
+  // print string
+  return this->print(str);
+
+} // HardwareSerial::_printNumber()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor
+  \param[in]  Console   print to stdout instead of emulating a UART
+*/
+HardwareSerial::HardwareSerial(bool Console)
+{
+  this->console    = Console;
+  this->isOpen     = false;
+  this->echo       = true;
+  this->echoErrorPeriod = 0;
+  this->echoCount  = 0;
+  this->baudrate   = 9600;
+  memset(&(this->usart), 0, sizeof(this->usart));
+  this->usart.BRR  = HOST_SERIAL_CLOCK / 9600;
+  this->huart.Instance = &(this->usart);
+  this->huart.hdmatx   = NULL;
+  this->huart.hdmarx   = NULL;
+  this->huart.gState   = HAL_UART_STATE_RESET;
+  this->huart.RxState  = HAL_UART_STATE_RESET;
+  this->huart.ReceptionType = HAL_UART_RECEPTION_STANDARD;
+  this->huart.pSerial  = this;
+  this->pDmaMem    = NULL;
+  this->lenDma     = 0;
+  this->numDma     = 0;
+  this->dmaHalf    = false;
+  this->dmaIdle    = false;
+  this->timeDma    = 0;
+  this->dmaTxBusy  = false;
+  this->baudRegBegin = this->usart.BRR;
+  this->baudRegEnabled = true;
+  this->timeBegin  = 0;
+  this->timeTxIdle = 0;
+  this->pListener  = NULL;
+  this->pBus       = NULL;
+  this->numRx      = 0;
+  this->numCoreIsr = 0;
+
+} // HardwareSerial::HardwareSerial()
+
+
+
+/**
+  \brief      Open interface with specified baudrate
+  \details    Open interface with specified baudrate. Like on AVR, pending bytes are not discarded
+  \param[in]  Baudrate  communication speed [Baud]
+  \param[in]  Config    ignored
+  \param[in]  PinRx     ignored
+  \param[in]  PinTx     ignored
+*/
+void HardwareSerial::begin(unsigned long Baudrate, uint32_t Config, int8_t PinRx, int8_t PinTx)
+{
+  (void) Config;
+  (void) PinRx;
+  (void) PinTx;
+
+  // simulated bus: decode pending bytes at old baudrate. After opening, only receive new bytes
+  if (this->pBus != NULL)
+  {
+    this->pBus->update(micros());
+    if (!this->isOpen)
+      this->pBus->resync(*this, micros());
+  }
+
+  // optionally model execution time, e.g. baudrate calculation
+  if (this->timeBegin > 0)
+    delayMicroseconds(this->timeBegin);
+
+  // set baudrate and baudrate register
+  this->baudrate     = (uint32_t) Baudrate;
+  this->usart.BRR    = (HOST_SERIAL_CLOCK + this->baudrate / 2) / this->baudrate;
+  this->usart.CR1    = USART_CR1_UE;                            // like HAL_UART_Init(), e.g. LIN mode off
+  this->usart.CR2    = 0;
+  this->usart.CR3    = 0;
+  this->baudRegBegin = this->usart.BRR;
+  this->huart.gState  = HAL_UART_STATE_READY;                 // like HAL_UART_Init()
+  this->huart.RxState = HAL_UART_STATE_READY;
+  this->isOpen       = true;
+
+} // HardwareSerial::begin()
+
+
+
+/**
+  \brief      Current baudrate
+  \details    Current baudrate. Host only. If the baudrate register was changed after begin(), the baudrate is scaled
+              by the ratio of register values, i.e. doubling the register exactly halves the baudrate like on a real UART
+  \return     baudrate [Baud]
+*/
+uint32_t HardwareSerial::getBaudrate(void)
+{
+  // register unchanged or invalid -> baudrate of begin()
+  uint32_t reg = this->usart.BRR;
+  if ((reg == this->baudRegBegin) || (reg == 0))
+    return this->baudrate;
+
+  return (uint32_t) (((uint64_t) this->baudrate * this->baudRegBegin) / reg);
+
+} // HardwareSerial::getBaudrate()
+
+
+
+/**
+  \brief      Close interface and discard received bytes
+*/
+void HardwareSerial::end(void)
+{
+  this->abortDMA(true, true);
+  detachIrq(&(this->huart));
+  this->huart.gState  = HAL_UART_STATE_RESET;
+  this->huart.RxState = HAL_UART_STATE_RESET;
+  this->isOpen = false;
+  this->numRx  = 0;
+
+} // HardwareSerial::end()
+
+
+
+/**
+  \brief      Number of bytes received until now
+  \return     number of bytes whose stop bit has been received
+*/
+int HardwareSerial::available(void)
+{
+  uint32_t  now = micros();
+  int       num = 0;
+
+  // simulated bus: decode bytes until now
+  if (this->pBus != NULL)
+    this->pBus->update(now);
+
+  // buffer is sorted by reception time
+  while ((num < this->numRx) && ((int32_t) (now - this->bufRx[num].time) >= 0))
+    num++;
+  return num;
+
+} // HardwareSerial::available()
+
+
+
+/**
+  \brief      Read next received byte
+  \return     received byte or -1 if none
+*/
+int HardwareSerial::read(void)
+{
+  // simulated bus: decode bytes until now
+  if (this->pBus != NULL)
+    this->pBus->update(micros());
+
+  // no byte received yet
+  if ((this->numRx == 0) || ((int32_t) (micros() - this->bufRx[0].time) < 0))
+    return -1;
+
+  // remove oldest byte from buffer
+  uint8_t data = this->bufRx[0].data;
+  this->numRx--;
+  memmove(this->bufRx, this->bufRx+1, this->numRx * sizeof(rxByte_t));
+  return data;
+
+} // HardwareSerial::read()
+
+
+
+/**
+  \brief      Read received bytes with timeout
+  \details    Read received bytes. Like Arduino Stream, wait up to HOST_SERIAL_TIMEOUT for missing bytes
+  \param[out] Buffer    received bytes
+  \param[in]  Length    number of bytes to read
+  \return     number of read bytes
+*/
+size_t HardwareSerial::readBytes(uint8_t *Buffer, size_t Length)
+{
+  uint32_t  start = millis();
+  size_t    num = 0;
+
+  while ((num < Length) && (millis() - start < HOST_SERIAL_TIMEOUT))
+  {
+    int c = this->read();
+    if (c >= 0)
+      Buffer[num++] = (uint8_t) c;
+  }
+  return num;
+
+} // HardwareSerial::readBytes()
+
+
+
+/**
+  \brief      Queue byte for transmission
+  \details    Queue byte for transmission. On target the byte is moved to TDR by the Tx ISR of the core
+  \param[in]  Data      byte to send
+  \return     number of queued bytes
+*/
+size_t HardwareSerial::write(uint8_t Data)
+{
+  if ((!this->console) && (this->isOpen))
+    this->numCoreIsr++;
+  return this->_transmit(Data);
+
+} // HardwareSerial::write()
+
+
+
+/**
+  \brief      Queue byte for transmission via write() or DMA
+  \details    Queue byte for transmission. The transmitter is busy for 10 bit times, then the byte is echoed
+  \param[in]  Data      byte to send
+  \return     number of queued bytes
+*/
+size_t HardwareSerial::_transmit(uint8_t Data)
+{
+  // console -> print to stdout
+  if (this->console)
+  {
+    putchar(Data);
+    return 1;
+  }
+
+  // closed interface doesn't send
+  if (!this->isOpen)
+    return 0;
+
+  // start after previous byte, end after start + 10 bit. Use 64-bit time, as transmitter may be idle for >2^31us
+  uint64_t now = micros64();
+  uint64_t timeStart64 = (this->timeTxIdle > now) ? this->timeTxIdle : now;
+  uint32_t baud = this->getBaudrate();
+  this->timeTxIdle = timeStart64 + (10000000ULL + baud/2) / baud;
+  uint32_t timeStart = (uint32_t) timeStart64;
+  uint32_t timeEnd = (uint32_t) this->timeTxIdle;
+  scheduleTime(timeEnd);
+
+  // simulated bus -> send bits. Echo is received via bus
+  if (this->pBus != NULL)
+    this->pBus->transmit(Data, baud, timeStart);
+
+  // 1-wire bus -> receive own byte, optionally corrupted
+  else if (this->echo)
+  {
+    uint8_t echo = Data;
+    if ((this->echoErrorPeriod > 0) && (++(this->echoCount) >= this->echoErrorPeriod))
+    {
+      this->echoCount = 0;
+      echo ^= 0x01;
+    }
+    this->inject(echo, timeEnd);
+  }
+
+  // notify optional observer, e.g. slave model
+  if (this->pListener != NULL)
+    this->pListener->onTransmit(*this, Data, baud, timeEnd);
+
+  return 1;
+
+} // HardwareSerial::_transmit()
+
+
+
+/**
+  \brief      Simulated UART and DMA interrupts of HAL transfers
+  \details    Simulated peripheral ISR, see attachIrq(). Completes DMA transmission when the transmitter is idle. Copies
+              received bytes to the receive DMA buffer and, like the HAL, calls HAL_UARTEx_RxEventCallback() at half
+              transfer, transfer complete and idle line (1 byte w/o reception). Like in normal DMA mode, reception stops
+              at transfer complete and idle. Each event is counted as interrupt, see getIsrCount()
+  \param[in]  Arg       HAL handle of serial interface
+*/
+void HardwareSerial::_serviceDMA(void *Arg)
+{
+  UART_HandleTypeDef  *huart  = (UART_HandleTypeDef*) Arg;
+  HardwareSerial      *serial = huart->pSerial;
+  bool                again   = true;
+
+  // repeat after each callback, which may start a new transfer
+  while (again)
+  {
+    again = false;
+
+    // transmission complete -> DMA transfer complete and USART transmission complete interrupt
+    if ((serial->dmaTxBusy) && (micros64() >= serial->timeTxIdle))
+    {
+      serial->abortDMA(true, false);
+      serial->numCoreIsr += 2;
+    }
+
+    // no reception via DMA
+    if ((serial->pDmaMem == NULL) || (!(serial->usart.CR3 & USART_CR3_DMAR)))
+      return;
+
+    // copy received bytes. Reception stops at transfer complete
+    while ((serial->numDma < serial->lenDma) && (serial->available() > 0))
+    {
+      serial->timeDma = serial->bufRx[0].time;
+      hostDcacheWrite(serial->pDmaMem + serial->numDma, (uint8_t) serial->read());
+      serial->numDma++;
+      serial->dmaIdle = true;
+
+      // transfer complete or half transfer -> notify
+      uint16_t num = serial->numDma;
+      if (num == serial->lenDma)
+        serial->abortDMA(false, true);
+      else if ((!serial->dmaHalf) && (num == serial->lenDma / 2))
+        serial->dmaHalf = true;
+      else
+        continue;
+      serial->numCoreIsr++;
+      HAL_UARTEx_RxEventCallback(huart, num);
+      again = true;
+      break;
+    }
+    if ((again) || (serial->pDmaMem == NULL))
+      continue;
+
+    // idle line for 1 byte after last reception -> notify, and in normal DMA mode stop reception
+    if ((serial->dmaIdle) && (serial->usart.CR1 & USART_CR1_IDLEIE))
+    {
+      uint32_t baud = serial->getBaudrate();
+      uint32_t timeIdle = serial->timeDma + (10000000UL + baud/2) / baud;
+      if ((int32_t) (micros() - timeIdle) >= 0)
+      {
+        uint16_t num = serial->numDma;
+        serial->abortDMA(false, true);
+        serial->numCoreIsr++;
+        HAL_UARTEx_RxEventCallback(huart, num);
+        again = true;
+      }
+      else
+        scheduleTime(timeIdle);
+    }
+  }
+
+} // HardwareSerial::_serviceDMA()
+
+
+
+/**
+  \brief      Queue break for transmission
+  \details    Queue break after previous byte, like STM32 RQR.SBKRQ. Break is 13 low bits in LIN mode (USART CR2.LINEN),
+              else 10 low bits, followed by a stop bit. W/o simulated bus, the break is echoed as 0x00 and reported to the
+              observer as 0x00 at a lower baudrate, i.e. with the same low time
+*/
+void HardwareSerial::sendBreak(void)
+{
+  // closed interface doesn't send
+  if ((this->console) || (!this->isOpen))
+    return;
+
+  // start after previous byte, end after low bits and stop bit
+  uint8_t  bits = (this->usart.CR2 & USART_CR2_LINEN) ? 13 : 10;
+  uint64_t now = micros64();
+  uint64_t timeStart64 = (this->timeTxIdle > now) ? this->timeTxIdle : now;
+  uint32_t baud = this->getBaudrate();
+  this->timeTxIdle = timeStart64 + ((bits + 1) * 1000000ULL + baud/2) / baud;
+  uint32_t timeStart = (uint32_t) timeStart64;
+  uint32_t timeEnd = (uint32_t) this->timeTxIdle;
+  scheduleTime(timeEnd);
+
+  // simulated bus -> send low bits. Echo is received via bus
+  if (this->pBus != NULL)
+    this->pBus->transmitBreak(bits, baud, timeStart);
+
+  // 1-wire bus -> receive 0x00
+  else if (this->echo)
+    this->inject(0x00, timeEnd);
+
+  // notify optional observer, e.g. slave model
+  if (this->pListener != NULL)
+    this->pListener->onTransmit(*this, 0x00, (baud * 9) / bits, timeEnd);
+
+} // HardwareSerial::sendBreak()
+
+
+
+/**
+  \brief      Send bytes via DMA
+  \details    Send bytes via linked Tx DMA like HAL_UART_Transmit_DMA(). Host only. Bytes are queued immediately, the
+              transfer is completed by _serviceDMA() when the transmitter is idle. With D-cache, the bytes must have been
+              cleaned before, see SCB_CleanDCache_by_Addr()
+  \param[in]  Data      bytes to send
+  \param[in]  Size      number of bytes
+  \return     HAL_OK, HAL_BUSY if a transmission is ongoing, or HAL_ERROR if closed or no DMA is linked
+*/
+HAL_StatusTypeDef HardwareSerial::transmitDMA(const uint8_t *Data, uint16_t Size)
+{
+  // closed, no DMA or nothing to send
+  if ((!this->isOpen) || (this->huart.hdmatx == NULL) || (Data == NULL) || (Size == 0))
+    return HAL_ERROR;
+
+  // previous transmission ongoing
+  if (this->huart.gState != HAL_UART_STATE_READY)
+    return HAL_BUSY;
+
+  // DMA reads from RAM -> bytes must be cleaned from D-cache
+  hostDcacheCheckClean(Data, Size);
+
+  // start transfer. DMA copies to TDR when transmit register is empty, i.e. bytes are queued back-to-back
+  this->huart.gState = HAL_UART_STATE_BUSY_TX;
+  this->huart.hdmatx->State = HAL_DMA_STATE_BUSY;
+  SET_BIT(this->usart.CR3, USART_CR3_DMAT);
+  for (uint16_t i = 0; i < Size; i++)
+    this->_transmit(Data[i]);
+  this->dmaTxBusy = true;
+  attachIrq(HardwareSerial::_serviceDMA, &(this->huart));
+
+  return HAL_OK;
+
+} // HardwareSerial::transmitDMA()
+
+
+
+/**
+  \brief      Receive bytes via DMA until full or idle
+  \details    Receive bytes via linked Rx DMA like HAL_UARTEx_ReceiveToIdle_DMA() in normal DMA mode. Host only.
+              Received bytes are copied by _serviceDMA(), which also calls HAL_UARTEx_RxEventCallback()
+  \param[out] Data      receive buffer
+  \param[in]  Size      size of receive buffer
+  \return     HAL_OK, HAL_BUSY if a reception is ongoing, or HAL_ERROR if closed or no DMA is linked
+*/
+HAL_StatusTypeDef HardwareSerial::receiveDMA(uint8_t *Data, uint16_t Size)
+{
+  // closed, no DMA or no buffer
+  if ((!this->isOpen) || (this->huart.hdmarx == NULL) || (Data == NULL) || (Size == 0))
+    return HAL_ERROR;
+
+  // previous reception ongoing
+  if (this->huart.RxState != HAL_UART_STATE_READY)
+    return HAL_BUSY;
+
+  // start transfer. Like HAL, enable DMA request, idle and error interrupts
+  this->huart.RxState = HAL_UART_STATE_BUSY_RX;
+  this->huart.ReceptionType = HAL_UART_RECEPTION_TOIDLE;
+  this->huart.hdmarx->State = HAL_DMA_STATE_BUSY;
+  this->pDmaMem = Data;
+  this->lenDma  = Size;
+  this->numDma  = 0;
+  this->dmaHalf = false;
+  this->dmaIdle = false;
+  SET_BIT(this->usart.CR1, USART_CR1_IDLEIE | USART_CR1_PEIE);
+  SET_BIT(this->usart.CR3, USART_CR3_DMAR | USART_CR3_EIE);
+  attachIrq(HardwareSerial::_serviceDMA, &(this->huart));
+
+  return HAL_OK;
+
+} // HardwareSerial::receiveDMA()
+
+
+
+/**
+  \brief      Abort DMA transfers
+  \details    Abort DMA transmission and/or reception w/o callback, like HAL_UART_Abort(). Host only. Bytes already
+              queued for transmission are still sent
+  \param[in]  Tx        abort transmission
+  \param[in]  Rx        abort reception
+*/
+void HardwareSerial::abortDMA(bool Tx, bool Rx)
+{
+  HAL_UART_StateTypeDef ready = (this->isOpen) ? HAL_UART_STATE_READY : HAL_UART_STATE_RESET;
+
+  // stop transmission
+  if (Tx)
+  {
+    this->dmaTxBusy = false;
+    this->huart.gState = ready;
+    CLEAR_BIT(this->usart.CR3, USART_CR3_DMAT);
+    if (this->huart.hdmatx != NULL)
+      this->huart.hdmatx->State = HAL_DMA_STATE_READY;
+  }
+
+  // stop reception
+  if (Rx)
+  {
+    this->pDmaMem = NULL;
+    this->huart.RxState = ready;
+    this->huart.ReceptionType = HAL_UART_RECEPTION_STANDARD;
+    CLEAR_BIT(this->usart.CR1, USART_CR1_IDLEIE | USART_CR1_PEIE);
+    CLEAR_BIT(this->usart.CR3, USART_CR3_DMAR | USART_CR3_EIE);
+    if (this->huart.hdmarx != NULL)
+      this->huart.hdmarx->State = HAL_DMA_STATE_READY;
+  }
+
+} // HardwareSerial::abortDMA()
+
+
+
+/**
+  \brief      Queue bytes for transmission
+  \param[in]  Buffer    bytes to send
+  \param[in]  Length    number of bytes
+  \return     number of queued bytes
+*/
+size_t HardwareSerial::write(const uint8_t *Buffer, size_t Length)
+{
+  size_t num = 0;
+
+  for (size_t i = 0; i < Length; i++)
+    num += this->write(Buffer[i]);
+  return num;
+
+} // HardwareSerial::write()
+
+
+
+/**
+  \brief      Wait until all bytes have been sent
+*/
+void HardwareSerial::flush(void)
+{
+  if (this->console)
+    fflush(stdout);
+  else
+  {
+    uint64_t now = micros64();
+    if (this->timeTxIdle > now)
+      delayMicroseconds((uint32_t) (this->timeTxIdle - now));
+  }
+
+} // HardwareSerial::flush()
+
+
+
+/**
+  \brief      Print string
+  \param[in]  Str       string to print
+  \return     number of printed characters
+*/
+size_t HardwareSerial::print(const char Str[])
+{
+  size_t len = strlen(Str);
+
+  return this->write((const uint8_t*) Str, len);
+
+} // HardwareSerial::print()
+
+
+
+/**
+  \brief      Print character
+  \param[in]  Chr       character to print
+  \return     number of printed characters
+*/
+size_t HardwareSerial::print(char Chr)
+{
+  return this->write((uint8_t) Chr);
+
+} // HardwareSerial::print()
+
+
+
+/**
+  \brief      Print signed number
+  \param[in]  Number    number to print
+  \param[in]  Base      number base (2..16)
+  \return     number of printed characters
+*/
+size_t HardwareSerial::print(long Number, int Base)
+{
+  // like Arduino, only print sign for decimal numbers
+  if ((Base == DEC) && (Number < 0))
+    return this->print('-') + this->_printNumber((unsigned long) -Number, DEC);
+  return this->_printNumber((unsigned long) Number, Base);
+
+} // HardwareSerial::print()
+
+
+
+/**
+  \brief      Print floating point number
+  \details    Print floating point number with given number of decimals, rounded like Arduino Print::printFloat()
+  \param[in]  Number    number to print
+  \param[in]  Digits    number of decimals
+  \return     number of printed characters
+*/
+size_t HardwareSerial::print(double Number, int Digits)
+{
+  char    buf[32];
+  int     len = snprintf(buf, sizeof(buf), "%.*f", (Digits < 0) ? 0 : Digits, Number);
+
+  return this->write((const uint8_t *) buf, (len < (int) sizeof(buf)) ? len : sizeof(buf)-1);
+
+} // HardwareSerial::print()
+
+
+
+/**
+  \brief      Connect to simulated LIN bus
+  \details    Connect to simulated LIN bus. Sent bytes are put on the bus and received bytes are decoded from the bus
+              at the current baudrate, incl. the own echo. Direct echo via setEcho() is not used
+  \param[in]  Bus       simulated LIN bus (NULL = none)
+*/
+void HardwareSerial::connect(LIN_Bus_Host *Bus)
+{
+  this->pBus = Bus;
+  if (Bus != NULL)
+    Bus->attach(*this);
+
+} // HardwareSerial::connect()
+
+
+
+/**
+  \brief      Byte decoded from simulated LIN bus
+  \details    Byte decoded from simulated LIN bus. Like on AVR, bytes with framing error (e.g. BREAK) are received
+  \param[in]  Data        received byte
+  \param[in]  FrameError  stop bit was dominant (ignored)
+  \param[in]  Time        end of stop bit [us]
+*/
+void HardwareSerial::onReceive(uint8_t Data, bool FrameError, uint32_t Time)
+{
+  (void) FrameError;
+
+  // optionally corrupt byte
+  if ((this->echoErrorPeriod > 0) && (++(this->echoCount) >= this->echoErrorPeriod))
+  {
+    this->echoCount = 0;
+    Data ^= 0x01;
+  }
+  this->inject(Data, Time);
+
+} // HardwareSerial::onReceive()
+
+
+
+/**
+  \brief      Add byte to receive buffer
+  \details    Add byte to receive buffer, which becomes available after specified time. Buffer is kept sorted by time.
+              Bytes are dropped if interface is closed or buffer is full (overrun)
+  \param[in]  Data      received byte
+  \param[in]  Time      micros() when stop bit is received
+*/
+void HardwareSerial::inject(uint8_t Data, uint32_t Time)
+{
+  // closed interface or buffer overrun
+  if ((!this->isOpen) || (this->numRx >= HOST_SERIAL_RX_BUFLEN))
+    return;
+
+  // find position (after all bytes received earlier or at same time)
+  uint8_t pos = this->numRx;
+  while ((pos > 0) && ((int32_t) (this->bufRx[pos-1].time - Time) > 0))
+    pos--;
+
+  // insert byte
+  memmove(this->bufRx+pos+1, this->bufRx+pos, (this->numRx - pos) * sizeof(rxByte_t));
+  this->bufRx[pos].data = Data;
+  this->bufRx[pos].time = Time;
+  this->numRx++;
+
+  // w/o receive DMA the byte is moved from RDR by the Rx ISR of the core
+  if ((this->pDmaMem == NULL) || (!(this->usart.CR3 & USART_CR3_DMAR)))
+    this->numCoreIsr++;
+
+  // virtual clock jumps to reception
+  scheduleTime(Time);
+
+} // HardwareSerial::inject()
+
+/**
+  \brief      Request break before next sent byte
+  \details    Request break before next sent byte, like RQR.SBKRQ of STM32 HAL. Host only: the break is queued by the
+              owning HardwareSerial mock
+  \param[in]  huart     HAL handle, see HardwareSerial::getHandle()
+  \return     HAL_OK, or HAL_ERROR if handle is invalid
+*/
+HAL_StatusTypeDef HAL_LIN_SendBreak(UART_HandleTypeDef *huart)
+{
+  if ((huart == NULL) || (huart->pSerial == NULL))
+    return HAL_ERROR;
+
+  huart->Instance->RQR |= USART_RQR_SBKRQ;
+  huart->pSerial->sendBreak();
+  huart->Instance->RQR &= ~USART_RQR_SBKRQ;
+
+  return HAL_OK;
+
+} // HAL_LIN_SendBreak()
+
+
+
+/**
+  \brief      Send bytes via DMA
+  \details    Send bytes via linked Tx DMA, like HAL_UART_Transmit_DMA(). Host only: see HardwareSerial::transmitDMA()
+  \param[in]  huart     HAL handle, see HardwareSerial::getHandle()
+  \param[in]  pData     bytes to send. Must remain valid until sent
+  \param[in]  Size      number of bytes
+  \return     HAL_OK, HAL_BUSY or HAL_ERROR
+*/
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+  if ((huart == NULL) || (huart->pSerial == NULL))
+    return HAL_ERROR;
+
+  return huart->pSerial->transmitDMA(pData, Size);
+
+} // HAL_UART_Transmit_DMA()
+
+
+
+/**
+  \brief      Receive bytes via DMA until buffer is full or line is idle
+  \details    Receive bytes via linked Rx DMA, like HAL_UARTEx_ReceiveToIdle_DMA(). Host only: see HardwareSerial::receiveDMA()
+  \param[in]  huart     HAL handle, see HardwareSerial::getHandle()
+  \param[out] pData     receive buffer
+  \param[in]  Size      size of receive buffer
+  \return     HAL_OK, HAL_BUSY or HAL_ERROR
+*/
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+  if ((huart == NULL) || (huart->pSerial == NULL))
+    return HAL_ERROR;
+
+  return huart->pSerial->receiveDMA(pData, Size);
+
+} // HAL_UARTEx_ReceiveToIdle_DMA()
+
+
+
+/**
+  \brief      Abort ongoing reception w/o callback
+  \param[in]  huart     HAL handle, see HardwareSerial::getHandle()
+  \return     HAL_OK or HAL_ERROR
+*/
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart)
+{
+  if ((huart == NULL) || (huart->pSerial == NULL))
+    return HAL_ERROR;
+
+  huart->pSerial->abortDMA(false, true);
+
+  return HAL_OK;
+
+} // HAL_UART_AbortReceive()
+
+
+
+/**
+  \brief      Abort ongoing transmission and reception w/o callback
+  \param[in]  huart     HAL handle, see HardwareSerial::getHandle()
+  \return     HAL_OK or HAL_ERROR
+*/
+HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef *huart)
+{
+  if ((huart == NULL) || (huart->pSerial == NULL))
+    return HAL_ERROR;
+
+  huart->pSerial->abortDMA(true, true);
+
+  return HAL_OK;
+
+} // HAL_UART_Abort()
+
+
+
+/**
+  \brief      Reception event
+  \details    Reception event (half transfer, transfer complete or idle). Weak default like HAL, i.e. is replaced if the
+              application or library defines it
+  \param[in]  huart     HAL handle
+  \param[in]  Size      number of bytes received since start of reception
+*/
+extern "C" __attribute__((weak)) void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+  (void) huart;
+  (void) Size;
+
+} // HAL_UARTEx_RxEventCallback()
+
+
+
+/**************************
+ * D-CACHE MODEL
+**************************/
+
+// bytes written by DMA, which are in RAM but not yet visible to the CPU (stale cache line)
+static struct
+{
+  uint8_t   *addr;
+  uint8_t   data;
+} dcachePending[HOST_DCACHE_PENDING];
+static uint8_t    dcacheNumPending = 0;
+
+// last cleaned memory range (whole cache lines)
+static uintptr_t  dcacheCleanStart = 0;
+static uintptr_t  dcacheCleanEnd = 0;
+
+// number of maintenance errors
+static uint32_t   dcacheErrors = 0;
+
+
+
+/**
+  \brief      DMA writes byte to RAM
+  \details    DMA writes byte to RAM, which is visible to the CPU after SCB_InvalidateDCache_by_Addr(). Host only. If too
+              many bytes are pending, the oldest becomes visible, like an evicted cache line
+  \param[in]  Addr      address
+  \param[in]  Data      written byte
+*/
+void hostDcacheWrite(uint8_t *Addr, uint8_t Data)
+{
+  // too many pending bytes -> oldest cache line is evicted
+  if (dcacheNumPending >= HOST_DCACHE_PENDING)
+  {
+    *(dcachePending[0].addr) = dcachePending[0].data;
+    dcacheNumPending--;
+    memmove(dcachePending, dcachePending+1, dcacheNumPending * sizeof(dcachePending[0]));
+  }
+
+  // byte is in RAM, but CPU still reads cache
+  dcachePending[dcacheNumPending].addr = Addr;
+  dcachePending[dcacheNumPending].data = Data;
+  dcacheNumPending++;
+
+} // hostDcacheWrite()
+
+
+
+/**
+  \brief      Check that memory sent via DMA was cleaned before
+  \details    Check that memory sent via DMA is within the range of the last SCB_CleanDCache_by_Addr(). Host only. The
+              range is consumed, as the CPU may write again afterwards
+  \param[in]  Addr      start address
+  \param[in]  Size      number of bytes
+  \return     true if memory was cleaned, else false (error is counted)
+*/
+bool hostDcacheCheckClean(const uint8_t *Addr, uint16_t Size)
+{
+  bool ok = ((uintptr_t) Addr >= dcacheCleanStart) && ((uintptr_t) Addr + Size <= dcacheCleanEnd);
+
+  dcacheCleanStart = dcacheCleanEnd = 0;
+  if (!ok)
+    dcacheErrors++;
+  return ok;
+
+} // hostDcacheCheckClean()
+
+
+
+/**
+  \brief      Number of D-cache maintenance errors
+  \return     number of memory ranges sent w/o clean and of invalidations of partial cache lines
+*/
+uint32_t hostDcacheErrors(void)
+{
+  return dcacheErrors;
+
+} // hostDcacheErrors()
+
+
+
+/**
+  \brief      Write back D-cache lines to RAM
+  \details    Write back D-cache lines of memory range to RAM, like CMSIS. Host only: stores the range for
+              hostDcacheCheckClean(). Cleaning partial cache lines is safe
+  \param[in]  addr      start address
+  \param[in]  dsize     number of bytes
+*/
+void SCB_CleanDCache_by_Addr(volatile void *addr, int32_t dsize)
+{
+  uintptr_t start = (uintptr_t) addr;
+
+  dcacheCleanStart = start & ~((uintptr_t) __SCB_DCACHE_LINE_SIZE - 1);
+  dcacheCleanEnd   = (start + dsize + __SCB_DCACHE_LINE_SIZE - 1) & ~((uintptr_t) __SCB_DCACHE_LINE_SIZE - 1);
+
+} // SCB_CleanDCache_by_Addr()
+
+
+
+/**
+  \brief      Discard D-cache lines
+  \details    Discard D-cache lines of memory range, like CMSIS. Host only: bytes written by DMA to that range become
+              visible. Partial cache lines are counted as error, as CPU writes to neighbouring data would be lost
+  \param[in]  addr      start address. Must be aligned to cache line
+  \param[in]  dsize     number of bytes. Must be a multiple of cache line size
+*/
+void SCB_InvalidateDCache_by_Addr(volatile void *addr, int32_t dsize)
+{
+  uintptr_t start = (uintptr_t) addr;
+  uint8_t   num = 0;
+
+  // partial cache lines
+  if ((start % __SCB_DCACHE_LINE_SIZE) || (dsize % __SCB_DCACHE_LINE_SIZE))
+    dcacheErrors++;
+
+  // pending bytes in range become visible in order of writing, others stay pending
+  for (uint8_t i = 0; i < dcacheNumPending; i++)
+  {
+    uintptr_t a = (uintptr_t) dcachePending[i].addr;
+    if ((a >= start) && (a < start + dsize))
+      *(dcachePending[i].addr) = dcachePending[i].data;
+    else
+      dcachePending[num++] = dcachePending[i];
+  }
+  dcacheNumPending = num;
+
+} // SCB_InvalidateDCache_by_Addr()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
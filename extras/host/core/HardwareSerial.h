@@ -0,0 +1,283 @@
+/**
+  \file     HardwareSerial.h
+  \brief    Timing-accurate HardwareSerial mock for host (Linux) builds
+  \details  Each written byte occupies the transmitter for 10 bit times at the baudrate set in begin(). The byte
+            is echoed into the own receive buffer when its stop bit has been sent, like on a 1-wire LIN bus.
+            available() and read() only return bytes whose reception time has already passed.
+            Optional listeners (e.g. slave models) are notified about each sent byte and may inject response bytes.
+            Alternatively the interface can be connected to a bit-level simulated LIN bus, see LIN_bus_host.h.
+            The baudrate can also be changed via a mock baudrate register, like UBRR on AVR or BRR on STM32. It is part
+            of a mocked STM32 USART register block incl. HAL handle, which also supports a LIN break via HAL_LIN_SendBreak()
+            and transfers via DMA, see stm32_usart.h.
+            Serial1 and Serial2 are also used by the mocked ESP-IDF UART driver, see esp32_uart.h.
+            Serial (instance 0) is a console and prints to stdout without any timing.
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _HARDWARE_SERIAL_HOST_H_
+#define _HARDWARE_SERIAL_HOST_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+#include <LIN_bus_host.h>
+#include <stm32_usart.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#define HOST_SERIAL_RX_BUFLEN     64              //!< max. number of pending received bytes
+#define HOST_SERIAL_TIMEOUT       1000            //!< readBytes() timeout [ms] like Stream::setTimeout() default
+#define HOST_SERIAL_CLOCK         16000000        //!< UART clock [Hz] of mock baudrate register, see getBaudRegister()
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASSES
+-----------------------------------------------------------------------------*/
+
+// forward declaration
+class HardwareSerial;
+
+/**
+  \brief  Observer of bytes sent via HardwareSerial, e.g. a LIN slave model
+
+  \details Observer of bytes sent via HardwareSerial. Is notified for each byte written to the attached interface.
+*/
+class HardwareSerial_Listener
+{
+  public:
+
+    /// @brief Destructor. Any class with virtual functions should have virtual destructor
+    virtual ~HardwareSerial_Listener(void) { }
+
+    /// @brief Byte was queued for transmission. Data is on bus until TimeEnd [us] at specified baudrate
+    virtual void onTransmit(HardwareSerial &Port, uint8_t Data, uint32_t Baudrate, uint32_t TimeEnd) = 0;
+
+}; // class HardwareSerial_Listener
+
+
+/**
+  \brief  Timing-accurate mock of Arduino HardwareSerial
+
+  \details Timing-accurate mock of Arduino HardwareSerial incl. LIN echo
+*/
+class HardwareSerial : public LIN_Bus_Node
+{
+  // PROTECTED TYPEDEFS
+  protected:
+
+    /// byte in receive buffer
+    typedef struct
+    {
+      uint8_t               data;               //!< received byte
+      uint32_t              time;               //!< micros() when stop bit is received
+    } rxByte_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    bool                    console;            //!< is console (print to stdout)
+    bool                    isOpen;             //!< interface opened via begin()
+    bool                    echo;               //!< receive own sent bytes (1-wire bus)
+    uint32_t                echoErrorPeriod;    //!< corrupt every n-th echoed byte (0 = never)
+    uint32_t                echoCount;          //!< number of echoed bytes for error injection
+    uint32_t                baudrate;           //!< baudrate [Baud] set in begin()
+    USART_TypeDef           usart;              //!< mock STM32 USART registers. BRR is the baudrate register (clock divider)
+    UART_HandleTypeDef      huart;              //!< mock STM32 HAL handle, see getHandle()
+    uint8_t                 *pDmaMem;           //!< memory of ongoing receive DMA (NULL = none)
+    uint16_t                lenDma;             //!< size of receive DMA
+    uint16_t                numDma;             //!< number of bytes received via DMA
+    bool                    dmaHalf;            //!< half transfer event of receive DMA occurred
+    bool                    dmaIdle;            //!< bytes received since last idle event
+    uint32_t                timeDma;            //!< micros() when last byte was received via DMA
+    bool                    dmaTxBusy;          //!< transmission via DMA ongoing
+    uint32_t                baudRegBegin;       //!< baudrate register value set in begin()
+    bool                    baudRegEnabled;     //!< baudrate register is accessible
+    uint32_t                timeBegin;          //!< modelled execution time [us] of begin()
+    uint64_t                timeTxIdle;         //!< micros64() when transmitter is idle again
+    HardwareSerial_Listener *pListener;         //!< optional observer of sent bytes
+    LIN_Bus_Host            *pBus;              //!< optional simulated LIN bus for sending and receiving
+    uint8_t                 numRx;              //!< number of pending received bytes
+    uint32_t                numCoreIsr;         //!< number of interrupts of UART or DMA on target, see getIsrCount()
+    rxByte_t                bufRx[HOST_SERIAL_RX_BUFLEN];   //!< received bytes, sorted by reception time
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Print unsigned number in specified base
+    size_t _printNumber(unsigned long Number, int Base);
+
+    /// @brief Queue byte for transmission via Serial.write() or DMA
+    size_t _transmit(uint8_t Data);
+
+    /// @brief Simulated UART and DMA interrupts of HAL transfers, see attachIrq()
+    static void _serviceDMA(void *Arg);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Constructor
+    HardwareSerial(bool Console = false);
+
+    /// @brief Open interface with specified baudrate. Format parameters are ignored
+    void begin(unsigned long Baudrate, uint32_t Config = 0, int8_t PinRx = -1, int8_t PinTx = -1);
+
+    /// @brief Close interface and discard received bytes
+    void end(void);
+
+    /// @brief Interface is ready
+    operator bool(void) { return true; }
+
+    /// @brief Number of bytes received until now
+    int available(void);
+
+    /// @brief Read next received byte or -1 if none
+    int read(void);
+
+    /// @brief Read received bytes with timeout
+    size_t readBytes(uint8_t *Buffer, size_t Length);
+
+    /// @brief Queue byte for transmission
+    size_t write(uint8_t Data);
+
+    /// @brief Queue bytes for transmission
+    size_t write(const uint8_t *Buffer, size_t Length);
+
+    /// @brief Wait until all bytes have been sent
+    void flush(void);
+
+
+    /// @brief Print string
+    size_t print(const char Str[]);
+
+    /// @brief Print character
+    size_t print(char Chr);
+
+    /// @brief Print signed number
+    size_t print(long Number, int Base = DEC);
+
+    /// @brief Print signed number
+    size_t print(int Number, int Base = DEC) { return this->print((long) Number, Base); }
+
+    /// @brief Print unsigned number
+    size_t print(unsigned long Number, int Base = DEC) { return this->_printNumber(Number, Base); }
+
+    /// @brief Print unsigned number
+    size_t print(unsigned int Number, int Base = DEC) { return this->_printNumber(Number, Base); }
+
+    /// @brief Print floating point number with given number of decimals
+    size_t print(double Number, int Digits = 2);
+
+    /// @brief Print newline
+    size_t println(void) { return this->print('\n'); }
+
+    /// @brief Print value and newline
+    template <typename T> size_t println(T Value) { return this->print(Value) + this->println(); }
+
+    /// @brief Print number and newline
+    template <typename T> size_t println(T Value, int Base) { return this->print(Value, Base) + this->println(); }
+
+
+    /// @brief Host only: attach observer of sent bytes, e.g. LIN slave model (NULL = none)
+    void attach(HardwareSerial_Listener *Listener) { this->pListener = Listener; }
+
+    /// @brief Host only: connect to simulated LIN bus instead of direct echo (NULL = none)
+    void connect(LIN_Bus_Host *Bus);
+
+    /// @brief Host only: receive baudrate for simulated LIN bus (0 = closed)
+    uint32_t getRxBaudrate(void) { return (this->isOpen) ? this->getBaudrate() : 0; }
+
+    /// @brief Host only: byte decoded from simulated LIN bus
+    void onReceive(uint8_t Data, bool FrameError, uint32_t Time);
+
+    /// @brief Host only: enable/disable echo of sent bytes (default = on)
+    void setEcho(bool Echo) { this->echo = Echo; }
+
+    /// @brief Host only: corrupt (bit 0 inverted) every n-th echoed (or with bus: received) byte to emulate bus errors (0 = never)
+    void setEchoError(uint32_t Period) { this->echoErrorPeriod = Period; this->echoCount = 0; }
+
+    /// @brief Host only: current baudrate [Baud], incl. changes via baudrate register
+    uint32_t getBaudrate(void);
+
+    /// @brief Host only: baudrate register like UBRR or BRR (baudrate = HOST_SERIAL_CLOCK / value), or NULL if disabled
+    volatile uint32_t *getBaudRegister(void) { return (this->baudRegEnabled) ? &(this->usart.BRR) : NULL; }
+
+    /// @brief Host only: enable/disable access to baudrate register (default = on)
+    void setBaudRegister(bool Enable) { this->baudRegEnabled = Enable; }
+
+    /// @brief Host only: STM32 HAL handle with mock USART registers, like Uart::getHandle() of STM32 core
+    UART_HandleTypeDef *getHandle(void) { return &(this->huart); }
+
+    /// @brief Host only: Rx pin like STM32 core. Ignored
+    void setRx(uint32_t Pin) { (void) Pin; }
+
+    /// @brief Host only: Tx pin like STM32 core. Ignored
+    void setTx(uint32_t Pin) { (void) Pin; }
+
+    /// @brief Host only: queue break (13 low bits if LIN mode via USART CR2.LINEN, else 10) and stop bit, see HAL_LIN_SendBreak()
+    void sendBreak(void);
+
+    /// @brief Host only: send bytes via DMA, see HAL_UART_Transmit_DMA()
+    HAL_StatusTypeDef transmitDMA(const uint8_t *Data, uint16_t Size);
+
+    /// @brief Host only: receive bytes via DMA until full or idle, see HAL_UARTEx_ReceiveToIdle_DMA()
+    HAL_StatusTypeDef receiveDMA(uint8_t *Data, uint16_t Size);
+
+    /// @brief Host only: abort DMA transmission and/or reception, see HAL_UART_Abort()
+    void abortDMA(bool Tx, bool Rx);
+
+    /// @brief Host only: model execution time [us] of begin(), e.g. baudrate calculation on a slow MCU (default = 0)
+    void setBeginTime(uint32_t Time) { this->timeBegin = Time; }
+
+    /// @brief Host only: add byte to receive buffer, which is available after specified micros()
+    void inject(uint8_t Data, uint32_t Time);
+
+    /// @brief Host only: time [us] until transmitter is idle, see flush()
+    uint32_t getTxBusy(void)
+    {
+      uint64_t now = micros64();
+      return (this->timeTxIdle > now) ? (uint32_t) (this->timeTxIdle - now) : 0;
+    }
+
+    /// @brief Host only: number of interrupts on target. Per byte via write() and w/o receive DMA, else per DMA or idle event
+    uint32_t getIsrCount(void) { return this->numCoreIsr; }
+
+    /// @brief Host only: reset number of interrupts, see getIsrCount()
+    void resetIsrCount(void) { this->numCoreIsr = 0; }
+
+    /// @brief Host only: micros() when pending received byte is/was received (Index < number of pending bytes), e.g. for Rx FIFO model
+    uint32_t getRxTime(uint8_t Index) { return this->bufRx[Index].time; }
+
+}; // class HardwareSerial
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL VARIABLES
+-----------------------------------------------------------------------------*/
+
+extern HardwareSerial   Serial;         //!< console (stdout)
+extern HardwareSerial   Serial1;        //!< emulated UART 1
+extern HardwareSerial   Serial2;        //!< emulated UART 2
+extern HardwareSerial   Serial3;        //!< emulated UART 3
+extern HardwareSerial   Serial4;        //!< emulated UART 4
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _HARDWARE_SERIAL_HOST_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,553 @@
+/**
+  \file     LIN_bus_host.cpp
+  \brief    Bit-level LIN bus simulation for host (Linux) builds
+  \details  Dominant levels are stored as sorted, merged time intervals. Receivers decode one byte per falling edge.
+            All time comparisons use signed 32-bit differences, i.e. are robust against micros() wrap-around.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <Arduino.h>
+#include <LIN_bus_host.h>
+#include <LIN_slave_sim.h>
+
+
+/**************************
+ * LOCAL VARIABLES
+**************************/
+
+static LIN_Bus_Host   *busPin[HOST_NUM_PINS];       //!< bus connected to GPIO (NULL = none)
+static bool           pinDominant[HOST_NUM_PINS];   //!< GPIO currently drives dominant level
+
+
+/**************************
+ * LOCAL FUNCTIONS
+**************************/
+
+/**
+  \brief      Time offset of bit edge or sample point
+  \param[in]  HalfBits    offset in half bit times
+  \param[in]  Baudrate    baudrate [Baud]
+  \return     time offset [us], rounded
+*/
+static inline uint32_t _bitTime(uint32_t HalfBits, uint32_t Baudrate)
+{
+  return (uint32_t) ((HalfBits * 500000ULL + Baudrate/2) / Baudrate);
+
+} // _bitTime()
+
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Add dominant interval
+  \details    Add dominant interval and merge with overlapping or adjacent intervals. If the buffer is full,
+              the oldest interval is dropped
+  \param[in]  Start     begin of dominant level [us]
+  \param[in]  End       end of dominant level [us] (excluded)
+*/
+void LIN_Bus_Host::_addLevel(uint32_t Start, uint32_t End)
+{
+  // ignore empty interval
+  if ((int32_t) (End - Start) <= 0)
+    return;
+
+  // buffer full -> drop oldest interval
+  if (this->numLevels >= HOST_BUS_MAX_LEVELS)
+  {
+    this->numLevels--;
+    memmove(this->levels, this->levels+1, this->numLevels * sizeof(level_t));
+  }
+
+  // insert sorted by start time
+  uint16_t pos = this->numLevels;
+  while ((pos > 0) && ((int32_t) (this->levels[pos-1].start - Start) > 0))
+    pos--;
+  memmove(this->levels+pos+1, this->levels+pos, (this->numLevels - pos) * sizeof(level_t));
+  this->levels[pos].start = Start;
+  this->levels[pos].end   = End;
+  this->numLevels++;
+
+  // merge overlapping or adjacent intervals
+  uint16_t j = 0;
+  for (uint16_t i = 1; i < this->numLevels; i++)
+  {
+    if ((int32_t) (this->levels[i].start - this->levels[j].end) <= 0)
+    {
+      if ((int32_t) (this->levels[i].end - this->levels[j].end) > 0)
+        this->levels[j].end = this->levels[i].end;
+    }
+    else
+      this->levels[++j] = this->levels[i];
+  }
+  this->numLevels = j + 1;
+
+} // LIN_Bus_Host::_addLevel()
+
+
+
+/**
+  \brief      Time of first falling edge at or after specified time
+  \details    Time of first falling edge (recessive to dominant) at or after specified time, incl. dominant level driven via GPIO
+  \param[in]  Time      earliest time [us]
+  \param[out] Edge      time [us] of falling edge
+  \return     true if a falling edge was found
+*/
+bool LIN_Bus_Host::_nextFallingEdge(uint32_t Time, uint32_t &Edge)
+{
+  bool      found = false;
+
+  // first stored interval starting at or after Time
+  for (uint16_t i = 0; i < this->numLevels; i++)
+  {
+    if ((int32_t) (this->levels[i].start - Time) >= 0)
+    {
+      Edge  = this->levels[i].start;
+      found = true;
+      break;
+    }
+  }
+
+  // dominant level driven by GPIO until further notice
+  if (this->numPinsDominant > 0)
+  {
+    uint32_t pin = this->timePinDominant;
+
+    // later stored edges are hidden by GPIO level
+    if (found && ((int32_t) (Edge - pin) >= 0))
+      found = false;
+
+    // start of GPIO level is an edge, if bus was recessive before
+    if ((!found) && ((int32_t) (pin - Time) >= 0) && (!this->isDominant(pin - 1)))
+    {
+      Edge  = pin;
+      found = true;
+    }
+  }
+
+  return found;
+
+} // LIN_Bus_Host::_nextFallingEdge()
+
+
+
+/**
+  \brief      Decode byte
+  \details    Decode byte starting at falling edge like a UART, i.e. sample each bit in the middle
+  \param[in]  Edge        falling edge of start bit [us]
+  \param[in]  Baudrate    receive baudrate [Baud]
+  \param[out] FrameError  stop bit was dominant, e.g. BREAK
+  \return     decoded byte
+*/
+uint8_t LIN_Bus_Host::_decode(uint32_t Edge, uint32_t Baudrate, bool &FrameError)
+{
+  uint8_t   data = 0x00;
+
+  // sample data bits LSB first. Recessive = 1
+  for (uint8_t bit = 0; bit < 8; bit++)
+  {
+    if (!this->isDominant(Edge + _bitTime(2*bit + 3, Baudrate)))
+      data |= (uint8_t) (1 << bit);
+  }
+
+  // sample stop bit
+  FrameError = this->isDominant(Edge + _bitTime(19, Baudrate));
+
+  return data;
+
+} // LIN_Bus_Host::_decode()
+
+
+
+/**
+  \brief      Remove dominant intervals which can no longer be sampled
+  \param[in]  Now       current time [us]
+*/
+void LIN_Bus_Host::_prune(uint32_t Now)
+{
+  uint32_t  timeMin = Now - this->loopDelay;
+
+  // earliest possible sample time of all enabled receivers
+  for (uint8_t i = 0; i < this->numNodes; i++)
+  {
+    if ((this->nodes[i].pNode->getRxBaudrate() > 0) && ((int32_t) (this->nodes[i].timeIdle - timeMin) < 0))
+      timeMin = this->nodes[i].timeIdle;
+  }
+  if ((this->numSlaves > 0) && ((int32_t) (this->timeIdleSlaves - timeMin) < 0))
+    timeMin = this->timeIdleSlaves;
+
+  // remove intervals ending before
+  uint16_t num = 0;
+  while ((num < this->numLevels) && ((int32_t) (this->levels[num].end - timeMin) <= 0))
+    num++;
+  if (num > 0)
+  {
+    this->numLevels -= num;
+    memmove(this->levels, this->levels+num, this->numLevels * sizeof(level_t));
+  }
+
+} // LIN_Bus_Host::_prune()
+
+
+
+/**
+  \brief      Register end of byte for virtual clock
+  \details    Register end of a byte starting at a falling edge at the baudrates of all enabled receivers and slaves,
+              so that a virtual clock jumps directly to the time when it can be decoded
+  \param[in]  Edge      falling edge of start bit [us]
+*/
+void LIN_Bus_Host::_scheduleDecode(uint32_t Edge)
+{
+  if (!isVirtualTime())
+    return;
+
+  for (uint8_t i = 0; i < this->numNodes; i++)
+  {
+    uint32_t baud = this->nodes[i].pNode->getRxBaudrate();
+    if (baud > 0)
+      scheduleTime(Edge + _bitTime(20, baud) + this->loopDelay);
+  }
+  if (this->numSlaves > 0)
+    scheduleTime(Edge + _bitTime(20, this->baudrate) + this->loopDelay);
+
+} // LIN_Bus_Host::_scheduleDecode()
+
+
+
+/**
+  \brief      GPIO connected via connectPin() changed
+  \param[in]  Pin       GPIO number
+  \param[in]  Value     new output level (LOW = dominant)
+  \param[in]  Arg       connected bus
+*/
+void LIN_Bus_Host::_onPin(uint8_t Pin, uint8_t Value, void *Arg)
+{
+  LIN_Bus_Host  *bus = (LIN_Bus_Host*) Arg;
+  bool          dominant = (Value == LOW);
+
+  // only act on level changes
+  if (dominant != pinDominant[Pin])
+  {
+    pinDominant[Pin] = dominant;
+    bus->drive(dominant, micros());
+  }
+
+} // LIN_Bus_Host::_onPin()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor
+  \param[in]  Baudrate    nominal baudrate [Baud] used by slaves
+*/
+LIN_Bus_Host::LIN_Bus_Host(uint32_t Baudrate)
+{
+  this->baudrate        = Baudrate;
+  this->loopDelay       = 0;
+  this->numLevels       = 0;
+  this->numPinsDominant = 0;
+  this->timePinDominant = 0;
+  this->numNodes        = 0;
+  this->numSlaves       = 0;
+  this->timeIdleSlaves  = 0;
+  this->updating        = false;
+  this->numBytes        = 0;
+  this->numFrameErrors  = 0;
+
+} // LIN_Bus_Host::LIN_Bus_Host()
+
+
+
+/**
+  \brief      Attach receiver
+  \param[in]  Node      receiver, e.g. mocked serial interface of a master
+  \return     false if too many receivers
+*/
+bool LIN_Bus_Host::attach(LIN_Bus_Node &Node)
+{
+  if (this->numNodes >= HOST_BUS_MAX_NODES)
+    return false;
+
+  this->nodes[this->numNodes].pNode    = &Node;
+  this->nodes[this->numNodes].timeIdle = micros() - this->loopDelay;
+  this->numNodes++;
+  return true;
+
+} // LIN_Bus_Host::attach()
+
+
+
+/**
+  \brief      Add simulated slave
+  \param[in]  Slave     simulated slave, receives at nominal baudrate
+  \return     false if too many slaves
+*/
+bool LIN_Bus_Host::addSlave(LIN_Slave_Sim &Slave)
+{
+  if (this->numSlaves >= HOST_BUS_MAX_SLAVES)
+    return false;
+
+  if (this->numSlaves == 0)
+    this->timeIdleSlaves = micros() - this->loopDelay;
+  this->pSlaves[this->numSlaves++] = &Slave;
+  return true;
+
+} // LIN_Bus_Host::addSlave()
+
+
+
+/**
+  \brief      Connect GPIO
+  \details    Connect GPIO to bus. Output low drives dominant level, e.g. SoftwareSerial Tx pin during BREAK.
+              A mocked SoftwareSerial with this Tx pin also uses the bus for sending and receiving
+  \param[in]  Pin       GPIO number
+*/
+void LIN_Bus_Host::connectPin(uint8_t Pin)
+{
+  if (Pin >= HOST_NUM_PINS)
+    return;
+
+  busPin[Pin] = this;
+  pinDominant[Pin] = false;
+  attachPinListener(Pin, LIN_Bus_Host::_onPin, this);
+
+} // LIN_Bus_Host::connectPin()
+
+
+
+/**
+  \brief      Find bus a GPIO is connected to
+  \param[in]  Pin       GPIO number
+  \return     connected bus or NULL
+*/
+LIN_Bus_Host *LIN_Bus_Host::findPin(uint8_t Pin)
+{
+  if (Pin >= HOST_NUM_PINS)
+    return NULL;
+  return busPin[Pin];
+
+} // LIN_Bus_Host::findPin()
+
+
+
+/**
+  \brief      (Re-)start receiver
+  \details    (Re-)start receiver at specified time. Bytes started before are ignored
+  \param[in]  Node      attached receiver
+  \param[in]  Time      start time [us]
+*/
+void LIN_Bus_Host::resync(LIN_Bus_Node &Node, uint32_t Time)
+{
+  for (uint8_t i = 0; i < this->numNodes; i++)
+  {
+    if (this->nodes[i].pNode == &Node)
+      this->nodes[i].timeIdle = Time - this->loopDelay;
+  }
+
+} // LIN_Bus_Host::resync()
+
+
+
+/**
+  \brief      Send byte
+  \details    Send byte as start bit, 8 data bits (LSB first) and stop bit
+  \param[in]  Data        byte to send
+  \param[in]  Baudrate    baudrate [Baud]
+  \param[in]  TimeStart   falling edge of start bit [us]
+  \return     end of stop bit [us]
+*/
+uint32_t LIN_Bus_Host::transmit(uint8_t Data, uint32_t Baudrate, uint32_t TimeStart)
+{
+  uint16_t  bits = ((uint16_t) Data << 1) | 0x200;    // start bit (0), data, stop bit (1)
+  uint8_t   bit = 0;
+
+  // add runs of dominant bits
+  while (bit < 10)
+  {
+    if (bits & (1 << bit))
+    {
+      bit++;
+      continue;
+    }
+    uint8_t first = bit;
+    while ((bit < 10) && (!(bits & (1 << bit))))
+      bit++;
+    this->_addLevel(TimeStart + _bitTime(2*first, Baudrate), TimeStart + _bitTime(2*bit, Baudrate));
+  }
+  this->numBytes++;
+  this->_scheduleDecode(TimeStart);
+
+  return TimeStart + _bitTime(20, Baudrate);
+
+} // LIN_Bus_Host::transmit()
+
+
+
+/**
+  \brief      Send break
+  \details    Send break as dominant level for specified number of bits, e.g. STM32 LIN mode break. Is followed by a stop bit
+  \param[in]  Bits        number of dominant bits
+  \param[in]  Baudrate    baudrate [Baud]
+  \param[in]  TimeStart   falling edge of break [us]
+  \return     end of stop bit [us]
+*/
+uint32_t LIN_Bus_Host::transmitBreak(uint8_t Bits, uint32_t Baudrate, uint32_t TimeStart)
+{
+  this->_addLevel(TimeStart, TimeStart + _bitTime(2*Bits, Baudrate));
+  this->numBytes++;
+  this->_scheduleDecode(TimeStart);
+
+  return TimeStart + _bitTime(2*(Bits+1), Baudrate);
+
+} // LIN_Bus_Host::transmitBreak()
+
+
+
+/**
+  \brief      Drive or release dominant level
+  \details    Drive or release dominant level, e.g. via GPIO. Multiple drivers are counted
+  \param[in]  Dominant  true = start driving dominant, false = release
+  \param[in]  Time      time of change [us]
+*/
+void LIN_Bus_Host::drive(bool Dominant, uint32_t Time)
+{
+  if (Dominant)
+  {
+    if (this->numPinsDominant++ == 0)
+    {
+      this->timePinDominant = Time;
+      this->_scheduleDecode(Time);
+    }
+  }
+  else if ((this->numPinsDominant > 0) && (--(this->numPinsDominant) == 0))
+    this->_addLevel(this->timePinDominant, Time);
+
+} // LIN_Bus_Host::drive()
+
+
+
+/**
+  \brief      Bus level at specified time
+  \param[in]  Time      time [us]
+  \return     true = dominant, false = recessive
+*/
+bool LIN_Bus_Host::isDominant(uint32_t Time)
+{
+  // GPIO driven level
+  if ((this->numPinsDominant > 0) && ((int32_t) (Time - this->timePinDominant) >= 0))
+    return true;
+
+  // stored intervals are sorted
+  for (uint16_t i = 0; i < this->numLevels; i++)
+  {
+    if ((int32_t) (Time - this->levels[i].start) < 0)
+      return false;
+    if ((int32_t) (Time - this->levels[i].end) < 0)
+      return true;
+  }
+  return false;
+
+} // LIN_Bus_Host::isDominant()
+
+
+
+/**
+  \brief      Decode all bytes completed until specified time
+  \details    Decode all bytes completed until specified time in chronological order and notify receivers and slaves.
+              Slaves may send responses, which are considered for all later bytes
+  \param[in]  Now       current time [us]
+*/
+void LIN_Bus_Host::update(uint32_t Now)
+{
+  // avoid recursion, e.g. via slave script
+  if (this->updating)
+    return;
+  this->updating = true;
+
+  // process bytes in chronological order
+  while (true)
+  {
+    int16_t   next = -2;              // -1 = slaves, >=0 = receiver index
+    uint32_t  nextEdge = 0, nextEnd = 0, nextBaud = 0;
+    uint32_t  edge;
+
+    // earliest completed byte of all enabled receivers
+    for (uint8_t i = 0; i < this->numNodes; i++)
+    {
+      uint32_t baud = this->nodes[i].pNode->getRxBaudrate();
+      if ((baud == 0) || (!this->_nextFallingEdge(this->nodes[i].timeIdle, edge)))
+        continue;
+      uint32_t end = edge + _bitTime(20, baud) + this->loopDelay;
+      if (((int32_t) (end - Now) <= 0) && ((next == -2) || ((int32_t) (end - nextEnd) < 0)))
+      {
+        next = i;
+        nextEdge = edge;
+        nextEnd = end;
+        nextBaud = baud;
+      }
+    }
+
+    // completed byte for slaves
+    if ((this->numSlaves > 0) && (this->_nextFallingEdge(this->timeIdleSlaves, edge)))
+    {
+      uint32_t end = edge + _bitTime(20, this->baudrate) + this->loopDelay;
+      if (((int32_t) (end - Now) <= 0) && ((next == -2) || ((int32_t) (end - nextEnd) < 0)))
+      {
+        next = -1;
+        nextEdge = edge;
+        nextEnd = end;
+        nextBaud = this->baudrate;
+      }
+    }
+
+    // no more completed bytes
+    if (next == -2)
+      break;
+
+    // decode byte. Next start bit is detected after stop bit sample point
+    bool frameError;
+    uint8_t data = this->_decode(nextEdge, nextBaud, frameError);
+    uint32_t idle = nextEdge + _bitTime(19, nextBaud);
+
+    // notify receiver
+    if (next >= 0)
+    {
+      this->nodes[next].timeIdle = idle;
+      this->nodes[next].pNode->onReceive(data, frameError, nextEnd);
+    }
+
+    // notify all slaves
+    else
+    {
+      this->timeIdleSlaves = idle;
+      this->numFrameErrors += frameError;
+      for (uint8_t i = 0; i < this->numSlaves; i++)
+        this->pSlaves[i]->onReceive(*this, data, frameError, nextEnd);
+    }
+
+  } // loop over bytes
+
+  // remove old levels
+  this->_prune(Now);
+
+  // idle bus -> catch up receivers, as time stamps older than 2^31us can't be compared
+  if ((this->numLevels == 0) && (this->numPinsDominant == 0))
+  {
+    for (uint8_t i = 0; i < this->numNodes; i++)
+      this->nodes[i].timeIdle = Now - this->loopDelay;
+    this->timeIdleSlaves = Now - this->loopDelay;
+  }
+  this->updating = false;
+
+} // LIN_Bus_Host::update()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,191 @@
+/**
+  \file     LIN_bus_host.h
+  \brief    Bit-level LIN bus simulation for host (Linux) builds
+  \details  The bus carries dominant (low) and recessive (high) levels over time as wired-AND of all transmitters.
+            Transmitters are mocked UARTs (each byte = start bit, 8 data bits LSB first, stop bit at the sender's
+            baudrate), GPIOs connected via connectPin() (e.g. a SoftwareSerial BREAK) and simulated slaves.
+            Each receiver decodes bytes from the bus levels like a UART at its own baudrate: a falling edge starts
+            a byte, bits are sampled in the middle, and a dominant stop bit is a framing error (e.g. a BREAK).
+            As on a real transceiver, a transmitting node receives its own bytes, possibly overlaid by other nodes.
+            Decoding is lazy, i.e. update() processes all bytes completed until the specified time in chronological
+            order. Mocked interfaces call update() in available() and read().
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_BUS_HOST_H_
+#define _LIN_BUS_HOST_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#define HOST_BUS_MAX_LEVELS       256             //!< max. number of pending dominant intervals
+#define HOST_BUS_MAX_NODES        8               //!< max. number of attached interfaces (masters)
+#define HOST_BUS_MAX_SLAVES       64              //!< max. number of simulated slaves
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASSES
+-----------------------------------------------------------------------------*/
+
+// forward declarations
+class LIN_Bus_Host;
+class LIN_Slave_Sim;
+
+/**
+  \brief  Receiver attached to a simulated LIN bus, e.g. a mocked serial interface
+
+  \details Receiver attached to a simulated LIN bus. Decoding is done by the bus at the receiver's baudrate.
+*/
+class LIN_Bus_Node
+{
+  public:
+
+    /// @brief Destructor. Any class with virtual functions should have virtual destructor
+    virtual ~LIN_Bus_Node(void) { }
+
+    /// @brief Current receive baudrate [Baud]. 0 = receiver disabled
+    virtual uint32_t getRxBaudrate(void) = 0;
+
+    /// @brief Byte was decoded from bus. Stop bit ends at Time [us]
+    virtual void onReceive(uint8_t Data, bool FrameError, uint32_t Time) = 0;
+
+}; // class LIN_Bus_Node
+
+
+/**
+  \brief  Bit-level LIN bus simulation
+
+  \details Bit-level LIN bus simulation with wired-AND of all transmitters
+*/
+class LIN_Bus_Host
+{
+  // PROTECTED TYPEDEFS
+  protected:
+
+    /// time interval with dominant bus level
+    typedef struct
+    {
+      uint32_t              start;              //!< begin of dominant level [us]
+      uint32_t              end;                //!< end of dominant level [us] (excluded)
+    } level_t;
+
+    /// attached receiver
+    typedef struct
+    {
+      LIN_Bus_Node          *pNode;             //!< receiver
+      uint32_t              timeIdle;           //!< earliest time [us] of next start bit
+    } node_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    uint32_t                baudrate;           //!< nominal baudrate [Baud] of slaves
+    uint32_t                loopDelay;          //!< transceiver loop delay [us] from bus to receivers
+    uint16_t                numLevels;          //!< number of dominant intervals
+    level_t                 levels[HOST_BUS_MAX_LEVELS];  //!< dominant intervals, sorted and merged
+    uint8_t                 numPinsDominant;    //!< number of GPIOs currently driving dominant level
+    uint32_t                timePinDominant;    //!< start [us] of dominant level driven by GPIOs
+    uint8_t                 numNodes;           //!< number of attached receivers
+    node_t                  nodes[HOST_BUS_MAX_NODES];    //!< attached receivers
+    uint8_t                 numSlaves;          //!< number of simulated slaves
+    LIN_Slave_Sim           *pSlaves[HOST_BUS_MAX_SLAVES];  //!< simulated slaves, decoded at nominal baudrate
+    uint32_t                timeIdleSlaves;     //!< earliest time [us] of next start bit for slaves
+    bool                    updating;           //!< update() is ongoing. Avoid recursion via callbacks
+
+
+  // PUBLIC VARIABLES
+  public:
+
+    uint32_t                numBytes;           //!< number of bytes sent by all transmitters
+    uint32_t                numFrameErrors;     //!< number of bytes with framing error decoded by slaves (incl. BREAK)
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Add dominant interval, merge with overlapping intervals
+    void _addLevel(uint32_t Start, uint32_t End);
+
+    /// @brief Time of first falling edge at or after Time, if any
+    bool _nextFallingEdge(uint32_t Time, uint32_t &Edge);
+
+    /// @brief Decode byte starting at falling edge at specified baudrate
+    uint8_t _decode(uint32_t Edge, uint32_t Baudrate, bool &FrameError);
+
+    /// @brief Remove dominant intervals which can no longer be sampled
+    void _prune(uint32_t Now);
+
+    /// @brief Register end of byte starting at falling edge for virtual clock
+    void _scheduleDecode(uint32_t Edge);
+
+    /// @brief GPIO connected via connectPin() changed
+    static void _onPin(uint8_t Pin, uint8_t Value, void *Arg);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Constructor
+    LIN_Bus_Host(uint32_t Baudrate = 19200);
+
+    /// @brief Nominal baudrate [Baud] of slaves
+    uint32_t getBaudrate(void) { return this->baudrate; }
+
+    /// @brief Set transceiver loop delay [us] from bus to all receivers (default = 0)
+    void setLoopDelay(uint32_t Delay) { this->loopDelay = Delay; }
+
+    /// @brief Attach receiver, e.g. mocked serial interface of a master
+    bool attach(LIN_Bus_Node &Node);
+
+    /// @brief Add simulated slave
+    bool addSlave(LIN_Slave_Sim &Slave);
+
+    /// @brief Connect GPIO (low = dominant), e.g. SoftwareSerial Tx pin
+    void connectPin(uint8_t Pin);
+
+    /// @brief Find bus a GPIO is connected to (NULL = none)
+    static LIN_Bus_Host *findPin(uint8_t Pin);
+
+    /// @brief (Re-)start receiver at specified time, e.g. after a baudrate change or SoftwareSerial::listen()
+    void resync(LIN_Bus_Node &Node, uint32_t Time);
+
+    /// @brief Send byte at specified baudrate, starting at TimeStart [us]. Returns end of stop bit [us]
+    uint32_t transmit(uint8_t Data, uint32_t Baudrate, uint32_t TimeStart);
+
+    /// @brief Send break of specified number of dominant bits, followed by a stop bit. Returns end of stop bit [us]
+    uint32_t transmitBreak(uint8_t Bits, uint32_t Baudrate, uint32_t TimeStart);
+
+    /// @brief Drive dominant level (e.g. via GPIO) starting at or release at specified time [us]
+    void drive(bool Dominant, uint32_t Time);
+
+    /// @brief Bus level at specified time (true = dominant)
+    bool isDominant(uint32_t Time);
+
+    /// @brief Decode all bytes completed until specified time [us] and notify receivers and slaves
+    void update(uint32_t Now);
+
+}; // class LIN_Bus_Host
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_BUS_HOST_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
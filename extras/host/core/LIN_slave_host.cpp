@@ -0,0 +1,127 @@
+/**
+  \file     LIN_slave_host.cpp
+  \brief    Simple LIN slave model for host (Linux) builds
+  \details  The slave observes the bytes sent via a mocked HardwareSerial and injects configured responses.
+            Checksum and PID are calculated independent of the master library to allow cross-checking.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_host.h>
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor
+  \param[in]  Baudrate    nominal baudrate [Baud]. Bytes sent slower are considered BREAK
+*/
+LIN_Slave_Host::LIN_Slave_Host(uint32_t Baudrate)
+{
+  this->baudrate      = Baudrate;
+  this->responseSpace = 0;
+  this->state         = LIN_Slave_Host::WAIT_BREAK;
+  this->numHeaders    = 0;
+  this->numResponses  = 0;
+  memset(this->lenResponse, 0, sizeof(this->lenResponse));
+
+} // LIN_Slave_Host::LIN_Slave_Host()
+
+
+
+/**
+  \brief      Respond to frame ID
+  \details    Respond to frame ID with specified data and checksum. Diagnostic frames 0x3C/0x3D always use classic checksum
+  \param[in]  Id          frame ID (protected or unprotected)
+  \param[in]  NumData     number of data bytes (0..8)
+  \param[in]  Data        response data
+  \param[in]  Classic     use classic (LIN1.x) checksum
+*/
+void LIN_Slave_Host::setResponse(uint8_t Id, uint8_t NumData, const uint8_t Data[], bool Classic)
+{
+  uint16_t  chk = 0;
+
+  // unprotected ID
+  Id &= 0x3F;
+
+  // enhanced checksum includes PID
+  if (!(Classic || (Id == 0x3C) || (Id == 0x3D)))
+  {
+    uint8_t p0 = ((Id >> 0) ^ (Id >> 1) ^ (Id >> 2) ^ (Id >> 4)) & 0x01;
+    uint8_t p1 = (~((Id >> 1) ^ (Id >> 3) ^ (Id >> 4) ^ (Id >> 5))) & 0x01;
+    chk = (uint16_t) (Id | (p0 << 6) | (p1 << 7));
+  }
+
+  // sum with carry over data bytes
+  for (uint8_t i = 0; i < NumData; i++)
+  {
+    this->bufResponse[Id][i] = Data[i];
+    chk += Data[i];
+    if (chk > 255)
+      chk -= 255;
+  }
+  this->bufResponse[Id][NumData] = (uint8_t) (~chk);
+  this->lenResponse[Id] = NumData + 1;
+
+} // LIN_Slave_Host::setResponse()
+
+
+
+/**
+  \brief      Observe byte sent by master
+  \details    Observe byte sent by master. After BREAK, SYNC and PID with configured response, inject response bytes
+  \param[in]  Port        interface used by master
+  \param[in]  Data        sent byte
+  \param[in]  Baudrate    baudrate used for sending [Baud]
+  \param[in]  TimeEnd     micros() when stop bit is sent
+*/
+void LIN_Slave_Host::onTransmit(HardwareSerial &Port, uint8_t Data, uint32_t Baudrate, uint32_t TimeEnd)
+{
+  // byte sent at lower baudrate is BREAK, independent of state
+  if ((Data == 0x00) && (Baudrate < this->baudrate))
+  {
+    this->state = LIN_Slave_Host::WAIT_SYNC;
+    return;
+  }
+
+  // act according to state
+  switch (this->state)
+  {
+    // wait for SYNC
+    case LIN_Slave_Host::WAIT_SYNC:
+      this->state = (Data == 0x55) ? LIN_Slave_Host::WAIT_PID : LIN_Slave_Host::WAIT_BREAK;
+      break;
+
+    // PID received -> optionally send response
+    case LIN_Slave_Host::WAIT_PID:
+      {
+        this->numHeaders++;
+        uint8_t id = Data & 0x3F;
+        if (this->lenResponse[id] > 0)
+        {
+          uint32_t timePerByte = (uint32_t) ((10000000ULL + Baudrate/2) / Baudrate);
+          uint32_t time = TimeEnd + this->responseSpace;
+          for (uint8_t i = 0; i < this->lenResponse[id]; i++)
+          {
+            time += timePerByte;
+            Port.inject(this->bufResponse[id][i], time);
+          }
+          this->numResponses++;
+        }
+        this->state = LIN_Slave_Host::WAIT_BREAK;
+      }
+      break;
+
+    // ignore other bytes, e.g. master request data
+    default:
+      break;
+
+  } // switch (state)
+
+} // LIN_Slave_Host::onTransmit()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
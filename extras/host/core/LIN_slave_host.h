@@ -0,0 +1,91 @@
+/**
+  \file     LIN_slave_host.h
+  \brief    Simple LIN slave model for host (Linux) builds
+  \details  The slave observes the bytes sent via a mocked HardwareSerial. After a BREAK (=byte sent at lower
+            baudrate), SYNC and a PID with a configured response, it injects the response bytes incl. checksum
+            into the receive buffer of the same interface, like a slave on a 1-wire LIN bus.
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_SLAVE_HOST_H_
+#define _LIN_SLAVE_HOST_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Simple LIN slave model attached to a mocked HardwareSerial
+
+  \details Simple LIN slave model attached to a mocked HardwareSerial. Responds to configured frame IDs.
+*/
+class LIN_Slave_Host : public HardwareSerial_Listener
+{
+  // PROTECTED TYPEDEFS
+  protected:
+
+    /// receive state of slave
+    typedef enum : uint8_t
+    {
+      WAIT_BREAK            = 0x01,             //!< wait for BREAK
+      WAIT_SYNC             = 0x02,             //!< wait for SYNC
+      WAIT_PID              = 0x04              //!< wait for protected ID
+    } state_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    uint32_t                baudrate;           //!< nominal baudrate [Baud]
+    uint32_t                responseSpace;      //!< delay [us] between PID and 1st response byte
+    state_t                 state;              //!< receive state
+    uint8_t                 lenResponse[64];    //!< response length per ID incl. checksum (0 = no response)
+    uint8_t                 bufResponse[64][9]; //!< response per ID incl. checksum
+
+
+  // PUBLIC VARIABLES
+  public:
+
+    uint32_t                numHeaders;         //!< number of received frame headers
+    uint32_t                numResponses;       //!< number of sent slave responses
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Constructor
+    LIN_Slave_Host(uint32_t Baudrate = 19200);
+
+    /// @brief Set delay [us] between end of PID and start of response
+    void setResponseSpace(uint32_t Time) { this->responseSpace = Time; }
+
+    /// @brief Respond to frame ID with specified data and classic (LIN1.x) or enhanced (LIN2.x) checksum
+    void setResponse(uint8_t Id, uint8_t NumData, const uint8_t Data[], bool Classic = false);
+
+    /// @brief Don't respond to frame ID
+    void clearResponse(uint8_t Id) { this->lenResponse[Id & 0x3F] = 0; }
+
+    /// @brief Observe byte sent by master
+    void onTransmit(HardwareSerial &Port, uint8_t Data, uint32_t Baudrate, uint32_t TimeEnd);
+
+}; // class LIN_Slave_Host
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_SLAVE_HOST_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,244 @@
+/**
+  \file     LIN_slave_sim.cpp
+  \brief    Scriptable LIN slave model for the simulated LIN bus of host (Linux) builds
+  \details  Checksum and PID are calculated independent of the master library to allow cross-checking.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_sim.h>
+
+
+/**************************
+ * LOCAL FUNCTIONS
+**************************/
+
+/**
+  \brief      Calculate protected ID
+  \param[in]  Id        frame ID (protected or unprotected)
+  \return     protected ID
+*/
+static uint8_t _protectedId(uint8_t Id)
+{
+  Id &= 0x3F;
+  uint8_t p0 = ((Id >> 0) ^ (Id >> 1) ^ (Id >> 2) ^ (Id >> 4)) & 0x01;
+  uint8_t p1 = (~((Id >> 1) ^ (Id >> 3) ^ (Id >> 4) ^ (Id >> 5))) & 0x01;
+  return (uint8_t) (Id | (p0 << 6) | (p1 << 7));
+
+} // _protectedId()
+
+
+
+/**
+  \brief      Calculate checksum
+  \details    Calculate checksum. Diagnostic frames 0x3C/0x3D always use classic checksum
+  \param[in]  Id        frame ID (unprotected)
+  \param[in]  NumData   number of data bytes (0..8)
+  \param[in]  Data      data bytes
+  \param[in]  Classic   use classic (LIN1.x) checksum
+  \return     checksum
+*/
+static uint8_t _checksum(uint8_t Id, uint8_t NumData, const uint8_t Data[], bool Classic)
+{
+  uint16_t  chk = 0;
+
+  // enhanced checksum includes PID
+  if (!(Classic || (Id == 0x3C) || (Id == 0x3D)))
+    chk = _protectedId(Id);
+
+  // sum with carry over data bytes
+  for (uint8_t i = 0; i < NumData; i++)
+  {
+    chk += Data[i];
+    if (chk > 255)
+      chk -= 255;
+  }
+  return (uint8_t) (~chk);
+
+} // _checksum()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor
+  \param[in]  Seed        seed of pseudo random generator for jitter (!=0)
+*/
+LIN_Slave_Sim::LIN_Slave_Sim(uint32_t Seed)
+{
+  this->state          = LIN_Slave_Sim::WAIT_BREAK;
+  this->responseSpace  = 0;
+  this->responseJitter = 0;
+  this->interByteSpace = 0;
+  this->random         = (Seed != 0) ? Seed : 1;
+  this->script         = NULL;
+  this->scriptArg      = NULL;
+  this->numBreaks      = 0;
+  this->numHeaders     = 0;
+  this->numResponses   = 0;
+  this->numRequests    = 0;
+  this->request        = NULL;
+  this->requestArg     = NULL;
+  this->idRequest      = 0;
+  this->idxRequest     = 0;
+  this->timeRx         = 0;
+  memset(this->lenResponse, 0, sizeof(this->lenResponse));
+  memset(this->lenRequest, 0, sizeof(this->lenRequest));
+  memset(this->classicRequest, 0, sizeof(this->classicRequest));
+
+} // LIN_Slave_Sim::LIN_Slave_Sim()
+
+
+
+/**
+  \brief      Respond to frame ID
+  \details    Respond to frame ID with specified data and checksum. Diagnostic frames 0x3C/0x3D always use classic checksum
+  \param[in]  Id          frame ID (protected or unprotected)
+  \param[in]  NumData     number of data bytes (0..8)
+  \param[in]  Data        response data
+  \param[in]  Classic     use classic (LIN1.x) checksum
+*/
+void LIN_Slave_Sim::setResponse(uint8_t Id, uint8_t NumData, const uint8_t Data[], bool Classic)
+{
+  // unprotected ID
+  Id &= 0x3F;
+
+  // copy data and append checksum
+  memcpy(this->bufResponse[Id], Data, NumData);
+  this->bufResponse[Id][NumData] = _checksum(Id, NumData, Data, Classic);
+  this->lenResponse[Id] = NumData + 1;
+
+} // LIN_Slave_Sim::setResponse()
+
+
+
+/**
+  \brief      Receive master requests of frame ID
+  \details    Receive master requests of frame ID. Requests with correct checksum are passed to the request handler,
+              see attachRequest(). Diagnostic frames 0x3C/0x3D always use classic checksum
+  \param[in]  Id          frame ID (protected or unprotected)
+  \param[in]  NumData     number of data bytes (0..8, 0 = don't receive)
+  \param[in]  Classic     use classic (LIN1.x) checksum
+*/
+void LIN_Slave_Sim::setRequest(uint8_t Id, uint8_t NumData, bool Classic)
+{
+  this->lenRequest[Id & 0x3F]     = (NumData > 0) ? NumData + 1 : 0;
+  this->classicRequest[Id & 0x3F] = Classic;
+
+} // LIN_Slave_Sim::setRequest()
+
+
+
+/**
+  \brief      Byte was decoded from bus
+  \details    Byte was decoded from bus at nominal baudrate. After BREAK, SYNC and PID with configured response,
+              send response bytes via bus
+  \param[in]  Bus         simulated LIN bus
+  \param[in]  Data        received byte
+  \param[in]  FrameError  stop bit was dominant
+  \param[in]  Time        end of stop bit [us]
+*/
+void LIN_Slave_Sim::onReceive(LIN_Bus_Host &Bus, uint8_t Data, bool FrameError, uint32_t Time)
+{
+  // time of last byte, e.g. for scripts
+  this->timeRx = Time;
+
+  // 0x00 with framing error is BREAK, independent of state
+  if ((Data == 0x00) && FrameError)
+  {
+    this->numBreaks++;
+    this->state = LIN_Slave_Sim::WAIT_SYNC;
+    return;
+  }
+
+  // act according to state
+  switch (this->state)
+  {
+    // wait for SYNC
+    case LIN_Slave_Sim::WAIT_SYNC:
+      this->state = ((Data == 0x55) && (!FrameError)) ? LIN_Slave_Sim::WAIT_PID : LIN_Slave_Sim::WAIT_BREAK;
+      break;
+
+    // PID received -> optionally send response
+    case LIN_Slave_Sim::WAIT_PID:
+      {
+        uint8_t id = Data & 0x3F;
+        this->state = LIN_Slave_Sim::WAIT_BREAK;
+
+        // ignore PID with parity or framing error
+        if ((Data != _protectedId(id)) || FrameError)
+          break;
+        this->numHeaders++;
+
+        // receive master request
+        if (this->lenRequest[id] > 0)
+        {
+          this->idRequest  = id;
+          this->idxRequest = 0;
+          this->state      = LIN_Slave_Sim::WAIT_DATA;
+          break;
+        }
+
+        // optional script may change or suppress response
+        if ((this->script != NULL) && (!this->script(*this, id, this->scriptArg)))
+          break;
+        if (this->lenResponse[id] == 0)
+          break;
+
+        // response space with random jitter (xorshift32)
+        uint32_t time = Time + this->responseSpace;
+        if (this->responseJitter > 0)
+        {
+          this->random ^= this->random << 13;
+          this->random ^= this->random >> 17;
+          this->random ^= this->random << 5;
+          time += this->random % (this->responseJitter + 1);
+        }
+
+        // send response via bus
+        for (uint8_t i = 0; i < this->lenResponse[id]; i++)
+          time = Bus.transmit(this->bufResponse[id][i], Bus.getBaudrate(), time) + this->interByteSpace;
+        this->numResponses++;
+      }
+      break;
+
+    // receive master request data and checksum
+    case LIN_Slave_Sim::WAIT_DATA:
+      {
+        uint8_t id = this->idRequest;
+
+        // abort on framing error
+        if (FrameError)
+        {
+          this->state = LIN_Slave_Sim::WAIT_BREAK;
+          break;
+        }
+
+        // store byte. After checksum pass correct request to handler
+        this->bufRequest[this->idxRequest++] = Data;
+        if (this->idxRequest < this->lenRequest[id])
+          break;
+        this->state = LIN_Slave_Sim::WAIT_BREAK;
+        uint8_t numData = this->lenRequest[id] - 1;
+        if (this->bufRequest[numData] != _checksum(id, numData, this->bufRequest, this->classicRequest[id]))
+          break;
+        this->numRequests++;
+        if (this->request != NULL)
+          this->request(*this, id, numData, this->bufRequest, this->requestArg);
+      }
+      break;
+
+    // ignore other bytes, e.g. responses
+    default:
+      break;
+
+  } // switch (state)
+
+} // LIN_Slave_Sim::onReceive()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,131 @@
+/**
+  \file     LIN_slave_sim.h
+  \brief    Scriptable LIN slave model for the simulated LIN bus of host (Linux) builds
+  \details  The slave receives bytes decoded from a LIN_Bus_Host at nominal baudrate. After a BREAK (=0x00 with
+            framing error), SYNC and a PID with correct parity it sends a configured response via the bus, after
+            a response space with optional random jitter. An optional script is called for each frame header and
+            may change the response or suppress it. Master requests of configured IDs are received and passed to an
+            optional request handler, e.g. for a diagnostic transport layer (see LIN_slave_tp.h).
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_SLAVE_SIM_H_
+#define _LIN_SLAVE_SIM_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+#include <LIN_bus_host.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Scriptable LIN slave model attached to a simulated LIN bus
+
+  \details Scriptable LIN slave model attached to a simulated LIN bus, see LIN_Bus_Host::addSlave()
+*/
+class LIN_Slave_Sim
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// script called for each received frame header. Return false to suppress the response
+    typedef bool (*script_t)(LIN_Slave_Sim &Slave, uint8_t Id, void *Arg);
+
+    /// request handler called for each received master request with correct checksum
+    typedef void (*request_t)(LIN_Slave_Sim &Slave, uint8_t Id, uint8_t NumData, const uint8_t Data[], void *Arg);
+
+
+  // PROTECTED TYPEDEFS
+  protected:
+
+    /// receive state of slave
+    typedef enum : uint8_t
+    {
+      WAIT_BREAK            = 0x01,             //!< wait for BREAK
+      WAIT_SYNC             = 0x02,             //!< wait for SYNC
+      WAIT_PID              = 0x04,             //!< wait for protected ID
+      WAIT_DATA             = 0x08              //!< receive master request data and checksum
+    } state_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    state_t                 state;              //!< receive state
+    uint32_t                responseSpace;      //!< min. delay [us] between PID and 1st response byte
+    uint32_t                responseJitter;     //!< max. additional random delay [us] of response
+    uint32_t                interByteSpace;     //!< delay [us] between response bytes
+    uint32_t                random;             //!< state of pseudo random generator for jitter
+    script_t                script;             //!< optional script called for each header
+    void                    *scriptArg;         //!< optional argument of script
+    uint8_t                 lenResponse[64];    //!< response length per ID incl. checksum (0 = no response)
+    uint8_t                 bufResponse[64][9]; //!< response per ID incl. checksum
+    request_t               request;            //!< optional handler for received master requests
+    void                    *requestArg;        //!< optional argument of request handler
+    uint8_t                 lenRequest[64];     //!< request length per ID incl. checksum (0 = don't receive)
+    bool                    classicRequest[64]; //!< request uses classic checksum
+    uint8_t                 idRequest;          //!< ID of master request being received
+    uint8_t                 idxRequest;         //!< number of received request bytes
+    uint8_t                 bufRequest[9];      //!< received request incl. checksum
+    uint32_t                timeRx;             //!< end of last received byte [us]
+
+
+  // PUBLIC VARIABLES
+  public:
+
+    uint32_t                numBreaks;          //!< number of received BREAKs
+    uint32_t                numHeaders;         //!< number of received frame headers
+    uint32_t                numResponses;       //!< number of sent slave responses
+    uint32_t                numRequests;        //!< number of received master requests with correct checksum
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Constructor. Seed initializes the jitter of the response space
+    LIN_Slave_Sim(uint32_t Seed = 1);
+
+    /// @brief Set delay [us] between end of PID and start of response plus max. random jitter [us]
+    void setResponseSpace(uint32_t Space, uint32_t Jitter = 0) { this->responseSpace = Space; this->responseJitter = Jitter; }
+
+    /// @brief Set delay [us] between response bytes
+    void setInterByteSpace(uint32_t Space) { this->interByteSpace = Space; }
+
+    /// @brief Respond to frame ID with specified data and classic (LIN1.x) or enhanced (LIN2.x) checksum
+    void setResponse(uint8_t Id, uint8_t NumData, const uint8_t Data[], bool Classic = false);
+
+    /// @brief Don't respond to frame ID
+    void clearResponse(uint8_t Id) { this->lenResponse[Id & 0x3F] = 0; }
+
+    /// @brief Attach script called for each received frame header (NULL = none)
+    void attachScript(script_t Script, void *Arg = NULL) { this->script = Script; this->scriptArg = Arg; }
+
+    /// @brief Receive master requests of frame ID with classic (LIN1.x) or enhanced (LIN2.x) checksum
+    void setRequest(uint8_t Id, uint8_t NumData, bool Classic = false);
+
+    /// @brief Attach handler called for each received master request (NULL = none)
+    void attachRequest(request_t Handler, void *Arg = NULL) { this->request = Handler; this->requestArg = Arg; }
+
+    /// @brief Byte was decoded from bus at nominal baudrate. Stop bit ends at Time [us]
+    void onReceive(LIN_Bus_Host &Bus, uint8_t Data, bool FrameError, uint32_t Time);
+
+}; // class LIN_Slave_Sim
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_SLAVE_SIM_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,240 @@
+/**
+  \file     LIN_slave_tp.cpp
+  \brief    LIN slave model with diagnostic transport layer for the simulated LIN bus of host (Linux) builds
+  \details  PCI and sequence numbers are checked independent of the master library to allow cross-checking.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_slave_tp.h>
+
+
+/**************************
+ * LOCAL FUNCTIONS
+**************************/
+
+/**
+  \brief      Echo service
+  \details    Echo service with positive response, i.e. SID+0x40 followed by the request parameters
+*/
+static uint16_t _echo(LIN_Slave_TP &Slave, const uint8_t Request[], uint16_t Length, uint8_t Response[], void *Arg)
+{
+  (void) Slave;
+  (void) Arg;
+
+  memcpy(Response, Request, Length);
+  Response[0] = Request[0] + 0x40;
+  return Length;
+
+} // _echo()
+
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Reassemble master request
+  \details    Reassemble master request (ID 0x3C) from single, first and consecutive frames. Complete requests are
+              passed to the service. A new request discards a pending response.
+*/
+void LIN_Slave_TP::_onRequest(LIN_Slave_Sim &Slave, uint8_t Id, uint8_t NumData, const uint8_t Data[], void *Arg)
+{
+  LIN_Slave_TP  &tp = *((LIN_Slave_TP *) Arg);
+  uint8_t       pci = Data[1];
+  uint16_t      num;
+
+  (void) Slave;
+
+  // only diagnostic requests to own NAD or wildcard
+  if ((Id != 0x3C) || (NumData != 8) || ((Data[0] != tp.nad) && (Data[0] != 0x7F)))
+    return;
+
+  // act according to PCI type
+  switch (pci >> 4)
+  {
+    // single frame
+    case 0x0:
+      if (((pci & 0x0F) == 0) || ((pci & 0x0F) > 6))
+      {
+        tp.numDiagErrors++;
+        return;
+      }
+      tp.lenReq = pci & 0x0F;
+      memcpy(tp.bufReq, Data+2, tp.lenReq);
+      tp.idxReq = tp.lenReq;
+      break;
+
+    // first frame
+    case 0x1:
+      tp.lenReq = ((uint16_t) (pci & 0x0F) << 8) | Data[2];
+      if (tp.lenReq < 7)
+      {
+        tp.numDiagErrors++;
+        tp.lenReq = 0;
+        return;
+      }
+      memcpy(tp.bufReq, Data+3, 5);
+      tp.idxReq = 5;
+      tp.seqReq = 1;
+      tp.lenResp = 0;
+      return;
+
+    // consecutive frame
+    case 0x2:
+      if ((tp.lenReq == 0) || (tp.idxReq >= tp.lenReq) || ((pci & 0x0F) != tp.seqReq))
+      {
+        tp.numDiagErrors++;
+        tp.lenReq = 0;
+        return;
+      }
+      num = tp.lenReq - tp.idxReq;
+      if (num > 6)
+        num = 6;
+      memcpy(tp.bufReq + tp.idxReq, Data+2, num);
+      tp.idxReq += num;
+      tp.seqReq = (tp.seqReq + 1) & 0x0F;
+      if (tp.idxReq < tp.lenReq)
+        return;
+      break;
+
+    // unknown PCI
+    default:
+      tp.numDiagErrors++;
+      return;
+
+  } // switch (PCI type)
+
+  // request complete -> call service and prepare response
+  tp.numDiagRequests++;
+  tp.lenResp     = (tp.service != NULL) ? tp.service(tp, tp.bufReq, tp.lenReq, tp.bufResp, tp.serviceArg) : _echo(tp, tp.bufReq, tp.lenReq, tp.bufResp, NULL);
+  tp.idxResp     = 0;
+  tp.seqResp     = 1;
+  tp.pendingLeft = tp.numPending;
+  tp.timeReady   = tp.timeRx + tp.processTime;
+  tp.lenReq      = 0;
+
+} // LIN_Slave_TP::_onRequest()
+
+
+
+/**
+  \brief      Prepare next frame of response
+  \details    Prepare next frame of response for a slave response header (ID 0x3D). Is not answered if no response
+              is pending or the response is not yet ready. Other IDs use the configured static responses
+*/
+bool LIN_Slave_TP::_onHeader(LIN_Slave_Sim &Slave, uint8_t Id, void *Arg)
+{
+  LIN_Slave_TP  &tp = *((LIN_Slave_TP *) Arg);
+  uint8_t       frame[8];
+  uint16_t      num;
+
+  // other IDs -> static response
+  if (Id != 0x3D)
+    return true;
+
+  // no response pending or not yet ready -> no answer
+  if ((tp.lenResp == 0) || ((int32_t) (tp.timeRx - tp.timeReady) < 0))
+  {
+    tp.numNotReady++;
+    return false;
+  }
+
+  // construct next frame. Unused bytes are 0xFF
+  memset(frame, 0xFF, sizeof(frame));
+  frame[0] = tp.nad;
+
+  // response pending (NRC 0x78), then wait again
+  if (tp.pendingLeft > 0)
+  {
+    tp.pendingLeft--;
+    tp.timeReady = tp.timeRx + tp.processTime;
+    frame[1] = 0x03;
+    frame[2] = 0x7F;
+    frame[3] = tp.bufReq[0];
+    frame[4] = 0x78;
+  }
+
+  // single frame
+  else if (tp.lenResp <= 6)
+  {
+    frame[1] = (uint8_t) tp.lenResp;
+    memcpy(frame+2, tp.bufResp, tp.lenResp);
+    tp.lenResp = 0;
+    tp.numDiagResponses++;
+  }
+
+  // first frame
+  else if (tp.idxResp == 0)
+  {
+    frame[1] = 0x10 | (uint8_t) (tp.lenResp >> 8);
+    frame[2] = (uint8_t) tp.lenResp;
+    memcpy(frame+3, tp.bufResp, 5);
+    tp.idxResp = 5;
+  }
+
+  // consecutive frame
+  else
+  {
+    num = tp.lenResp - tp.idxResp;
+    if (num > 6)
+      num = 6;
+    frame[1] = 0x20 | tp.seqResp;
+    memcpy(frame+2, tp.bufResp + tp.idxResp, num);
+    tp.idxResp += num;
+    tp.seqResp = (tp.seqResp + 1) & 0x0F;
+    if (tp.idxResp >= tp.lenResp)
+    {
+      tp.lenResp = 0;
+      tp.numDiagResponses++;
+    }
+  }
+
+  // send frame
+  Slave.setResponse(0x3D, sizeof(frame), frame);
+  return true;
+
+} // LIN_Slave_TP::_onHeader()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor
+  \param[in]  NAD         node address
+  \param[in]  Seed        seed of pseudo random generator for jitter (!=0)
+*/
+LIN_Slave_TP::LIN_Slave_TP(uint8_t NAD, uint32_t Seed) : LIN_Slave_Sim(Seed)
+{
+  this->nad              = NAD;
+  this->service          = NULL;
+  this->serviceArg       = NULL;
+  this->processTime      = 0;
+  this->numPending       = 0;
+  this->lenReq           = 0;
+  this->idxReq           = 0;
+  this->seqReq           = 0;
+  this->lenResp          = 0;
+  this->idxResp          = 0;
+  this->seqResp          = 0;
+  this->pendingLeft      = 0;
+  this->timeReady        = 0;
+  this->numDiagRequests  = 0;
+  this->numDiagResponses = 0;
+  this->numDiagErrors    = 0;
+  this->numNotReady      = 0;
+
+  // receive diagnostic requests and answer slave response headers
+  this->setRequest(0x3C, 8);
+  this->attachRequest(LIN_Slave_TP::_onRequest, this);
+  this->attachScript(LIN_Slave_TP::_onHeader, this);
+
+} // LIN_Slave_TP::LIN_Slave_TP()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
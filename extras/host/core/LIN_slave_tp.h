@@ -0,0 +1,115 @@
+/**
+  \file     LIN_slave_tp.h
+  \brief    LIN slave model with diagnostic transport layer for the simulated LIN bus of host (Linux) builds
+  \details  The slave reassembles single, first and consecutive frames of master requests (ID 0x3C) addressed to its
+            NAD (or the wildcard 0x7F), passes the complete request to a service and sends the segmented response
+            via slave responses (ID 0x3D). Before the response is ready (processing time) slave response headers
+            are not answered, and optionally "response pending" (NRC 0x78) is sent first. Default service is an echo
+            with positive response SID+0x40. PCI and sequence numbers are checked independent of the master library.
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_SLAVE_TP_H_
+#define _LIN_SLAVE_TP_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <LIN_slave_sim.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#define HOST_TP_MAX_LEN         4095          //!< max. length of diagnostic request or response
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN slave model with diagnostic transport layer
+
+  \details LIN slave model with diagnostic transport layer, see LIN_Bus_Host::addSlave()
+*/
+class LIN_Slave_TP : public LIN_Slave_Sim
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// diagnostic service. Returns response length (0 = no response)
+    typedef uint16_t (*service_t)(LIN_Slave_TP &Slave, const uint8_t Request[], uint16_t Length, uint8_t Response[], void *Arg);
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    uint8_t                 nad;                //!< node address
+    service_t               service;            //!< diagnostic service
+    void                    *serviceArg;        //!< argument of service
+    uint32_t                processTime;        //!< time [us] from request until response (or pending) is ready
+    uint8_t                 numPending;         //!< number of "response pending" before response
+
+    // request reassembly
+    uint8_t                 bufReq[HOST_TP_MAX_LEN];  //!< request
+    uint16_t                lenReq;             //!< request length (0 = no request)
+    uint16_t                idxReq;             //!< number of received request bytes
+    uint8_t                 seqReq;             //!< expected sequence number of next consecutive frame
+
+    // response segmentation
+    uint8_t                 bufResp[HOST_TP_MAX_LEN];  //!< response
+    uint16_t                lenResp;            //!< response length (0 = no response)
+    uint16_t                idxResp;            //!< number of sent response bytes
+    uint8_t                 seqResp;            //!< sequence number of next consecutive frame
+    uint8_t                 pendingLeft;        //!< remaining "response pending" before response
+    uint32_t                timeReady;          //!< time [us] when next response frame is ready
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Reassemble master request
+    static void _onRequest(LIN_Slave_Sim &Slave, uint8_t Id, uint8_t NumData, const uint8_t Data[], void *Arg);
+
+    /// @brief Prepare next frame of response
+    static bool _onHeader(LIN_Slave_Sim &Slave, uint8_t Id, void *Arg);
+
+
+  // PUBLIC VARIABLES
+  public:
+
+    uint32_t                numDiagRequests;    //!< number of complete diagnostic requests
+    uint32_t                numDiagResponses;   //!< number of complete diagnostic responses
+    uint32_t                numDiagErrors;      //!< number of PCI or sequence errors
+    uint32_t                numNotReady;        //!< number of unanswered slave response headers
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Constructor. Seed initializes the jitter of the response space
+    LIN_Slave_TP(uint8_t NAD, uint32_t Seed = 1);
+
+    /// @brief Attach diagnostic service (NULL = echo)
+    void attachService(service_t Service, void *Arg = NULL) { this->service = Service; this->serviceArg = Arg; }
+
+    /// @brief Set processing time [us] and number of "response pending" (NRC 0x78) before response
+    void setProcessTime(uint32_t Time, uint8_t NumPending = 0) { this->processTime = Time; this->numPending = NumPending; }
+
+}; // class LIN_Slave_TP
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_SLAVE_TP_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
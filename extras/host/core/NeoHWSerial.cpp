@@ -0,0 +1,122 @@
+/**
+  \file     NeoHWSerial.cpp
+  \brief    Mock of NeoHWSerial for host (Linux) builds
+  \details  Timing-accurate HardwareSerial mock with the per-byte receive interrupt of NeoHWSerial, see attachInterrupt().
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <NeoHWSerial.h>
+
+
+/**************************
+ * GLOBAL VARIABLES
+**************************/
+
+NeoHWSerial      NeoSerial;          // emulated UART 0
+NeoHWSerial      NeoSerial1;         // emulated UART 1
+
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Simulated peripheral ISR
+  \details    Simulated peripheral ISR, see attachIrq(). Calls Rx ISR for each byte received until now, in order of
+              reception. Bytes for which the Rx ISR returns true are stored in the ring buffer
+  \param[in]  Arg       serial interface
+*/
+void NeoHWSerial::_serviceRx(void *Arg)
+{
+  NeoHWSerial *serial = (NeoHWSerial*) Arg;
+
+  // pass received bytes to Rx ISR. ISR may detach itself
+  while ((serial->isr != NULL) && (serial->HardwareSerial::available() > 0))
+  {
+    uint8_t data = (uint8_t) serial->HardwareSerial::read();
+    if ((serial->isr(data, 0x00)) && (serial->numIsr < HOST_SERIAL_RX_BUFLEN))
+      serial->bufIsr[serial->numIsr++] = data;
+  }
+
+} // NeoHWSerial::_serviceRx()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Attach Rx ISR
+  \details    Attach Rx ISR, which is called for each received byte instead of storing it in the ring buffer
+  \param[in]  Isr       Rx ISR (NULL = detach)
+*/
+void NeoHWSerial::attachInterrupt(isr_t Isr)
+{
+  this->isr = Isr;
+  if (Isr != NULL)
+    attachIrq(NeoHWSerial::_serviceRx, this);
+  else
+    detachIrq(this);
+
+} // NeoHWSerial::attachInterrupt()
+
+
+
+/**
+  \brief      Close interface and discard received bytes
+*/
+void NeoHWSerial::end(void)
+{
+  HardwareSerial::end();
+  this->numIsr = 0;
+
+} // NeoHWSerial::end()
+
+
+
+/**
+  \brief      Number of received bytes in ring buffer
+  \details    Number of received bytes in ring buffer. W/o Rx ISR, received bytes are stored directly
+  \return     number of bytes
+*/
+int NeoHWSerial::available(void)
+{
+  int num = (int) this->numIsr;
+
+  // no Rx ISR -> bytes received until now
+  if (this->isr == NULL)
+    num += HardwareSerial::available();
+  return num;
+
+} // NeoHWSerial::available()
+
+
+
+/**
+  \brief      Read next received byte from ring buffer
+  \return     received byte or -1 if none
+*/
+int NeoHWSerial::read(void)
+{
+  // byte stored by Rx ISR
+  if (this->numIsr > 0)
+  {
+    uint8_t data = this->bufIsr[0];
+    this->numIsr--;
+    memmove(this->bufIsr, this->bufIsr+1, this->numIsr);
+    return data;
+  }
+
+  // no Rx ISR -> bytes received until now
+  if (this->isr == NULL)
+    return HardwareSerial::read();
+  return -1;
+
+} // NeoHWSerial::read()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
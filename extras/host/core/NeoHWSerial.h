@@ -0,0 +1,98 @@
+/**
+  \file     NeoHWSerial.h
+  \brief    Mock of NeoHWSerial for host (Linux) builds
+  \details  Timing-accurate HardwareSerial mock with the per-byte receive interrupt of NeoHWSerial, see attachInterrupt().
+            The Rx ISR is called for each received byte as simulated peripheral ISR (see attachIrq()), i.e. when the
+            program waits or enables interrupts at or after the reception time of the byte. If the ISR returns true,
+            the byte is stored in the ring buffer (see available() and read()), else it is discarded.
+            The status argument of the ISR is always 0x00 (no framing error or overrun) on host.
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _NEO_HW_SERIAL_HOST_H_
+#define _NEO_HW_SERIAL_HOST_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASSES
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief  Mock of NeoHWSerial
+
+  \details Mock of NeoHWSerial, i.e. HardwareSerial with optional per-byte receive interrupt
+*/
+class NeoHWSerial : public HardwareSerial
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// Rx ISR, called for each received byte with data and UART status. Return true to store byte in ring buffer
+    typedef bool (*isr_t)(uint8_t Data, uint8_t Status);
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    isr_t                   isr;                //!< optional Rx ISR (NULL = none)
+    uint8_t                 numIsr;             //!< number of bytes stored by Rx ISR
+    uint8_t                 bufIsr[HOST_SERIAL_RX_BUFLEN];  //!< bytes stored by Rx ISR
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Simulated peripheral ISR: call Rx ISR for each byte received until now
+    static void _serviceRx(void *Arg);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Constructor
+    NeoHWSerial(void) : HardwareSerial(false), isr(NULL), numIsr(0) { }
+
+    /// @brief Attach Rx ISR, which is called for each received byte (NULL = detach)
+    void attachInterrupt(isr_t Isr);
+
+    /// @brief Detach Rx ISR, i.e. received bytes are stored in ring buffer
+    void detachInterrupt(void) { this->attachInterrupt(NULL); }
+
+    /// @brief Close interface and discard received bytes
+    void end(void);
+
+    /// @brief Number of received bytes in ring buffer
+    int available(void);
+
+    /// @brief Read next received byte from ring buffer or -1 if none
+    int read(void);
+
+}; // class NeoHWSerial
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL VARIABLES
+-----------------------------------------------------------------------------*/
+
+extern NeoHWSerial      NeoSerial;      //!< emulated UART 0 (no console)
+extern NeoHWSerial      NeoSerial1;     //!< emulated UART 1
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _NEO_HW_SERIAL_HOST_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,248 @@
+/**
+  \file     SoftwareSerial.cpp
+  \brief    SoftwareSerial mock for host (Linux) builds
+  \details  Sending and receiving via a simulated LIN bus connected to the Tx pin. write() busy waits until the
+            stop bit has been sent, like the bit-banging on AVR.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <SoftwareSerial.h>
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor
+  \param[in]  PinRx         receive pin (not used)
+  \param[in]  PinTx         transmit pin, must be connected to simulated bus via LIN_Bus_Host::connectPin()
+  \param[in]  InverseLogic  not supported
+*/
+SoftwareSerial::SoftwareSerial(uint8_t PinRx, uint8_t PinTx, bool InverseLogic)
+{
+  (void) InverseLogic;
+
+  this->pinRx     = PinRx;
+  this->pinTx     = PinTx;
+  this->baudrate  = 9600;
+  this->isOpen    = false;
+  this->listening = false;
+  this->sentIdle  = false;
+  this->timeTxEnd = 0;
+  this->pBus      = NULL;
+  this->numRx     = 0;
+
+} // SoftwareSerial::SoftwareSerial()
+
+
+
+/**
+  \brief      Open interface and start listening
+  \details    Open interface with specified baudrate and start listening. Connects to simulated bus of Tx pin
+  \param[in]  Baudrate  communication speed [Baud]
+*/
+void SoftwareSerial::begin(long Baudrate)
+{
+  // connect to simulated bus once
+  if (this->pBus == NULL)
+  {
+    this->pBus = LIN_Bus_Host::findPin(this->pinTx);
+    if (this->pBus != NULL)
+      this->pBus->attach(*this);
+  }
+
+  // idle level is recessive
+  pinMode(this->pinTx, OUTPUT);
+  digitalWrite(this->pinTx, HIGH);
+
+  this->baudrate = (uint32_t) Baudrate;
+  this->isOpen   = true;
+  this->listen();
+
+} // SoftwareSerial::begin()
+
+
+
+/**
+  \brief      Close interface and discard received bytes
+*/
+void SoftwareSerial::end(void)
+{
+  this->stopListening();
+  this->isOpen = false;
+  this->numRx  = 0;
+
+} // SoftwareSerial::end()
+
+
+
+/**
+  \brief      Start receiving
+  \details    Start receiving. Bytes started before are ignored. If bytes were sent while not listening, receiving
+              starts after the last stop bit, i.e. independent of OS scheduling delays of the host
+  \return     true if listening was started
+*/
+bool SoftwareSerial::listen(void)
+{
+  if (this->listening)
+    return false;
+
+  if (this->pBus != NULL)
+  {
+    this->pBus->update(micros());
+    this->pBus->resync(*this, this->sentIdle ? this->timeTxEnd : micros());
+  }
+  this->listening = true;
+  this->sentIdle  = false;
+  return true;
+
+} // SoftwareSerial::listen()
+
+
+
+/**
+  \brief      Stop receiving
+  \return     true if was listening
+*/
+bool SoftwareSerial::stopListening(void)
+{
+  if (!this->listening)
+    return false;
+
+  if (this->pBus != NULL)
+    this->pBus->update(micros());
+  this->listening = false;
+  return true;
+
+} // SoftwareSerial::stopListening()
+
+
+
+/**
+  \brief      Number of received bytes
+  \return     number of bytes whose stop bit has been received
+*/
+int SoftwareSerial::available(void)
+{
+  if (this->pBus != NULL)
+    this->pBus->update(micros());
+  return this->numRx;
+
+} // SoftwareSerial::available()
+
+
+
+/**
+  \brief      Read next received byte
+  \return     received byte or -1 if none
+*/
+int SoftwareSerial::read(void)
+{
+  if (this->available() == 0)
+    return -1;
+
+  uint8_t data = this->bufRx[0];
+  this->numRx--;
+  memmove(this->bufRx, this->bufRx+1, this->numRx);
+  return data;
+
+} // SoftwareSerial::read()
+
+
+
+/**
+  \brief      Read received bytes with timeout
+  \details    Read received bytes. Like Arduino Stream, wait up to HOST_SERIAL_TIMEOUT for missing bytes
+  \param[out] Buffer    received bytes
+  \param[in]  Length    number of bytes to read
+  \return     number of read bytes
+*/
+size_t SoftwareSerial::readBytes(uint8_t *Buffer, size_t Length)
+{
+  uint32_t  start = millis();
+  size_t    num = 0;
+
+  while ((num < Length) && (millis() - start < HOST_SERIAL_TIMEOUT))
+  {
+    int c = this->read();
+    if (c >= 0)
+      Buffer[num++] = (uint8_t) c;
+  }
+  return num;
+
+} // SoftwareSerial::readBytes()
+
+
+
+/**
+  \brief      Blocking send of byte
+  \details    Blocking send of byte. Like on AVR, nothing is received during sending
+  \param[in]  Data      byte to send
+  \return     number of sent bytes
+*/
+size_t SoftwareSerial::write(uint8_t Data)
+{
+  if ((!this->isOpen) || (this->pBus == NULL))
+    return 0;
+
+  // receiver is blocked while sending
+  bool listening = this->listening;
+  if (listening)
+    this->stopListening();
+
+  // send and wait until stop bit is sent
+  this->timeTxEnd = this->pBus->transmit(Data, this->baudrate, micros());
+  this->sentIdle  = true;
+  int32_t wait = (int32_t) (this->timeTxEnd - micros());
+  if (wait > 0)
+    delayMicroseconds((uint32_t) wait);
+
+  // optionally resume receiving
+  if (listening)
+    this->listen();
+  return 1;
+
+} // SoftwareSerial::write()
+
+
+
+/**
+  \brief      Blocking send of bytes
+  \param[in]  Buffer    bytes to send
+  \param[in]  Length    number of bytes
+  \return     number of sent bytes
+*/
+size_t SoftwareSerial::write(const uint8_t *Buffer, size_t Length)
+{
+  size_t num = 0;
+
+  for (size_t i = 0; i < Length; i++)
+    num += this->write(Buffer[i]);
+  return num;
+
+} // SoftwareSerial::write()
+
+
+
+/**
+  \brief      Byte decoded from simulated LIN bus
+  \details    Byte decoded from simulated LIN bus. Like on AVR, the stop bit is not checked
+  \param[in]  Data        received byte
+  \param[in]  FrameError  stop bit was dominant (not used)
+  \param[in]  Time        end of stop bit [us] (not used)
+*/
+void SoftwareSerial::onReceive(uint8_t Data, bool FrameError, uint32_t Time)
+{
+  (void) FrameError;
+  (void) Time;
+
+  if (this->numRx < HOST_SERIAL_RX_BUFLEN)
+    this->bufRx[this->numRx++] = Data;
+
+} // SoftwareSerial::onReceive()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,106 @@
+/**
+  \file     SoftwareSerial.h
+  \brief    SoftwareSerial mock for host (Linux) builds
+  \details  Like on AVR, write() is blocking and only the listening instance receives. Sending and receiving require
+            a simulated LIN bus connected to the Tx pin via LIN_Bus_Host::connectPin() before begin(), see LIN_bus_host.h.
+            Inverse logic is not supported.
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _SOFTWARE_SERIAL_HOST_H_
+#define _SOFTWARE_SERIAL_HOST_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+#include <LIN_bus_host.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Mock of Arduino SoftwareSerial on a simulated LIN bus
+
+  \details Mock of Arduino SoftwareSerial on a simulated LIN bus
+*/
+class SoftwareSerial : public LIN_Bus_Node
+{
+  // PROTECTED VARIABLES
+  protected:
+
+    uint8_t                 pinRx;              //!< receive pin (not used)
+    uint8_t                 pinTx;              //!< transmit pin, connected to simulated bus
+    uint32_t                baudrate;           //!< current baudrate [Baud]
+    bool                    isOpen;             //!< interface opened via begin()
+    bool                    listening;          //!< instance is receiving
+    bool                    sentIdle;           //!< byte was sent while not listening
+    uint32_t                timeTxEnd;          //!< end [us] of last sent stop bit
+    LIN_Bus_Host            *pBus;              //!< simulated LIN bus connected to pinTx
+    uint8_t                 numRx;              //!< number of received bytes
+    uint8_t                 bufRx[HOST_SERIAL_RX_BUFLEN];   //!< received bytes
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Constructor
+    SoftwareSerial(uint8_t PinRx, uint8_t PinTx, bool InverseLogic = false);
+
+    /// @brief Open interface with specified baudrate and start listening
+    void begin(long Baudrate);
+
+    /// @brief Close interface and discard received bytes
+    void end(void);
+
+    /// @brief Start receiving
+    bool listen(void);
+
+    /// @brief Stop receiving
+    bool stopListening(void);
+
+    /// @brief Instance is receiving
+    bool isListening(void) { return this->listening; }
+
+    /// @brief Number of received bytes
+    int available(void);
+
+    /// @brief Read next received byte or -1 if none
+    int read(void);
+
+    /// @brief Read received bytes with timeout
+    size_t readBytes(uint8_t *Buffer, size_t Length);
+
+    /// @brief Blocking send of byte
+    size_t write(uint8_t Data);
+
+    /// @brief Blocking send of bytes
+    size_t write(const uint8_t *Buffer, size_t Length);
+
+    /// @brief Wait until all bytes have been sent. Nothing to do, as write() is blocking
+    void flush(void) { }
+
+
+    /// @brief Host only: receive baudrate for simulated LIN bus (0 = not listening)
+    uint32_t getRxBaudrate(void) { return (this->isOpen && this->listening) ? this->baudrate : 0; }
+
+    /// @brief Host only: byte decoded from simulated LIN bus
+    void onReceive(uint8_t Data, bool FrameError, uint32_t Time);
+
+}; // class SoftwareSerial
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _SOFTWARE_SERIAL_HOST_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
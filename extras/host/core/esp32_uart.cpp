@@ -0,0 +1,498 @@
+/**
+  \file     esp32_uart.cpp
+  \brief    Mock of ESP-IDF UART driver and FreeRTOS queue for host (Linux) builds
+  \details  UART_NUM_1 and UART_NUM_2 are mapped to the mocked HardwareSerial Serial1 and Serial2. The driver ISR, which
+            moves received bytes from the Rx FIFO to the ring buffer and sends UART_DATA events, is modelled from the
+            reception times of the HardwareSerial mock whenever the driver or the event queue is accessed.
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <HardwareSerial.h>
+#include <esp32_uart.h>
+
+
+/**************************
+ * LOCAL TYPES
+**************************/
+
+/// FreeRTOS queue of UART events
+struct QueueDefinition
+{
+  uart_port_t           port;                 //!< UART which sends the events
+  uint8_t               size;                 //!< max. number of pending events
+  uint8_t               num;                  //!< number of pending events
+  uart_event_t          event[HOST_UART_QUEUE_LEN];   //!< pending events, oldest first
+};
+
+/// state of UART driver
+typedef struct
+{
+  bool                  installed;            //!< driver installed via uart_driver_install()
+  bool                  useQueue;             //!< send events to queue
+  uint8_t               fullThresh;           //!< Rx FIFO full threshold [bytes]
+  uint8_t               timeout;              //!< Rx timeout [symbols] (0 = disabled)
+  size_t                numRing;              //!< number of bytes in ring buffer, i.e. oldest pending bytes of HardwareSerial
+  struct QueueDefinition  queue;              //!< event queue
+} hostUart_t;
+
+
+/**************************
+ * LOCAL VARIABLES
+**************************/
+
+static hostUart_t   uart[UART_NUM_MAX];       //!< driver state per UART
+
+
+
+/**************************
+ * LOCAL FUNCTIONS
+**************************/
+
+/**
+  \brief      Serial interface of UART
+  \param[in]  uart_num  UART port number
+  \return     mocked HardwareSerial or NULL if not supported
+*/
+static HardwareSerial *_serial(uart_port_t uart_num)
+{
+  if (uart_num == UART_NUM_1)
+    return &Serial1;
+  if (uart_num == UART_NUM_2)
+    return &Serial2;
+  return NULL;
+
+} // _serial()
+
+
+
+/**
+  \brief      Send event to queue of UART
+  \details    Send event to queue of UART. Like xQueueSendFromISR(), the event is dropped if the queue is full
+  \param[in]  p         UART driver state
+  \param[in]  Type      event type
+  \param[in]  Size      number of bytes for UART_DATA
+  \param[in]  Timeout   UART_DATA was caused by Rx timeout
+*/
+static void _sendEvent(hostUart_t *p, uart_event_type_t Type, size_t Size, bool Timeout)
+{
+  if ((!p->useQueue) || (p->queue.num >= p->queue.size))
+    return;
+
+  uart_event_t  *event = &(p->queue.event[p->queue.num++]);
+  event->type         = Type;
+  event->size         = Size;
+  event->timeout_flag = Timeout;
+
+} // _sendEvent()
+
+
+
+/**
+  \brief      Model driver ISR until now
+  \details    Move received bytes from Rx FIFO to ring buffer with a UART_DATA event, once the FIFO reaches the full
+              threshold, or if no further byte was received within the Rx timeout. A pending timeout is registered
+              as deadline of the virtual clock, like the Rx timeout interrupt
+  \param[in]  uart_num  UART port number
+*/
+static void _isr(uart_port_t uart_num)
+{
+  HardwareSerial  *pSerial = _serial(uart_num);
+  hostUart_t      *p = &(uart[uart_num]);
+
+  // driver not installed
+  if ((pSerial == NULL) || (!p->installed))
+    return;
+
+  // bytes received until now, incl. ring buffer. Symbol time (11 bit) at current baudrate
+  uint32_t  now   = micros();
+  size_t    avail = (size_t) pSerial->available();
+  uint32_t  baud  = pSerial->getBaudrate();
+  uint32_t  tout  = (uint32_t) p->timeout * ((11000000UL + baud/2) / baud);
+
+  // move bytes from FIFO to ring buffer in the order of the interrupts
+  while (avail > p->numRing)
+  {
+    size_t  first = p->numRing;
+    size_t  idx;
+
+    for (idx = first; idx < avail; idx++)
+    {
+      size_t num = idx - first + 1;
+
+      // Rx FIFO full interrupt
+      if (num >= p->fullThresh)
+      {
+        p->numRing += num;
+        _sendEvent(p, UART_DATA, num, false);
+        break;
+      }
+
+      // Rx timeout disabled or next byte received before timeout -> no interrupt
+      if (p->timeout == 0)
+        continue;
+      uint32_t timeEnd = pSerial->getRxTime((uint8_t) idx) + tout;
+      if ((idx+1 < avail) && ((int32_t) (pSerial->getRxTime((uint8_t) (idx+1)) - timeEnd) < 0))
+        continue;
+
+      // Rx timeout interrupt
+      if ((idx+1 < avail) || ((int32_t) (now - timeEnd) >= 0))
+      {
+        p->numRing += num;
+        _sendEvent(p, UART_DATA, num, true);
+        break;
+      }
+
+      // timeout still pending -> virtual clock jumps to interrupt
+      scheduleTime(timeEnd);
+      return;
+    }
+
+    // waiting for more bytes
+    if (idx >= avail)
+      return;
+  }
+
+} // _isr()
+
+
+
+/**************************
+ * GLOBAL FUNCTIONS
+**************************/
+
+/**
+  \brief      Install UART driver
+  \details    Install UART driver with Rx ring buffer and optional event queue. Sets default thresholds
+  \param[in]  uart_num          UART port number
+  \param[in]  rx_buffer_size    size of Rx ring buffer (> UART_FIFO_LEN)
+  \param[in]  tx_buffer_size    ignored
+  \param[in]  queue_size        size of event queue (0 = none). Limited to HOST_UART_QUEUE_LEN
+  \param[out] uart_queue        event queue (NULL = none)
+  \param[in]  intr_alloc_flags  ignored
+  \return     ESP_OK, or ESP_FAIL / ESP_ERR_INVALID_ARG on error
+*/
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size, int queue_size,
+  QueueHandle_t *uart_queue, int intr_alloc_flags)
+{
+  (void) tx_buffer_size;
+  (void) intr_alloc_flags;
+
+  // check parameters
+  if ((_serial(uart_num) == NULL) || (rx_buffer_size <= UART_FIFO_LEN))
+    return ESP_ERR_INVALID_ARG;
+  hostUart_t *p = &(uart[uart_num]);
+  if (p->installed)
+    return ESP_FAIL;
+
+  // initialize driver with default thresholds
+  p->installed   = true;
+  p->fullThresh  = UART_FULL_THRESH_DEFAULT;
+  p->timeout     = UART_TOUT_THRESH_DEFAULT;
+  p->numRing     = 0;
+  p->queue.port  = uart_num;
+  p->queue.size  = (queue_size < HOST_UART_QUEUE_LEN) ? (uint8_t) queue_size : HOST_UART_QUEUE_LEN;
+  p->queue.num   = 0;
+  p->useQueue    = ((uart_queue != NULL) && (queue_size > 0));
+  if (uart_queue != NULL)
+    *uart_queue = (p->useQueue) ? &(p->queue) : NULL;
+
+  return ESP_OK;
+
+} // uart_driver_install()
+
+
+
+/**
+  \brief      Remove UART driver
+  \details    Remove UART driver and close interface
+  \param[in]  uart_num  UART port number
+  \return     ESP_OK or ESP_ERR_INVALID_ARG
+*/
+esp_err_t uart_driver_delete(uart_port_t uart_num)
+{
+  HardwareSerial *pSerial = _serial(uart_num);
+
+  if (pSerial == NULL)
+    return ESP_ERR_INVALID_ARG;
+  uart[uart_num].installed = false;
+  uart[uart_num].useQueue  = false;
+  pSerial->end();
+
+  return ESP_OK;
+
+} // uart_driver_delete()
+
+
+
+/**
+  \brief      Configure UART
+  \details    Configure UART and open interface. Host only uses the baudrate
+  \param[in]  uart_num      UART port number
+  \param[in]  uart_config   UART configuration
+  \return     ESP_OK or ESP_ERR_INVALID_ARG
+*/
+esp_err_t uart_param_config(uart_port_t uart_num, const uart_config_t *uart_config)
+{
+  HardwareSerial *pSerial = _serial(uart_num);
+
+  if ((pSerial == NULL) || (uart_config == NULL) || (uart_config->baud_rate <= 0))
+    return ESP_ERR_INVALID_ARG;
+  pSerial->begin((unsigned long) uart_config->baud_rate);
+
+  return ESP_OK;
+
+} // uart_param_config()
+
+
+
+/**
+  \brief      Assign UART pins
+  \details    Assign UART pins. Ignored on host
+  \param[in]  uart_num      UART port number
+  \param[in]  tx_io_num     Tx pin
+  \param[in]  rx_io_num     Rx pin
+  \param[in]  rts_io_num    RTS pin
+  \param[in]  cts_io_num    CTS pin
+  \return     ESP_OK or ESP_ERR_INVALID_ARG
+*/
+esp_err_t uart_set_pin(uart_port_t uart_num, int tx_io_num, int rx_io_num, int rts_io_num, int cts_io_num)
+{
+  (void) tx_io_num;
+  (void) rx_io_num;
+  (void) rts_io_num;
+  (void) cts_io_num;
+
+  return (_serial(uart_num) != NULL) ? ESP_OK : ESP_ERR_INVALID_ARG;
+
+} // uart_set_pin()
+
+
+
+/**
+  \brief      Change baudrate
+  \details    Change baudrate w/o re-initialization of the driver. Pending bytes are kept
+  \param[in]  uart_num  UART port number
+  \param[in]  baudrate  new baudrate [Baud]
+  \return     ESP_OK or ESP_ERR_INVALID_ARG
+*/
+esp_err_t uart_set_baudrate(uart_port_t uart_num, uint32_t baudrate)
+{
+  HardwareSerial *pSerial = _serial(uart_num);
+
+  if ((pSerial == NULL) || (baudrate == 0))
+    return ESP_ERR_INVALID_ARG;
+
+  // complete ISR at old baudrate, i.e. Rx timeout
+  _isr(uart_num);
+  pSerial->begin(baudrate);
+
+  return ESP_OK;
+
+} // uart_set_baudrate()
+
+
+
+/**
+  \brief      Set Rx FIFO full threshold
+  \param[in]  uart_num    UART port number
+  \param[in]  threshold   number of bytes in Rx FIFO, which triggers an interrupt (1..UART_FIFO_LEN-1)
+  \return     ESP_OK or ESP_ERR_INVALID_ARG
+*/
+esp_err_t uart_set_rx_full_threshold(uart_port_t uart_num, int threshold)
+{
+  if ((_serial(uart_num) == NULL) || (threshold < 1) || (threshold >= UART_FIFO_LEN))
+    return ESP_ERR_INVALID_ARG;
+  _isr(uart_num);
+  uart[uart_num].fullThresh = (uint8_t) threshold;
+
+  return ESP_OK;
+
+} // uart_set_rx_full_threshold()
+
+
+
+/**
+  \brief      Set Rx timeout
+  \param[in]  uart_num      UART port number
+  \param[in]  tout_thresh   Rx idle time [symbols], which triggers an interrupt (0 = disabled)
+  \return     ESP_OK or ESP_ERR_INVALID_ARG
+*/
+esp_err_t uart_set_rx_timeout(uart_port_t uart_num, const uint8_t tout_thresh)
+{
+  if ((_serial(uart_num) == NULL) || (tout_thresh > 126))
+    return ESP_ERR_INVALID_ARG;
+  _isr(uart_num);
+  uart[uart_num].timeout = tout_thresh;
+
+  return ESP_OK;
+
+} // uart_set_rx_timeout()
+
+
+
+/**
+  \brief      Queue bytes for transmission
+  \param[in]  uart_num  UART port number
+  \param[in]  src       bytes to send
+  \param[in]  size      number of bytes
+  \return     number of queued bytes, or -1 on error
+*/
+int uart_write_bytes(uart_port_t uart_num, const void *src, size_t size)
+{
+  HardwareSerial *pSerial = _serial(uart_num);
+
+  if ((pSerial == NULL) || (!uart[uart_num].installed) || (src == NULL))
+    return -1;
+
+  return (int) pSerial->write((const uint8_t*) src, size);
+
+} // uart_write_bytes()
+
+
+
+/**
+  \brief      Wait until all bytes have been sent
+  \param[in]  uart_num        UART port number
+  \param[in]  ticks_to_wait   max. wait time [ticks], portMAX_DELAY waits until done
+  \return     ESP_OK, ESP_ERR_TIMEOUT or ESP_FAIL
+*/
+esp_err_t uart_wait_tx_done(uart_port_t uart_num, TickType_t ticks_to_wait)
+{
+  HardwareSerial *pSerial = _serial(uart_num);
+
+  if ((pSerial == NULL) || (!uart[uart_num].installed))
+    return ESP_FAIL;
+
+  // still busy after max. wait time -> wait max. time and time out
+  uint32_t maxWait = ticks_to_wait * portTICK_PERIOD_MS * 1000UL;
+  if ((ticks_to_wait != portMAX_DELAY) && (pSerial->getTxBusy() > maxWait))
+  {
+    delayMicroseconds(maxWait);
+    return ESP_ERR_TIMEOUT;
+  }
+  pSerial->flush();
+
+  return ESP_OK;
+
+} // uart_wait_tx_done()
+
+
+
+/**
+  \brief      Read bytes from ring buffer
+  \param[in]  uart_num        UART port number
+  \param[out] buf             read bytes
+  \param[in]  length          max. number of bytes
+  \param[in]  ticks_to_wait   ignored, i.e. doesn't wait for missing bytes
+  \return     number of read bytes, or -1 on error
+*/
+int uart_read_bytes(uart_port_t uart_num, void *buf, uint32_t length, TickType_t ticks_to_wait)
+{
+  HardwareSerial *pSerial = _serial(uart_num);
+
+  (void) ticks_to_wait;
+
+  if ((pSerial == NULL) || (!uart[uart_num].installed) || (buf == NULL))
+    return -1;
+
+  // only bytes in ring buffer
+  _isr(uart_num);
+  size_t num = (length < uart[uart_num].numRing) ? length : uart[uart_num].numRing;
+  for (size_t i = 0; i < num; i++)
+    ((uint8_t*) buf)[i] = (uint8_t) pSerial->read();
+  uart[uart_num].numRing -= num;
+
+  return (int) num;
+
+} // uart_read_bytes()
+
+
+
+/**
+  \brief      Number of bytes in ring buffer
+  \param[in]  uart_num  UART port number
+  \param[out] size      number of bytes readable via uart_read_bytes()
+  \return     ESP_OK or ESP_FAIL
+*/
+esp_err_t uart_get_buffered_data_len(uart_port_t uart_num, size_t *size)
+{
+  if ((_serial(uart_num) == NULL) || (!uart[uart_num].installed) || (size == NULL))
+    return ESP_FAIL;
+  _isr(uart_num);
+  *size = uart[uart_num].numRing;
+
+  return ESP_OK;
+
+} // uart_get_buffered_data_len()
+
+
+
+/**
+  \brief      Discard received bytes
+  \details    Discard ring buffer and Rx FIFO. Pending events are kept, like on ESP-IDF
+  \param[in]  uart_num  UART port number
+  \return     ESP_OK or ESP_FAIL
+*/
+esp_err_t uart_flush_input(uart_port_t uart_num)
+{
+  HardwareSerial *pSerial = _serial(uart_num);
+
+  if ((pSerial == NULL) || (!uart[uart_num].installed))
+    return ESP_FAIL;
+  while (pSerial->available() > 0)
+    pSerial->read();
+  uart[uart_num].numRing = 0;
+
+  return ESP_OK;
+
+} // uart_flush_input()
+
+
+
+/**
+  \brief      Get next event from queue
+  \details    Get next event from queue. Host only: the driver ISR is modelled first, and the call never blocks
+  \param[in]  xQueue        event queue
+  \param[out] pvBuffer      event
+  \param[in]  xTicksToWait  ignored
+  \return     pdTRUE if an event was received, else pdFALSE
+*/
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+  (void) xTicksToWait;
+
+  if ((xQueue == NULL) || (pvBuffer == NULL))
+    return pdFALSE;
+
+  // model ISR, then get oldest event
+  _isr(xQueue->port);
+  if (xQueue->num == 0)
+    return pdFALSE;
+  memcpy(pvBuffer, &(xQueue->event[0]), sizeof(uart_event_t));
+  xQueue->num--;
+  memmove(xQueue->event, xQueue->event+1, xQueue->num * sizeof(uart_event_t));
+
+  return pdTRUE;
+
+} // xQueueReceive()
+
+
+
+/**
+  \brief      Discard all events in queue
+  \param[in]  xQueue    event queue
+  \return     pdTRUE
+*/
+BaseType_t xQueueReset(QueueHandle_t xQueue)
+{
+  if (xQueue != NULL)
+    xQueue->num = 0;
+
+  return pdTRUE;
+
+} // xQueueReset()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,204 @@
+/**
+  \file     esp32_uart.h
+  \brief    Mock of ESP-IDF UART driver and FreeRTOS queue for host (Linux) builds
+  \details  Minimal subset of the ESP-IDF UART driver (driver/uart.h) and FreeRTOS queues, which is used by
+            LIN_Master_UART_ESP32. UART_NUM_1 and UART_NUM_2 are mapped to the mocked HardwareSerial Serial1 and Serial2,
+            UART_NUM_0 (console) is not supported.
+            Like the driver ISR, received bytes are moved from the Rx FIFO to the ring buffer (readable via uart_read_bytes())
+            with a UART_DATA event, once the number of bytes in the FIFO reaches the full threshold, or if no further byte
+            is received within the Rx timeout (unit: 1 symbol = 11 bit times), see uart_set_rx_full_threshold() and
+            uart_set_rx_timeout(). Defaults are those of uart_driver_install() (120 bytes, 10 symbols).
+            The ISR is modelled when the driver is accessed, incl. xQueueReceive(). The queue can't block, i.e. the wait
+            time is ignored. Other events (e.g. UART_FIFO_OVF, UART_BREAK) are not generated.
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _ESP32_UART_HOST_H_
+#define _ESP32_UART_HOST_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+// ESP-IDF error codes
+#define ESP_OK                    0               //!< success
+#define ESP_FAIL                  -1              //!< generic failure
+#define ESP_ERR_INVALID_ARG       0x102           //!< invalid argument
+#define ESP_ERR_INVALID_STATE     0x103           //!< invalid state, e.g. driver not installed
+#define ESP_ERR_TIMEOUT           0x107           //!< operation timed out
+
+// FreeRTOS
+#define pdFALSE                   ((BaseType_t) 0)
+#define pdTRUE                    ((BaseType_t) 1)
+#define portMAX_DELAY             ((TickType_t) 0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS        1               //!< FreeRTOS tick [ms], default 1kHz tick rate
+#define pdMS_TO_TICKS(ms)         ((TickType_t) ((ms) / portTICK_PERIOD_MS))
+
+// UART driver
+#define UART_PIN_NO_CHANGE        (-1)            //!< keep pin assignment
+#define UART_FIFO_LEN             128             //!< size of hardware FIFO [bytes]
+#define UART_FULL_THRESH_DEFAULT  120             //!< default Rx FIFO full threshold [bytes]
+#define UART_TOUT_THRESH_DEFAULT  10              //!< default Rx timeout [symbols]
+#define HOST_UART_QUEUE_LEN       32              //!< max. number of events per queue on host
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL TYPES
+-----------------------------------------------------------------------------*/
+
+/// ESP-IDF error code
+typedef int         esp_err_t;
+
+/// FreeRTOS types
+typedef long        BaseType_t;
+typedef uint32_t    TickType_t;
+
+/// FreeRTOS queue. Opaque like in FreeRTOS
+typedef struct QueueDefinition *QueueHandle_t;
+
+/// UART port number
+typedef enum
+{
+  UART_NUM_0 = 0,                             //!< console, not supported on host
+  UART_NUM_1,                                 //!< mapped to Serial1
+  UART_NUM_2,                                 //!< mapped to Serial2
+  UART_NUM_MAX
+} uart_port_t;
+
+/// UART word length
+typedef enum
+{
+  UART_DATA_5_BITS = 0,
+  UART_DATA_6_BITS,
+  UART_DATA_7_BITS,
+  UART_DATA_8_BITS
+} uart_word_length_t;
+
+/// UART parity
+typedef enum
+{
+  UART_PARITY_DISABLE = 0,
+  UART_PARITY_EVEN = 2,
+  UART_PARITY_ODD = 3
+} uart_parity_t;
+
+/// UART stop bits
+typedef enum
+{
+  UART_STOP_BITS_1 = 1,
+  UART_STOP_BITS_1_5,
+  UART_STOP_BITS_2
+} uart_stop_bits_t;
+
+/// UART hardware flow control
+typedef enum
+{
+  UART_HW_FLOWCTRL_DISABLE = 0,
+  UART_HW_FLOWCTRL_RTS,
+  UART_HW_FLOWCTRL_CTS,
+  UART_HW_FLOWCTRL_CTS_RTS
+} uart_hw_flowcontrol_t;
+
+/// UART configuration. Only baudrate is used on host
+typedef struct
+{
+  int                     baud_rate;          //!< baudrate [Baud]
+  uart_word_length_t      data_bits;          //!< word length
+  uart_parity_t           parity;             //!< parity
+  uart_stop_bits_t        stop_bits;          //!< number of stop bits
+  uart_hw_flowcontrol_t   flow_ctrl;          //!< hardware flow control
+  uint8_t                 rx_flow_ctrl_thresh;  //!< RTS threshold
+  int                     source_clk;         //!< clock source (0 = default)
+} uart_config_t;
+
+/// UART event types
+typedef enum
+{
+  UART_DATA = 0,                              //!< data moved to ring buffer
+  UART_BREAK,                                 //!< break detected
+  UART_BUFFER_FULL,                           //!< ring buffer full
+  UART_FIFO_OVF,                              //!< hardware FIFO overflow
+  UART_FRAME_ERR,                             //!< framing error
+  UART_PARITY_ERR,                            //!< parity error
+  UART_DATA_BREAK,                            //!< data and break sent
+  UART_PATTERN_DET,                           //!< pattern detected
+  UART_EVENT_MAX
+} uart_event_type_t;
+
+/// UART event, see uart_driver_install()
+typedef struct
+{
+  uart_event_type_t       type;               //!< event type
+  size_t                  size;               //!< number of received bytes for UART_DATA
+  bool                    timeout_flag;       //!< UART_DATA was caused by Rx timeout
+} uart_event_t;
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// @brief Install driver with Rx ring buffer and optional event queue. Tx buffer is ignored (writes never block on host)
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size, int queue_size,
+  QueueHandle_t *uart_queue, int intr_alloc_flags);
+
+/// @brief Remove driver and close interface
+esp_err_t uart_driver_delete(uart_port_t uart_num);
+
+/// @brief Configure and open interface. Only baudrate is used
+esp_err_t uart_param_config(uart_port_t uart_num, const uart_config_t *uart_config);
+
+/// @brief Assign pins. Ignored
+esp_err_t uart_set_pin(uart_port_t uart_num, int tx_io_num, int rx_io_num, int rts_io_num, int cts_io_num);
+
+/// @brief Change baudrate w/o re-initialization
+esp_err_t uart_set_baudrate(uart_port_t uart_num, uint32_t baudrate);
+
+/// @brief Set Rx FIFO full threshold [bytes] for moving data to ring buffer
+esp_err_t uart_set_rx_full_threshold(uart_port_t uart_num, int threshold);
+
+/// @brief Set Rx timeout [symbols] for moving data to ring buffer (0 = disabled)
+esp_err_t uart_set_rx_timeout(uart_port_t uart_num, const uint8_t tout_thresh);
+
+/// @brief Queue bytes for transmission. Returns number of bytes or -1 on error
+int uart_write_bytes(uart_port_t uart_num, const void *src, size_t size);
+
+/// @brief Wait until all bytes have been sent, max. specified ticks. Returns ESP_ERR_TIMEOUT if still busy
+esp_err_t uart_wait_tx_done(uart_port_t uart_num, TickType_t ticks_to_wait);
+
+/// @brief Read bytes from ring buffer. Wait time is ignored on host. Returns number of bytes or -1 on error
+int uart_read_bytes(uart_port_t uart_num, void *buf, uint32_t length, TickType_t ticks_to_wait);
+
+/// @brief Number of bytes in ring buffer
+esp_err_t uart_get_buffered_data_len(uart_port_t uart_num, size_t *size);
+
+/// @brief Discard ring buffer and Rx FIFO
+esp_err_t uart_flush_input(uart_port_t uart_num);
+
+/// @brief Get next event from queue. Wait time is ignored on host
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait);
+
+/// @brief Discard all events in queue
+BaseType_t xQueueReset(QueueHandle_t xQueue);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _ESP32_UART_HOST_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,213 @@
+/**
+  \file     stm32_usart.h
+  \brief    Mock of STM32 USART registers, UART HAL with DMA and D-cache maintenance for host (Linux) builds
+  \details  Minimal subset of the STM32 device header, CMSIS and HAL, which is used by LIN_Master_HardwareSerial_STM32.
+            Register layout is that of newer families (e.g. STM32L4, G4, F7) with RQR/ISR/ICR. Each mocked HardwareSerial
+            owns a register block and HAL handle. Registers are plain memory, i.e. writes have no side effect, except for:
+              - BRR: sets the baudrate (baudrate = HOST_SERIAL_CLOCK / BRR) of the next sent byte
+              - CR2.LINEN: LIN mode, i.e. a break has 13 instead of 10 low bits
+              - HAL_LIN_SendBreak(): queues a break before the next sent byte, like RQR.SBKRQ
+            HAL_UART_Transmit_DMA() queues all bytes at start. HAL_UARTEx_ReceiveToIdle_DMA() copies received bytes in a
+            simulated interrupt (see attachIrq()), which like the HAL calls HAL_UARTEx_RxEventCallback() at half transfer,
+            transfer complete and line idle (1 byte w/o reception), and in normal DMA mode stops reception after idle.
+            The D-cache is modelled like on STM32F7/H7 (__DCACHE_PRESENT): bytes written by the receive DMA are only
+            visible to the CPU after SCB_InvalidateDCache_by_Addr() on whole cache lines, and memory sent via DMA must
+            have been cleaned via SCB_CleanDCache_by_Addr() before, else hostDcacheErrors() is incremented.
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _STM32_USART_HOST_H_
+#define _STM32_USART_HOST_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+// register bits used by library
+#define USART_CR1_UE              (1UL << 0)      //!< USART enable
+#define USART_CR1_IDLEIE          (1UL << 4)      //!< idle line interrupt enable
+#define USART_CR1_RXNEIE          (1UL << 5)      //!< receive interrupt enable
+#define USART_CR1_PEIE            (1UL << 8)      //!< parity error interrupt enable
+#define USART_CR2_CLKEN           (1UL << 11)     //!< clock enable (must be 0 in LIN mode)
+#define USART_CR2_STOP            (3UL << 12)     //!< number of stop bits (must be 0 in LIN mode)
+#define USART_CR2_LINEN           (1UL << 14)     //!< LIN mode enable
+#define USART_CR3_EIE             (1UL << 0)      //!< error interrupt enable
+#define USART_CR3_IREN            (1UL << 1)      //!< IrDA mode (must be 0 in LIN mode)
+#define USART_CR3_HDSEL           (1UL << 3)      //!< half-duplex mode (must be 0 in LIN mode)
+#define USART_CR3_SCEN            (1UL << 5)      //!< smartcard mode (must be 0 in LIN mode)
+#define USART_CR3_DMAR            (1UL << 6)      //!< DMA enable receiver
+#define USART_CR3_DMAT            (1UL << 7)      //!< DMA enable transmitter
+#define USART_RQR_SBKRQ           (1UL << 1)      //!< send break request
+#define USART_RQR_RXFRQ           (1UL << 3)      //!< receive data flush request
+#define USART_ICR_FECF            (1UL << 1)      //!< framing error clear flag
+#define USART_ICR_ORECF           (1UL << 3)      //!< overrun error clear flag
+#define USART_ISR_LBDF            (1UL << 8)      //!< LIN break detected
+#define USART_TDR_TDR             (0x1FFUL)       //!< transmit data (device has TDR/RDR instead of DR)
+
+// register access like CMSIS
+#define SET_BIT(REG, BIT)         ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)       ((REG) &= ~(BIT))
+#define READ_BIT(REG, BIT)        ((REG) & (BIT))
+
+// clear errors and discard received data like HAL. No effect on host
+#define __HAL_UART_CLEAR_FEFLAG(__HANDLE__)       ((__HANDLE__)->Instance->ICR = USART_ICR_FECF)
+#define __HAL_UART_CLEAR_OREFLAG(__HANDLE__)      ((__HANDLE__)->Instance->ICR = USART_ICR_ORECF)
+#define __HAL_UART_FLUSH_DRREGISTER(__HANDLE__)   ((__HANDLE__)->Instance->RQR |= USART_RQR_RXFRQ)
+
+// link DMA handle to UART handle like HAL
+#define __HAL_LINKDMA(__HANDLE__, __PPP_DMA_FIELD__, __DMA_HANDLE__) \
+  do { (__HANDLE__)->__PPP_DMA_FIELD__ = &(__DMA_HANDLE__); (__DMA_HANDLE__).Parent = (__HANDLE__); } while (0)
+
+// all mocked USARTs support LIN mode
+#define IS_UART_LIN_INSTANCE(INSTANCE)  ((INSTANCE) != NULL)
+
+// D-cache like STM32F7/H7, see SCB_CleanDCache_by_Addr() and SCB_InvalidateDCache_by_Addr()
+#define __DCACHE_PRESENT          1U              //!< device has D-cache
+#define __SCB_DCACHE_LINE_SIZE    32U             //!< D-cache line size [bytes]
+#define HOST_DCACHE_PENDING       64              //!< max. number of bytes written by DMA, which are not yet visible to CPU
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL TYPES
+-----------------------------------------------------------------------------*/
+
+// forward declaration
+class HardwareSerial;
+
+/// USART register block
+typedef struct
+{
+  volatile uint32_t       CR1;                //!< control register 1
+  volatile uint32_t       CR2;                //!< control register 2
+  volatile uint32_t       CR3;                //!< control register 3
+  volatile uint32_t       BRR;                //!< baudrate register
+  volatile uint32_t       GTPR;               //!< guard time and prescaler register
+  volatile uint32_t       RTOR;               //!< receiver timeout register
+  volatile uint32_t       RQR;                //!< request register
+  volatile uint32_t       ISR;                //!< interrupt and status register
+  volatile uint32_t       ICR;                //!< interrupt flag clear register
+  volatile uint32_t       RDR;                //!< receive data register
+  volatile uint32_t       TDR;                //!< transmit data register
+} USART_TypeDef;
+
+/// DMA channel registers
+typedef struct
+{
+  volatile uint32_t       CCR;                //!< channel configuration register
+  volatile uint32_t       CNDTR;              //!< number of data to transfer
+  volatile uint32_t       CPAR;               //!< peripheral address
+  volatile uint32_t       CMAR;               //!< memory address
+} DMA_Channel_TypeDef;
+
+/// HAL DMA state
+typedef enum
+{
+  HAL_DMA_STATE_RESET  = 0x00,
+  HAL_DMA_STATE_READY  = 0x01,
+  HAL_DMA_STATE_BUSY   = 0x02
+} HAL_DMA_StateTypeDef;
+
+/// HAL DMA handle. Channel, direction and normal mode are configured by the application, here only the channel
+typedef struct
+{
+  DMA_Channel_TypeDef     *Instance;          //!< DMA channel registers
+  HAL_DMA_StateTypeDef    State;              //!< transfer state
+  void                    *Parent;            //!< parent object, e.g. UART handle, see __HAL_LINKDMA()
+} DMA_HandleTypeDef;
+
+/// HAL UART state
+typedef enum
+{
+  HAL_UART_STATE_RESET    = 0x00,
+  HAL_UART_STATE_READY    = 0x20,
+  HAL_UART_STATE_BUSY     = 0x24,
+  HAL_UART_STATE_BUSY_TX  = 0x21,
+  HAL_UART_STATE_BUSY_RX  = 0x22
+} HAL_UART_StateTypeDef;
+
+/// HAL UART reception type
+typedef enum
+{
+  HAL_UART_RECEPTION_STANDARD = 0x00,
+  HAL_UART_RECEPTION_TOIDLE   = 0x01
+} HAL_UART_RxTypeTypeDef;
+
+/// HAL UART handle
+typedef struct
+{
+  USART_TypeDef           *Instance;          //!< USART registers
+  DMA_HandleTypeDef       *hdmatx;            //!< Tx DMA, see __HAL_LINKDMA()
+  DMA_HandleTypeDef       *hdmarx;            //!< Rx DMA, see __HAL_LINKDMA()
+  volatile HAL_UART_StateTypeDef  gState;     //!< global and Tx state
+  volatile HAL_UART_StateTypeDef  RxState;    //!< Rx state
+  volatile HAL_UART_RxTypeTypeDef ReceptionType;  //!< type of ongoing reception
+  HardwareSerial          *pSerial;           //!< host only: owning HardwareSerial mock
+} UART_HandleTypeDef;
+
+/// HAL status
+typedef enum
+{
+  HAL_OK       = 0x00,
+  HAL_ERROR    = 0x01,
+  HAL_BUSY     = 0x02,
+  HAL_TIMEOUT  = 0x03
+} HAL_StatusTypeDef;
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// @brief Request break before next sent byte (RQR.SBKRQ). 13 low bits in LIN mode, else 10
+HAL_StatusTypeDef HAL_LIN_SendBreak(UART_HandleTypeDef *huart);
+
+/// @brief Send bytes via linked Tx DMA. Bytes must remain valid and, with D-cache, be cleaned until sent
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+
+/// @brief Receive bytes via linked Rx DMA until buffer is full or line is idle, see HAL_UARTEx_RxEventCallback()
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+
+/// @brief Abort ongoing reception w/o callback
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+
+/// @brief Abort ongoing transmission and reception w/o callback
+HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef *huart);
+
+/// @brief Reception event (half transfer, transfer complete or idle) with number of bytes received since start. Weak, like HAL
+extern "C" void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
+
+/// @brief Write back D-cache lines of memory range to RAM, e.g. before DMA reads it
+void SCB_CleanDCache_by_Addr(volatile void *addr, int32_t dsize);
+
+/// @brief Discard D-cache lines of memory range, e.g. after DMA wrote it. Address and size must be aligned to cache lines
+void SCB_InvalidateDCache_by_Addr(volatile void *addr, int32_t dsize);
+
+/// @brief Host only: DMA writes byte to RAM, which is visible to CPU after SCB_InvalidateDCache_by_Addr()
+void hostDcacheWrite(uint8_t *Addr, uint8_t Data);
+
+/// @brief Host only: check that memory sent via DMA was cleaned before. Returns true if ok
+bool hostDcacheCheckClean(const uint8_t *Addr, uint16_t Size);
+
+/// @brief Host only: number of D-cache maintenance errors (memory sent w/o clean, invalidation of partial cache lines)
+uint32_t hostDcacheErrors(void);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _STM32_USART_HOST_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
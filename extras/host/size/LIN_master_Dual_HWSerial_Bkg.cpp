@@ -0,0 +1,100 @@
+/*********************
+
+Size program for example LIN_master_Dual_HWSerial_Bkg w/o console output, see "make size".
+Uses LIN_Master_Template if LIN_MASTER_SIZE_TEMPLATE is defined, else LIN_Master_HardwareSerial.
+Is also built for Arduino Mega via arduino-cli, see "make size-avr".
+
+**********************/
+
+// pause between LIN frames
+#define LIN_FRAME_PERIOD      200                       // [ms]
+#define PIN_TOGGLE            30                        // pin to show CPU idle
+#define PIN_ERROR1            32                        // LIN1 error status pin (high=error)
+#define PIN_ERROR2            34                        // LIN2 error status pin (high=error)
+
+// setup LIN nodes
+#if defined(LIN_MASTER_SIZE_TEMPLATE)
+  #include "LIN_master_Template.h"
+  LIN_Master_Template<HardwareSerial, 8>  LIN1(Serial1), LIN2(Serial2);
+#else
+  #include "LIN_master_HardwareSerial.h"
+  LIN_Master_HardwareSerial               LIN1(Serial1, "Master_1"), LIN2(Serial2, "Master_2");
+#endif
+
+
+// call once
+void setup()
+{
+  pinMode(PIN_TOGGLE, OUTPUT);
+  pinMode(PIN_ERROR1, OUTPUT);
+  pinMode(PIN_ERROR2, OUTPUT);
+  LIN1.begin(19200);
+  LIN2.begin(9600);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t           lastLINFrame = 0;
+  static uint8_t            count = 0;
+  uint8_t                   Tx[4] = {0x01, 0x02, 0x03, 0x04};
+  LIN_Master_Base::frame_t  Type;
+  uint8_t                   Id;
+  uint8_t                   NumData;
+  uint8_t                   Data[8];
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // call LIN background handlers
+  LIN1.handler();
+  LIN2.handler();
+
+  // check if LIN frames have finished
+  if (LIN1.getState() == LIN_Master_Base::STATE_DONE)
+  {
+    LIN1.getFrame(Type, Id, NumData, Data);
+    digitalWrite(PIN_ERROR1, LIN1.getError());
+    LIN1.resetStateMachine();
+    LIN1.resetError();
+  }
+  if (LIN2.getState() == LIN_Master_Base::STATE_DONE)
+  {
+    LIN2.getFrame(Type, Id, NumData, Data);
+    digitalWrite(PIN_ERROR2, LIN2.getError());
+    LIN2.resetStateMachine();
+    LIN2.resetError();
+  }
+
+  // SW scheduler for sending/receiving LIN frames
+  if (millis() - lastLINFrame > LIN_FRAME_PERIOD)
+  {
+    lastLINFrame = millis();
+    if (count == 0)
+    {
+      count++;
+      LIN1.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, 4, Tx);
+      LIN2.sendMasterRequest(LIN_Master_Base::LIN_V1, 0x1A, 3, Tx);
+    }
+    else
+    {
+      count = 0;
+      LIN1.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, 6);
+      LIN2.receiveSlaveResponse(LIN_Master_Base::LIN_V1, 0x06, 8);
+    }
+  }
+
+} // loop()
+
+
+// Arduino main for host build. On target the core provides main()
+#if defined(ARDUINO_ARCH_HOST)
+int main(void)
+{
+  setup();
+  for (;;)
+    loop();
+}
+#endif
@@ -0,0 +1,93 @@
+/*********************
+
+Size program for example LIN_master_HWSerial_Bkg w/o console output, see "make size".
+Uses LIN_Master_Template if LIN_MASTER_SIZE_TEMPLATE is defined, else LIN_Master_HardwareSerial.
+Is also built for Arduino Mega via arduino-cli, see "make size-avr".
+
+**********************/
+
+// pause between LIN frames
+#define LIN_FRAME_PERIOD      200                       // [ms]
+#define LIN_HANDLER_PERIOD    300                       // [us]
+#define PIN_TOGGLE            30                        // pin to show CPU idle
+#define PIN_ERROR             32                        // LIN error status pin (high=error)
+
+// setup LIN node
+#if defined(LIN_MASTER_SIZE_TEMPLATE)
+  #include "LIN_master_Template.h"
+  LIN_Master_Template<HardwareSerial, 8>  LIN(Serial1);
+#else
+  #include "LIN_master_HardwareSerial.h"
+  LIN_Master_HardwareSerial               LIN(Serial1, "Master");
+#endif
+
+
+// call once
+void setup()
+{
+  pinMode(PIN_TOGGLE, OUTPUT);
+  pinMode(PIN_ERROR, OUTPUT);
+  LIN.begin(19200);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t           lastLINFrame = 0;
+  static uint32_t           lastLINHandler = 0;
+  static uint8_t            count = 0;
+  uint8_t                   Tx[4] = {0x01, 0x02, 0x03, 0x04};
+  LIN_Master_Base::frame_t  Type;
+  uint8_t                   Id;
+  uint8_t                   NumData;
+  uint8_t                   Data[8];
+
+  // toggle pin to show background operation
+  digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // periodically call LIN background handler
+  if (micros() - lastLINHandler > LIN_HANDLER_PERIOD)
+  {
+    lastLINHandler = micros();
+    LIN.handler();
+  }
+
+  // check if LIN frame has finished
+  if (LIN.getState() == LIN_Master_Base::STATE_DONE)
+  {
+    LIN.getFrame(Type, Id, NumData, Data);
+    digitalWrite(PIN_ERROR, LIN.getError());
+    LIN.resetStateMachine();
+    LIN.resetError();
+  }
+
+  // SW scheduler for sending/receiving LIN frames
+  if (millis() - lastLINFrame > LIN_FRAME_PERIOD)
+  {
+    lastLINFrame = millis();
+    if (count == 0)
+    {
+      count++;
+      LIN.sendMasterRequest(LIN_Master_Base::LIN_V2, 0x1A, 4, Tx);
+    }
+    else
+    {
+      count = 0;
+      LIN.receiveSlaveResponse(LIN_Master_Base::LIN_V2, 0x05, 6);
+    }
+  }
+
+} // loop()
+
+
+// Arduino main for host build. On target the core provides main()
+#if defined(ARDUINO_ARCH_HOST)
+int main(void)
+{
+  setup();
+  for (;;)
+    loop();
+}
+#endif
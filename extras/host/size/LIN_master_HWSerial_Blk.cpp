@@ -0,0 +1,79 @@
+/*********************
+
+Size program for example LIN_master_HWSerial_Blk w/o console output, see "make size".
+Uses LIN_Master_Template if LIN_MASTER_SIZE_TEMPLATE is defined, else LIN_Master_HardwareSerial.
+Is also built for Arduino Mega via arduino-cli, see "make size-avr".
+
+**********************/
+
+// pause [ms] between LIN frames
+#define LIN_FRAME_PERIOD      200
+#define PIN_TOGGLE            30                        // pin to show CPU idle
+#define PIN_ERROR             32                        // LIN error status pin (high=error)
+
+// setup LIN node
+#if defined(LIN_MASTER_SIZE_TEMPLATE)
+  #include "LIN_master_Template.h"
+  LIN_Master_Template<HardwareSerial, 8>  LIN(Serial1);
+#else
+  #include "LIN_master_HardwareSerial.h"
+  LIN_Master_HardwareSerial               LIN(Serial1, "Master");
+#endif
+
+
+// call once
+void setup()
+{
+  pinMode(PIN_TOGGLE, OUTPUT);
+  pinMode(PIN_ERROR, OUTPUT);
+  LIN.begin(19200);
+
+} // setup()
+
+
+// call repeatedly
+void loop()
+{
+  static uint32_t           tStart;
+  uint8_t                   Tx[4] = {0x01, 0x02, 0x03, 0x04};
+  LIN_Master_Base::frame_t  Type;
+  LIN_Master_Base::error_t  error;
+  uint8_t                   Id;
+  uint8_t                   NumData;
+  uint8_t                   Data[8];
+
+  // send master request frame and get result immediately
+  error = LIN.sendMasterRequestBlocking(LIN_Master_Base::LIN_V2, 0x1A, 4, Tx);
+  digitalWrite(PIN_ERROR, error);
+  LIN.getFrame(Type, Id, NumData, Data);
+  LIN.resetStateMachine();
+  LIN.resetError();
+
+  // wait a bit. Toggle pin to show CPU load
+  tStart = millis();
+  while (millis() - tStart < LIN_FRAME_PERIOD)
+    digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+  // send/receive slave response frame and get result immediately
+  error = LIN.receiveSlaveResponseBlocking(LIN_Master_Base::LIN_V2, 0x05, 6, Data);
+  digitalWrite(PIN_ERROR, error);
+  LIN.resetStateMachine();
+  LIN.resetError();
+
+  // wait a bit. Toggle pin to show CPU load
+  tStart = millis();
+  while (millis() - tStart < LIN_FRAME_PERIOD)
+    digitalWrite(PIN_TOGGLE, !digitalRead(PIN_TOGGLE));
+
+} // loop()
+
+
+// Arduino main for host build. On target the core provides main()
+#if defined(ARDUINO_ARCH_HOST)
+int main(void)
+{
+  setup();
+  for (;;)
+    loop();
+}
+#endif
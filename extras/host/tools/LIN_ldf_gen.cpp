@@ -0,0 +1,893 @@
+/*********************
+
+Code generator for LIN Description Files (LDF)
+
+Parses an LDF and writes a C++11 header with constexpr tables for the LIN master library (see LIN_master_LDF.h):
+  - frame descriptors with precomputed PID, checksum seed, lengths and timeout (LIN_Master_Base::descriptor_t)
+  - frame data buffers (RAM), initialized with the signal init values. Unused bits are recessive (1)
+  - signals with frame, bit offset, width, encoding and init value (LIN_Master_LDF::signal_t)
+  - physical encodings and constants for logical values (LIN_Master_LDF::encoding_t)
+  - schedule tables for setSchedule_P() (LIN_Master_Base::schedule_t)
+  - compile-time layouts of scalar signals and per frame a struct with pack() and unpack() (see LIN_master_Signal.h)
+All tables are stored in flash (PROGMEM). Supported LDF sections: LIN_protocol_version, LIN_speed, Nodes, Signals,
+Diagnostic_signals, Frames, Diagnostic_frames, Schedule_tables, Signal_encoding_types and Signal_representation.
+Other sections (e.g. Node_attributes, Event_triggered_frames) are skipped. Schedule commands other than MasterReq
+and SlaveResp (e.g. AssignNAD) are skipped with a warning.
+
+usage: LIN_ldf_gen file.ldf [-n namespace] [-o file.h]
+  -n    namespace of generated tables (default: LDF file name)
+  -o    output file (default: stdout)
+
+**********************/
+
+// include files
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+
+
+// token types
+enum { TOKEN_END, TOKEN_IDENT, TOKEN_NUMBER, TOKEN_STRING, TOKEN_PUNCT };
+
+// LDF token
+struct Token
+{
+  int           type;             // token type
+  std::string   text;             // identifier, number, string w/o quotes or punctuation character
+  int           line;             // line in LDF
+};
+
+// signal
+struct Signal
+{
+  std::string   name;             // signal name
+  int           width;            // width [bit]
+  bool          array;            // byte array, i.e. init value is a list
+  std::vector<uint32_t> init;     // init value (array: 1 value per byte)
+  int           frame;            // index of frame (-1 = not mapped)
+  int           start;            // bit offset in frame
+  int           encoding;         // index of encoding (-1 = none)
+};
+
+// frame
+struct Frame
+{
+  std::string   name;             // frame name
+  int           id;               // frame ID (0..0x3F)
+  std::string   publisher;        // publishing node
+  int           length;           // number of data bytes
+  int           line;             // line in LDF
+  std::vector<std::pair<std::string, int> > signals;  // signal name and bit offset
+};
+
+// logical value of an encoding
+struct Logical
+{
+  uint32_t      value;            // raw value
+  std::string   text;             // description
+};
+
+// signal encoding
+struct Encoding
+{
+  std::string   name;             // encoding name
+  bool          physical;         // has physical range
+  uint32_t      min, max;         // raw range of physical value
+  double        scale, offset;    // physical = offset + scale * raw
+  std::string   unit;             // physical unit
+  std::vector<Logical> logical;   // logical values
+};
+
+// schedule table
+struct Schedule
+{
+  std::string   name;             // table name
+  std::vector<std::pair<int, uint32_t> > entries;   // frame index and slot [us]
+};
+
+// parsed LDF
+static std::vector<Token>     tokens;
+static size_t                 pos;
+static const char             *fileName;
+static int                    version = 2;
+static uint32_t               baudrate = 19200;
+static std::string            master;
+static std::vector<Signal>    signals;
+static std::vector<Frame>     frames;
+static std::vector<Encoding>  encodings;
+static std::vector<Schedule>  schedules;
+
+
+// print error and exit
+static void error(int Line, const char *Text, const std::string &Arg = "")
+{
+  fprintf(stderr, "%s:%d: error: %s%s\n", fileName, Line, Text, Arg.c_str());
+  exit(1);
+}
+
+
+// print warning
+static void warning(int Line, const char *Text, const std::string &Arg = "")
+{
+  fprintf(stderr, "%s:%d: warning: %s%s\n", fileName, Line, Text, Arg.c_str());
+}
+
+
+// split LDF into tokens. Skips whitespace and C/C++ comments
+static void tokenize(const std::string &Text)
+{
+  size_t    i = 0, n = Text.size();
+  int       line = 1;
+
+  while (i < n)
+  {
+    char c = Text[i];
+    Token tok;
+    tok.line = line;
+
+    // whitespace and comments
+    if (c == '\n')
+    {
+      line++;
+      i++;
+      continue;
+    }
+    if (isspace((unsigned char) c))
+    {
+      i++;
+      continue;
+    }
+    if ((c == '/') && (i+1 < n) && (Text[i+1] == '/'))
+    {
+      while ((i < n) && (Text[i] != '\n'))
+        i++;
+      continue;
+    }
+    if ((c == '/') && (i+1 < n) && (Text[i+1] == '*'))
+    {
+      for (i += 2; (i+1 < n) && !((Text[i] == '*') && (Text[i+1] == '/')); i++)
+        line += (Text[i] == '\n');
+      i += 2;
+      continue;
+    }
+
+    // string
+    if (c == '"')
+    {
+      size_t end = Text.find('"', i+1);
+      if (end == std::string::npos)
+        error(line, "unterminated string");
+      tok.type = TOKEN_STRING;
+      tok.text = Text.substr(i+1, end-i-1);
+      i = end + 1;
+    }
+
+    // number, optionally signed, hex or with fraction/exponent
+    else if (isdigit((unsigned char) c) || (((c == '-') || (c == '+')) && (i+1 < n) && isdigit((unsigned char) Text[i+1])))
+    {
+      size_t start = i++;
+      while ((i < n) && (isalnum((unsigned char) Text[i]) || (Text[i] == '.') ||
+        (((Text[i] == '-') || (Text[i] == '+')) && ((Text[i-1] == 'e') || (Text[i-1] == 'E')) && (Text.compare(start, 2, "0x") != 0))))
+        i++;
+      tok.type = TOKEN_NUMBER;
+      tok.text = Text.substr(start, i-start);
+    }
+
+    // identifier
+    else if (isalpha((unsigned char) c) || (c == '_'))
+    {
+      size_t start = i;
+      while ((i < n) && (isalnum((unsigned char) Text[i]) || (Text[i] == '_')))
+        i++;
+      tok.type = TOKEN_IDENT;
+      tok.text = Text.substr(start, i-start);
+    }
+
+    // punctuation
+    else
+    {
+      tok.type = TOKEN_PUNCT;
+      tok.text = std::string(1, c);
+      i++;
+    }
+    tokens.push_back(tok);
+  }
+
+  // end marker
+  Token tok;
+  tok.type = TOKEN_END;
+  tok.line = line;
+  tokens.push_back(tok);
+}
+
+
+// current token
+static const Token &peek(void)
+{
+  return tokens[pos];
+}
+
+
+// consume current token
+static const Token &next(void)
+{
+  const Token &tok = tokens[pos];
+  if (tok.type != TOKEN_END)
+    pos++;
+  return tok;
+}
+
+
+// check for punctuation and consume it
+static bool accept(const char *Punct)
+{
+  if ((peek().type == TOKEN_PUNCT) && (peek().text == Punct))
+  {
+    pos++;
+    return true;
+  }
+  return false;
+}
+
+
+// expect punctuation
+static void expect(const char *Punct)
+{
+  if (!accept(Punct))
+    error(peek().line, "expected ", std::string("'") + Punct + "' before '" + peek().text + "'");
+}
+
+
+// expect identifier
+static std::string ident(void)
+{
+  if (peek().type != TOKEN_IDENT)
+    error(peek().line, "expected identifier before ", "'" + peek().text + "'");
+  return next().text;
+}
+
+
+// expect number
+static double number(void)
+{
+  if (peek().type != TOKEN_NUMBER)
+    error(peek().line, "expected number before ", "'" + peek().text + "'");
+  const Token &tok = next();
+  if ((tok.text.size() > 2) && (tok.text[0] == '0') && ((tok.text[1] == 'x') || (tok.text[1] == 'X')))
+    return (double) strtoul(tok.text.c_str(), NULL, 16);
+  return strtod(tok.text.c_str(), NULL);
+}
+
+
+// expect integer
+static uint32_t integer(void)
+{
+  int     line = peek().line;
+  double  val = number();
+  if ((val < 0) || (val > 4294967295.0) || (val != (double) (uint32_t) val))
+    error(line, "expected unsigned integer");
+  return (uint32_t) val;
+}
+
+
+// skip tokens until end of statement or block, incl. nested blocks
+static void skip(void)
+{
+  int   depth = 0;
+
+  while (peek().type != TOKEN_END)
+  {
+    const Token &tok = next();
+    if (tok.type != TOKEN_PUNCT)
+      continue;
+    if (tok.text == "{")
+      depth++;
+    else if ((tok.text == "}") && (--depth <= 0))
+    {
+      accept(";");
+      return;
+    }
+    else if ((tok.text == ";") && (depth == 0))
+      return;
+  }
+}
+
+
+// find item by name (-1 = not found)
+template <class T> static int find(const std::vector<T> &Items, const std::string &Name)
+{
+  for (size_t i = 0; i < Items.size(); i++)
+    if (Items[i].name == Name)
+      return (int) i;
+  return -1;
+}
+
+
+// Nodes { Master : name, timebase ms, jitter ms ; Slaves : ... ; }
+static void parseNodes(void)
+{
+  expect("{");
+  while (!accept("}"))
+  {
+    std::string kind = ident();
+    if (kind == "Master")
+    {
+      expect(":");
+      master = ident();
+    }
+    skip();
+  }
+}
+
+
+// Signals { name : width, init, publisher, subscribers ; }. Diagnostic signals have no publisher
+static void parseSignals(void)
+{
+  expect("{");
+  while (!accept("}"))
+  {
+    Signal sig;
+    int line = peek().line;
+    sig.name = ident();
+    expect(":");
+    sig.width = (int) integer();
+    expect(",");
+    sig.array = accept("{");
+    if (sig.array)
+    {
+      do
+        sig.init.push_back(integer());
+      while (accept(","));
+      expect("}");
+    }
+    else
+      sig.init.push_back(integer());
+    sig.frame = -1;
+    sig.start = 0;
+    sig.encoding = -1;
+
+    // check width
+    if ((sig.width < 1) || (sig.width > 64) || ((!sig.array) && (sig.width > 32)))
+      error(line, "invalid width of signal ", sig.name);
+    if (sig.array && ((sig.width % 8 != 0) || (sig.init.size() != (size_t) sig.width / 8)))
+      error(line, "byte array width and init value mismatch for signal ", sig.name);
+    if (find(signals, sig.name) >= 0)
+      error(line, "duplicate signal ", sig.name);
+    signals.push_back(sig);
+    skip();
+  }
+}
+
+
+// Frames { name : id, publisher, length { signal, offset ; } }
+// Diagnostic_frames { MasterReq : 0x3C { signal, offset ; } SlaveResp : 0x3D { ... } }
+static void parseFrames(bool Diagnostic)
+{
+  expect("{");
+  while (!accept("}"))
+  {
+    Frame frm;
+    int line = peek().line;
+    frm.name = ident();
+    frm.line = line;
+    expect(":");
+    frm.id = (int) integer();
+    if (Diagnostic)
+    {
+      if (master.empty())
+        error(line, "Nodes must be defined before ", frm.name);
+      frm.publisher = (frm.id == 0x3C) ? master : "";
+      frm.length = 8;
+    }
+    else
+    {
+      expect(",");
+      frm.publisher = ident();
+      expect(",");
+      frm.length = (int) integer();
+    }
+    if ((frm.id > 0x3F) || (frm.length < 1) || (frm.length > 8))
+      error(line, "invalid ID or length of frame ", frm.name);
+    if (find(frames, frm.name) >= 0)
+      error(line, "duplicate frame ", frm.name);
+
+    // signal mapping
+    expect("{");
+    while (!accept("}"))
+    {
+      std::string name = ident();
+      expect(",");
+      int offset = (int) integer();
+      expect(";");
+      frm.signals.push_back(std::make_pair(name, offset));
+    }
+    frames.push_back(frm);
+  }
+}
+
+
+// Schedule_tables { name { frame delay X ms ; command { ... } delay X ms ; } }
+static void parseSchedules(void)
+{
+  expect("{");
+  while (!accept("}"))
+  {
+    Schedule sch;
+    sch.name = ident();
+    expect("{");
+    while (!accept("}"))
+    {
+      int line = peek().line;
+      std::string name = ident();
+      bool command = accept("{");
+      if (command)
+      {
+        pos--;
+        skip();
+      }
+      if (ident() != "delay")
+        error(line, "expected 'delay' in schedule table ", sch.name);
+      double delay = number();
+      if (ident() != "ms")
+        error(line, "expected 'ms' in schedule table ", sch.name);
+      expect(";");
+
+      // only frames are supported, i.e. no node configuration commands
+      int frm = find(frames, name);
+      if (command || (frm < 0))
+      {
+        warning(line, "skipped unsupported schedule command ", name);
+        continue;
+      }
+      sch.entries.push_back(std::make_pair(frm, (uint32_t) (delay * 1000.0 + 0.5)));
+    }
+    if (sch.entries.empty())
+      warning(peek().line, "skipped empty schedule table ", sch.name);
+    else
+      schedules.push_back(sch);
+  }
+}
+
+
+// Signal_encoding_types { name { logical_value, value, "text" ; physical_value, min, max, scale, offset, "unit" ; } }
+static void parseEncodings(void)
+{
+  expect("{");
+  while (!accept("}"))
+  {
+    Encoding enc;
+    enc.name = ident();
+    enc.physical = false;
+    enc.min = enc.max = 0;
+    enc.scale = 1.0;
+    enc.offset = 0.0;
+    expect("{");
+    while (!accept("}"))
+    {
+      int line = peek().line;
+      std::string kind = ident();
+      if (kind == "logical_value")
+      {
+        Logical val;
+        expect(",");
+        val.value = integer();
+        if (accept(",") && (peek().type == TOKEN_STRING))
+          val.text = next().text;
+        enc.logical.push_back(val);
+      }
+      else if ((kind == "physical_value") && enc.physical)
+        warning(line, "only 1st physical range is used for encoding ", enc.name);
+      else if (kind == "physical_value")
+      {
+        enc.physical = true;
+        expect(",");
+        enc.min = integer();
+        expect(",");
+        enc.max = integer();
+        expect(",");
+        enc.scale = number();
+        expect(",");
+        enc.offset = number();
+        if (accept(",") && (peek().type == TOKEN_STRING))
+          enc.unit = next().text;
+      }
+      skip();
+    }
+    encodings.push_back(enc);
+  }
+}
+
+
+// Signal_representation { encoding : signal, signal ; }
+static void parseRepresentation(void)
+{
+  expect("{");
+  while (!accept("}"))
+  {
+    int line = peek().line;
+    std::string name = ident();
+    int enc = find(encodings, name);
+    if (enc < 0)
+      error(line, "unknown encoding ", name);
+    expect(":");
+    do
+    {
+      int sig = find(signals, ident());
+      if (sig < 0)
+        error(line, "unknown signal in representation ", name);
+      signals[sig].encoding = enc;
+    } while (accept(","));
+    expect(";");
+  }
+}
+
+
+// parse LDF top level
+static void parse(void)
+{
+  while (peek().type != TOKEN_END)
+  {
+    int line = peek().line;
+    std::string name = ident();
+
+    if (name == "LIN_protocol_version")
+    {
+      expect("=");
+      if (peek().type != TOKEN_STRING)
+        error(line, "expected string for LIN_protocol_version");
+      version = (next().text.compare(0, 2, "1.") == 0) ? 1 : 2;
+      expect(";");
+    }
+    else if (name == "LIN_speed")
+    {
+      expect("=");
+      baudrate = (uint32_t) (number() * 1000.0 + 0.5);
+      if (ident() != "kbps")
+        error(line, "expected 'kbps' for LIN_speed");
+      expect(";");
+    }
+    else if (name == "Nodes")
+      parseNodes();
+    else if ((name == "Signals") || (name == "Diagnostic_signals"))
+      parseSignals();
+    else if (name == "Frames")
+      parseFrames(false);
+    else if (name == "Diagnostic_frames")
+      parseFrames(true);
+    else if (name == "Schedule_tables")
+      parseSchedules();
+    else if (name == "Signal_encoding_types")
+      parseEncodings();
+    else if (name == "Signal_representation")
+      parseRepresentation();
+    else
+      skip();
+  }
+}
+
+
+// map signals to frames and check layout
+static void link(void)
+{
+  if (master.empty())
+    error(tokens.back().line, "no master node defined");
+  for (size_t f = 0; f < frames.size(); f++)
+  {
+    for (size_t s = 0; s < frames[f].signals.size(); s++)
+    {
+      const std::string &name = frames[f].signals[s].first;
+      int offset = frames[f].signals[s].second;
+      int sig = find(signals, name);
+      if (sig < 0)
+        error(frames[f].line, "unknown signal in frame ", frames[f].name + ": " + name);
+      if (offset + signals[sig].width > 8 * frames[f].length)
+        error(frames[f].line, "signal exceeds frame length: ", name);
+      if (signals[sig].array && (offset % 8 != 0))
+        error(frames[f].line, "byte array not byte aligned: ", name);
+      if (signals[sig].frame >= 0)
+      {
+        warning(frames[f].line, "only 1st frame is used for signal ", name);
+        continue;
+      }
+      signals[sig].frame = (int) f;
+      signals[sig].start = offset;
+    }
+  }
+  if (frames.size() > 255)
+    error(tokens.back().line, "too many frames");
+  if (signals.size() > 255)
+    error(tokens.back().line, "too many signals");
+  if (encodings.size() >= 255)
+    error(tokens.back().line, "too many encodings");
+}
+
+
+// convert text to C identifier
+static std::string identifier(const std::string &Text)
+{
+  std::string id;
+  for (size_t i = 0; i < Text.size(); i++)
+    id += isalnum((unsigned char) Text[i]) ? Text[i] : '_';
+  if (id.empty() || isdigit((unsigned char) id[0]))
+    id = "_" + id;
+  return id;
+}
+
+
+// format float constant
+static std::string floatConst(double Value)
+{
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.9g", Value);
+  std::string str = buf;
+  if (str.find_first_of(".e") == std::string::npos)
+    str += ".0";
+  return str + "f";
+}
+
+
+// frame type as C++ enum
+static const char *frameType(const Frame &Frm)
+{
+  return (Frm.publisher == master) ? "LIN_Master_Base::MASTER_REQUEST" : "LIN_Master_Base::SLAVE_RESPONSE";
+}
+
+
+// smallest unsigned type for a signal width
+static const char *valueType(int Width)
+{
+  return (Width <= 8) ? "uint8_t" : ((Width <= 16) ? "uint16_t" : "uint32_t");
+}
+
+
+// write generated header
+static void generate(FILE *Out, const std::string &Name, const char *Source)
+{
+  std::string guard = "_LDF_" + identifier(Name) + "_H_";
+  for (size_t i = 0; i < guard.size(); i++)
+    guard[i] = (char) toupper((unsigned char) guard[i]);
+
+  // file header
+  fprintf(Out, "/**\n");
+  fprintf(Out, "  \\file     %s.h\n", Name.c_str());
+  fprintf(Out, "  \\brief    LIN tables generated from %s by LIN_ldf_gen. Do not edit\n", Source);
+  fprintf(Out, "  \\details  Frames, signals, encodings and schedule tables are stored in flash (PROGMEM), see LIN_master_LDF.h.\n");
+  fprintf(Out, "            Frame data buffers are defined static, i.e. include this header in only one source file.\n");
+  fprintf(Out, "*/\n\n");
+  fprintf(Out, "#ifndef %s\n#define %s\n\n", guard.c_str(), guard.c_str());
+  fprintf(Out, "#include <LIN_master_LDF.h>\n\n");
+  fprintf(Out, "namespace %s\n{\n", Name.c_str());
+
+  // bus properties
+  fprintf(Out, "  // bus properties\n");
+  fprintf(Out, "  constexpr LIN_Master_Base::version_t  VERSION  = LIN_Master_Base::LIN_V%d;   //!< LIN protocol version\n", version);
+  fprintf(Out, "  constexpr uint32_t                    BAUDRATE = %u;   //!< baudrate [Baud]\n\n", (unsigned) baudrate);
+
+  // frame indices and descriptors
+  fprintf(Out, "  // frame indices\n  enum : uint8_t\n  {\n");
+  for (size_t f = 0; f < frames.size(); f++)
+    fprintf(Out, "    FRAME_%s = %u,   //!< ID 0x%02X, %s, %d bytes\n", frames[f].name.c_str(), (unsigned) f, frames[f].id,
+      (frames[f].publisher == master) ? "master request" : "slave response", frames[f].length);
+  fprintf(Out, "    NUM_FRAMES = %u\n  };\n\n", (unsigned) frames.size());
+  fprintf(Out, "  // frame descriptors with precomputed PID, checksum seed, lengths and timeout\n");
+  fprintf(Out, "  constexpr LIN_Master_Base::descriptor_t FRAMES[NUM_FRAMES] PROGMEM =\n  {\n");
+  for (size_t f = 0; f < frames.size(); f++)
+    fprintf(Out, "    LIN_Master_LDF::frame(%s, VERSION, 0x%02X, %d, BAUDRATE),   // %s\n", frameType(frames[f]),
+      frames[f].id, frames[f].length, frames[f].name.c_str());
+  fprintf(Out, "  };\n\n");
+
+  // frame data buffers with init values. Unused bits are recessive
+  fprintf(Out, "  // frame data buffers (RAM) with signal init values. Unused bits are recessive\n");
+  for (size_t f = 0; f < frames.size(); f++)
+  {
+    uint8_t data[8];
+    memset(data, 0xFF, sizeof(data));
+    for (size_t s = 0; s < signals.size(); s++)
+    {
+      if (signals[s].frame != (int) f)
+        continue;
+      for (int b = 0; b < signals[s].width; b++)
+      {
+        int idx = b / 8;
+        uint32_t val = signals[s].array ? (signals[s].init[idx] >> (b % 8)) : (signals[s].init[0] >> b);
+        int bit = signals[s].start + b;
+        data[bit / 8] = (uint8_t) ((data[bit / 8] & ~(1 << (bit % 8))) | ((val & 0x01) << (bit % 8)));
+      }
+    }
+    fprintf(Out, "  static uint8_t data_%s[%d] = {", frames[f].name.c_str(), frames[f].length);
+    for (int i = 0; i < frames[f].length; i++)
+      fprintf(Out, "%s0x%02X", (i == 0) ? " " : ", ", data[i]);
+    fprintf(Out, " };\n");
+  }
+  fprintf(Out, "  constexpr uint8_t * DATA[NUM_FRAMES] PROGMEM =\n  {\n");
+  for (size_t f = 0; f < frames.size(); f++)
+    fprintf(Out, "    data_%s,\n", frames[f].name.c_str());
+  fprintf(Out, "  };\n\n");
+
+  // encodings and logical values
+  if (!encodings.empty())
+  {
+    fprintf(Out, "  // encoding indices\n  enum : uint8_t\n  {\n");
+    for (size_t e = 0; e < encodings.size(); e++)
+      fprintf(Out, "    ENC_%s = %u,\n", encodings[e].name.c_str(), (unsigned) e);
+    fprintf(Out, "    NUM_ENCODINGS = %u\n  };\n\n", (unsigned) encodings.size());
+    fprintf(Out, "  // physical encodings: physical = offset + scale * raw for raw in [min, max]\n");
+    fprintf(Out, "  constexpr LIN_Master_LDF::encoding_t ENCODINGS[NUM_ENCODINGS] PROGMEM =\n  {\n");
+    for (size_t e = 0; e < encodings.size(); e++)
+    {
+      const Encoding &enc = encodings[e];
+      fprintf(Out, "    { %u, %u, %s, %s },   // %s", (unsigned) enc.min, (unsigned) enc.max, floatConst(enc.scale).c_str(),
+        floatConst(enc.offset).c_str(), enc.name.c_str());
+      fprintf(Out, "%s%s\n", enc.unit.empty() ? "" : " [", enc.unit.empty() ? "" : (enc.unit + "]").c_str());
+    }
+    fprintf(Out, "  };\n\n");
+    fprintf(Out, "  // logical values\n");
+    std::vector<std::string> names;
+    for (size_t e = 0; e < encodings.size(); e++)
+    {
+      for (size_t l = 0; l < encodings[e].logical.size(); l++)
+      {
+        const Logical &val = encodings[e].logical[l];
+        std::string name = encodings[e].name + "_" + identifier(val.text.empty() ? std::to_string(val.value) : val.text);
+        for (size_t i = 0; i < names.size(); i++)
+          if (names[i] == name)
+            name += "_" + std::to_string(val.value);
+        names.push_back(name);
+        fprintf(Out, "  constexpr uint32_t %s = %u;\n", name.c_str(), (unsigned) val.value);
+      }
+    }
+    fprintf(Out, "\n");
+  }
+
+  // signals
+  fprintf(Out, "  // signal indices\n  enum : uint8_t\n  {\n");
+  for (size_t s = 0; s < signals.size(); s++)
+    fprintf(Out, "    SIG_%s = %u,\n", signals[s].name.c_str(), (unsigned) s);
+  fprintf(Out, "    NUM_SIGNALS = %u\n  };\n\n", (unsigned) signals.size());
+  fprintf(Out, "  // signals: frame, bit offset, width, encoding, init value. Unmapped signals use frame 0xFF\n");
+  fprintf(Out, "  constexpr LIN_Master_LDF::signal_t SIGNALS[NUM_SIGNALS] PROGMEM =\n  {\n");
+  for (size_t s = 0; s < signals.size(); s++)
+  {
+    const Signal &sig = signals[s];
+    std::string frm = (sig.frame >= 0) ? "FRAME_" + frames[sig.frame].name : "0xFF";
+    std::string enc = (sig.encoding >= 0) ? "ENC_" + encodings[sig.encoding].name : "LIN_MASTER_LDF_NO_ENCODING";
+    fprintf(Out, "    { %s, %d, %d, %s, %u },\n", frm.c_str(), sig.start, sig.width, enc.c_str(), sig.array ? 0 : (unsigned) sig.init[0]);
+  }
+  fprintf(Out, "  };\n\n");
+
+  // schedule tables
+  for (size_t t = 0; t < schedules.size(); t++)
+  {
+    const Schedule &sch = schedules[t];
+    fprintf(Out, "  // schedule table %s: type, version, ID, number of data, data, slot [us]\n", sch.name.c_str());
+    fprintf(Out, "  constexpr LIN_Master_Base::schedule_t SCHEDULE_%s[] PROGMEM =\n  {\n", sch.name.c_str());
+    for (size_t e = 0; e < sch.entries.size(); e++)
+    {
+      const Frame &frm = frames[sch.entries[e].first];
+      std::string data = (frm.publisher == master) ? "data_" + frm.name : "NULL";
+      fprintf(Out, "    { %s, VERSION, 0x%02X, %d, %s, %u },\n", frameType(frm), frm.id, frm.length, data.c_str(),
+        (unsigned) sch.entries[e].second);
+    }
+    fprintf(Out, "  };\n");
+    fprintf(Out, "  constexpr uint8_t NUM_SCHEDULE_%s = %u;\n\n", sch.name.c_str(), (unsigned) sch.entries.size());
+  }
+
+  // compile-time signal layouts and frame structs. Only mapped scalar signals
+  fprintf(Out, "  // signal layouts for compile-time packing, see LIN_master_Signal.h\n");
+  for (size_t s = 0; s < signals.size(); s++)
+    if ((signals[s].frame >= 0) && !signals[s].array)
+      fprintf(Out, "  typedef LIN_Master_Signal<%d, %d> Signal_%s;\n", signals[s].start, signals[s].width, signals[s].name.c_str());
+  fprintf(Out, "\n");
+  for (size_t f = 0; f < frames.size(); f++)
+  {
+    std::vector<size_t> scalar;
+    for (size_t s = 0; s < signals.size(); s++)
+      if ((signals[s].frame == (int) f) && !signals[s].array)
+        scalar.push_back(s);
+    if (scalar.empty())
+      continue;
+    const char *name = frames[f].name.c_str();
+    fprintf(Out, "  // raw signals of frame %s for bulk unpack() and pack()\n", name);
+    fprintf(Out, "  struct Frame_%s\n  {\n", name);
+    for (size_t i = 0; i < scalar.size(); i++)
+      fprintf(Out, "    %-10s %s;\n", valueType(signals[scalar[i]].width), signals[scalar[i]].name.c_str());
+    fprintf(Out, "  };\n");
+    fprintf(Out, "  typedef LIN_Master_Layout<Frame_%s", name);
+    for (size_t i = 0; i < scalar.size(); i++)
+      fprintf(Out, ",\n    LIN_MASTER_FIELD(Frame_%s, %s, %d, %d)", name, signals[scalar[i]].name.c_str(),
+        signals[scalar[i]].start, signals[scalar[i]].width);
+    fprintf(Out, "> Layout_%s;\n", name);
+    fprintf(Out, "  static inline void unpack(const uint8_t Data[], Frame_%s &Values) { Layout_%s::unpack(Data, Values); }\n", name, name);
+    fprintf(Out, "  static inline void pack(uint8_t Data[], const Frame_%s &Values) { Layout_%s::pack(Data, Values); }\n\n", name, name);
+  }
+
+  // signal access
+  fprintf(Out, "  /// raw value of scalar signal in its frame data buffer\n");
+  fprintf(Out, "  static inline uint32_t getSignal(uint8_t Signal)\n  {\n");
+  fprintf(Out, "    LIN_Master_LDF::signal_t sig = LIN_Master_LDF::read_P(&(SIGNALS[Signal]));\n");
+  fprintf(Out, "    return LIN_Master_LDF::getRaw(sig, LIN_Master_LDF::read_P(&(DATA[sig.frame])));\n  }\n\n");
+  fprintf(Out, "  /// set raw value of scalar signal in its frame data buffer\n");
+  fprintf(Out, "  static inline void setSignal(uint8_t Signal, uint32_t Value)\n  {\n");
+  fprintf(Out, "    LIN_Master_LDF::signal_t sig = LIN_Master_LDF::read_P(&(SIGNALS[Signal]));\n");
+  fprintf(Out, "    LIN_Master_LDF::setRaw(sig, LIN_Master_LDF::read_P(&(DATA[sig.frame])), Value);\n  }\n\n");
+
+  fprintf(Out, "} // namespace %s\n\n#endif // %s\n", Name.c_str(), guard.c_str());
+}
+
+
+int main(int argc, char *argv[])
+{
+  const char  *outName = NULL;
+  std::string name;
+  bool        usage = false;
+
+  // parse arguments
+  for (int i = 1; i < argc; i++)
+  {
+    if ((strcmp(argv[i], "-n") == 0) && (i+1 < argc))
+      name = argv[++i];
+    else if ((strcmp(argv[i], "-o") == 0) && (i+1 < argc))
+      outName = argv[++i];
+    else if ((argv[i][0] != '-') && (fileName == NULL))
+      fileName = argv[i];
+    else
+      usage = true;
+  }
+  if (usage || (fileName == NULL))
+  {
+    fprintf(stderr, "usage: LIN_ldf_gen file.ldf [-n namespace] [-o file.h]\n");
+    return 1;
+  }
+
+  // default namespace is LDF file name w/o path and extension
+  if (name.empty())
+  {
+    name = fileName;
+    size_t slash = name.find_last_of('/');
+    if (slash != std::string::npos)
+      name = name.substr(slash+1);
+    name = identifier(name.substr(0, name.find('.')));
+  }
+
+  // read LDF
+  FILE *fp = fopen(fileName, "rb");
+  if (fp == NULL)
+  {
+    fprintf(stderr, "cannot open %s\n", fileName);
+    return 1;
+  }
+  std::string text;
+  char buf[4096];
+  size_t num;
+  while ((num = fread(buf, 1, sizeof(buf), fp)) > 0)
+    text.append(buf, num);
+  fclose(fp);
+
+  // parse and check
+  tokenize(text);
+  parse();
+  link();
+
+  // write header
+  FILE *out = stdout;
+  if (outName != NULL)
+  {
+    out = fopen(outName, "w");
+    if (out == NULL)
+    {
+      fprintf(stderr, "cannot create %s\n", outName);
+      return 1;
+    }
+  }
+  const char *source = strrchr(fileName, '/');
+  generate(out, name, (source != NULL) ? source+1 : fileName);
+  if (out != stdout)
+    fclose(out);
+
+  return 0;
+
+} // main()
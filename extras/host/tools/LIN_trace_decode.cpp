@@ -0,0 +1,121 @@
+/*********************
+
+Decoder for binary trace of LIN master library
+
+Reads trace entries as copied by LIN_Master_Base::getTrace() (8 bytes each, little endian) from a file or stdin,
+e.g. captured from Serial.write(), and prints them as text with time relative to the 1st entry.
+
+usage: LIN_trace_decode [file]
+
+Note: event codes must be kept in sync with LIN_Master_Base::trace_event_t
+
+**********************/
+
+// include files
+#include <stdio.h>
+#include <stdint.h>
+
+
+// print state bitmask as text
+static const char *stateName(uint8_t State)
+{
+  switch (State)
+  {
+    case 0x01: return "OFF";
+    case 0x02: return "IDLE";
+    case 0x04: return "BREAK";
+    case 0x08: return "BODY";
+    case 0x10: return "DONE";
+    default:   return "?";
+  }
+}
+
+
+// decode and print one trace entry
+static void printEntry(const uint8_t Raw[8], uint32_t TimeFirst, uint32_t &TimePrev)
+{
+  uint32_t  time  = (uint32_t) Raw[0] | ((uint32_t) Raw[1] << 8) | ((uint32_t) Raw[2] << 16) | ((uint32_t) Raw[3] << 24);
+  uint8_t   event = Raw[4];
+  uint8_t   node  = Raw[5];
+  uint8_t   arg1  = Raw[6];
+  uint8_t   arg2  = Raw[7];
+
+  // time relative to 1st entry and to previous entry
+  printf("%10u %+8d  node %u  ", (unsigned) (time - TimeFirst), (int) (time - TimePrev), (unsigned) node);
+  TimePrev = time;
+
+  // event specific text
+  switch (event)
+  {
+    case 0x01:
+      printf("START     ID=0x%02X %s\n", arg1, (arg2 == 0x01) ? "request" : "response");
+      break;
+    case 0x02:
+      printf("STATE     %-5s err=0x%02X\n", stateName(arg1), arg2);
+      break;
+    case 0x03:
+      printf("RX        [%u]=0x%02X\n", arg1, arg2);
+      break;
+    case 0x04:
+      printf("ERR_ECHO  [%u]=0x%02X\n", arg1, arg2);
+      break;
+    case 0x05:
+      printf("ERR_CHK   expect=0x%02X received=0x%02X\n", arg1, arg2);
+      break;
+    case 0x06:
+      printf("SLOT      [%u] ID=0x%02X\n", arg1, arg2);
+      break;
+    case 0x07:
+      printf("QUEUE     ID=0x%02X remaining=%u\n", arg1, arg2);
+      break;
+    case 0x08:
+      printf("CALLBACK  ID=0x%02X err=0x%02X\n", arg1, arg2);
+      break;
+    case 0x09:
+      printf("CHANGE    ID=0x%02X bytes=0x%02X\n", arg1, arg2);
+      break;
+    default:
+      printf("unknown event 0x%02X (0x%02X 0x%02X)\n", event, arg1, arg2);
+  }
+
+} // printEntry()
+
+
+int main(int argc, char *argv[])
+{
+  FILE      *fp = stdin;
+  uint8_t   raw[8];
+  uint32_t  num = 0;
+  uint32_t  timeFirst = 0, timePrev = 0;
+
+  // open trace file or use stdin
+  if (argc > 1)
+  {
+    fp = fopen(argv[1], "rb");
+    if (fp == NULL)
+    {
+      fprintf(stderr, "cannot open %s\n", argv[1]);
+      return 1;
+    }
+  }
+
+  // decode all entries
+  printf("  time[us] delta[us]\n");
+  while (fread(raw, sizeof(raw), 1, fp) == 1)
+  {
+    if (num++ == 0)
+    {
+      timeFirst = (uint32_t) raw[0] | ((uint32_t) raw[1] << 8) | ((uint32_t) raw[2] << 16) | ((uint32_t) raw[3] << 24);
+      timePrev  = timeFirst;
+    }
+    printEntry(raw, timeFirst, timePrev);
+  }
+  printf("%u entries\n", (unsigned) num);
+
+  // close file
+  if (fp != stdin)
+    fclose(fp);
+
+  return 0;
+
+} // main()
@@ -10,6 +10,20 @@
 // include files
 #include <LIN_master_Base.h>
 
+
+/**************************
+ * STATIC VARIABLES
+**************************/
+
+// optional binary trace, shared by all nodes
+#if defined(LIN_MASTER_TRACE)
+  static_assert((LIN_MASTER_TRACE_SIZE & (LIN_MASTER_TRACE_SIZE-1)) == 0, "LIN_MASTER_TRACE_SIZE must be power of 2");
+  LIN_Master_Base::trace_t  LIN_Master_Base::traceBuf[LIN_MASTER_TRACE_SIZE];
+  volatile uint16_t         LIN_Master_Base::traceHead = 0;
+  uint16_t                  LIN_Master_Base::traceTail = 0;
+  uint8_t                   LIN_Master_Base::traceNum  = 0;
+#endif
+
 // warn if debug interface is active (see LIN_master_Base.h)
 #if defined(LIN_MASTER_DEBUG_SERIAL)
   #warning Debug interface is active, see file 'LIN_master_Base.h'
@@ -24,15 +38,16 @@
 /**
   \brief      Calculate protected frame ID
   \details    Calculate protected frame ID as described in LIN2.0 spec "2.3.1.3 Protected identifier field"
+  \param[in]  Id        frame idendifier (protected or unprotected)
   \return     Protected frame ID
 */
-uint8_t LIN_Master_Base::_calculatePID(void)
+uint8_t LIN_Master_Base::_calculatePID(uint8_t Id)
 {
   uint8_t  pid_tmp;   // calculated protected frame ID
   uint8_t  tmp;       // temporary variable for calculating parity bits
 
   // protect ID  with parity bits
-  pid_tmp  = (uint8_t) (this->id & 0x3F);                                                   // clear upper bits 6 & 7
+  pid_tmp  = (uint8_t) (Id & 0x3F);                                                         // clear upper bits 6 & 7
   tmp  = (uint8_t) ((pid_tmp ^ (pid_tmp>>1) ^ (pid_tmp>>2) ^ (pid_tmp>>4)) & 0x01);         // pid[6] = PI0 = ID0^ID1^ID2^ID4
   pid_tmp |= (uint8_t) (tmp << 6);
   tmp  = (uint8_t) (~((pid_tmp>>1) ^ (pid_tmp>>3) ^ (pid_tmp>>4) ^ (pid_tmp>>5)) & 0x01);   // pid[7] = PI1 = ~(ID1^ID3^ID4^ID5)
@@ -50,28 +65,23 @@ uint8_t LIN_Master_Base::_calculatePID(void)
 
 /**
   \brief      Calculate LIN frame checksum
-  \details    Calculate LIN frame checksum as described in LIN1.x / LIN2.x specs
+  \details    Calculate LIN frame checksum as described in LIN1.x / LIN2.x specs. Starts from checksum seed,
+              which is the PID for enhanced checksum (LIN2.x) and 0 for classic checksum (LIN1.x, diagnostic frames)
   \param[in]  NumData   number of data bytes in frame
   \param[in]  Data      frame data bytes
   \return     calculated checksum, depending on protocol version
 */
-uint8_t LIN_Master_Base::_calculateChecksum(uint8_t NumData, uint8_t Data[])
+uint8_t LIN_Master_Base::_calculateChecksum(uint8_t NumData, const uint8_t Data[])
 {
-  uint16_t chk = 0x00;    // frame checksum
-
-  // LIN2.x uses extended checksum which includes protected ID, i.e. including parity bits
-  // LIN1.x uses classical checksum only over data bytes
-  // Diagnostic frames with ID=0x3C/PID=0x3C and ID=0x3D/PID=0x7D always use classical checksum (see LIN spec "2.3.1.5 Checkum")
-  if (!((this->version == LIN_V1) || (id == 0x3C) || (id == 0x3D)))
-    chk = (uint16_t) this->_calculatePID();
+  uint16_t chk = (uint16_t) this->chkSeed;    // frame checksum
 
-  // loop over data bytes
+  // sum over data bytes. Max. 256*255 -> no 16-bit overflow
   for (uint8_t i = 0; i < NumData; i++)
-  {
     chk += (uint16_t) (Data[i]);
-    if (chk>255)
-      chk -= 255;
-  }
+
+  // add carries (twice, as 1st addition may carry again) instead of checking for carry after each byte
+  chk = (chk & 0xFF) + (chk >> 8);
+  chk = (chk & 0xFF) + (chk >> 8);
   chk = (uint8_t)(0xFF - ((uint8_t) chk));   // bitwise invert and strip upper byte
 
   // print debug message
@@ -129,6 +139,404 @@ LIN_Master_Base::error_t LIN_Master_Base::_checkFrame(void)
 
 
 
+/**
+  \brief      Store and check a single received byte
+  \details    Store and check a single received byte (echo or slave response). The echo of sent bytes is checked
+              immediately and the checksum is accumulated, so the frame is aborted on the 1st mismatch, which releases
+              the bus and CPU before the frame timeout. After the last byte the checksum is checked and the frame is completed.
+  \param[in]  Data      received byte
+  \return     current state of LIN state machine
+*/
+LIN_Master_Base::state_t LIN_Master_Base::_receiveByte(uint8_t Data)
+{
+  uint8_t   idx = this->idxRx;      // index of received byte in frame
+
+  // frame already completed or aborted -> ignore byte
+  if ((!(this->state & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY))) || (idx >= this->lenRx))
+    return this->state;
+
+  // store byte
+  this->bufRx[idx] = Data;
+  this->idxRx = idx + 1;
+  LIN_TRACE(LIN_Master_Base::TRACE_RX, idx, Data);
+
+  // echo of sent byte -> check immediately
+  if (idx < this->lenTx)
+  {
+    // echo error -> abort frame
+    if (Data != this->bufTx[idx])
+    {
+      // print debug message
+      DEBUG_PRINT(1, "echo error: Tx[%d]=0x%02X, Rx[%d]=0x%02X", (int) idx, (int) this->bufTx[idx], (int) idx, (int) Data);
+      LIN_TRACE(LIN_Master_Base::TRACE_ERR_ECHO, idx, Data);
+
+      // set error state and return immediately
+      this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_ECHO);
+      this->state = LIN_Master_Base::STATE_DONE;
+      this->_disableTransmitter();
+      return this->state;
+    }
+
+    // header of slave response sent -> optionally disable RS485 transmitter
+    if ((idx == this->lenTx-1) && (this->type == LIN_Master_Base::SLAVE_RESPONSE))
+      this->_disableTransmitter();
+
+  } // echo
+
+  // data byte -> accumulate checksum
+  if ((idx >= 3) && (idx < this->lenRx-1))
+    this->chkRx += (uint16_t) Data;
+
+  // checksum received -> check and finish frame
+  else if (idx == this->lenRx-1)
+  {
+    // add carries (see _calculateChecksum()) and invert
+    uint16_t chk = this->chkRx;
+    chk = (chk & 0xFF) + (chk >> 8);
+    chk = (chk & 0xFF) + (chk >> 8);
+    chk = (uint8_t)(0xFF - ((uint8_t) chk));
+
+    // checksum error
+    if (Data != (uint8_t) chk)
+    {
+      // print debug message
+      DEBUG_PRINT(1, "checksum error: expect 0x%02X, received 0x%02X", (int) chk, (int) Data);
+      LIN_TRACE(LIN_Master_Base::TRACE_ERR_CHK, chk, Data);
+
+      // set error
+      this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_CHK);
+    }
+
+    // optionally disable RS485 transmitter after frame is completed
+    this->_disableTransmitter();
+
+    // progress state
+    this->state = LIN_Master_Base::STATE_DONE;
+
+    // print debug message
+    DEBUG_PRINT(3, "done");
+
+  } // checksum received
+
+  // return state
+  return this->state;
+
+} // LIN_Master_Base::_receiveByte()
+
+
+
+/**
+  \brief      Start next frame of schedule table
+  \details    Start next frame of schedule table at slot boundary. Optionally switch to new schedule table first.
+              Result of previous frame is discarded. If previous frame is still ongoing, start is delayed until done.
+*/
+void LIN_Master_Base::_startSlot(void)
+{
+  // previous frame still ongoing or interface closed -> try again later
+  if (!(this->state & (LIN_Master_Base::STATE_IDLE | LIN_Master_Base::STATE_DONE)))
+    return;
+
+  // optionally switch schedule table at slot boundary
+  if (this->scheduleSwitch)
+  {
+    this->scheduleSwitch = false;
+    this->scheduleTable  = this->scheduleNew;
+    this->scheduleNum    = this->scheduleNumNew;
+    this->scheduleFlash  = this->scheduleFlashNew;
+    this->scheduleIdx    = 0;
+
+    // schedule was stopped
+    if (this->scheduleTable == NULL)
+    {
+      // print debug message
+      DEBUG_PRINT(2, "schedule stopped");
+
+      return;
+    }
+
+  } // switch table
+
+  // copy current entry (from flash on AVR) and advance to next
+  LIN_Master_Base::schedule_t entry;
+  uint8_t idx = this->scheduleIdx;
+  #if defined(__AVR__)
+    if (this->scheduleFlash)
+      memcpy_P(&entry, &(this->scheduleTable[idx]), sizeof(entry));
+    else
+  #endif
+      entry = this->scheduleTable[idx];
+  if (++(this->scheduleIdx) >= this->scheduleNum)
+    this->scheduleIdx = 0;
+
+  // next slot boundary on fixed grid. If more than one slot late (e.g. handler not called), re-synchronize
+  uint32_t now = micros();
+  this->scheduleNext += entry.slot;
+  if ((int32_t) (now - this->scheduleNext) >= 0)
+    this->scheduleNext = now + entry.slot;
+
+  // print debug message
+  DEBUG_PRINT(3, "ID=0x%02X", (int) entry.id);
+  LIN_TRACE(LIN_Master_Base::TRACE_SLOT, idx, entry.id);
+
+  // start frame
+  this->state = LIN_Master_Base::STATE_IDLE;
+  this->error = LIN_Master_Base::NO_ERROR;
+  if (entry.type == LIN_Master_Base::MASTER_REQUEST)
+    this->sendMasterRequest(entry.version, entry.id, entry.numData, entry.data);
+  else
+    this->receiveSlaveResponse(entry.version, entry.id, entry.numData);
+
+} // LIN_Master_Base::_startSlot()
+
+
+
+/**
+  \brief      Call completion callback for finished frame
+  \details    Call completion callback with frame, error and timing of the finished frame. Is called once per frame
+              by handler() when STATE_DONE is reached. State and error are not reset, i.e. polling via getState() still works.
+*/
+void LIN_Master_Base::_notify(void)
+{
+  LIN_Master_Base::result_t   result;
+
+  // callback is called only once per frame
+  this->callbackPending = false;
+
+  // collect frame result
+  result.type      = this->type;
+  result.version   = this->version;
+  result.id        = this->id;
+  result.numData   = this->lenRx - 4;
+  result.data      = this->bufRx + 3;
+  result.error     = this->error;
+  result.timeStart = this->timeStart;
+  result.duration  = micros() - this->timeStart;
+
+  // print debug message
+  DEBUG_PRINT(3, "ID=0x%02X, err=0x%02X", (int) result.id, (int) result.error);
+  LIN_TRACE(LIN_Master_Base::TRACE_CALLBACK, result.id, result.error);
+
+  // call user function
+  this->callback(*this, result, this->callbackArg);
+
+} // LIN_Master_Base::_notify()
+
+
+
+/**
+  \brief      Compare finished slave response with subscriptions and call change callbacks
+  \details    Compare finished slave response with subscriptions and call change callbacks. Is called once per slave
+              response by handler() when STATE_DONE is reached w/o error. Data is compared word-wise via XOR and masked
+              with the watched bits, i.e. unchanged responses cost only a few instructions per subscription.
+*/
+void LIN_Master_Base::_checkChanges(void)
+{
+  LIN_Master_Base::payload_t        data;
+  LIN_Master_Base::subscription_t   *sub, *next;
+  uint32_t                          diff0, diff1;
+  uint8_t                           numData;
+  uint8_t                           id = this->id & 0x3F;
+
+  // changes are checked only once per frame
+  this->changePending = false;
+
+  // erroneous responses are ignored
+  if (this->error != LIN_Master_Base::NO_ERROR)
+    return;
+
+  // copy data for aligned word access. Unused bytes are 0. Fixed length avoids a slow generic memcpy()
+  numData = this->lenRx - 4;
+  for (uint8_t i = 0; i < 8; i++)
+    data.byte[i] = (i < numData) ? this->bufRx[3+i] : 0x00;
+
+  // compare with all subscriptions of this ID. Next is stored before callback, which may unsubscribe itself
+  for (sub = this->subscriptions; sub != NULL; sub = next)
+  {
+    next = sub->next;
+    if (sub->id != id)
+      continue;
+
+    // count response
+    if (sub->numFrames < UINT16_MAX)
+      sub->numFrames++;
+
+    // watched bits unchanged -> nothing to do
+    diff0 = (data.word[0] ^ sub->last.word[0]) & sub->mask.word[0];
+    diff1 = (data.word[1] ^ sub->last.word[1]) & sub->mask.word[1];
+    if (((diff0 | diff1) == 0) && (sub->valid))
+      continue;
+
+    // store change. 1st response changes all watched bits
+    sub->changed.word[0] = (sub->valid) ? diff0 : sub->mask.word[0];
+    sub->changed.word[1] = (sub->valid) ? diff1 : sub->mask.word[1];
+    sub->last  = data;
+    sub->valid = true;
+    if (sub->numChanges < UINT16_MAX)
+      sub->numChanges++;
+
+    // print debug message
+    DEBUG_PRINT(3, "ID=0x%02X changed", (int) id);
+    #if defined(LIN_MASTER_TRACE)
+      uint8_t bytes = 0;
+      for (uint8_t i = 0; i < 8; i++)
+        bytes |= (sub->changed.byte[i] != 0) << i;
+      LIN_TRACE(LIN_Master_Base::TRACE_CHANGE, id, bytes);
+    #endif
+
+    // call user function
+    if (sub->callback != NULL)
+      sub->callback(*this, *sub, sub->arg);
+  }
+
+} // LIN_Master_Base::_checkChanges()
+
+
+
+/**
+  \brief      Check changes and call completion callback once for finished frame
+  \details    Check changes and call completion callback once for finished frame. Is called by handler() before a
+              new frame is started, as a frame may already be finished by an Rx ISR, and after the state machine
+              for frames finished in the same call. Starting a frame overwrites the pending flags.
+*/
+void LIN_Master_Base::_finishFrame(void)
+{
+  // only for finished frame
+  if (this->state != LIN_Master_Base::STATE_DONE)
+    return;
+
+  // slave response finished -> check for changes once
+  if (this->changePending)
+    this->_checkChanges();
+
+  // frame finished -> call optional completion callback once
+  if (this->callbackPending)
+    this->_notify();
+
+} // LIN_Master_Base::_finishFrame()
+
+
+
+/**
+  \brief      Start oldest frame of request queue
+  \details    Start oldest frame of request queue. Result of previous frame is discarded, i.e. use attachCallback()
+              to receive the results of queued frames. Queue entry is released after its data has been copied.
+*/
+void LIN_Master_Base::_startQueued(void)
+{
+// queue not used -> is never called, as queue is always empty
+#if (LIN_MASTER_QUEUE_SIZE > 0)
+
+  uint8_t   tail = this->queueTail;
+
+  // queueHead was read by handler(). Read entry only after that, as it is published before queueHead, see queueFrame()
+  LIN_MASTER_MEMORY_BARRIER();
+
+  // print debug message
+  DEBUG_PRINT(3, "ID=0x%02X", (int) this->queueBuf[tail].frame.id);
+  LIN_TRACE(LIN_Master_Base::TRACE_QUEUE, this->queueBuf[tail].frame.id, this->queueCount() - 1);
+
+  // start frame. Data is copied to bufTx by startFrame()
+  this->state = LIN_Master_Base::STATE_IDLE;
+  this->error = LIN_Master_Base::NO_ERROR;
+  this->startFrame(this->queueBuf[tail].frame, this->queueBuf[tail].data);
+
+  // release queue entry after frame was copied
+  LIN_MASTER_MEMORY_BARRIER();
+  this->queueTail = (tail >= LIN_MASTER_QUEUE_SIZE) ? 0 : tail + 1;
+
+#endif // LIN_MASTER_QUEUE_SIZE > 0
+
+} // LIN_Master_Base::_startQueued()
+
+
+
+#if defined(LIN_MASTER_TIMING)
+
+/**
+  \brief      Add sample to timing histogram
+  \details    Add sample to timing histogram with log2 buckets, i.e. bucket i>0 contains [2^(i-1), 2^i) us. Counters saturate
+  \param[in,out] Histogram   histogram to update
+  \param[in]  Value     sample [us]
+*/
+void LIN_Master_Base::_addSample(LIN_Master_Base::histogram_t &Histogram, uint32_t Value)
+{
+  uint8_t   idx = 0;
+
+  // bucket index = number of significant bits, limited to last bucket
+  for (uint32_t val = Value; (val != 0) && (idx < LIN_MASTER_TIMING_BUCKETS-1); val >>= 1)
+    idx++;
+
+  // update statistics
+  if (Histogram.bucket[idx] < 0xFFFF)
+    Histogram.bucket[idx]++;
+  if ((Histogram.num == 0) || (Value < Histogram.min))
+    Histogram.min = Value;
+  if (Value > Histogram.max)
+    Histogram.max = Value;
+  if (Histogram.num < 0xFFFF)
+    Histogram.num++;
+
+} // LIN_Master_Base::_addSample()
+
+
+
+/**
+  \brief      Record timing of state transitions of current frame
+  \details    Record timing of state transitions of current frame (end of BREAK, header echo, 1st response byte, frame done).
+              Is called by handler() after state or number of received bytes has changed, i.e. time stamps are as observed by
+              handler(). Each sample is recorded once per frame. Is locked, as it is also called from Rx ISRs or DMA callbacks
+              of some backends, e.g. LIN_Master_NeoHWSerial_AVR.
+*/
+void LIN_Master_Base::_recordTiming(void)
+{
+  LIN_MASTER_CRITICAL_BEGIN();
+  uint32_t  now = micros();
+
+  // BREAK completed
+  if ((this->state == LIN_Master_Base::STATE_BODY) && (!(this->timingFlags & 0x01)))
+  {
+    this->timingFlags |= 0x01;
+    this->_addSample(this->timing.breakDuration, now - this->timeStart);
+  }
+
+  // header echo (BREAK+SYNC+PID) received
+  if ((this->idxRx >= 3) && (this->error == LIN_Master_Base::NO_ERROR) && (!(this->timingFlags & 0x02)))
+  {
+    this->timingFlags |= 0x02;
+    this->timeHeader = now;
+    this->_addSample(this->timing.header, now - this->timeStart);
+  }
+
+  // 1st slave response byte received
+  if ((this->type == LIN_Master_Base::SLAVE_RESPONSE) && (this->idxRx > 3) && (this->timingFlags & 0x02) && (!(this->timingFlags & 0x04)))
+  {
+    this->timingFlags |= 0x04;
+    this->_addSample(this->timing.responseSpace, now - this->timeHeader);
+  }
+
+  // frame completed
+  if ((this->state == LIN_Master_Base::STATE_DONE) && (!(this->timingFlags & 0x08)))
+  {
+    this->timingFlags |= 0x08;
+    if (this->error == LIN_Master_Base::NO_ERROR)
+    {
+      this->_addSample(this->timing.frame, now - this->timeStart);
+      #if defined(LIN_MASTER_TIMING_PER_ID)
+        this->_addSample(this->timingId[this->id & 0x3F], now - this->timeStart);
+      #endif
+    }
+    else if (this->timing.numErr < 0xFFFF)
+      this->timing.numErr++;
+  }
+
+  LIN_MASTER_CRITICAL_END();
+
+} // LIN_Master_Base::_recordTiming()
+
+#endif // LIN_MASTER_TIMING
+
+
+
 /**
   \brief      Send LIN break
   \details    Send LIN break (=16bit low). Here dummy!
@@ -223,11 +631,47 @@ LIN_Master_Base::LIN_Master_Base(const char NameLIN[], const int8_t PinTxEN)
   // store parameters in class variables
   memcpy(this->nameLIN, NameLIN, LIN_MASTER_BUFLEN_NAME);     // node name e.g. for debug
   this->pinTxEN = PinTxEN;                                    // optional Tx enable pin for RS485
+  this->profile = LIN_Master_Base::PROFILE_STANDARD;          // break and timeout parameters
 
   // initialize master node properties
   this->error = LIN_Master_Base::NO_ERROR;                    // last LIN error. Is latched
   this->state = LIN_Master_Base::STATE_OFF;                   // status of LIN state machine
 
+  // no schedule table active
+  this->scheduleTable  = NULL;
+  this->scheduleNew    = NULL;
+  this->scheduleNum    = 0;
+  this->scheduleNumNew = 0;
+  this->scheduleIdx    = 0;
+  this->scheduleSwitch = false;
+  this->scheduleFlash  = false;
+  this->scheduleFlashNew = false;
+  this->scheduleNext   = 0;
+
+  // no completion callback
+  this->callback        = NULL;
+  this->callbackArg     = NULL;
+  this->callbackPending = false;
+
+  // no change subscriptions
+  this->subscriptions = NULL;
+  this->changePending = false;
+
+  // empty request queue
+  this->queueHead = 0;
+  this->queueTail = 0;
+
+  // clear optional timing statistics
+  #if defined(LIN_MASTER_TIMING)
+    this->timingFlags = 0x00;
+    this->resetTiming();
+  #endif
+
+  // node index for optional trace
+  #if defined(LIN_MASTER_TRACE)
+    this->traceNode = LIN_Master_Base::traceNum++;
+  #endif
+
 } // LIN_Master_Base::LIN_Master_Base()
 
 
@@ -237,7 +681,7 @@ LIN_Master_Base::LIN_Master_Base(const char NameLIN[], const int8_t PinTxEN)
   \details    Open serial interface with specified baudrate. Here dummy!
   \param[in]  Baudrate    communication speed [Baud] (default = 19200)
 */
-void LIN_Master_Base::begin(uint16_t Baudrate)
+void LIN_Master_Base::begin(uint32_t Baudrate)
 {
   // initialize debug interface with optional timeout
   #if defined(LIN_MASTER_DEBUG_SERIAL)
@@ -256,7 +700,8 @@ void LIN_Master_Base::begin(uint16_t Baudrate)
   // initialize master node properties
   this->error = LIN_Master_Base::NO_ERROR;                      // last LIN error. Is latched
   this->state = LIN_Master_Base::STATE_IDLE;                    // status of LIN state machine
-  this->timePerByte = 10000000L / (uint32_t) this->baudrate;    // time [us] per byte (for performance)
+  this->timeHandler = micros();                                 // time of last handler() call
+  this->timePerByte = (10000000L + this->baudrate - 1) / this->baudrate;  // time [us] per byte, rounded up (for performance)
 
   // initialize optional TxEN pin to low (=transmitter off)
   if (this->pinTxEN >= 0)
@@ -266,7 +711,7 @@ void LIN_Master_Base::begin(uint16_t Baudrate)
   }
 
   // print debug message
-  DEBUG_PRINT(2, "BR=%d", (int) Baudrate);
+  DEBUG_PRINT(2, "BR=%ld", (long) Baudrate);
   
 } // LIN_Master_Base::begin()
 
@@ -282,6 +727,13 @@ void LIN_Master_Base::end()
   this->error = LIN_Master_Base::NO_ERROR;                    // last LIN error. Is latched
   this->state = LIN_Master_Base::STATE_OFF;                   // status of LIN state machine
 
+  // stop schedule table immediately
+  this->scheduleTable  = NULL;
+  this->scheduleSwitch = false;
+
+  // discard pending frames
+  this->queueTail = this->queueHead;
+
   // optionally disable RS485 transmitter
   this->_disableTransmitter();
 
@@ -293,38 +745,100 @@ void LIN_Master_Base::end()
 
 
 /**
-  \brief      Start sending a LIN master request frame in background (if supported)
-  \details    Start sending a LIN master request frame in background (if supported). Background handling is handling by handler().
-              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \brief      Precompute properties of a LIN frame
+  \details    Precompute PID, checksum seed, buffer lengths and timeout of a LIN frame. The prepared frame can then
+              be started repeatedly via startFrame() without recalculation. Timeout depends on baudrate, therefore
+              prepare frames after begin().
+  \param[out] Frame     prepared frame
+  \param[in]  Type      LIN frame type
   \param[in]  Version   LIN protocol version (default = v2)
   \param[in]  Id        frame idendifier (protected or unprotected)
   \param[in]  NumData   number of data bytes (0..8)
-  \param[in]  Data      data bytes
+*/
+void LIN_Master_Base::prepareFrame(LIN_Master_Base::descriptor_t &Frame, LIN_Master_Base::frame_t Type, 
+  LIN_Master_Base::version_t Version, uint8_t Id, uint8_t NumData)
+{
+  // store frame properties
+  Frame.type    = Type;
+  Frame.version = Version;
+  Frame.id      = Id;
+
+  // protected ID
+  Frame.pid = this->_calculatePID(Id);
+
+  // LIN2.x uses extended checksum which includes protected ID, i.e. including parity bits
+  // LIN1.x uses classical checksum only over data bytes
+  // Diagnostic frames with ID=0x3C/PID=0x3C and ID=0x3D/PID=0x7D always use classical checksum (see LIN spec "2.3.1.5 Checkum")
+  if ((Version == LIN_Master_Base::LIN_V1) || (Id == 0x3C) || (Id == 0x3D))
+    Frame.chkSeed = 0x00;
+  else
+    Frame.chkSeed = Frame.pid;
+
+  // buffer lengths. Request: BREAK+SYNC+PID+DATA[]+CHK, just receive LIN echo. Response: send header, receive header echo + DATA[] + CHK
+  Frame.lenRx = NumData + 4;
+  Frame.lenTx = (Type == LIN_Master_Base::MASTER_REQUEST) ? Frame.lenRx : 3;
+
+  // frame timeout depending on profile, see setProfile()
+  Frame.timeout = this->_frameTimeout(Frame.lenRx);
+
+  // print debug message
+  DEBUG_PRINT(3, "PID=0x%02X", (int) Frame.pid);
+
+} // LIN_Master_Base::prepareFrame()
+
+
+
+/**
+  \brief      Start a prepared LIN frame in background (if supported)
+  \details    Start a prepared LIN frame in background (if supported). Background handling is handling by handler().
+              Only the checksum over the data bytes of a master request is calculated here.
+  \param[in]  Frame     frame prepared via prepareFrame()
+  \param[in]  Data      data bytes for master request (not used for slave response)
   \return     LIN state machine state
 */
-LIN_Master_Base::state_t LIN_Master_Base::sendMasterRequest(LIN_Master_Base::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[])
+LIN_Master_Base::state_t LIN_Master_Base::startFrame(const LIN_Master_Base::descriptor_t &Frame, const uint8_t Data[])
 {
-  // construct Tx frame
-  this->type     = LIN_Master_Base::MASTER_REQUEST;
-  this->version  = Version;
-  this->id       = Id;
-  this->lenTx    = NumData + 4;                                         // Frame length
+  // copy frame properties
+  this->type     = Frame.type;
+  this->version  = Frame.version;
+  this->id       = Frame.id;
+  this->chkSeed  = Frame.chkSeed;
+  this->lenTx    = Frame.lenTx;
+  this->lenRx    = Frame.lenRx;
+
+  // construct Tx frame. Response frame only has header
   this->bufTx[0] = 0x00;                                                // BREAK
   this->bufTx[1] = 0x55;                                                // SYNC
-  this->bufTx[2] = this->_calculatePID();                               // PID
-  memcpy(this->bufTx+3, Data, NumData);                                 // DATA[]
-  this->bufTx[this->lenTx-1] = this->_calculateChecksum(NumData, Data); // CHK
-  this->lenRx    = this->lenTx;                                         // just receive LIN echo
+  this->bufTx[2] = Frame.pid;                                           // PID
+  if (Frame.type == LIN_Master_Base::MASTER_REQUEST)
+  {
+    memcpy(this->bufTx+3, Data, this->lenTx-4);                         // DATA[]
+    this->bufTx[this->lenTx-1] = this->_calculateChecksum(this->lenTx-4, Data); // CHK
+  }
 
-  // init receive buffer
+  // init receive buffer and checksum accumulator
   memset(this->bufRx, 0, 12);
+  this->idxRx = 0;
+  this->chkRx = (uint16_t) Frame.chkSeed;
+
+  // call optional completion callback once for this frame
+  this->callbackPending = (this->callback != NULL);
+
+  // check slave response for changes once
+  this->changePending = (this->subscriptions != NULL) && (Frame.type == LIN_Master_Base::SLAVE_RESPONSE);
 
-  // set break timeout (= 200% nominal) and start timeout
+  // no timing samples yet recorded for this frame
+  #if defined(LIN_MASTER_TIMING)
+    this->timingFlags = 0x00;
+  #endif
+
+  // start timeout
   this->timeStart    = micros();
-  this->timeoutFrame = ((this->lenRx + 1) * this->timePerByte) * 2;
+  this->timeoutFrame = Frame.timeout;
 
-  // print debug message
+  // print debug message. Trace uses start time to avoid a 2nd micros() call
   DEBUG_PRINT(2, " ");
+  LIN_TRACE_AT(LIN_Master_Base::TRACE_START, this->timeStart, Frame.id, Frame.type);
 
   // start LIN frame by sending a Sync Break
   this->_sendBreak();
@@ -332,6 +846,31 @@ LIN_Master_Base::state_t LIN_Master_Base::sendMasterRequest(LIN_Master_Base::ver
   // return state machine state
   return this->state;
 
+} // LIN_Master_Base::startFrame()
+
+
+
+/**
+  \brief      Start sending a LIN master request frame in background (if supported)
+  \details    Start sending a LIN master request frame in background (if supported). Background handling is handling by handler().
+              For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \param[in]  Version   LIN protocol version (default = v2)
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes (0..8)
+  \param[in]  Data      data bytes
+  \return     LIN state machine state
+*/
+LIN_Master_Base::state_t LIN_Master_Base::sendMasterRequest(LIN_Master_Base::version_t Version, uint8_t Id, uint8_t NumData, uint8_t Data[])
+{
+  LIN_Master_Base::descriptor_t   frame;
+
+  // print debug message
+  DEBUG_PRINT(2, " ");
+
+  // prepare and start frame
+  this->prepareFrame(frame, LIN_Master_Base::MASTER_REQUEST, Version, Id, NumData);
+  return this->startFrame(frame, Data);
+
 } // LIN_Master_Base::sendMasterRequest()
 
 
@@ -377,31 +916,14 @@ LIN_Master_Base::error_t LIN_Master_Base::sendMasterRequestBlocking(LIN_Master_B
 */
 LIN_Master_Base::state_t LIN_Master_Base::receiveSlaveResponse(LIN_Master_Base::version_t Version, uint8_t Id, uint8_t NumData)
 {
-  // construct Tx frame
-  this->type     = LIN_Master_Base::SLAVE_RESPONSE;
-  this->version  = Version;
-  this->id       = Id;
-  this->lenTx    = 3;                                               // Frame header length
-  this->bufTx[0] = 0x00;                                            // BREAK
-  this->bufTx[1] = 0x55;                                            // SYNC
-  this->bufTx[2] = this->_calculatePID();                           // PID
-  this->lenRx    = NumData + 4;                                     // receive LIN header echo + DATA[] + CHK
-
-  // init receive buffer
-  memset(this->bufRx, 0, 12);
-
-  // set break timeout (= 200% nominal) and start timeout
-  this->timeoutFrame   = ((this->lenRx + 1) * this->timePerByte) * 2;
-  this->timeStart = micros();
+  LIN_Master_Base::descriptor_t   frame;
 
   // print debug message
   DEBUG_PRINT(2, " ");
 
-  // start LIN frame by sending BREAK
-  this->_sendBreak();
-
-  // return state machine state
-  return this->state;
+  // prepare and start frame
+  this->prepareFrame(frame, LIN_Master_Base::SLAVE_RESPONSE, Version, Id, NumData);
+  return this->startFrame(frame);
 
 } // LIN_Master_Base::sendMasterRequestBlocking()
 
@@ -451,6 +973,24 @@ LIN_Master_Base::state_t LIN_Master_Base::handler(void)
   // print debug message
   DEBUG_PRINT(3, "state=%d", (int) this->state);
 
+  // remember call time for getDeadline()
+  this->timeHandler = micros();
+
+  // frame finished e.g. in Rx ISR -> check changes and notify before next frame overwrites result
+  this->_finishFrame();
+
+  // schedule table active and slot boundary reached -> start next frame
+  if ((this->scheduleTable != NULL) && ((int32_t) (this->timeHandler - this->scheduleNext) >= 0))
+    this->_startSlot();
+
+  // remember progress for optional timing statistics and trace
+  #if defined(LIN_MASTER_TIMING) || defined(LIN_MASTER_TRACE)
+    LIN_Master_Base::state_t  statePrev = this->state;
+  #endif
+  #if defined(LIN_MASTER_TIMING)
+    uint8_t                   idxPrev   = this->idxRx;
+  #endif
+
   // act according to current state
   switch (this->state)
   {
@@ -480,12 +1020,408 @@ LIN_Master_Base::state_t LIN_Master_Base::handler(void)
       this->_disableTransmitter();
 
   } // switch (this->state)
+
+  // optionally trace state transitions
+  #if defined(LIN_MASTER_TRACE)
+    if (this->state != statePrev)
+      LIN_TRACE(LIN_Master_Base::TRACE_STATE, this->state, this->error);
+  #endif
+
+  // optionally record timing of state transitions and received bytes
+  #if defined(LIN_MASTER_TIMING)
+    if ((this->state != statePrev) || (this->idxRx != idxPrev))
+      this->_recordTiming();
+  #endif
+
+  // frame finished in this call -> check changes and notify once
+  this->_finishFrame();
+
+  // no frame ongoing -> start next queued frame back-to-back. Queue is paused while a schedule table is active
+  if ((this->state & (LIN_Master_Base::STATE_IDLE | LIN_Master_Base::STATE_DONE)) && (this->queueTail != this->queueHead) && (this->scheduleTable == NULL))
+    this->_startQueued();
   
   // return state machine state
   return this->state;
 
 } // LIN_Master_Base::handler()
 
+
+
+/**
+  \brief      Get micros() of next timing deadline
+  \details    Get micros() of next timing deadline, at which handler() has to be called. Deadlines are end of BREAK,
+              end of header for slave responses via RS485 (release transmitter), end of frame, and the next slot of
+              an active schedule table. If handler() was already called after a deadline w/o progress (e.g. slave
+              response still pending), the next deadline is 1/2 byte after that call, but not after the frame timeout.
+              I.e. a main loop, timer ISR or RTOS task can sleep until the deadline instead of polling. Is used e.g. by LIN_Master_Group.
+  \param[out] Deadline  micros() of next deadline (only valid if true is returned)
+  \return     true if a deadline is pending, false if handler() needs not be called
+*/
+bool LIN_Master_Base::getDeadline(uint32_t &Deadline)
+{
+  bool      pending = true;
+
+  // deadline of ongoing frame
+  switch (this->state)
+  {
+    // end of BREAK (=1 byte at half baudrate)
+    case LIN_Master_Base::STATE_BREAK:
+      Deadline = this->timeStart + (this->timePerByte << 1);
+      break;
+
+    // slave response via RS485: end of header to release transmitter. Else end of frame
+    case LIN_Master_Base::STATE_BODY:
+      if ((this->type == LIN_Master_Base::SLAVE_RESPONSE) && (this->pinTxEN >= 0) && (this->idxRx < this->lenTx))
+        Deadline = this->timeStart + (this->lenTx + 1) * this->timePerByte;
+      else
+        Deadline = this->timeStart + (this->lenRx + 1) * this->timePerByte;
+      break;
+
+    // no frame ongoing -> immediately if callback, change check or queued frames are pending
+    case LIN_Master_Base::STATE_IDLE:
+    case LIN_Master_Base::STATE_DONE:
+      if ((this->callbackPending) || (this->changePending) || ((this->queueTail != this->queueHead) && (this->scheduleTable == NULL)))
+        Deadline = micros();
+      else
+        pending = false;
+      break;
+
+    // interface closed
+    default:
+      return false;
+
+  } // switch (this->state)
+
+  // handler() already called after frame deadline w/o progress (e.g. slave response pending) -> check again after 1/2 byte or at timeout
+  if (this->state & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY))
+  {
+    if ((int32_t) (this->timeHandler - Deadline) >= 0)
+    {
+      uint32_t  timeout = this->timeStart + this->timeoutFrame + 1;
+      Deadline = this->timeHandler + (this->timePerByte >> 1);
+      if ((int32_t) (Deadline - timeout) > 0)
+        Deadline = timeout;
+    }
+  }
+
+  // next slot of schedule table, if earlier
+  if ((this->scheduleTable != NULL) && ((!pending) || ((int32_t) (this->scheduleNext - Deadline) < 0)))
+  {
+    Deadline = this->scheduleNext;
+    pending  = true;
+  }
+
+  // print debug message
+  DEBUG_PRINT(3, "pending=%d", (int) pending);
+
+  return pending;
+
+} // LIN_Master_Base::getDeadline()
+
+
+
+/**
+  \brief      Start or switch LIN schedule table
+  \details    Start or switch LIN schedule table. If no table is active, the 1st entry is started with the next handler() call.
+              Otherwise the new table is activated at the next slot boundary, starting with its 1st entry.
+              handler() starts each frame at its slot boundary. The result of a frame is available via getState(), getError()
+              and getFrame() until the next slot boundary. Table and master request data must remain valid while the table is active.
+  \param[in]  Table       schedule table (NULL = stop schedule)
+  \param[in]  NumEntries  number of entries in table (0 = stop schedule)
+  \param[in]  Flash       table is stored in flash (PROGMEM), see setSchedule_P(). Entries are copied to RAM slot by slot
+*/
+void LIN_Master_Base::_setSchedule(const LIN_Master_Base::schedule_t Table[], uint8_t NumEntries, bool Flash)
+{
+  // empty table stops schedule
+  if ((Table == NULL) || (NumEntries == 0))
+  {
+    Table = NULL;
+    NumEntries = 0;
+  }
+
+  // for data consistency temporarily disable ISRs
+  noInterrupts();
+
+  // no schedule active -> start immediately
+  if (this->scheduleTable == NULL)
+  {
+    this->scheduleTable  = Table;
+    this->scheduleNum    = NumEntries;
+    this->scheduleFlash  = Flash;
+    this->scheduleIdx    = 0;
+    this->scheduleSwitch = false;
+    this->scheduleNext   = micros();
+  }
+
+  // schedule active -> switch at next slot boundary
+  else
+  {
+    this->scheduleNew    = Table;
+    this->scheduleNumNew = NumEntries;
+    this->scheduleFlashNew = Flash;
+    this->scheduleSwitch = true;
+  }
+
+  // re-enable ISRs
+  interrupts();
+
+} // LIN_Master_Base::_setSchedule()
+
+
+
+/**
+  \brief      Add prepared frame to request queue
+  \details    Add prepared frame to request queue. Queued frames are started by handler() in FIFO order, the next one
+              in the same call in which the previous frame is completed, i.e. w/o idle gap. Queue is a lock-free single
+              producer/single consumer ring buffer, i.e. it may be filled from one ISR or task while handler() runs in another.
+              Use attachCallback() to receive the results. Queue is paused while a schedule table is active.
+              Queue size is LIN_MASTER_QUEUE_SIZE, which is 0 (no queue) by default on AVR to save RAM.
+  \param[in]  Frame     frame prepared via prepareFrame()
+  \param[in]  Data      data bytes for master request (not used for slave response)
+  \return     true if frame was queued, false if queue is full or not used, or master request data is missing
+*/
+bool LIN_Master_Base::queueFrame(const LIN_Master_Base::descriptor_t &Frame, const uint8_t Data[])
+{
+// queue not used -> frame is never queued
+#if (LIN_MASTER_QUEUE_SIZE == 0)
+
+  (void) Frame;
+  (void) Data;
+
+  // print debug message
+  DEBUG_PRINT(2, "no queue");
+
+  return false;
+
+#else
+
+  uint8_t   head = this->queueHead;
+  uint8_t   next = (head >= LIN_MASTER_QUEUE_SIZE) ? 0 : head + 1;
+
+  // master request w/o data -> would send stale data of entry
+  if ((Frame.type == LIN_Master_Base::MASTER_REQUEST) && (Frame.lenTx > 4) && (Data == NULL))
+  {
+    // print debug message
+    DEBUG_PRINT(2, "no data");
+
+    return false;
+  }
+
+  // queue full -> return immediately
+  if (next == this->queueTail)
+  {
+    // print debug message
+    DEBUG_PRINT(2, "queue full");
+
+    return false;
+  }
+
+  // copy frame to free entry
+  this->queueBuf[head].frame = Frame;
+  if (Frame.type == LIN_Master_Base::MASTER_REQUEST)
+    memcpy(this->queueBuf[head].data, Data, Frame.lenTx-4);
+
+  // publish entry after it was written
+  LIN_MASTER_MEMORY_BARRIER();
+  this->queueHead = next;
+
+  // print debug message
+  DEBUG_PRINT(3, "ID=0x%02X", (int) Frame.id);
+
+  return true;
+
+#endif // LIN_MASTER_QUEUE_SIZE == 0
+
+} // LIN_Master_Base::queueFrame()
+
+
+
+/**
+  \brief      Subscribe to changes of a slave response or a signal in it
+  \details    Subscribe to changes of a slave response or a signal in it. handler() compares each error-free slave
+              response with this ID against the last change and calls the callback only if watched bits have changed.
+              Further signals can be watched via addSignal(). Subscriptions of a node are kept in a list, i.e. the
+              subscription must remain valid until unsubscribe(). Don't (un-)subscribe other subscriptions from a callback.
+  \param[out] Sub       subscription (is initialized)
+  \param[in]  Id        frame identifier (protected or unprotected)
+  \param[in]  Callback  change callback (NULL = counters only)
+  \param[in]  Arg       user argument passed to callback
+  \param[in]  Start     bit offset of watched signal (default = 0)
+  \param[in]  Width     width of watched signal [bit] (default = 64, i.e. complete frame)
+*/
+void LIN_Master_Base::subscribe(LIN_Master_Base::subscription_t &Sub, uint8_t Id, LIN_Master_Base::change_callback_t Callback,
+  void *Arg, uint8_t Start, uint8_t Width)
+{
+  // print debug message
+  DEBUG_PRINT(2, "ID=0x%02X", (int) Id);
+
+  // avoid duplicate list entry
+  this->unsubscribe(Sub);
+
+  // initialize subscription
+  Sub.id             = Id & 0x3F;
+  Sub.valid          = false;
+  Sub.mask.word[0]   = 0;
+  Sub.mask.word[1]   = 0;
+  Sub.last.word[0]   = 0;
+  Sub.last.word[1]   = 0;
+  Sub.changed.word[0] = 0;
+  Sub.changed.word[1] = 0;
+  Sub.numFrames      = 0;
+  Sub.numChanges     = 0;
+  Sub.callback       = Callback;
+  Sub.arg            = Arg;
+  LIN_Master_Base::addSignal(Sub, Start, Width);
+
+  // add to head of list. For data consistency temporarily disable ISRs
+  noInterrupts();
+  Sub.next = this->subscriptions;
+  this->subscriptions = &Sub;
+  interrupts();
+
+} // LIN_Master_Base::subscribe()
+
+
+
+/**
+  \brief      Remove change subscription
+  \details    Remove change subscription from list of node. Unknown subscriptions are ignored
+  \param[in]  Sub       subscription
+*/
+void LIN_Master_Base::unsubscribe(LIN_Master_Base::subscription_t &Sub)
+{
+  LIN_Master_Base::subscription_t   **link;
+
+  // print debug message
+  DEBUG_PRINT(3, " ");
+
+  // find and remove list entry. For data consistency temporarily disable ISRs
+  noInterrupts();
+  for (link = &(this->subscriptions); *link != NULL; link = &((*link)->next))
+  {
+    if (*link == &Sub)
+    {
+      *link = Sub.next;
+      break;
+    }
+  }
+  interrupts();
+
+} // LIN_Master_Base::unsubscribe()
+
+
+
+/**
+  \brief      Additionally watch a signal of a subscription
+  \details    Additionally watch a signal of a subscription, e.g. to get one callback for several signals of a frame.
+              Signals are packed little endian like specified by LIN, i.e. bit 0 is the LSB of the 1st data byte.
+  \param[in,out] Sub    subscription, see subscribe()
+  \param[in]  Start     bit offset of signal (0..63)
+  \param[in]  Width     width of signal [bit] (1..64)
+*/
+void LIN_Master_Base::addSignal(LIN_Master_Base::subscription_t &Sub, uint8_t Start, uint8_t Width)
+{
+  // print debug message
+  DEBUG_PRINT_STATIC(3, "start=%d, width=%d", (int) Start, (int) Width);
+
+  // set bits byte by byte
+  for (uint8_t bit = Start; (bit < 64) && (bit < Start + Width); bit++)
+    Sub.mask.byte[bit >> 3] |= (uint8_t) (1 << (bit & 0x07));
+
+} // LIN_Master_Base::addSignal()
+
+
+
+/**
+  \brief      Check if a signal changed with the last change of a subscription
+  \details    Check if a signal changed with the last change of a subscription, e.g. in change callback
+  \param[in]  Sub       subscription, see subscribe()
+  \param[in]  Start     bit offset of signal (0..63)
+  \param[in]  Width     width of signal [bit] (1..64)
+  \return     true if any bit of the signal has changed
+*/
+bool LIN_Master_Base::hasChanged(const LIN_Master_Base::subscription_t &Sub, uint8_t Start, uint8_t Width)
+{
+  // print debug message
+  DEBUG_PRINT_STATIC(3, "start=%d, width=%d", (int) Start, (int) Width);
+
+  // check bits byte by byte
+  for (uint8_t bit = Start; (bit < 64) && (bit < Start + Width); bit++)
+    if (Sub.changed.byte[bit >> 3] & (1 << (bit & 0x07)))
+      return true;
+
+  return false;
+
+} // LIN_Master_Base::hasChanged()
+
+
+
+#if defined(LIN_MASTER_TIMING)
+
+/**
+  \brief      Clear timing statistics
+  \details    Clear timing statistics of node and optionally per frame ID
+*/
+void LIN_Master_Base::resetTiming(void)
+{
+  // print debug message
+  DEBUG_PRINT(3, " ");
+
+  // for data consistency temporarily disable ISRs
+  noInterrupts();
+  memset(&(this->timing), 0, sizeof(this->timing));
+  #if defined(LIN_MASTER_TIMING_PER_ID)
+    memset(this->timingId, 0, sizeof(this->timingId));
+  #endif
+  interrupts();
+
+} // LIN_Master_Base::resetTiming()
+
+#endif // LIN_MASTER_TIMING
+
+
+
+#if defined(LIN_MASTER_TRACE)
+
+/**
+  \brief      Copy and remove oldest entries of binary trace
+  \details    Copy and remove oldest entries of binary trace of all nodes. If the ring buffer overflowed, the oldest
+              entries are lost. Entries can e.g. be sent via Serial.write() and decoded with extras/host/tools/LIN_trace_decode.cpp
+  \param[out] Buf       buffer for trace entries
+  \param[in]  Num       max. number of entries to copy
+  \return     number of copied entries
+*/
+uint16_t LIN_Master_Base::getTrace(LIN_Master_Base::trace_t Buf[], uint16_t Num)
+{
+  uint16_t  num = 0;
+
+  // for data consistency temporarily disable ISRs
+  noInterrupts();
+
+  // skip overwritten entries
+  uint16_t head = LIN_Master_Base::traceHead;
+  if ((uint16_t) (head - LIN_Master_Base::traceTail) > LIN_MASTER_TRACE_SIZE)
+    LIN_Master_Base::traceTail = head - LIN_MASTER_TRACE_SIZE;
+
+  // copy oldest entries
+  while ((LIN_Master_Base::traceTail != head) && (num < Num))
+  {
+    Buf[num++] = LIN_Master_Base::traceBuf[LIN_Master_Base::traceTail & (LIN_MASTER_TRACE_SIZE-1)];
+    LIN_Master_Base::traceTail++;
+  }
+
+  // re-enable ISRs
+  interrupts();
+
+  // print debug message
+  DEBUG_PRINT_STATIC(3, "num=%d", (int) num);
+
+  return num;
+
+} // LIN_Master_Base::getTrace()
+
+#endif // LIN_MASTER_TRACE
+
 /*-----------------------------------------------------------------------------
     END OF FILE
 -----------------------------------------------------------------------------*/
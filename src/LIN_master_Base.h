@@ -21,6 +21,54 @@
 // misc parameters
 #define LIN_MASTER_BUFLEN_NAME          30            //!< max. length of node name
 #define LIN_MASTER_LIN_PORT_TIMEOUT     3000          //!< optional LIN.begin() timeout [ms] (<=0 -> no timeout). Is relevant for native USB ports, if USB is not connected 
+#if !defined(LIN_MASTER_FAST_LATENCY)
+  #define LIN_MASTER_FAST_LATENCY       200           //!< max. handler/interrupt latency [us] added to frame timeout with PROFILE_FAST
+#endif
+#if !defined(LIN_MASTER_QUEUE_SIZE)
+  #if defined(ARDUINO_ARCH_AVR)
+    #define LIN_MASTER_QUEUE_SIZE       0             //!< max. number of pending frames in request queue, see queueFrame(). 0 = no queue (saves ~20B RAM per entry and node)
+  #else
+    #define LIN_MASTER_QUEUE_SIZE       4             //!< max. number of pending frames in request queue, see queueFrame(). 0 = no queue (saves ~20B RAM per entry and node)
+  #endif
+#endif
+
+// memory barrier for lock-free frame request queue. Compiler barrier is sufficient on single-core MCUs
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_HOST)
+  #define LIN_MASTER_MEMORY_BARRIER()   __sync_synchronize()
+#else
+  #define LIN_MASTER_MEMORY_BARRIER()   __asm__ __volatile__ ("" ::: "memory")
+#endif
+
+// critical section, which restores the previous interrupt state, i.e. can be used in ISRs. Guards data shared with
+// backends which handle frames in ISRs (e.g. trace and timing). Not required on platforms w/o such backends
+#if defined(__AVR__)
+  #define LIN_MASTER_CRITICAL_BEGIN()   uint8_t _linIrqState = SREG; cli()
+  #define LIN_MASTER_CRITICAL_END()     SREG = _linIrqState
+#elif defined(ARDUINO_ARCH_STM32)
+  #define LIN_MASTER_CRITICAL_BEGIN()   uint32_t _linIrqState = __get_PRIMASK(); __disable_irq()
+  #define LIN_MASTER_CRITICAL_END()     __set_PRIMASK(_linIrqState)
+#elif defined(ARDUINO_ARCH_HOST)
+  #define LIN_MASTER_CRITICAL_BEGIN()   bool _linIrqState = interruptsEnabled(); noInterrupts()
+  #define LIN_MASTER_CRITICAL_END()     if (_linIrqState) interrupts()
+#else
+  #define LIN_MASTER_CRITICAL_BEGIN()   do {} while (0)
+  #define LIN_MASTER_CRITICAL_END()     do {} while (0)
+#endif
+
+// optional timing statistics (histograms of break, header, response space and frame duration). Comment out for none
+#if !defined(LIN_MASTER_TIMING)
+  //#define LIN_MASTER_TIMING                           //!< record timing histograms per node
+  //#define LIN_MASTER_TIMING_PER_ID                    //!< additionally record frame duration histogram per frame ID (needs ~2.8kB RAM)
+#endif
+#define LIN_MASTER_TIMING_BUCKETS       16            //!< number of log2 histogram buckets. Bucket i>0 contains [2^(i-1), 2^i) us
+
+// optional binary trace of events into a static ring buffer, see getTrace(). Use instead of LIN_MASTER_DEBUG_SERIAL for timing-critical debugging
+#if !defined(LIN_MASTER_TRACE)
+  //#define LIN_MASTER_TRACE                            //!< record binary trace, decode with extras/host/tools/LIN_trace_decode.cpp
+#endif
+#if !defined(LIN_MASTER_TRACE_SIZE)
+  #define LIN_MASTER_TRACE_SIZE         64            //!< number of trace entries (power of 2). Oldest entries are overwritten
+#endif
 
 // required for CI test environment. Call arduino-cli with "-DINCLUDE_NEOHWSERIAL"
 #if defined(INCLUDE_NEOHWSERIAL)
@@ -84,6 +132,16 @@
 
 #endif // LIN_MASTER_DEBUG_SERIAL
 
+// define macro for optional binary trace. Use like: LIN_TRACE(LIN_Master_Base::TRACE_RX, idx, data);
+// LIN_TRACE_AT() uses an already sampled time stamp, which saves a micros() call
+#if defined(LIN_MASTER_TRACE)
+  #define LIN_TRACE(event, arg1, arg2)  this->_trace((event), (uint8_t) (arg1), (uint8_t) (arg2), micros())
+  #define LIN_TRACE_AT(event, time, arg1, arg2)  this->_trace((event), (uint8_t) (arg1), (uint8_t) (arg2), (time))
+#else
+  #define LIN_TRACE(event, arg1, arg2)  do {} while (0)
+  #define LIN_TRACE_AT(event, time, arg1, arg2)  do {} while (0)
+#endif
+
 
 /*-----------------------------------------------------------------------------
   INCLUDE FILES
@@ -146,13 +204,151 @@ class LIN_Master_Base
     } error_t;
 
 
+    /// break and timeout parameters, see setProfile()
+    typedef enum : uint8_t
+    {
+      PROFILE_STANDARD      = 0,                //!< frame timeout 200% nominal, SW break 16 bit with 50us delimiter
+      PROFILE_FAST          = 1                 //!< for fast/flash mode >20kBaud: timeout 140% nominal + latency (max. 200%), SW break 13 bit with 1 bit delimiter
+    } profile_t;
+
+
+    /// entry of LIN schedule table, see setSchedule()
+    typedef struct
+    {
+      LIN_Master_Base::frame_t    type;         //!< LIN frame type
+      LIN_Master_Base::version_t  version;      //!< LIN protocol version
+      uint8_t                     id;           //!< LIN frame identifier (protected or unprotected)
+      uint8_t                     numData;      //!< number of data bytes (0..8)
+      uint8_t                     *data;        //!< master request data (not used for slave response)
+      uint32_t                    slot;         //!< slot duration [us], i.e. time until start of next frame
+    } schedule_t;
+
+
+    /// prepared LIN frame with precomputed PID, checksum seed, lengths and timeout, see prepareFrame()
+    typedef struct
+    {
+      LIN_Master_Base::frame_t    type;         //!< LIN frame type
+      LIN_Master_Base::version_t  version;      //!< LIN protocol version
+      uint8_t                     id;           //!< LIN frame identifier (as passed to prepareFrame())
+      uint8_t                     pid;          //!< protected frame identifier
+      uint8_t                     chkSeed;      //!< checksum seed (PID for enhanced, 0 for classic checksum)
+      uint8_t                     lenTx;        //!< send buffer length incl. BREAK, SYNC, PID (and DATA, CHK for request)
+      uint8_t                     lenRx;        //!< receive buffer length incl. BREAK, SYNC, PID, DATA, CHK
+      uint32_t                    timeout;      //!< max. frame duration [us]
+    } descriptor_t;
+
+
+    /// pending frame in request queue, see queueFrame()
+    typedef struct
+    {
+      LIN_Master_Base::descriptor_t frame;      //!< prepared frame
+      uint8_t                     data[8];      //!< master request data (not used for slave response)
+    } request_t;
+
+
+    /// result of a completed LIN frame, passed to completion callback. Data is only valid during callback
+    typedef struct
+    {
+      LIN_Master_Base::frame_t    type;         //!< LIN frame type
+      LIN_Master_Base::version_t  version;      //!< LIN protocol version
+      uint8_t                     id;           //!< LIN frame identifier (as passed when starting the frame)
+      uint8_t                     numData;      //!< number of data bytes (0..8)
+      const uint8_t               *data;        //!< sent or received data bytes
+      LIN_Master_Base::error_t    error;        //!< LIN error of this frame
+      uint32_t                    timeStart;    //!< micros() when frame was started
+      uint32_t                    duration;     //!< time [us] from frame start until completion was detected by handler()
+    } result_t;
+
+
+    /// timing histogram with log2 buckets [us], see getTiming()
+    typedef struct
+    {
+      uint16_t                    num;          //!< number of samples (saturated)
+      uint32_t                    min;          //!< min. sample [us]
+      uint32_t                    max;          //!< max. sample [us]
+      uint16_t                    bucket[LIN_MASTER_TIMING_BUCKETS];  //!< sample count per bucket (saturated)
+    } histogram_t;
+
+
+    /// timing statistics of a LIN node, see getTiming()
+    typedef struct
+    {
+      LIN_Master_Base::histogram_t  breakDuration;  //!< start of frame until end of BREAK
+      LIN_Master_Base::histogram_t  header;         //!< start of frame until header echo (BREAK+SYNC+PID) received
+      LIN_Master_Base::histogram_t  responseSpace;  //!< header echo until 1st slave response byte received
+      LIN_Master_Base::histogram_t  frame;          //!< start of frame until STATE_DONE w/o error
+      uint16_t                      numErr;         //!< number of erroneous frames (saturated)
+    } timing_t;
+
+
+    /// event of binary trace, see getTrace(). Keep in sync with extras/host/tools/LIN_trace_decode.cpp
+    typedef enum : uint8_t
+    {
+      TRACE_START           = 0x01,             //!< frame started (arg1=ID, arg2=type)
+      TRACE_STATE           = 0x02,             //!< state changed in handler() (arg1=state, arg2=error)
+      TRACE_RX              = 0x03,             //!< byte received (arg1=index, arg2=data)
+      TRACE_ERR_ECHO        = 0x04,             //!< echo error (arg1=index, arg2=data)
+      TRACE_ERR_CHK         = 0x05,             //!< checksum error (arg1=expected, arg2=received)
+      TRACE_SLOT            = 0x06,             //!< schedule slot started (arg1=index, arg2=ID)
+      TRACE_QUEUE           = 0x07,             //!< queued frame started (arg1=ID, arg2=remaining frames)
+      TRACE_CALLBACK        = 0x08,             //!< completion callback called (arg1=ID, arg2=error)
+      TRACE_CHANGE          = 0x09              //!< watched bits of slave response changed (arg1=ID, arg2=changed bytes bitmask)
+    } trace_event_t;
+
+
+    /// entry of binary trace (8 bytes, little endian on all supported boards), see getTrace()
+    typedef struct
+    {
+      uint32_t                    time;         //!< micros() of event
+      uint8_t                     event;        //!< event, see trace_event_t
+      uint8_t                     node;         //!< LIN node index in order of construction
+      uint8_t                     arg1;         //!< 1st event argument
+      uint8_t                     arg2;         //!< 2nd event argument
+    } trace_t;
+
+
+    /// completion callback, called once per frame from handler() when STATE_DONE is reached, see attachCallback()
+    typedef void (*callback_t)(LIN_Master_Base &LIN, const LIN_Master_Base::result_t &Result, void *Arg);
+
+
+    /// frame data for word-wise comparison. Byte order within words is not relevant for XOR and AND
+    typedef union
+    {
+      uint8_t                     byte[8];      //!< data bytes
+      uint32_t                    word[2];      //!< data words
+    } payload_t;
+
+
+    /// subscription to changes of a slave response or of signals in it, see subscribe()
+    struct subscription_s;
+
+    /// change callback, called from handler() only if watched bits of a slave response changed, see subscribe()
+    typedef void (*change_callback_t)(LIN_Master_Base &LIN, const struct LIN_Master_Base::subscription_s &Sub, void *Arg);
+
+    /// subscription to changes of a slave response or of signals in it, see subscribe(). Bit 0 is the LSB of the 1st data byte
+    typedef struct subscription_s
+    {
+      uint8_t                     id;           //!< LIN frame identifier (unprotected)
+      bool                        valid;        //!< last is valid. 1st error-free response always counts as change
+      LIN_Master_Base::payload_t  mask;         //!< watched bits, see addSignal()
+      LIN_Master_Base::payload_t  last;         //!< data of last response with changed watched bits (unused bytes are 0)
+      LIN_Master_Base::payload_t  changed;      //!< watched bits changed by last change, see hasChanged()
+      uint16_t                    numFrames;    //!< number of error-free responses (saturated)
+      uint16_t                    numChanges;   //!< number of changes of watched bits (saturated)
+      LIN_Master_Base::change_callback_t  callback; //!< optional change callback (NULL = counters only)
+      void                        *arg;         //!< user argument passed to change callback
+      struct subscription_s       *next;        //!< next subscription of node (internal)
+    } subscription_t;
+
+
   // PROTECTED VARIABLES
   protected:
 
     // node properties
     int8_t                  pinTxEN;            //!< optional Tx direction pin, e.g. for LIN via RS485 
-    uint16_t                baudrate;           //!< communication baudrate [Baud]
-    LIN_Master_Base::state_t  state;            //!< status of LIN state machine
+    uint32_t                baudrate;           //!< communication baudrate [Baud]
+    LIN_Master_Base::profile_t  profile;        //!< break and timeout parameters
+    volatile LIN_Master_Base::state_t  state;   //!< status of LIN state machine. Volatile, as it may be changed by Rx ISR or DMA callback
     LIN_Master_Base::error_t  error;            //!< error state. Is latched until cleared
     uint32_t                timePerByte;        //!< time [us] per byte at specified baudrate
     uint32_t                timeoutFrame;       //!< max. frame duration [us]
@@ -161,11 +357,61 @@ class LIN_Master_Base
     LIN_Master_Base::version_t  version;        //!< LIN protocol version
     LIN_Master_Base::frame_t    type;           //!< LIN frame type
     uint8_t                 id;                 //!< LIN frame identifier (protected or unprotected)
+    uint8_t                 chkSeed;            //!< checksum seed (PID for enhanced, 0 for classic checksum)
     uint8_t                 lenTx;              //!< send buffer length (max. 12)
     uint8_t                 bufTx[12];          //!< send buffer incl. BREAK, SYNC, DATA and CHK (max. 12B)
     uint8_t                 lenRx;              //!< receive buffer length (max. 12)
     uint8_t                 bufRx[12];          //!< receive buffer incl. BREAK, SYNC, DATA and CHK (max. 12B)
     uint32_t                timeStart;          //!< starting time [us] for frame timeout
+    uint32_t                timeHandler;        //!< time [us] of last handler() call, for re-check of overdue frames
+    uint8_t                 idxRx;              //!< index of next received byte in bufRx
+    uint16_t                chkRx;              //!< checksum accumulator of received bytes
+
+    // schedule table
+    const LIN_Master_Base::schedule_t *scheduleTable;   //!< active schedule table (NULL = none)
+    const LIN_Master_Base::schedule_t *scheduleNew;     //!< schedule table to activate at next slot boundary
+    uint8_t                 scheduleNum;        //!< number of entries in active schedule table
+    uint8_t                 scheduleNumNew;     //!< number of entries in new schedule table
+    uint8_t                 scheduleIdx;        //!< index of next schedule entry
+    bool                    scheduleSwitch;     //!< switch schedule table at next slot boundary
+    bool                    scheduleFlash;      //!< active schedule table is stored in flash (PROGMEM), see setSchedule_P()
+    bool                    scheduleFlashNew;   //!< new schedule table is stored in flash (PROGMEM)
+    uint32_t                scheduleNext;       //!< micros() of next slot boundary
+
+    // completion callback
+    LIN_Master_Base::callback_t callback;       //!< optional completion callback (NULL = none)
+    void                    *callbackArg;       //!< user argument passed to completion callback
+    bool                    callbackPending;    //!< frame started, callback not yet called
+
+    // change subscriptions
+    LIN_Master_Base::subscription_t *subscriptions;   //!< list of change subscriptions (NULL = none)
+    bool                    changePending;      //!< slave response started, changes not yet checked
+
+    // frame request queue (single producer, single consumer)
+    #if (LIN_MASTER_QUEUE_SIZE > 0)
+      LIN_Master_Base::request_t  queueBuf[LIN_MASTER_QUEUE_SIZE+1];  //!< ring buffer of pending frames (1 entry always unused)
+    #endif
+    volatile uint8_t        queueHead;          //!< index of next free entry. Only written by producer, see queueFrame()
+    volatile uint8_t        queueTail;          //!< index of oldest pending entry. Only written by consumer, see handler()
+
+    // optional binary trace. Buffer is shared by all nodes
+    #if defined(LIN_MASTER_TRACE)
+      static LIN_Master_Base::trace_t traceBuf[LIN_MASTER_TRACE_SIZE];  //!< trace ring buffer
+      static volatile uint16_t  traceHead;      //!< number of written entries (wraps)
+      static uint16_t       traceTail;          //!< number of read entries (wraps)
+      static uint8_t        traceNum;           //!< number of LIN nodes, used for node index
+      uint8_t               traceNode;          //!< node index in trace
+    #endif
+
+    // optional timing statistics
+    #if defined(LIN_MASTER_TIMING)
+      uint8_t               timingFlags;        //!< timing samples already recorded for current frame
+      uint32_t              timeHeader;         //!< micros() when header echo was received
+      LIN_Master_Base::timing_t  timing;        //!< timing statistics of node
+      #if defined(LIN_MASTER_TIMING_PER_ID)
+        LIN_Master_Base::histogram_t  timingId[64];   //!< frame duration statistics per frame ID
+      #endif
+    #endif
 
 
   // PUBLIC VARIABLES
@@ -178,14 +424,84 @@ class LIN_Master_Base
   protected:
   
     /// @brief Calculate protected frame ID
-    uint8_t _calculatePID(void);
+    uint8_t _calculatePID(uint8_t Id);
+
+    /// @brief Max. frame duration [us] depending on profile. Overflow-free up to 1 Baud
+    inline uint32_t _frameTimeout(uint8_t LenRx)
+    {
+      uint32_t  nominal  = (uint32_t) (LenRx + 1) * this->timePerByte;
+      uint32_t  standard = nominal << 1;
+
+      // fast profile: LIN tolerance 140% plus fixed latency, but never longer than standard profile, as latency
+      // exceeds the 60% margin at high baudrates (e.g. 12 bytes @ 500kBaud: 240us)
+      if (this->profile == LIN_Master_Base::PROFILE_FAST)
+      {
+        uint32_t fast = nominal + ((nominal * 2) / 5) + LIN_MASTER_FAST_LATENCY;
+        return (fast < standard) ? fast : standard;
+      }
+
+      // standard profile: 200% nominal
+      return standard;
+
+    } // _frameTimeout()
 
     /// @brief Calculate LIN frame checksum
-    uint8_t _calculateChecksum(uint8_t NumData, uint8_t Data[]);
+    uint8_t _calculateChecksum(uint8_t NumData, const uint8_t Data[]);
 
     /// @brief Check received LIN frame
     LIN_Master_Base::error_t _checkFrame(void);
 
+    /// @brief Store and check a single received byte, finish frame after last byte
+    LIN_Master_Base::state_t _receiveByte(uint8_t Data);
+
+    /// @brief Start next frame of schedule table
+    void _startSlot(void);
+
+    /// @brief Start or switch LIN schedule table in RAM or flash
+    void _setSchedule(const LIN_Master_Base::schedule_t Table[], uint8_t NumEntries, bool Flash);
+
+    /// @brief Call completion callback for finished frame
+    void _notify(void);
+
+    /// @brief Compare finished slave response with subscriptions and call change callbacks
+    void _checkChanges(void);
+
+    /// @brief Check changes and call completion callback once for finished frame
+    void _finishFrame(void);
+
+    /// @brief Start oldest frame of request queue
+    void _startQueued(void);
+
+    #if defined(LIN_MASTER_TRACE)
+
+      /// @brief Add entry to binary trace. Is locked, as entries are also added from Rx ISRs or DMA callbacks of some backends
+      inline void _trace(LIN_Master_Base::trace_event_t Event, uint8_t Arg1, uint8_t Arg2, uint32_t Time)
+      {
+        LIN_MASTER_CRITICAL_BEGIN();
+        LIN_Master_Base::trace_t *entry = &(LIN_Master_Base::traceBuf[LIN_Master_Base::traceHead & (LIN_MASTER_TRACE_SIZE-1)]);
+
+        entry->time  = Time;
+        entry->event = (uint8_t) Event;
+        entry->node  = this->traceNode;
+        entry->arg1  = Arg1;
+        entry->arg2  = Arg2;
+        LIN_Master_Base::traceHead++;
+        LIN_MASTER_CRITICAL_END();
+
+      } // _trace()
+
+    #endif // LIN_MASTER_TRACE
+
+    #if defined(LIN_MASTER_TIMING)
+
+      /// @brief Add sample to timing histogram
+      void _addSample(LIN_Master_Base::histogram_t &Histogram, uint32_t Value);
+
+      /// @brief Record timing of state transitions of current frame
+      void _recordTiming(void);
+
+    #endif // LIN_MASTER_TIMING
+
     
     /// @brief Send LIN break
     virtual LIN_Master_Base::state_t _sendBreak(void);
@@ -233,11 +549,19 @@ class LIN_Master_Base
 
 
     /// @brief Open serial interface
-    virtual void begin(uint16_t Baudrate = 19200);
+    virtual void begin(uint32_t Baudrate = 19200);
     
     /// @brief Close serial interface
     virtual void end(void);
     
+    /// @brief Set break and timeout parameters (call before begin() and prepareFrame())
+    inline void setProfile(LIN_Master_Base::profile_t Profile) { this->profile = Profile; }
+
+    /// @brief Getter for break and timeout parameters
+    inline LIN_Master_Base::profile_t getProfile(void) { return this->profile; }
+
+    /// @brief Getter for communication baudrate [Baud]
+    inline uint32_t getBaudrate(void) { return this->baudrate; }
     
     /// @brief Reset LIN state machine
     inline void resetStateMachine(void)
@@ -301,6 +625,13 @@ class LIN_Master_Base
     } // getFrame()
 
     
+    /// @brief Precompute PID, checksum seed, lengths and timeout of a LIN frame (call after begin())
+    void prepareFrame(LIN_Master_Base::descriptor_t &Frame, LIN_Master_Base::frame_t Type, 
+      LIN_Master_Base::version_t Version = LIN_Master_Base::LIN_V2, uint8_t Id = 0x00, uint8_t NumData = 0);
+
+    /// @brief Start a prepared LIN frame in background (if supported)
+    LIN_Master_Base::state_t startFrame(const LIN_Master_Base::descriptor_t &Frame, const uint8_t Data[] = NULL);
+
     /// @brief Start sending a LIN master request frame in background (if supported)
     LIN_Master_Base::state_t sendMasterRequest(LIN_Master_Base::version_t Version = LIN_Master_Base::LIN_V2, 
       uint8_t Id = 0x00, uint8_t NumData = 0, uint8_t Data[] = NULL);
@@ -320,6 +651,153 @@ class LIN_Master_Base
     /// @brief Handle LIN background operation (call until STATE_DONE is returned)
     LIN_Master_Base::state_t handler(void);
 
+    /// @brief Get micros() of next timing deadline, at which handler() has to be called
+    bool getDeadline(uint32_t &Deadline);
+
+    /// @brief Handle LIN background operation and get micros() of next deadline (false = no deadline pending)
+    inline bool handler(uint32_t &Deadline)
+    {
+      this->handler();
+      return this->getDeadline(Deadline);
+
+    } // handler()
+
+    /// @brief Check if next timing deadline has been reached, i.e. handler() has to be called
+    inline bool isDue(uint32_t Now)
+    {
+      uint32_t  deadline;
+
+      // no deadline pending or not yet reached
+      if ((!this->getDeadline(deadline)) || ((int32_t) (Now - deadline) < 0))
+        return false;
+
+      // deadline reached
+      return true;
+
+    } // isDue()
+
+
+    /// @brief Start or switch LIN schedule table. Is executed by handler()
+    inline void setSchedule(const LIN_Master_Base::schedule_t Table[], uint8_t NumEntries)
+    {
+      // print debug message
+      DEBUG_PRINT(2, "num=%d", (int) NumEntries);
+
+      // table in RAM
+      this->_setSchedule(Table, NumEntries, false);
+
+    } // setSchedule()
+
+    /// @brief Start or switch LIN schedule table stored in flash (PROGMEM), e.g. generated from an LDF. Is executed by handler()
+    inline void setSchedule_P(const LIN_Master_Base::schedule_t Table[], uint8_t NumEntries)
+    {
+      // print debug message
+      DEBUG_PRINT(2, "num=%d", (int) NumEntries);
+
+      // table in flash. Only differs from RAM on AVR (Harvard architecture)
+      this->_setSchedule(Table, NumEntries, true);
+
+    } // setSchedule_P()
+
+    /// @brief Stop LIN schedule table at next slot boundary
+    inline void stopSchedule(void)
+    {
+      // print debug message
+      DEBUG_PRINT(3, " ");
+
+      // switch to empty table
+      this->setSchedule(NULL, 0);
+
+    } // stopSchedule()
+
+
+    /// @brief Attach completion callback, which is called once per frame by handler() (NULL = detach)
+    inline void attachCallback(LIN_Master_Base::callback_t Callback, void *Arg = NULL)
+    {
+      // print debug message
+      DEBUG_PRINT(3, " ");
+
+      // for data consistency temporarily disable ISRs
+      noInterrupts();
+      this->callback        = Callback;
+      this->callbackArg     = Arg;
+      this->callbackPending = false;
+      interrupts();
+
+    } // attachCallback()
+
+
+    /// @brief Subscribe to changes of a slave response or a signal in it. Subscription must remain valid until unsubscribe()
+    void subscribe(LIN_Master_Base::subscription_t &Sub, uint8_t Id, LIN_Master_Base::change_callback_t Callback = NULL,
+      void *Arg = NULL, uint8_t Start = 0, uint8_t Width = 64);
+
+    /// @brief Remove change subscription
+    void unsubscribe(LIN_Master_Base::subscription_t &Sub);
+
+    /// @brief Additionally watch a signal of a subscription
+    static void addSignal(LIN_Master_Base::subscription_t &Sub, uint8_t Start, uint8_t Width);
+
+    /// @brief Check if a signal changed with the last change of a subscription, e.g. in change callback
+    static bool hasChanged(const LIN_Master_Base::subscription_t &Sub, uint8_t Start, uint8_t Width);
+
+
+    /// @brief Add prepared frame to request queue. Is started by handler(). Safe to call from ISR or other task
+    bool queueFrame(const LIN_Master_Base::descriptor_t &Frame, const uint8_t Data[] = NULL);
+
+    /// @brief Number of pending frames in request queue
+    inline uint8_t queueCount(void)
+    {
+      // print debug message
+      DEBUG_PRINT(3, " ");
+
+      // number of used entries in ring buffer
+      int16_t num = (int16_t) this->queueHead - (int16_t) this->queueTail;
+      return (uint8_t) ((num < 0) ? num + LIN_MASTER_QUEUE_SIZE + 1 : num);
+
+    } // queueCount()
+
+
+    #if defined(LIN_MASTER_TRACE)
+
+      /// @brief Copy and remove oldest entries of binary trace (all nodes)
+      static uint16_t getTrace(LIN_Master_Base::trace_t Buf[], uint16_t Num);
+
+    #endif // LIN_MASTER_TRACE
+
+
+    #if defined(LIN_MASTER_TIMING)
+
+      /// @brief Getter for timing statistics of node
+      inline const LIN_Master_Base::timing_t &getTiming(void)
+      {
+        // print debug message
+        DEBUG_PRINT(3, " ");
+
+        // return statistics
+        return this->timing;
+
+      } // getTiming()
+
+      #if defined(LIN_MASTER_TIMING_PER_ID)
+
+        /// @brief Getter for frame duration statistics of a frame ID
+        inline const LIN_Master_Base::histogram_t &getTiming(uint8_t Id)
+        {
+          // print debug message
+          DEBUG_PRINT(3, "ID=0x%02X", (int) Id);
+
+          // return statistics of unprotected ID
+          return this->timingId[Id & 0x3F];
+
+        } // getTiming()
+
+      #endif // LIN_MASTER_TIMING_PER_ID
+
+      /// @brief Clear timing statistics
+      void resetTiming(void);
+
+    #endif // LIN_MASTER_TIMING
+
 }; // class LIN_Master_Base
 
 /*-----------------------------------------------------------------------------
@@ -0,0 +1,384 @@
+/**
+  \file     LIN_master_Flash.cpp
+  \brief    Bulk download of a firmware image via LIN diagnostics
+  \details  This library provides a non-blocking download pipeline on top of LIN_Master_Transport, which streams an
+            image from a buffer or via a source callback (e.g. file) to a slave.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_master_Flash.h>
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Finish download with error
+  \details    Finish download with error and stop an ongoing transfer of the transport layer
+  \param[in]  Error     download error
+*/
+void LIN_Master_Flash::_finish(LIN_Master_Flash::error_t Error)
+{
+  // print debug message
+  DEBUG_PRINT_STATIC(1, "error 0x%02X at offset %ld", (int) Error, (long) this->offset);
+
+  // stop transfer
+  if (this->pTP->getState() & (LIN_Master_Transport::TP_TX | LIN_Master_Transport::TP_RX))
+    this->pTP->abort();
+
+  // latch error
+  this->error    = (LIN_Master_Flash::error_t) ((int) this->error | (int) Error);
+  this->duration = micros() - this->timeStart;
+  this->state    = LIN_Master_Flash::FLASH_DONE;
+
+} // LIN_Master_Flash::_finish()
+
+
+
+/**
+  \brief      Read block from source into buffer
+  \details    Read block from source into buffer and prepend TransferData SID and block sequence counter
+  \param[in]  Offset    image offset of block
+  \param[in]  Seq       block sequence counter
+  \return     true on success, false if source returned less data
+*/
+bool LIN_Master_Flash::_load(uint32_t Offset, uint8_t Seq)
+{
+  uint16_t  num = this->lenBlock;
+
+  // last block may be shorter
+  if (this->size - Offset < num)
+    num = (uint16_t) (this->size - Offset);
+
+  // TransferData with block sequence counter
+  this->buf[0] = 0x36;
+  this->buf[1] = Seq;
+  if (this->source(Offset, this->buf+2, num, this->sourceArg) != num)
+  {
+    this->_finish(LIN_Master_Flash::FLASH_ERROR_SOURCE);
+    return false;
+  }
+  this->lenNext = num;
+
+  return true;
+
+} // LIN_Master_Flash::_load()
+
+
+
+/**
+  \brief      Evaluate completed service and start next one
+  \details    Evaluate response of completed service and start next one, i.e. RequestDownload -> TransferData (n times)
+              -> RequestTransferExit
+*/
+void LIN_Master_Flash::_evaluate(void)
+{
+  uint16_t  len = this->pTP->getLength();
+  uint32_t  max;
+  uint8_t   n;
+
+  // transport layer error
+  if (this->pTP->getError() != LIN_Master_Transport::TP_NO_ERROR)
+  {
+    this->_finish(LIN_Master_Flash::FLASH_ERROR_TRANSPORT);
+    return;
+  }
+
+  // negative response
+  if ((len >= 3) && (this->resp[0] == 0x7F))
+  {
+    this->nrc = this->resp[2];
+    this->_finish(LIN_Master_Flash::FLASH_ERROR_NEGATIVE);
+    return;
+  }
+
+  // act according to service
+  switch (this->state)
+  {
+    // RequestDownload: get max. block length and send 1st block
+    case LIN_Master_Flash::FLASH_REQUEST:
+      n = (len >= 2) ? (this->resp[1] >> 4) : 0;
+      if ((this->resp[0] != 0x74) || (n == 0) || (n > 4) || (len < 2 + n))
+      {
+        this->_finish(LIN_Master_Flash::FLASH_ERROR_RESPONSE);
+        return;
+      }
+      max = 0;
+      for (uint8_t i = 0; i < n; i++)
+        max = (max << 8) | this->resp[2+i];
+      if (max > this->sizeBuf)
+        max = this->sizeBuf;
+      if (max > LIN_MASTER_TP_MAX_LEN)
+        max = LIN_MASTER_TP_MAX_LEN;
+      if (max < 3)
+      {
+        this->_finish(LIN_Master_Flash::FLASH_ERROR_BUFFER);
+        return;
+      }
+      this->lenBlock = (uint16_t) (max - 2);
+
+      // print debug message
+      DEBUG_PRINT_STATIC(2, "block length %d", (int) this->lenBlock);
+
+      this->seq = 1;
+      if (!this->_load(0, this->seq))
+        return;
+      this->state = LIN_Master_Flash::FLASH_TRANSFER;
+      break;
+
+    // TransferData: block acknowledged -> send next block or finish
+    case LIN_Master_Flash::FLASH_TRANSFER:
+      if ((len < 2) || (this->resp[0] != 0x76) || (this->resp[1] != this->seq))
+      {
+        this->_finish(LIN_Master_Flash::FLASH_ERROR_RESPONSE);
+        return;
+      }
+      this->offset += this->lenCurr;
+      this->seq++;
+      if (this->offset >= this->size)
+      {
+        this->req[0] = 0x37;
+        this->state  = LIN_Master_Flash::FLASH_EXIT;
+        this->pTP->request(this->nad, this->req, 1, this->resp, sizeof(this->resp));
+        return;
+      }
+      if ((this->lenNext == 0) && (!this->_load(this->offset, this->seq)))
+        return;
+      break;
+
+    // RequestTransferExit: download completed
+    case LIN_Master_Flash::FLASH_EXIT:
+      if (this->resp[0] != 0x77)
+      {
+        this->_finish(LIN_Master_Flash::FLASH_ERROR_RESPONSE);
+        return;
+      }
+      this->duration = micros() - this->timeStart;
+      this->state    = LIN_Master_Flash::FLASH_DONE;
+
+      // print debug message
+      DEBUG_PRINT_STATIC(2, "done after %ldus", (long) this->duration);
+
+      return;
+
+    // no service ongoing
+    default:
+      return;
+
+  } // switch (state)
+
+  // send next block
+  this->lenCurr = this->lenNext;
+  this->lenNext = 0;
+  this->pTP->request(this->nad, this->buf, this->lenCurr + 2, this->resp, sizeof(this->resp));
+
+} // LIN_Master_Flash::_evaluate()
+
+
+
+/**
+  \brief      Copy image data from RAM buffer
+  \details    Copy image data from RAM buffer, see begin()
+  \param[in]  Offset    image offset
+  \param[out] Data      destination
+  \param[in]  Length    number of bytes
+  \param[in]  Arg       start of image
+  \return     number of copied bytes
+*/
+uint16_t LIN_Master_Flash::_sourceBuffer(uint32_t Offset, uint8_t Data[], uint16_t Length, void *Arg)
+{
+  memcpy(Data, ((const uint8_t*) Arg) + Offset, Length);
+  return Length;
+
+} // LIN_Master_Flash::_sourceBuffer()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for download pipeline
+  \details    Constructor for download pipeline
+  \param[in]  TP        transport layer used for download. Must remain valid as long as pipeline is used
+*/
+LIN_Master_Flash::LIN_Master_Flash(LIN_Master_Transport &TP)
+{
+  // Debug serial initialized in begin() of node -> no debug output here
+
+  // no download
+  this->pTP       = &TP;
+  this->state     = LIN_Master_Flash::FLASH_IDLE;
+  this->error     = LIN_Master_Flash::FLASH_NO_ERROR;
+  this->nrc       = 0;
+  this->source    = NULL;
+  this->sourceArg = NULL;
+  this->size      = 0;
+  this->offset    = 0;
+  this->buf       = NULL;
+  this->sizeBuf   = 0;
+  this->lenBlock  = 0;
+  this->lenCurr   = 0;
+  this->lenNext   = 0;
+  this->duration  = 0;
+
+} // LIN_Master_Flash::LIN_Master_Flash()
+
+
+
+/**
+  \brief      Start download from source callback
+  \details    Start download from source callback, i.e. send RequestDownload. Download is handled by handler().
+              Source and buffer must remain valid until FLASH_DONE. Call after begin() of LIN node
+  \param[in]  NAD         node address of slave
+  \param[in]  Address     target address of image
+  \param[in]  Size        image size
+  \param[in]  Source      source of image data, is called once per block
+  \param[in]  Arg         optional argument of source
+  \param[in]  Buffer      block buffer. Max. block length is SizeBuffer-2
+  \param[in]  SizeBuffer  size of block buffer (3..4095). Large blocks minimize the number of slave responses
+  \return     true if download was started, false if a download is ongoing or on invalid parameters
+*/
+bool LIN_Master_Flash::begin(uint8_t NAD, uint32_t Address, uint32_t Size, source_t Source, void *Arg, uint8_t Buffer[], uint16_t SizeBuffer)
+{
+  // download ongoing -> return immediately
+  if (this->state & (LIN_Master_Flash::FLASH_REQUEST | LIN_Master_Flash::FLASH_TRANSFER | LIN_Master_Flash::FLASH_EXIT))
+  {
+    // print debug message
+    DEBUG_PRINT_STATIC(1, "download ongoing");
+
+    return false;
+  }
+
+  // store parameters
+  this->nad       = NAD;
+  this->address   = Address;
+  this->size      = Size;
+  this->source    = Source;
+  this->sourceArg = Arg;
+  this->buf       = Buffer;
+  this->sizeBuf   = SizeBuffer;
+  this->offset    = 0;
+  this->lenBlock  = 0;
+  this->lenCurr   = 0;
+  this->lenNext   = 0;
+  this->nrc       = 0;
+  this->error     = LIN_Master_Flash::FLASH_NO_ERROR;
+  this->timeStart = micros();
+
+  // check parameters
+  if ((Size == 0) || (Source == NULL) || (Buffer == NULL) || (SizeBuffer < 3))
+  {
+    this->_finish(LIN_Master_Flash::FLASH_ERROR_BUFFER);
+    return false;
+  }
+
+  // print debug message
+  DEBUG_PRINT_STATIC(2, "NAD=0x%02X, address=0x%08lX, size=%ld", (int) NAD, (long) Address, (long) Size);
+
+  // RequestDownload w/o compression and encryption, 4 byte address and size
+  this->req[0]  = 0x34;
+  this->req[1]  = 0x00;
+  this->req[2]  = 0x44;
+  this->req[3]  = (uint8_t) (Address >> 24);
+  this->req[4]  = (uint8_t) (Address >> 16);
+  this->req[5]  = (uint8_t) (Address >> 8);
+  this->req[6]  = (uint8_t) Address;
+  this->req[7]  = (uint8_t) (Size >> 24);
+  this->req[8]  = (uint8_t) (Size >> 16);
+  this->req[9]  = (uint8_t) (Size >> 8);
+  this->req[10] = (uint8_t) Size;
+  this->state   = LIN_Master_Flash::FLASH_REQUEST;
+  if (!this->pTP->request(this->nad, this->req, sizeof(this->req), this->resp, sizeof(this->resp)))
+  {
+    this->_finish(LIN_Master_Flash::FLASH_ERROR_TRANSPORT);
+    return false;
+  }
+
+  return true;
+
+} // LIN_Master_Flash::begin()
+
+
+
+/**
+  \brief      Abort ongoing download
+  \details    Abort ongoing download. An ongoing LIN frame must be completed via LIN_Master_Base::handler()
+*/
+void LIN_Master_Flash::abort(void)
+{
+  // print debug message
+  DEBUG_PRINT_STATIC(2, " ");
+
+  // stop transfer
+  this->pTP->abort();
+  this->state = LIN_Master_Flash::FLASH_IDLE;
+
+} // LIN_Master_Flash::abort()
+
+
+
+/**
+  \brief      Handle download in background
+  \details    Handle download in background (call until FLASH_DONE is returned). Services the transport layer and
+              starts the next service when the previous one is completed. While the slave processes a block,
+              the next block is read from the source.
+  \return     state of download
+*/
+LIN_Master_Flash::state_t LIN_Master_Flash::handler(void)
+{
+  LIN_Master_Transport::state_t   stateTP;
+
+  // no download ongoing -> nothing to do
+  if (!(this->state & (LIN_Master_Flash::FLASH_REQUEST | LIN_Master_Flash::FLASH_TRANSFER | LIN_Master_Flash::FLASH_EXIT)))
+    return this->state;
+
+  // service transport layer
+  stateTP = this->pTP->handler();
+
+  // block is sent -> prefetch next block while waiting for response
+  if (stateTP == LIN_Master_Transport::TP_RX)
+  {
+    if ((this->state == LIN_Master_Flash::FLASH_TRANSFER) && (this->lenNext == 0) && (this->offset + this->lenCurr < this->size))
+      this->_load(this->offset + this->lenCurr, this->seq + 1);
+    return this->state;
+  }
+
+  // service completed -> evaluate and start next
+  if (stateTP == LIN_Master_Transport::TP_DONE)
+    this->_evaluate();
+
+  // return state
+  return this->state;
+
+} // LIN_Master_Flash::handler()
+
+
+
+/**
+  \brief      Effective download rate
+  \details    Effective download rate of image data incl. all protocol overhead. While download is ongoing,
+              rate of acknowledged data until now
+  \return     download rate [bytes/s]
+*/
+uint32_t LIN_Master_Flash::getRate(void)
+{
+  uint32_t  duration = this->duration;
+
+  // download ongoing -> current duration
+  if (this->state & (LIN_Master_Flash::FLASH_REQUEST | LIN_Master_Flash::FLASH_TRANSFER | LIN_Master_Flash::FLASH_EXIT))
+    duration = micros() - this->timeStart;
+  if (duration == 0)
+    return 0;
+
+  return (uint32_t) (((uint64_t) this->offset * 1000000) / duration);
+
+} // LIN_Master_Flash::getRate()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
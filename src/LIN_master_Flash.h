@@ -0,0 +1,169 @@
+/**
+  \file     LIN_master_Flash.h
+  \brief    Bulk download of a firmware image via LIN diagnostics
+  \details  This library provides a non-blocking download pipeline on top of LIN_Master_Transport, which streams an
+            image from a buffer or via a source callback (e.g. file) to a slave. Services are like UDS, i.e.
+            RequestDownload (0x34), TransferData (0x36) with block sequence counter and RequestTransferExit (0x37).
+            Each block is sent as back-to-back master requests, and the slave is only polled for the positive response
+            per block as required by its flow control. The next block is read from the source while the slave
+            processes the current block. Block length is the min. of the buffer size and the length announced by the slave.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_FLASH_H_
+#define _LIN_MASTER_FLASH_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <LIN_master_Transport.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Bulk download of a firmware image via LIN diagnostics
+
+  \details Bulk download of a firmware image via LIN diagnostics. handler() services the transport layer and
+           starts the next service.
+*/
+class LIN_Master_Flash
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// state of download. Use bitmasks for fast checking multiple states
+    typedef enum : uint8_t
+    {
+      FLASH_IDLE            = 0x01,             //!< no download started
+      FLASH_REQUEST         = 0x02,             //!< RequestDownload ongoing
+      FLASH_TRANSFER        = 0x04,             //!< TransferData ongoing
+      FLASH_EXIT            = 0x08,             //!< RequestTransferExit ongoing
+      FLASH_DONE            = 0x10              //!< download completed (check getError())
+    } state_t;
+
+
+    /// download error codes. Use bitmasks, as error is latched
+    typedef enum : uint8_t
+    {
+      FLASH_NO_ERROR        = 0x00,             //!< no error
+      FLASH_ERROR_TRANSPORT = 0x01,             //!< transport layer error, see LIN_Master_Transport::getError()
+      FLASH_ERROR_NEGATIVE  = 0x02,             //!< negative response from slave, see getNRC()
+      FLASH_ERROR_RESPONSE  = 0x04,             //!< unexpected response or block sequence counter
+      FLASH_ERROR_SOURCE    = 0x08,             //!< source returned less data than requested
+      FLASH_ERROR_BUFFER    = 0x10              //!< invalid image size, buffer or block length too small
+    } error_t;
+
+
+    /// source of image data. Copies Length bytes from image offset to Data and returns the number of copied bytes
+    typedef uint16_t (*source_t)(uint32_t Offset, uint8_t Data[], uint16_t Length, void *Arg);
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Master_Transport    *pTP;               //!< transport layer used for download
+    LIN_Master_Flash::state_t   state;          //!< state of download
+    LIN_Master_Flash::error_t   error;          //!< error of download. Is latched until next begin()
+    uint8_t                 nrc;                //!< negative response code of slave (0 = none)
+    uint8_t                 nad;                //!< node address of slave
+
+    // image
+    source_t                source;             //!< source of image data
+    void                    *sourceArg;         //!< argument of source
+    uint32_t                address;            //!< target address of image
+    uint32_t                size;               //!< image size
+    uint32_t                offset;             //!< number of acknowledged bytes
+
+    // blocks
+    uint8_t                 *buf;               //!< block buffer incl. SID and sequence counter
+    uint16_t                sizeBuf;            //!< size of block buffer
+    uint16_t                lenBlock;           //!< max. data bytes per block
+    uint16_t                lenCurr;            //!< data bytes of block being sent
+    uint16_t                lenNext;            //!< data bytes of prefetched next block (0 = not loaded)
+    uint8_t                 seq;                //!< block sequence counter of block being sent
+    uint8_t                 req[11];            //!< request of RequestDownload and RequestTransferExit
+    uint8_t                 resp[16];           //!< response of slave
+
+    // statistics
+    uint32_t                timeStart;          //!< micros() of begin()
+    uint32_t                duration;           //!< duration [us] of completed download
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Finish download with error
+    void _finish(LIN_Master_Flash::error_t Error);
+
+    /// @brief Read block from source into buffer
+    bool _load(uint32_t Offset, uint8_t Seq);
+
+    /// @brief Evaluate completed service and start next one
+    void _evaluate(void);
+
+    /// @brief Copy image data from RAM buffer
+    static uint16_t _sourceBuffer(uint32_t Offset, uint8_t Data[], uint16_t Length, void *Arg);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_Flash(LIN_Master_Transport &TP);
+
+    /// @brief Start download from source callback (call after LIN begin())
+    bool begin(uint8_t NAD, uint32_t Address, uint32_t Size, source_t Source, void *Arg, uint8_t Buffer[], uint16_t SizeBuffer);
+
+    /// @brief Start download from RAM buffer (call after LIN begin())
+    inline bool begin(uint8_t NAD, uint32_t Address, const uint8_t Image[], uint32_t Size, uint8_t Buffer[], uint16_t SizeBuffer)
+    {
+      return this->begin(NAD, Address, Size, LIN_Master_Flash::_sourceBuffer, (void*) Image, Buffer, SizeBuffer);
+    }
+
+    /// @brief Abort ongoing download. An ongoing LIN frame must be completed via LIN_Master_Base::handler()
+    void abort(void);
+
+    /// @brief Handle download in background (call until FLASH_DONE is returned)
+    LIN_Master_Flash::state_t handler(void);
+
+    /// @brief Get micros() of next timing deadline, at which handler() has to be called
+    inline bool getDeadline(uint32_t &Deadline) { return this->pTP->getDeadline(Deadline); }
+
+    /// @brief Getter for download state
+    inline LIN_Master_Flash::state_t getState(void) { return this->state; }
+
+    /// @brief Getter for download error
+    inline LIN_Master_Flash::error_t getError(void) { return this->error; }
+
+    /// @brief Getter for negative response code of slave (0 = none)
+    inline uint8_t getNRC(void) { return this->nrc; }
+
+    /// @brief Getter for number of bytes acknowledged by slave
+    inline uint32_t getProgress(void) { return this->offset; }
+
+    /// @brief Getter for block length (data bytes per TransferData)
+    inline uint16_t getBlockLength(void) { return this->lenBlock; }
+
+    /// @brief Effective download rate [bytes/s] of image data
+    uint32_t getRate(void);
+
+}; // class LIN_Master_Flash
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_FLASH_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
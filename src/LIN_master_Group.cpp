@@ -0,0 +1,117 @@
+/**
+  \file     LIN_master_Group.cpp
+  \brief    Coordinator for multiple LIN master nodes
+  \details  This library provides a coordinator, which services several LIN master nodes via a single handler() call.
+            Only nodes with a reached timing deadline (end of BREAK, end of frame, next schedule slot) are serviced.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_master_Group.h>
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for LIN node group
+  \details    Constructor for LIN node group. Group is initially empty
+*/
+LIN_Master_Group::LIN_Master_Group(void)
+{
+  // Debug serial initialized in begin() of nodes -> no debug output here
+
+  // empty group
+  this->numLIN = 0;
+
+} // LIN_Master_Group::LIN_Master_Group()
+
+
+
+/**
+  \brief      Add LIN node to group
+  \details    Add LIN node to group. Node must remain valid as long as group is used
+  \param[in]  LIN       LIN node to add
+  \return     true if node was added, false if group is full
+*/
+bool LIN_Master_Group::add(LIN_Master_Base &LIN)
+{
+  // group full -> return immediately
+  if (this->numLIN >= LIN_MASTER_GROUP_SIZE)
+  {
+    // print debug message
+    DEBUG_PRINT_STATIC(1, "group full");
+
+    return false;
+  }
+
+  // store node
+  this->pLIN[this->numLIN++] = &LIN;
+
+  // print debug message
+  DEBUG_PRINT_STATIC(2, "num=%d", (int) this->numLIN);
+
+  return true;
+
+} // LIN_Master_Group::add()
+
+
+
+/**
+  \brief      Service all LIN nodes with a reached deadline
+  \details    Service all LIN nodes with a reached deadline, i.e. call their handler(). Nodes without pending deadline
+              (e.g. idle w/o schedule table) or with a deadline in the future are skipped.
+              Call as often as possible or at the time returned by getDeadline().
+  \return     number of serviced LIN nodes
+*/
+uint8_t LIN_Master_Group::handler(void)
+{
+  uint32_t  now = micros();
+  uint8_t   num = 0;
+
+  // service nodes with reached deadline
+  for (uint8_t i = 0; i < this->numLIN; i++)
+  {
+    if (this->pLIN[i]->isDue(now))
+    {
+      this->pLIN[i]->handler();
+      num++;
+    }
+  }
+
+  return num;
+
+} // LIN_Master_Group::handler()
+
+
+
+/**
+  \brief      Get micros() of earliest deadline of all LIN nodes
+  \details    Get micros() of earliest deadline of all LIN nodes, e.g. to sleep or to start a timer until then
+  \param[out] Deadline  micros() of earliest deadline (only valid if true is returned)
+  \return     true if a deadline is pending, false if no node needs servicing
+*/
+bool LIN_Master_Group::getDeadline(uint32_t &Deadline)
+{
+  bool      pending = false;
+  uint32_t  deadline;
+
+  // find earliest deadline
+  for (uint8_t i = 0; i < this->numLIN; i++)
+  {
+    if ((this->pLIN[i]->getDeadline(deadline)) && ((!pending) || ((int32_t) (deadline - Deadline) < 0)))
+    {
+      Deadline = deadline;
+      pending  = true;
+    }
+  }
+
+  return pending;
+
+} // LIN_Master_Group::getDeadline()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,80 @@
+/**
+  \file     LIN_master_Group.h
+  \brief    Coordinator for multiple LIN master nodes
+  \details  This library provides a coordinator, which services several LIN master nodes via a single handler() call.
+            Only nodes with a reached timing deadline (end of BREAK, end of frame, next schedule slot) are serviced.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_GROUP_H_
+#define _LIN_MASTER_GROUP_H_
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#if !defined(LIN_MASTER_GROUP_SIZE)
+  #define LIN_MASTER_GROUP_SIZE         4             //!< max. number of LIN nodes in a group
+#endif
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <LIN_master_Base.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Coordinator for multiple LIN master nodes
+
+  \details Coordinator for multiple LIN master nodes. handler() only calls LIN_Master_Base::handler() of nodes
+           with a reached timing deadline, see LIN_Master_Base::getDeadline().
+*/
+class LIN_Master_Group
+{
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Master_Base         *pLIN[LIN_MASTER_GROUP_SIZE];   //!< LIN nodes in group
+    uint8_t                 numLIN;             //!< number of LIN nodes in group
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_Group(void);
+
+    /// @brief Add LIN node to group
+    bool add(LIN_Master_Base &LIN);
+
+    /// @brief Number of LIN nodes in group
+    inline uint8_t getNum(void) { return this->numLIN; }
+
+    /// @brief Service all LIN nodes with a reached deadline
+    uint8_t handler(void);
+
+    /// @brief Get micros() of earliest deadline of all LIN nodes
+    bool getDeadline(uint32_t &Deadline);
+
+}; // class LIN_Master_Group
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_GROUP_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -9,6 +9,113 @@
 // include files
 #include <LIN_master_HardwareSerial.h>
 
+// access baudrate register of Arduino core serial classes, which store the UART only in protected members
+#if defined(ARDUINO_ARCH_AVR) && (defined(UBRRH) || defined(UBRR0H) || defined(UBRR1H))
+
+  /// AVR HardwareSerial: UBRRnH and UBRRnL, which are not adjacent on all devices
+  class LIN_Master_SerialAccess : public HardwareSerial
+  {
+    public:
+      volatile uint8_t *getBaudRegisterH(void) { return this->_ubrrh; }
+      volatile uint8_t *getBaudRegister(void) { return this->_ubrrl; }
+  };
+
+#elif defined(ARDUINO_ARCH_MEGAAVR)
+
+  /// megaAVR UartClass: USARTn.BAUD
+  class LIN_Master_SerialAccess : public UartClass
+  {
+    public:
+      volatile uint16_t *getBaudRegister(void) { return &(this->_hwserial_module->BAUD); }
+  };
+
+#elif defined(ARDUINO_ARCH_SAM)
+
+  /// SAM UARTClass (also base of USARTClass): UART_BRGR and US_BRGR have the same offset
+  class LIN_Master_SerialAccess : public UARTClass
+  {
+    public:
+      volatile uint32_t *getBaudRegister(void) { return (volatile uint32_t*) &(this->_pUart->UART_BRGR); }
+  };
+
+#endif
+
+
+
+#if defined(LIN_MASTER_BAUDREG_T)
+
+/**
+  \brief      Get baudrate register of UART
+  \details    Get baudrate register of UART and precalculate register values for nominal and 1/2 baudrate (BREAK).
+              If 1/2 baudrate exceeds the register range, Serial.begin() is used instead. Call after Serial.begin()
+*/
+void LIN_Master_HardwareSerial::_initBaudRegister(void)
+{
+  // get register from core serial class
+  #if defined(ARDUINO_ARCH_HOST)
+    this->pBaudReg = this->pSerial->getBaudRegister();
+  #elif defined(ARDUINO_ARCH_MEGAAVR)
+    this->pBaudReg = ((LIN_Master_SerialAccess*) ((UartClass*) this->pSerial))->getBaudRegister();
+  #elif defined(ARDUINO_ARCH_SAM)
+    this->pBaudReg = ((LIN_Master_SerialAccess*) ((UARTClass*) this->pSerial))->getBaudRegister();
+  #else
+    this->pBaudRegH = ((LIN_Master_SerialAccess*) this->pSerial)->getBaudRegisterH();
+    this->pBaudReg  = ((LIN_Master_SerialAccess*) this->pSerial)->getBaudRegister();
+  #endif
+
+  // store nominal value and calculate value for 1/2 baudrate
+  if (this->pBaudReg != NULL)
+  {
+    #if defined(LIN_MASTER_BAUDREG_SPLIT)
+      this->baudRegNominal = ((uint16_t) (*(this->pBaudRegH) & 0x0F) << 8) | *(this->pBaudReg);
+    #else
+      this->baudRegNominal = *(this->pBaudReg);
+    #endif
+    if ((this->baudRegNominal == 0) || (this->baudRegNominal > (LIN_MASTER_BAUDREG_MAX - 1) / 2))
+      this->pBaudReg = NULL;
+    #if defined(ARDUINO_ARCH_AVR)
+      this->baudRegBreak = 2 * this->baudRegNominal + 1;      // baud = F_CPU / (16 or 8 * (UBRR+1))
+    #else
+      this->baudRegBreak = 2 * this->baudRegNominal;          // baud = clock / (16 * CD) or similar
+    #endif
+  }
+
+} // LIN_Master_HardwareSerial::_initBaudRegister()
+
+#endif // LIN_MASTER_BAUDREG_T
+
+
+
+/**
+  \brief      Set UART to nominal or 1/2 baudrate
+  \details    Set UART to nominal or 1/2 baudrate (for BREAK). If available, only the baudrate register is written,
+              which takes a few cycles instead of a UART re-initialization via Serial.begin(). Transmitter must be idle
+  \param[in]  Break     true = 1/2 baudrate for BREAK, false = nominal baudrate
+*/
+void LIN_Master_HardwareSerial::_setBaudrate(bool Break)
+{
+  // write baudrate register directly
+  #if defined(LIN_MASTER_BAUDREG_T)
+    if (this->pBaudReg != NULL)
+    {
+      LIN_MASTER_BAUDREG_T value = (Break) ? this->baudRegBreak : this->baudRegNominal;
+      #if defined(LIN_MASTER_BAUDREG_SPLIT)
+        *(this->pBaudRegH) = (uint8_t) (value >> 8);          // UBRRnH first (URSEL=0 on ATmega8), write of UBRRnL updates prescaler
+        *(this->pBaudReg)  = (uint8_t) value;
+      #else
+        *(this->pBaudReg) = value;
+      #endif
+      return;
+    }
+  #endif
+
+  // re-initialize UART (w/o timeout)
+  this->pSerial->begin((Break) ? (this->baudrate >> 1) : this->baudrate);
+  while(!(*(this->pSerial)));
+
+} // LIN_Master_HardwareSerial::_setBaudrate()
+
+
 
 /**
   \brief      Send LIN break
@@ -35,9 +142,8 @@ LIN_Master_Base::state_t LIN_Master_HardwareSerial::_sendBreak(void)
   while (this->pSerial->available())
     this->pSerial->read();
 
-  // set half baudrate for BREAK (w/o timeout)
-  this->pSerial->begin(this->baudrate >> 1);
-  while(!(*(this->pSerial)));
+  // set half baudrate for BREAK
+  this->_setBaudrate(true);
   
   // optionally enable transmitter
   this->_enableTransmitter();
@@ -81,12 +187,12 @@ LIN_Master_Base::state_t LIN_Master_HardwareSerial::_sendFrame(void)
   // byte(s) received (likely BREAK echo)
   if (this->pSerial->available())
   {
-    // store echo in Rx
-    this->bufRx[0] = this->pSerial->read();
+    // store and check BREAK echo. Exit on error
+    if (this->_receiveByte((uint8_t) this->pSerial->read()) == LIN_Master_Base::STATE_DONE)
+      return this->state;
 
-    // restore nominal baudrate (w/o timeout)
-    this->pSerial->begin(this->baudrate);
-    while(!(*(this->pSerial)));
+    // restore nominal baudrate
+    this->_setBaudrate(false);
 
     // send rest of frame (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
     this->pSerial->write(this->bufTx+1, this->lenTx-1);
@@ -126,7 +232,7 @@ LIN_Master_Base::state_t LIN_Master_HardwareSerial::_sendFrame(void)
 
 /**
   \brief      Receive and check LIN frame
-  \details    Receive and check LIN frame (request frame: check echo; response frame: check header echo & checksum)
+  \details    Receive and check LIN frame byte by byte (request frame: check echo; response frame: check header echo & checksum)
   \return     current state of LIN state machine
 */
 LIN_Master_Base::state_t LIN_Master_HardwareSerial::_receiveFrame(void)
@@ -144,44 +250,24 @@ LIN_Master_Base::state_t LIN_Master_HardwareSerial::_receiveFrame(void)
     return this->state;
   }
 
-  // optionally disable RS485 transmitter for slave response frames. Len==2 because BREAK is handled already handled in _sendFrame()
-  if ((this->type == LIN_Master_Base::SLAVE_RESPONSE) && (this->pSerial->available() == 2))
-    this->_disableTransmitter();
+  // process received bytes one at a time. Frame is completed or aborted on 1st error, see _receiveByte()
+  int num = this->pSerial->available();
+  while ((num-- > 0) && (this->state == LIN_Master_Base::STATE_BODY))
+    this->_receiveByte((uint8_t) this->pSerial->read());
 
-  // frame body received (-1 because BREAK is handled already handled in _sendFrame())
-  if (this->pSerial->available() >= this->lenRx-1)
+  // frame not yet completed -> check for timeout
+  if ((this->state == LIN_Master_Base::STATE_BODY) && (micros() - this->timeStart > this->timeoutFrame))
   {
-    // store bytes in Rx
-    this->pSerial->readBytes(this->bufRx+1, this->lenRx-1);
-
-    // check frame for errors
-    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) this->_checkFrame());
-
-    // optionally disable RS485 transmitter after frame is completed
-    this->_disableTransmitter();
+    // print debug message
+    DEBUG_PRINT(1, "Rx timeout");
 
-    // progress state
+    // set error state and return immediately
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_TIMEOUT);
     this->state = LIN_Master_Base::STATE_DONE;
+    this->_disableTransmitter();
+    return this->state;
 
-  } // frame body received
-  
-  // frame body received not yet received
-  else
-  {
-    // check for timeout
-    if (micros() - this->timeStart > this->timeoutFrame)
-    {
-      // print debug message
-      DEBUG_PRINT(1, "Rx timeout");
-
-      // set error state and return immediately
-      this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_TIMEOUT);
-      this->state = LIN_Master_Base::STATE_DONE;
-      this->_disableTransmitter();
-      return this->state;
-    }
-
-  } // not enough bytes received
+  } // timeout
   
   // print debug message
   DEBUG_PRINT(2, " ");
@@ -206,6 +292,9 @@ LIN_Master_HardwareSerial::LIN_Master_HardwareSerial(HardwareSerial &Interface,
 
   // store pointer to used HW serial
   this->pSerial = &Interface;
+  #if defined(LIN_MASTER_BAUDREG_T)
+    this->pBaudReg = NULL;
+  #endif
 
   // must not open connection here, else (at least) ESP32 and ESP8266 fail
 
@@ -218,7 +307,7 @@ LIN_Master_HardwareSerial::LIN_Master_HardwareSerial(HardwareSerial &Interface,
   \details    Open serial interface with specified baudrate
   \param[in]  Baudrate    communication speed [Baud] (default = 19200)
 */
-void LIN_Master_HardwareSerial::begin(uint16_t Baudrate)
+void LIN_Master_HardwareSerial::begin(uint32_t Baudrate)
 {  
   // call base class method
   LIN_Master_Base::begin(Baudrate);
@@ -232,6 +321,11 @@ void LIN_Master_HardwareSerial::begin(uint16_t Baudrate)
     while(!(*(this->pSerial)));
   #endif
 
+  // get baudrate register for BREAK generation
+  #if defined(LIN_MASTER_BAUDREG_T)
+    this->_initBaudRegister();
+  #endif
+
   // print debug message
   DEBUG_PRINT(2, "ok");
 
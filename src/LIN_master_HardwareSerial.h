@@ -21,6 +21,27 @@
 #include <LIN_master_Base.h>
 
 
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+// UART baudrate register for BREAK generation w/o Serial.begin(). Other platforms use Serial.begin()
+#if defined(ARDUINO_ARCH_AVR) && (defined(UBRRH) || defined(UBRR0H) || defined(UBRR1H))
+  #define LIN_MASTER_BAUDREG_T          uint16_t      //!< type of UBRRn
+  #define LIN_MASTER_BAUDREG_MAX        0x0FFF        //!< max. value of UBRRn (12 bit)
+  #define LIN_MASTER_BAUDREG_SPLIT                    //!< UBRRnH and UBRRnL are accessed bytewise, as they are not adjacent on all devices (e.g. ATmega8 UBRRH shares address with UCSRC)
+#elif defined(ARDUINO_ARCH_MEGAAVR)
+  #define LIN_MASTER_BAUDREG_T          uint16_t      //!< type of USARTn.BAUD
+  #define LIN_MASTER_BAUDREG_MAX        0xFFFF        //!< max. value of USARTn.BAUD
+#elif defined(ARDUINO_ARCH_SAM)
+  #define LIN_MASTER_BAUDREG_T          uint32_t      //!< type of UART_BRGR / US_BRGR
+  #define LIN_MASTER_BAUDREG_MAX        0xFFFF        //!< max. clock divider CD (16 bit)
+#elif defined(ARDUINO_ARCH_HOST)
+  #define LIN_MASTER_BAUDREG_T          uint32_t      //!< type of mock baudrate register, see HardwareSerial::getBaudRegister()
+  #define LIN_MASTER_BAUDREG_MAX        0xFFFFFFFF    //!< max. value of mock baudrate register
+#endif
+
+
 /*-----------------------------------------------------------------------------
   GLOBAL CLASS
 -----------------------------------------------------------------------------*/
@@ -35,11 +56,29 @@ class LIN_Master_HardwareSerial : public LIN_Master_Base
   protected:
 
     HardwareSerial        *pSerial;           //!< serial interface used for LIN
+    #if defined(LIN_MASTER_BAUDREG_SPLIT)
+      volatile uint8_t      *pBaudRegH;       //!< UART baudrate register high byte (UBRRnH)
+      volatile uint8_t      *pBaudReg;        //!< UART baudrate register low byte (UBRRnL, NULL = use Serial.begin())
+    #elif defined(LIN_MASTER_BAUDREG_T)
+      volatile LIN_MASTER_BAUDREG_T *pBaudReg;  //!< UART baudrate register (NULL = use Serial.begin())
+    #endif
+    #if defined(LIN_MASTER_BAUDREG_T)
+      LIN_MASTER_BAUDREG_T  baudRegNominal;   //!< register value for nominal baudrate
+      LIN_MASTER_BAUDREG_T  baudRegBreak;     //!< register value for 1/2 baudrate (BREAK)
+    #endif
 
 
   // PROTECTED METHODS
   protected:
   
+    #if defined(LIN_MASTER_BAUDREG_T)
+      /// @brief Get baudrate register of UART
+      void _initBaudRegister(void);
+    #endif
+
+    /// @brief Set UART to nominal or 1/2 baudrate (BREAK)
+    void _setBaudrate(bool Break);
+
     /// @brief Send LIN break
     LIN_Master_Base::state_t _sendBreak(void);
 
@@ -57,7 +96,7 @@ class LIN_Master_HardwareSerial : public LIN_Master_Base
     LIN_Master_HardwareSerial(HardwareSerial &Interface, const char NameLIN[] = "Master", const int8_t PinTxEN = INT8_MIN);
      
     /// @brief Open serial interface
-    void begin(uint16_t Baudrate = 19200);
+    void begin(uint32_t Baudrate = 19200);
     
     /// @brief Close serial interface
     void end(void);
@@ -64,7 +64,7 @@ class LIN_Master_HardwareSerial_ESP32 : public LIN_Master_Base
       const char NameLIN[] = "Master", const int8_t PinTxEN = INT8_MIN);
      
     /// @brief Open serial interface
-    void begin(uint16_t Baudrate = 19200);
+    void begin(uint32_t Baudrate = 19200);
     
     /// @brief Close serial interface
     void end(void);
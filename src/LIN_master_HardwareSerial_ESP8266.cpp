@@ -85,8 +85,9 @@ LIN_Master_Base::state_t LIN_Master_HardwareSerial_ESP8266::_sendFrame(void)
   // byte(s) received (likely BREAK echo)
   if (this->pSerial->available())
   {
-    // store echo in Rx
-    this->bufRx[0] = this->pSerial->read();
+    // store and check BREAK echo. Exit on error
+    if (this->_receiveByte((uint8_t) this->pSerial->read()) == LIN_Master_Base::STATE_DONE)
+      return this->state;
 
     // restore nominal baudrate
     this->pSerial->updateBaudRate(this->baudrate);
@@ -129,7 +130,7 @@ LIN_Master_Base::state_t LIN_Master_HardwareSerial_ESP8266::_sendFrame(void)
 
 /**
   \brief      Receive and check LIN frame
-  \details    Receive and check LIN frame (request frame: check echo; response frame: check header echo & checksum)
+  \details    Receive and check LIN frame byte by byte (request frame: check echo; response frame: check header echo & checksum)
   \return     current state of LIN state machine
 */
 LIN_Master_Base::state_t LIN_Master_HardwareSerial_ESP8266::_receiveFrame(void)
@@ -147,44 +148,24 @@ LIN_Master_Base::state_t LIN_Master_HardwareSerial_ESP8266::_receiveFrame(void)
     return this->state;
   }
 
-  // optionally disable RS485 transmitter for slave response frames. Len==2 because BREAK is handled already handled in _sendFrame()
-  if ((this->type == LIN_Master_Base::SLAVE_RESPONSE) && (this->pSerial->available() == 2))
-    this->_disableTransmitter();
+  // process received bytes one at a time. Frame is completed or aborted on 1st error, see _receiveByte()
+  int num = this->pSerial->available();
+  while ((num-- > 0) && (this->state == LIN_Master_Base::STATE_BODY))
+    this->_receiveByte((uint8_t) this->pSerial->read());
 
-  // frame body received (-1 because BREAK is handled already handled in _sendFrame())
-  if (this->pSerial->available() >= this->lenRx-1)
+  // frame not yet completed -> check for timeout
+  if ((this->state == LIN_Master_Base::STATE_BODY) && (micros() - this->timeStart > this->timeoutFrame))
   {
-    // store bytes in Rx
-    this->pSerial->readBytes(this->bufRx+1, this->lenRx-1);
-
-    // check frame for errors
-    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) this->_checkFrame());
-
-    // optionally disable RS485 transmitter after frame is completed
-    this->_disableTransmitter();
+    // print debug message
+    DEBUG_PRINT(1, "Rx timeout");
 
-    // progress state
+    // set error state and return immediately
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_TIMEOUT);
     this->state = LIN_Master_Base::STATE_DONE;
+    this->_disableTransmitter();
+    return this->state;
 
-  } // frame body received
-  
-  // frame body received not yet received
-  else
-  {
-    // check for timeout
-    if (micros() - this->timeStart > this->timeoutFrame)
-    {
-      // print debug message
-      DEBUG_PRINT(1, "Rx timeout");
-
-      // set error state and return immediately
-      this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_TIMEOUT);
-      this->state = LIN_Master_Base::STATE_DONE;
-      this->_disableTransmitter();
-      return this->state;
-    }
-
-  } // not enough bytes received
+  } // timeout
   
   // print debug message
   DEBUG_PRINT(2, " ");
@@ -223,7 +204,7 @@ LIN_Master_HardwareSerial_ESP8266::LIN_Master_HardwareSerial_ESP8266(bool SwapPi
   \details    Open serial interface with specified baudrate. Optionally use Serial2 pins 
   \param[in]  Baudrate    communication speed [Baud] (default = 19200)
 */
-void LIN_Master_HardwareSerial_ESP8266::begin(uint16_t Baudrate)
+void LIN_Master_HardwareSerial_ESP8266::begin(uint32_t Baudrate)
 {
   // call base class method
   LIN_Master_Base::begin(Baudrate);
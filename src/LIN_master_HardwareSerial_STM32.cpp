@@ -2,6 +2,9 @@
   \file     LIN_master_HardwareSerial_STM32.cpp
   \brief    LIN master emulation library using a HardwareSerial interface of STM32
   \details  This library provides a master node emulation for a LIN bus via a HardwareSerial interface of STM32, optionally via RS485.
+            Optionally the BREAK is generated by the LIN mode of the USART, see setNativeBreak(), and frames are sent
+            and received via DMA and HAL reception event callback, see setDMA(). The host build uses a mocked USART
+            register block, UART HAL with DMA and D-cache.
             For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
   \note     Have to use dedicated class due to long latency on baudrate change, see https://github.com/stm32duino/Arduino_Core_STM32/issues/2907
   \author   Georg Icking-Konert
@@ -14,9 +17,193 @@
 #if defined(_LIN_MASTER_HW_SERIAL_STM32_H_)
 
 
+// USART data registers. Newer families (e.g. L4, G4) have separate TDR/RDR, older ones (e.g. F1, F4) a common DR
+#if defined(USART_TDR_TDR)
+  #define LIN_MASTER_STM32_TDR(huart)   ((huart)->Instance->TDR)
+  #define LIN_MASTER_STM32_RDR(huart)   ((huart)->Instance->RDR)
+#else
+  #define LIN_MASTER_STM32_TDR(huart)   ((huart)->Instance->DR)
+  #define LIN_MASTER_STM32_RDR(huart)   ((huart)->Instance->DR)
+#endif
+
+
+
+// first node with DMA, see onRxEvent()
+LIN_Master_HardwareSerial_STM32 *LIN_Master_HardwareSerial_STM32::pFirstDma = NULL;
+
+
+
+/**
+  \brief      Send bytes
+  \details    Send bytes via DMA (w/o CPU load per byte) or Serial.write(). With D-cache, the cache lines containing the
+              bytes are cleaned before, as DMA reads from RAM
+  \param[in]  Data      bytes to send. Must remain valid until sent
+  \param[in]  Num       number of bytes
+*/
+void LIN_Master_HardwareSerial_STM32::_send(const uint8_t *Data, uint8_t Num)
+{
+  // send via Arduino core
+  if (!this->useDma)
+  {
+    this->pSerial->write(Data, Num);
+    return;
+  }
+
+  // write back cache lines containing the bytes (range aligned to cache lines)
+  #if defined(LIN_MASTER_STM32_DCACHE)
+    uintptr_t addr = (uintptr_t) Data & ~((uintptr_t) LIN_MASTER_STM32_DMA_ALIGN - 1);
+    SCB_CleanDCache_by_Addr((uint32_t *) addr, (int32_t) ((uintptr_t) Data + Num - addr));
+  #endif
+
+  // send via DMA. Previous transfer is completed, as its echo was received. On error frame times out
+  if (HAL_UART_Transmit_DMA(this->huart, (uint8_t *) Data, Num) != HAL_OK)
+  {
+    // print debug message
+    DEBUG_PRINT(1, "Tx DMA failed");
+  }
+
+} // LIN_Master_HardwareSerial_STM32::_send()
+
+
+
+/**
+  \brief      Start DMA reception
+  \details    Start DMA reception of BREAK echo (1 byte) or rest of frame into bufDma, starting at idxDma. Reception
+              stops at transfer complete or idle line, see _onRxEvent(). Error interrupts enabled by HAL are disabled
+              again, as the framing error of the BREAK would otherwise abort the reception
+*/
+void LIN_Master_HardwareSerial_STM32::_startRx(void)
+{
+  uint8_t   len = (this->state == LIN_Master_Base::STATE_BREAK) ? 1 : this->lenRx - this->idxDma;
+
+  // start reception. No cache invalidation required, as CPU never writes bufDma, i.e. its cache lines are never dirty
+  this->ofsDma = this->idxDma;
+  if ((this->idxDma >= this->lenRx) || (HAL_UARTEx_ReceiveToIdle_DMA(this->huart, this->bufDma + this->ofsDma, len) != HAL_OK))
+  {
+    // print debug message
+    DEBUG_PRINT(1, "Rx DMA failed");
+
+    // set error state
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_MISC);
+    this->state = LIN_Master_Base::STATE_DONE;
+    this->_disableTransmitter();
+    return;
+  }
+
+  // disable error interrupts. Errors are detected via echo or checksum
+  CLEAR_BIT(this->huart->Instance->CR1, USART_CR1_PEIE);
+  CLEAR_BIT(this->huart->Instance->CR3, USART_CR3_EIE);
+
+} // LIN_Master_HardwareSerial_STM32::_startRx()
+
+
+
+/**
+  \brief      Handle DMA reception event
+  \details    Handle DMA reception event (half transfer, transfer complete or idle line) in interrupt context. New bytes
+              are checked via LIN_Master_Base::_receiveByte(), i.e. the frame is completed here. After BREAK echo the
+              nominal baudrate is restored and rest of frame sent. If the reception stopped (transfer complete or idle
+              line, e.g. in response space) before frame completion, it is restarted for the remaining bytes.
+              Optional trace and timing statistics are locked against handler(), see LIN_MASTER_CRITICAL_BEGIN()
+  \param[in]  Size      number of bytes received since start of reception, see _startRx()
+*/
+void LIN_Master_HardwareSerial_STM32::_onRxEvent(uint16_t Size)
+{
+  uint8_t   num = this->ofsDma + Size;
+  bool      sendBody = false;
+
+  // no frame ongoing, e.g. error or timeout -> ignore
+  if (!(this->state & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY)))
+    return;
+
+  // remember progress for optional timing statistics and trace
+  LIN_Master_Base::state_t  statePrev = this->state;
+
+  // discard stale cache lines of Rx buffer (whole cache lines), as DMA wrote to RAM
+  #if defined(LIN_MASTER_STM32_DCACHE)
+    SCB_InvalidateDCache_by_Addr((uint32_t *) this->bufDma, sizeof(this->bufDma));
+  #endif
+
+  // process new bytes one at a time. Frame is completed or aborted on 1st error, see _receiveByte()
+  if (num > sizeof(this->bufDma))
+    num = sizeof(this->bufDma);
+  while ((this->idxDma < num) && (this->state & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY)))
+  {
+    uint8_t data = this->bufDma[(this->idxDma)++];
+
+    // BREAK echo. Transmitter is idle after echo -> restore nominal baudrate and send rest of frame below
+    if (this->state == LIN_Master_Base::STATE_BREAK)
+    {
+      if (this->_receiveByte(data) != LIN_Master_Base::STATE_DONE)
+      {
+        // Note: don't use Serial.begin() or TE=1 due to HW latency, see https://github.com/stm32duino/Arduino_Core_STM32/issues/2907#issuecomment-3816058235
+        this->huart->Instance->BRR = this->brr;
+        this->state = LIN_Master_Base::STATE_BODY;
+        sendBody = true;
+      }
+      continue;
+    }
+
+    // native LIN break may be received as 0x00 with framing error (depends on device) -> ignore before SYNC echo
+    if ((this->nativeBreak) && (this->idxRx == 1) && (data == 0x00))
+      continue;
+
+    // echo or slave response
+    this->_receiveByte(data);
+  }
+
+  // reception stopped before frame completion -> restart for remaining bytes (before sending rest of frame)
+  if ((this->state == LIN_Master_Base::STATE_BODY) && (this->huart->RxState == HAL_UART_STATE_READY))
+    this->_startRx();
+  if ((sendBody) && (this->state == LIN_Master_Base::STATE_BODY))
+    this->_send(this->bufTx+1, this->lenTx-1);
+
+  // optionally trace state transitions
+  #if defined(LIN_MASTER_TRACE)
+    if (this->state != statePrev)
+      LIN_TRACE(LIN_Master_Base::TRACE_STATE, this->state, this->error);
+  #else
+    (void) statePrev;
+  #endif
+
+  // optionally record exact timing of received bytes
+  #if defined(LIN_MASTER_TIMING)
+    this->_recordTiming();
+  #endif
+
+} // LIN_Master_HardwareSerial_STM32::_onRxEvent()
+
+
+
+/**
+  \brief      Check for frame timeout
+  \details    Check for frame timeout with DMA, e.g. missing slave response. Interrupts are disabled, as DMA reception
+              event may progress state. A pending reception is aborted by next _sendBreak()
+*/
+void LIN_Master_HardwareSerial_STM32::_checkTimeout(void)
+{
+  LIN_MASTER_CRITICAL_BEGIN();
+  if ((this->state & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY)) && (micros() - this->timeStart > this->timeoutFrame))
+  {
+    // print debug message
+    DEBUG_PRINT(1, "Rx timeout");
+
+    // set error state
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_TIMEOUT);
+    this->state = LIN_Master_Base::STATE_DONE;
+    this->_disableTransmitter();
+  }
+  LIN_MASTER_CRITICAL_END();
+
+} // LIN_Master_HardwareSerial_STM32::_checkTimeout()
+
+
+
 /**
   \brief      Send LIN break
-  \details    Send LIN break (=16bit low)
+  \details    Send LIN break (=16bit low). With native break via LIN mode (=13bit low), the rest of the frame is queued
+              immediately, i.e. state proceeds directly to STATE_BODY. With DMA the reception is started before sending,
+              and the frame is handled by _onRxEvent()
   \return     current state of LIN state machine
 */
 LIN_Master_Base::state_t LIN_Master_HardwareSerial_STM32::_sendBreak(void)
@@ -39,18 +226,51 @@ LIN_Master_Base::state_t LIN_Master_HardwareSerial_STM32::_sendBreak(void)
   while (this->pSerial->available())
     this->pSerial->read();
 
+  // DMA: abort reception of previous frame. Discard stale byte, overrun and framing error (no receive interrupt between frames)
+  if (this->useDma)
+  {
+    HAL_UART_AbortReceive(this->huart);
+    __HAL_UART_CLEAR_OREFLAG(this->huart);
+    __HAL_UART_CLEAR_FEFLAG(this->huart);
+    __HAL_UART_FLUSH_DRREGISTER(this->huart);
+    this->ofsDma = 0;
+    this->idxDma = 0;
+  }
+
   // optionally enable transmitter
   this->_enableTransmitter();
 
+  // native LIN break: request 13bit BREAK and queue rest of frame immediately, i.e. w/o waiting for BREAK echo
+  if (this->nativeBreak)
+  {
+    // BREAK is not echoed as a regular byte -> store as received and continue with frame body
+    this->state = LIN_Master_Base::STATE_BODY;
+    this->_receiveByte(this->bufTx[0]);
+
+    // DMA: start reception of complete frame before sending
+    if (this->useDma)
+      this->_startRx();
+
+    HAL_LIN_SendBreak(this->huart);
+    this->_send(this->bufTx+1, this->lenTx-1);
+
+    // print debug message
+    DEBUG_PRINT(3, "native");
+
+    return this->state;
+  }
+
   // send 0x00 at 1/2 baudrate
   // Note: don't use Serial.begin() or TE=1 due to HW latency, see https://github.com/stm32duino/Arduino_Core_STM32/issues/2907#issuecomment-3816058235
   //this->huart->Instance->CR1 &= ~USART_CR1_UE;
   this->huart->Instance->BRR = this->brr * 2;
   //this->huart->Instance->CR1 |= USART_CR1_UE;
-  this->pSerial->write((int) 0x00);
 
-  // progress state
+  // progress state. With DMA, set before sending and start reception of BREAK echo, as echo is handled by _onRxEvent()
   this->state = LIN_Master_Base::STATE_BREAK;
+  if (this->useDma)
+    this->_startRx();
+  this->_send(this->bufTx, 1);
 
   // print debug message
   DEBUG_PRINT(3, " ");
@@ -64,11 +284,19 @@ LIN_Master_Base::state_t LIN_Master_HardwareSerial_STM32::_sendBreak(void)
 
 /**
   \brief      Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
-  \details    Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+  \details    Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID). With DMA, only check
+              timeout, as rest of frame is sent by _onRxEvent() after BREAK echo
   \return     current state of LIN state machine
 */
 LIN_Master_Base::state_t LIN_Master_HardwareSerial_STM32::_sendFrame(void)
 {
+  // DMA: frame is handled by reception event
+  if (this->useDma)
+  {
+    this->_checkTimeout();
+    return this->state;
+  }
+
   // if state is wrong, exit immediately
   if (this->state != LIN_Master_Base::STATE_BREAK)
   {
@@ -83,17 +311,18 @@ LIN_Master_Base::state_t LIN_Master_HardwareSerial_STM32::_sendFrame(void)
   }
 
   // byte(s) received (likely BREAK echo)
-  if (this->pSerial->available())
+  if (this->pSerial->available() > 0)
   {
-    // store echo in Rx
-    this->bufRx[0] = this->pSerial->read();
+    // store and check BREAK echo. Exit on error
+    if (this->_receiveByte((uint8_t) this->pSerial->read()) == LIN_Master_Base::STATE_DONE)
+      return this->state;
 
     // revert baudrate
     // Note: don't use Serial.begin() or TE=1 due to HW latency, see https://github.com/stm32duino/Arduino_Core_STM32/issues/2907#issuecomment-3816058235
     this->huart->Instance->BRR = this->brr;
 
     // send rest of frame (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
-    this->pSerial->write(this->bufTx+1, this->lenTx-1);
+    this->_send(this->bufTx+1, this->lenTx-1);
 
     // progress state
     this->state = LIN_Master_Base::STATE_BODY;
@@ -130,11 +359,19 @@ LIN_Master_Base::state_t LIN_Master_HardwareSerial_STM32::_sendFrame(void)
 
 /**
   \brief      Receive and check LIN frame
-  \details    Receive and check LIN frame (request frame: check echo; response frame: check header echo & checksum)
+  \details    Receive and check LIN frame byte by byte (request frame: check echo; response frame: check header echo & checksum).
+              With DMA, only check timeout, as frame is checked by _onRxEvent()
   \return     current state of LIN state machine
 */
 LIN_Master_Base::state_t LIN_Master_HardwareSerial_STM32::_receiveFrame(void)
 {
+  // DMA: frame is handled by reception event
+  if (this->useDma)
+  {
+    this->_checkTimeout();
+    return this->state;
+  }
+
   // if state is wrong, exit immediately
   if (this->state != LIN_Master_Base::STATE_BODY)
   {
@@ -148,44 +385,32 @@ LIN_Master_Base::state_t LIN_Master_HardwareSerial_STM32::_receiveFrame(void)
     return this->state;
   }
 
-  // optionally disable RS485 transmitter for slave response frames. Len==2 because BREAK is handled already handled in _sendFrame()
-  if ((this->type == LIN_Master_Base::SLAVE_RESPONSE) && (this->pSerial->available() == 2))
-    this->_disableTransmitter();
-
-  // frame body received (-1 because BREAK is handled already handled in _sendFrame())
-  if (this->pSerial->available() >= this->lenRx-1)
+  // process received bytes one at a time. Frame is completed or aborted on 1st error, see _receiveByte()
+  int num = this->pSerial->available();
+  while ((num-- > 0) && (this->state == LIN_Master_Base::STATE_BODY))
   {
-    // store bytes in Rx
-    this->pSerial->readBytes(this->bufRx+1, this->lenRx-1);
+    uint8_t data = (uint8_t) this->pSerial->read();
 
-    // check frame for errors
-    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) this->_checkFrame());
-
-    // optionally disable RS485 transmitter after frame is completed
-    this->_disableTransmitter();
+    // native LIN break may be received as 0x00 with framing error (depends on core) -> ignore before SYNC echo
+    if ((this->nativeBreak) && (this->idxRx == 1) && (data == 0x00))
+      continue;
 
-    // progress state
-    this->state = LIN_Master_Base::STATE_DONE;
+    this->_receiveByte(data);
+  }
 
-  } // frame body received
-  
-  // frame body received not yet received
-  else
+  // frame not yet completed -> check for timeout
+  if ((this->state == LIN_Master_Base::STATE_BODY) && (micros() - this->timeStart > this->timeoutFrame))
   {
-    // check for timeout
-    if (micros() - this->timeStart > this->timeoutFrame)
-    {
-      // print debug message
-      DEBUG_PRINT(1, "Rx timeout");
+    // print debug message
+    DEBUG_PRINT(1, "Rx timeout");
 
-      // set error state and return immediately
-      this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_TIMEOUT);
-      this->state = LIN_Master_Base::STATE_DONE;
-      this->_disableTransmitter();
-      return this->state;
-    }
+    // set error state and return immediately
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_TIMEOUT);
+    this->state = LIN_Master_Base::STATE_DONE;
+    this->_disableTransmitter();
+    return this->state;
 
-  } // not enough bytes received
+  } // timeout
   
   // print debug message
   DEBUG_PRINT(2, " ");
@@ -216,6 +441,13 @@ LIN_Master_HardwareSerial_STM32::LIN_Master_HardwareSerial_STM32(HWSERIAL &Inter
   this->huart      = Interface.getHandle();                   // pointer to underlying HAL UART handle
   this->pinRx      = PinRx;                                   // receive pin
   this->pinTx      = PinTx;                                   // transmit pin
+  this->nativeBreak = false;                                  // BREAK via 0x00 at 1/2 baudrate
+  this->hdmaTx     = NULL;                                    // send via Serial.write()
+  this->hdmaRx     = NULL;                                    // receive via Serial.read()
+  this->useDma     = false;
+  this->ofsDma     = 0;
+  this->idxDma     = 0;
+  this->pNextDma   = NULL;
 
 } // LIN_Master_HardwareSerial_STM32::LIN_Master_HardwareSerial_STM32()
 
@@ -226,7 +458,7 @@ LIN_Master_HardwareSerial_STM32::LIN_Master_HardwareSerial_STM32(HWSERIAL &Inter
   \details    Open serial interface with specified baudrate
   \param[in]  Baudrate    communication speed [Baud] (default = 19200)
 */
-void LIN_Master_HardwareSerial_STM32::begin(uint16_t Baudrate)
+void LIN_Master_HardwareSerial_STM32::begin(uint32_t Baudrate)
 {
   // call base class method
   LIN_Master_Base::begin(Baudrate);
@@ -250,6 +482,44 @@ void LIN_Master_HardwareSerial_STM32::begin(uint16_t Baudrate)
   // store BRR value for BRK generation
   this->brr = this->huart->Instance->BRR;
 
+  // optionally configure LIN mode for native BREAK. Only possible with UE=0, then use of USART is reduced to async mode
+  if (this->nativeBreak)
+  {
+    #if defined(IS_UART_LIN_INSTANCE)
+      if (!IS_UART_LIN_INSTANCE(this->huart->Instance))
+      {
+        DEBUG_PRINT(1, "no LIN mode");
+        this->nativeBreak = false;
+      }
+      else
+    #endif
+      {
+        CLEAR_BIT(this->huart->Instance->CR1, USART_CR1_UE);
+        CLEAR_BIT(this->huart->Instance->CR2, USART_CR2_CLKEN | USART_CR2_STOP);
+        CLEAR_BIT(this->huart->Instance->CR3, USART_CR3_SCEN | USART_CR3_HDSEL | USART_CR3_IREN);
+        SET_BIT(this->huart->Instance->CR2, USART_CR2_LINEN);
+        SET_BIT(this->huart->Instance->CR1, USART_CR1_UE);
+      }
+  }
+
+  // optional DMA (requires both channels). Link DMA handles and stop interrupt reception of core. Frames are started by _sendBreak()
+  this->useDma = (this->hdmaTx != NULL) && (this->hdmaRx != NULL);
+  if (this->useDma)
+  {
+    __HAL_LINKDMA(this->huart, hdmatx, *(this->hdmaTx));
+    __HAL_LINKDMA(this->huart, hdmarx, *(this->hdmaRx));
+    HAL_UART_AbortReceive(this->huart);
+    #if defined(USE_HAL_UART_REGISTER_CALLBACKS) && (USE_HAL_UART_REGISTER_CALLBACKS == 1)
+      HAL_UART_RegisterRxEventCallback(this->huart, LIN_Master_HardwareSerial_STM32::onRxEvent);
+    #endif
+
+    // add to list of DMA nodes for reception event, see onRxEvent()
+    LIN_MASTER_CRITICAL_BEGIN();
+    this->pNextDma = LIN_Master_HardwareSerial_STM32::pFirstDma;
+    LIN_Master_HardwareSerial_STM32::pFirstDma = this;
+    LIN_MASTER_CRITICAL_END();
+  }
+
   // print debug message
   DEBUG_PRINT(2, "ok");
 
@@ -266,6 +536,24 @@ void LIN_Master_HardwareSerial_STM32::end()
   // call base class method
   LIN_Master_Base::end();
     
+  // stop optional DMA and remove from list of DMA nodes
+  if (this->useDma)
+  {
+    HAL_UART_Abort(this->huart);
+    LIN_MASTER_CRITICAL_BEGIN();
+    for (LIN_Master_HardwareSerial_STM32 **pNode = &(LIN_Master_HardwareSerial_STM32::pFirstDma); *pNode != NULL; pNode = &((*pNode)->pNextDma))
+    {
+      if (*pNode == this)
+      {
+        *pNode = this->pNextDma;
+        break;
+      }
+    }
+    LIN_MASTER_CRITICAL_END();
+    this->pNextDma = NULL;
+    this->useDma   = false;
+  }
+
   // close serial interface
   this->pSerial->end();
 
@@ -274,6 +562,47 @@ void LIN_Master_HardwareSerial_STM32::end()
 
 } // LIN_Master_HardwareSerial_STM32::end()
 
+
+
+/**
+  rief      Dispatch DMA reception event
+  \details    Dispatch DMA reception event to the node using the UART, see _onRxEvent(). Is called from
+              HAL_UARTEx_RxEventCallback() in interrupt context. Events of other UARTs are ignored
+  \param[in]  huart     HAL UART handle of event
+  \param[in]  Size      number of bytes received since start of reception
+*/
+void LIN_Master_HardwareSerial_STM32::onRxEvent(UART_HandleTypeDef *huart, uint16_t Size)
+{
+  for (LIN_Master_HardwareSerial_STM32 *node = LIN_Master_HardwareSerial_STM32::pFirstDma; node != NULL; node = node->pNextDma)
+  {
+    if (node->huart == huart)
+    {
+      node->_onRxEvent(Size);
+      return;
+    }
+  }
+
+} // LIN_Master_HardwareSerial_STM32::onRxEvent()
+
+
+
+#if (LIN_MASTER_STM32_RX_EVENT_CALLBACK)
+
+/**
+  rief      HAL UART reception event callback
+  \details    HAL UART reception event callback (half transfer, transfer complete or idle line of HAL_UARTEx_ReceiveToIdle_DMA()).
+              Overrides weak HAL default. Set LIN_MASTER_STM32_RX_EVENT_CALLBACK to 0, if the application defines it
+  \param[in]  huart     HAL UART handle of event
+  \param[in]  Size      number of bytes received since start of reception
+*/
+extern "C" void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+  LIN_Master_HardwareSerial_STM32::onRxEvent(huart, Size);
+
+} // HAL_UARTEx_RxEventCallback()
+
+#endif // LIN_MASTER_STM32_RX_EVENT_CALLBACK
+
 #endif // _LIN_MASTER_HW_SERIAL_STM32_H_
 
 /*-----------------------------------------------------------------------------
@@ -2,12 +2,21 @@
   \file     LIN_master_HardwareSerial_STM32.h
   \brief    LIN master emulation library using a HardwareSerial interface of STM32
   \details  This library provides a master node emulation for a LIN bus via a HardwareSerial interface of STM32, optionally via RS485.
+            Optionally the BREAK is generated by the LIN mode of the USART, see setNativeBreak(), and frames are sent
+            and received via DMA, see setDMA(). With DMA, frames are sent via HAL_UART_Transmit_DMA() and received via
+            HAL_UARTEx_ReceiveToIdle_DMA(). The BREAK echo, echo and checksum checks and frame completion are handled in
+            HAL_UARTEx_RxEventCallback() (transfer complete, half transfer or idle line), i.e. a few interrupts per frame
+            instead of one per byte, and handler() only checks the frame timeout. The DMA channels must be initialized by
+            the application in normal mode (not circular) with their IRQ handlers calling HAL_DMA_IRQHandler(). On devices
+            with D-cache (e.g. STM32F7, STM32H7) the Tx buffer is cleaned and the cache line aligned Rx DMA buffer is
+            invalidated, i.e. the LIN instance must be statically allocated in DMA accessible RAM.
+            The host build uses a mocked USART register block, UART HAL with DMA and D-cache.
             For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
   \author   Georg Icking-Konert
 */
 
-// assert STM32 platform
-#if defined(ARDUINO_ARCH_STM32)
+// assert STM32 platform (or host build with mocked USART)
+#if defined(ARDUINO_ARCH_STM32) || defined(ARDUINO_ARCH_HOST)
 
 /*-----------------------------------------------------------------------------
   MODULE DEFINITION FOR MULTIPLE INCLUSION
@@ -29,7 +38,9 @@
 -----------------------------------------------------------------------------*/
 
 /// account for breaking change in v3.0.0 for Serial, see https://github.com/stm32duino/Arduino_Core_STM32/releases/tag/3.0.0
-#if defined(STM32_CORE_VERSION_MAJOR)
+#if defined(ARDUINO_ARCH_HOST)
+  #define HWSERIAL HardwareSerial
+#elif defined(STM32_CORE_VERSION_MAJOR)
   #if (STM32_CORE_VERSION_MAJOR >= 3)
     #define HWSERIAL Uart
   #else
@@ -40,6 +51,21 @@
 #endif
 
 
+// D-cache maintenance of DMA buffers, e.g. STM32F7, STM32H7
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+  #define LIN_MASTER_STM32_DCACHE                       //!< clean Tx and invalidate Rx DMA buffer
+  #define LIN_MASTER_STM32_DMA_ALIGN    32              //!< alignment [bytes] of Rx DMA buffer, i.e. D-cache line size
+#else
+  #define LIN_MASTER_STM32_DMA_ALIGN    4               //!< alignment [bytes] of Rx DMA buffer
+#endif
+#define LIN_MASTER_STM32_DMA_BUFLEN   (((12 + LIN_MASTER_STM32_DMA_ALIGN - 1) / LIN_MASTER_STM32_DMA_ALIGN) * LIN_MASTER_STM32_DMA_ALIGN)  //!< size of Rx DMA buffer (whole cache lines)
+
+// define HAL_UARTEx_RxEventCallback() for DMA. Set to 0, if the application defines it and calls onRxEvent() from there
+#if !defined(LIN_MASTER_STM32_RX_EVENT_CALLBACK)
+  #define LIN_MASTER_STM32_RX_EVENT_CALLBACK  1
+#endif
+
+
 /*-----------------------------------------------------------------------------
   GLOBAL CLASS
 -----------------------------------------------------------------------------*/
@@ -58,10 +84,31 @@ class LIN_Master_HardwareSerial_STM32 : public LIN_Master_Base
     uint32_t              pinRx;              //!< pin used for receive
     uint32_t              pinTx;              //!< pin used for transmit
     uint32_t              brr;                //!< BRR value if LIN mode is not available
+    bool                  nativeBreak;        //!< generate BREAK via LIN mode of USART (SBKRQ)
+    DMA_HandleTypeDef     *hdmaTx;            //!< optional DMA for sending, see setDMA()
+    DMA_HandleTypeDef     *hdmaRx;            //!< optional DMA for receiving, see setDMA()
+    bool                  useDma;             //!< frames via DMA and Rx event callback, see begin()
+    uint8_t               ofsDma;             //!< index in bufDma of ongoing DMA reception
+    uint8_t               idxDma;             //!< number of bytes in bufDma already processed
+    LIN_Master_HardwareSerial_STM32 *pNextDma; //!< next node with DMA, see onRxEvent()
+    static LIN_Master_HardwareSerial_STM32 *pFirstDma;  //!< first node with DMA, see onRxEvent()
+    uint8_t               bufDma[LIN_MASTER_STM32_DMA_BUFLEN] __attribute__((aligned(LIN_MASTER_STM32_DMA_ALIGN)));  //!< Rx DMA buffer. Not bufRx, as with D-cache it occupies whole cache lines
     
   // PROTECTED METHODS
   protected:
   
+    /// @brief Send bytes via DMA or Serial.write()
+    void _send(const uint8_t *Data, uint8_t Num);
+
+    /// @brief Start DMA reception of BREAK echo or rest of frame
+    void _startRx(void);
+
+    /// @brief Handle DMA reception event in interrupt context
+    void _onRxEvent(uint16_t Size);
+
+    /// @brief Check for frame timeout with DMA
+    void _checkTimeout(void);
+
     /// @brief Send LIN break
     LIN_Master_Base::state_t _sendBreak(void);
 
@@ -80,11 +127,20 @@ class LIN_Master_HardwareSerial_STM32 : public LIN_Master_Base
       const char NameLIN[] = "Master", const int8_t PinTxEN = INT8_MIN);
      
     /// @brief Open serial interface
-    void begin(uint16_t Baudrate = 19200);
+    void begin(uint32_t Baudrate = 19200);
     
     /// @brief Close serial interface
     void end(void);
 
+    /// @brief Generate BREAK via LIN mode of USART instead of 0x00 at 1/2 baudrate (call before begin())
+    inline void setNativeBreak(bool Enable) { this->nativeBreak = Enable; }
+
+    /// @brief Send and receive frames via DMA (call before begin()). DMA channels must be initialized in normal mode, see above (NULL = no DMA)
+    inline void setDMA(DMA_HandleTypeDef *DmaTx, DMA_HandleTypeDef *DmaRx) { this->hdmaTx = DmaTx; this->hdmaRx = DmaRx; }
+
+    /// @brief Dispatch DMA reception event to node using the UART. Call from HAL_UARTEx_RxEventCallback(), see LIN_MASTER_STM32_RX_EVENT_CALLBACK
+    static void onRxEvent(UART_HandleTypeDef *huart, uint16_t Size);
+
 }; // class LIN_master_HardwareSerial_STM32
 
 
@@ -93,7 +149,7 @@ class LIN_Master_HardwareSerial_STM32 : public LIN_Master_Base
 -----------------------------------------------------------------------------*/
 #endif // _LIN_MASTER_HW_SERIAL_STM32_H_
 
-#endif // ARDUINO_ARCH_STM32
+#endif // ARDUINO_ARCH_STM32 || ARDUINO_ARCH_HOST
 
 /*-----------------------------------------------------------------------------
     END OF FILE
@@ -0,0 +1,200 @@
+/**
+  \file     LIN_master_LDF.h
+  \brief    Runtime support for tables generated from a LIN Description File (LDF)
+  \details  The host tool extras/host/tools/LIN_ldf_gen.cpp converts an LDF into a header with constexpr tables of frames
+            (LIN_Master_Base::descriptor_t with precomputed PID, checksum seed, lengths and timeout), signals (frame,
+            bit offset, width, encoding, init value), signal encodings and schedule tables (LIN_Master_Base::schedule_t).
+            All static tables are stored in flash (PROGMEM on AVR), i.e. there is no runtime parsing and no RAM is used
+            except for the frame data buffers. Frames are started via startFrame() or queueFrame() and schedule tables
+            via setSchedule_P(). This header only provides the types and the compile-time and signal access helpers.
+            Signals are packed little endian like specified by LIN, i.e. bit 0 is the LSB of the 1st data byte.
+            getRaw()/setRaw() read the layout at runtime, e.g. for signals selected by index. For fixed signals the generated
+            header additionally provides compile-time layouts and per frame a struct with pack()/unpack(), see LIN_master_Signal.h
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_LDF_H_
+#define _LIN_MASTER_LDF_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries. Only types are used from base class
+#include <LIN_master_Base.h>
+#include <LIN_master_Signal.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+// only AVR has a separate flash address space. For other cores PROGMEM is usually defined empty
+#if !defined(PROGMEM)
+  #define PROGMEM
+#endif
+
+#define LIN_MASTER_LDF_NO_ENCODING    0xFF      //!< signal has no encoding, see signal_t
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Types and helpers for tables generated from a LIN Description File
+
+  \details Types and helpers for tables generated from a LIN Description File. All methods are static.
+*/
+class LIN_Master_LDF
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// signal in a frame. Scalar signals have max. 32 bit, byte arrays max. 64 bit
+    typedef struct
+    {
+      uint8_t                     frame;        //!< index of frame in generated frame table
+      uint8_t                     start;        //!< bit offset in frame data (0..63)
+      uint8_t                     width;        //!< signal width [bit] (1..64)
+      uint8_t                     encoding;     //!< index in generated encoding table (LIN_MASTER_LDF_NO_ENCODING = none)
+      uint32_t                    init;         //!< initial raw value (scalar signals only)
+    } signal_t;
+
+
+    /// physical encoding of a signal, i.e. physical = offset + scale * raw for raw in [min, max]
+    typedef struct
+    {
+      uint32_t                    min;          //!< min. raw value
+      uint32_t                    max;          //!< max. raw value
+      float                       scale;        //!< scaling factor
+      float                       offset;       //!< offset
+    } encoding_t;
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Protected identifier, i.e. parity bits P0=ID0^ID1^ID2^ID4 and P1=~(ID1^ID3^ID4^ID5). Same as LIN_Master_Base
+    static constexpr uint8_t pid(uint8_t Id)
+    {
+      return (uint8_t) ((Id & 0x3F)
+        | ((((Id) ^ (Id >> 1) ^ (Id >> 2) ^ (Id >> 4)) & 0x01) << 6)
+        | ((~((Id >> 1) ^ (Id >> 3) ^ (Id >> 4) ^ (Id >> 5)) & 0x01) << 7));
+
+    } // pid()
+
+    /// @brief Checksum seed, i.e. PID for enhanced checksum and 0 for classic checksum (LIN1.x and diagnostic frames)
+    static constexpr uint8_t chkSeed(LIN_Master_Base::version_t Version, uint8_t Id)
+    {
+      return ((Version == LIN_Master_Base::LIN_V1) || (Id == 0x3C) || (Id == 0x3D)) ? 0x00 : pid(Id);
+
+    } // chkSeed()
+
+    /// @brief Frame descriptor at compile time. Yields the same as LIN_Master_Base::prepareFrame() after begin(Baudrate) with PROFILE_STANDARD
+    static constexpr LIN_Master_Base::descriptor_t frame(LIN_Master_Base::frame_t Type, LIN_Master_Base::version_t Version,
+      uint8_t Id, uint8_t NumData, uint32_t Baudrate)
+    {
+      return { Type, Version, Id, pid(Id), chkSeed(Version, Id),
+        (uint8_t) ((Type == LIN_Master_Base::MASTER_REQUEST) ? NumData + 4 : 3),
+        (uint8_t) (NumData + 4),
+        (uint32_t) (((NumData + 5) * ((10000000L + Baudrate - 1) / Baudrate)) * 2) };
+
+    } // frame()
+
+
+    /// @brief Copy table entry from flash (PROGMEM) to RAM
+    template <typename T> static inline T read_P(const T *Addr)
+    {
+      T   tmp;
+
+      #if defined(__AVR__)
+        memcpy_P(&tmp, Addr, sizeof(T));
+      #else
+        memcpy(&tmp, Addr, sizeof(T));
+      #endif
+      return tmp;
+
+    } // read_P()
+
+
+    /// @brief Raw value of a scalar signal (max. 32 bit) from frame data
+    static inline uint32_t getRaw(const LIN_Master_LDF::signal_t &Signal, const uint8_t Data[])
+    {
+      uint8_t   first = Signal.start >> 3;
+      uint8_t   last  = (uint8_t) (Signal.start + Signal.width - 1) >> 3;
+      uint64_t  raw = 0;
+
+      // collect affected bytes, MSB first
+      for (int8_t i = last; i >= first; i--)
+        raw = (raw << 8) | Data[i];
+
+      // align and mask
+      raw >>= (Signal.start & 0x07);
+      return (uint32_t) raw & LIN_Master_LDF::_mask(Signal.width);
+
+    } // getRaw()
+
+    /// @brief Set raw value of a scalar signal (max. 32 bit) in frame data. Other signals are not changed
+    static inline void setRaw(const LIN_Master_LDF::signal_t &Signal, uint8_t Data[], uint32_t Value)
+    {
+      uint8_t   first = Signal.start >> 3;
+      uint8_t   last  = (uint8_t) (Signal.start + Signal.width - 1) >> 3;
+      uint64_t  mask  = (uint64_t) LIN_Master_LDF::_mask(Signal.width) << (Signal.start & 0x07);
+      uint64_t  raw   = ((uint64_t) Value << (Signal.start & 0x07)) & mask;
+
+      // read-modify-write affected bytes, LSB first
+      for (uint8_t i = first; i <= last; i++)
+      {
+        Data[i] = (uint8_t) ((Data[i] & ~mask) | raw);
+        mask >>= 8;
+        raw  >>= 8;
+      }
+
+    } // setRaw()
+
+
+    /// @brief Physical value of a raw value
+    static inline float toPhysical(const LIN_Master_LDF::encoding_t &Encoding, uint32_t Raw)
+    {
+      return Encoding.offset + Encoding.scale * (float) Raw;
+
+    } // toPhysical()
+
+    /// @brief Raw value of a physical value, rounded and limited to [min, max]
+    static inline uint32_t toRaw(const LIN_Master_LDF::encoding_t &Encoding, float Value)
+    {
+      float raw = (Encoding.scale != 0.0f) ? (Value - Encoding.offset) / Encoding.scale : 0.0f;
+
+      if (raw <= (float) Encoding.min)
+        return Encoding.min;
+      if (raw >= (float) Encoding.max)
+        return Encoding.max;
+      return (uint32_t) (raw + 0.5f);
+
+    } // toRaw()
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Bitmask for signal width (1..32)
+    static constexpr uint32_t _mask(uint8_t Width)
+    {
+      return (Width >= 32) ? 0xFFFFFFFFUL : ((1UL << Width) - 1);
+
+    } // _mask()
+
+}; // class LIN_Master_LDF
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_LDF_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,426 @@
+/**
+  \file     LIN_master_NeoHWSerial_AVR.h
+  \brief    LIN master emulation library using the per-byte Rx interrupt of NeoHWSerial on AVR
+  \details  This library provides a master node emulation for a LIN bus via NeoHWSerial on AVR, optionally via RS485.
+            Unlike LIN_Master_HardwareSerial, each received byte is passed from the UART Rx ISR (see
+            NeoHWSerial::attachInterrupt()) directly to the LIN state machine, i.e. the Rx ring buffer is bypassed.
+            The BREAK echo, echo and checksum checks and frame completion are handled in the ISR, i.e. the frame is
+            completed at the stop bit of the last byte instead of at the next handler() call. handler() only checks
+            the frame timeout and calls the optional completion and change callbacks.
+            The BREAK is sent at 1/2 baudrate via the UBRRn register, which is also restored from the ISR.
+            Is header-only, i.e. NeoHWSerial is only linked if this file is included. The index of NeoSerialN is passed
+            to the constructor, i.e. only the used NeoSerialN and its ISRs are linked. On AVR, NeoHWSerial can't be
+            used together with HardwareSerial (Serial, Serial1,...), see LIN_MASTER_DEBUG_SERIAL. The host build uses
+            a mocked NeoHWSerial. For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     Don't call the LIN_Master_Base methods which wait for frame completion (e.g. sendMasterRequestBlocking()) with
+            interrupts disabled
+  \author   Georg Icking-Konert
+*/
+
+// assert AVR platform (or host build with mocked NeoHWSerial)
+#if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_HOST)
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_NEOHWSERIAL_AVR_H_
+#define _LIN_MASTER_NEOHWSERIAL_AVR_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <LIN_master_Base.h>
+#include <NeoHWSerial.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+// UART baudrate register for BREAK generation
+#if defined(ARDUINO_ARCH_HOST)
+  #define LIN_MASTER_NEOSERIAL_BAUDREG_T    uint32_t      //!< type of mock baudrate register, see HardwareSerial::getBaudRegister()
+  #define LIN_MASTER_NEOSERIAL_BAUDREG_MAX  0xFFFFFFFF    //!< max. value of mock baudrate register
+#else
+  #define LIN_MASTER_NEOSERIAL_BAUDREG_T    uint16_t      //!< type of UBRRn
+  #define LIN_MASTER_NEOSERIAL_BAUDREG_MAX  0x0FFF        //!< max. value of UBRRn (12 bit)
+  #define LIN_MASTER_NEOSERIAL_BAUDREG_SPLIT              //!< UBRRnH and UBRRnL are accessed bytewise, as they are not adjacent on all devices (e.g. ATmega8 UBRRH shares address with UCSRC)
+#endif
+
+#define LIN_MASTER_NEOSERIAL_NUM            4             //!< max. number of UARTs (NeoSerial, NeoSerial1..3)
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+
+#if defined(ARDUINO_ARCH_AVR)
+
+  /// access baudrate register of NeoHWSerial, which stores the UART only in protected members. UBRRnH and UBRRnL are not adjacent on all devices
+  class LIN_Master_NeoSerialAccess : public NeoHWSerial
+  {
+    public:
+      volatile uint8_t *getBaudRegisterH(void) { return this->_ubrrh; }
+      volatile uint8_t *getBaudRegister(void) { return this->_ubrrl; }
+  };
+
+#endif
+
+
+/**
+  \brief  LIN master node class via NeoHWSerial with per-byte Rx interrupt
+
+  \details LIN master node class via NeoHWSerial with per-byte Rx interrupt (AVR only).
+*/
+class LIN_Master_NeoHWSerial_AVR : public LIN_Master_Base
+{
+  // PROTECTED VARIABLES
+  protected:
+
+    NeoHWSerial           *pSerial;           //!< serial interface used for LIN
+    uint8_t               idxSerial;          //!< index N of NeoSerialN for Rx ISR, see constructor
+    #if defined(LIN_MASTER_NEOSERIAL_BAUDREG_SPLIT)
+      volatile uint8_t    *pBaudRegH;         //!< UART baudrate register high byte (UBRRnH)
+      volatile uint8_t    *pBaudReg;          //!< UART baudrate register low byte (UBRRnL)
+    #else
+      volatile LIN_MASTER_NEOSERIAL_BAUDREG_T *pBaudReg;  //!< UART baudrate register
+    #endif
+    LIN_MASTER_NEOSERIAL_BAUDREG_T  baudRegNominal;   //!< register value for nominal baudrate
+    LIN_MASTER_NEOSERIAL_BAUDREG_T  baudRegBreak;     //!< register value for 1/2 baudrate (BREAK)
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Node attached to Rx ISR of each NeoSerialN. Function-local static, as header-only
+    static inline LIN_Master_NeoHWSerial_AVR **_nodes(void)
+    {
+      static LIN_Master_NeoHWSerial_AVR *nodes[LIN_MASTER_NEOSERIAL_NUM];
+      return nodes;
+
+    } // _nodes()
+
+    /// @brief Rx ISR of NeoSerialN. Passes byte to attached node, never stores it in ring buffer
+    template <uint8_t Idx> static bool _isrRx(uint8_t Data, uint8_t Status)
+    {
+      LIN_Master_NeoHWSerial_AVR *node = LIN_Master_NeoHWSerial_AVR::_nodes()[Idx];
+      if (node != NULL)
+        node->_onReceive(Data, Status);
+      return false;
+
+    } // _isrRx()
+
+    /// @brief Write UART baudrate register. Transmitter must be idle
+    inline void _setBaudRegister(LIN_MASTER_NEOSERIAL_BAUDREG_T Value)
+    {
+      #if defined(LIN_MASTER_NEOSERIAL_BAUDREG_SPLIT)
+        *(this->pBaudRegH) = (uint8_t) (Value >> 8);          // UBRRnH first (URSEL=0 on ATmega8), write of UBRRnL updates prescaler
+        *(this->pBaudReg)  = (uint8_t) Value;
+      #else
+        *(this->pBaudReg) = Value;
+      #endif
+
+    } // _setBaudRegister()
+
+    /// @brief Handle received byte in Rx ISR
+    inline void _onReceive(uint8_t Data, uint8_t Status);
+
+    /// @brief Check for frame timeout
+    inline void _checkTimeout(void);
+
+    /// @brief Send LIN break
+    inline LIN_Master_Base::state_t _sendBreak(void);
+
+    /// @brief Check BREAK timeout. Rest of frame is sent by Rx ISR
+    inline LIN_Master_Base::state_t _sendFrame(void);
+
+    /// @brief Check frame timeout. Frame is received and checked by Rx ISR
+    inline LIN_Master_Base::state_t _receiveFrame(void);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor. Index is N of NeoSerialN (0..3), e.g. 1 for NeoSerial1
+    LIN_Master_NeoHWSerial_AVR(NeoHWSerial &Interface, uint8_t Index, const char NameLIN[] = "Master",
+      const int8_t PinTxEN = INT8_MIN) : LIN_Master_Base::LIN_Master_Base(NameLIN, PinTxEN)
+    {
+      // Debug serial initialized in begin() -> no debug output here
+
+      // store pointer to used serial and its index. Don't compare with &NeoSerialN, which would link all of them
+      this->pSerial   = &Interface;
+      this->idxSerial = Index;
+      this->pBaudReg  = NULL;
+
+    } // LIN_Master_NeoHWSerial_AVR()
+
+    /// @brief Open serial interface and attach Rx ISR
+    inline void begin(uint32_t Baudrate = 19200);
+
+    /// @brief Detach Rx ISR and close serial interface
+    inline void end(void);
+
+}; // class LIN_Master_NeoHWSerial_AVR
+
+
+
+/*-----------------------------------------------------------------------------
+  METHOD DEFINITIONS (header-only)
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief      Handle received byte in Rx ISR
+  \details    Handle received byte in Rx ISR. BREAK echo: restore nominal baudrate and send rest of frame. Else store
+              and check byte, see LIN_Master_Base::_receiveByte(). Bytes outside of a frame are discarded.
+              UART errors (Status) are detected via echo or checksum. State is volatile, and optional trace and timing
+              statistics are locked against handler(), see LIN_MASTER_CRITICAL_BEGIN()
+  \param[in]  Data        received byte
+  \param[in]  Status      UART status (UCSRnA), ignored
+*/
+inline void LIN_Master_NeoHWSerial_AVR::_onReceive(uint8_t Data, uint8_t Status)
+{
+  (void) Status;
+
+  // remember progress for optional timing statistics and trace
+  LIN_Master_Base::state_t  statePrev = this->state;
+
+  // BREAK echo
+  if (this->state == LIN_Master_Base::STATE_BREAK)
+  {
+    // store and check BREAK echo. Transmitter is idle after echo -> restore nominal baudrate and send rest of frame
+    if (this->_receiveByte(Data) != LIN_Master_Base::STATE_DONE)
+    {
+      this->_setBaudRegister(this->baudRegNominal);
+      this->pSerial->write(this->bufTx+1, this->lenTx-1);
+      this->state = LIN_Master_Base::STATE_BODY;
+    }
+  }
+
+  // echo or slave response. Frame is completed after checksum
+  else if (this->state == LIN_Master_Base::STATE_BODY)
+    this->_receiveByte(Data);
+
+  // no frame ongoing -> discard
+  else
+    return;
+
+  // optionally trace state transitions
+  #if defined(LIN_MASTER_TRACE)
+    if (this->state != statePrev)
+      LIN_TRACE(LIN_Master_Base::TRACE_STATE, this->state, this->error);
+  #else
+    (void) statePrev;
+  #endif
+
+  // optionally record exact timing of received bytes
+  #if defined(LIN_MASTER_TIMING)
+    this->_recordTiming();
+  #endif
+
+} // LIN_Master_NeoHWSerial_AVR::_onReceive()
+
+
+
+/**
+  \brief      Check for frame timeout
+  \details    Check for frame timeout, e.g. missing slave response. Interrupts are disabled, as Rx ISR may progress state
+*/
+inline void LIN_Master_NeoHWSerial_AVR::_checkTimeout(void)
+{
+  noInterrupts();
+  if ((this->state & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY)) && (micros() - this->timeStart > this->timeoutFrame))
+  {
+    // print debug message
+    DEBUG_PRINT(1, "Rx timeout");
+
+    // set error state
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_TIMEOUT);
+    this->state = LIN_Master_Base::STATE_DONE;
+    this->_disableTransmitter();
+  }
+  interrupts();
+
+} // LIN_Master_NeoHWSerial_AVR::_checkTimeout()
+
+
+
+/**
+  \brief      Send LIN break
+  \details    Send LIN break (=16bit low) as 0x00 at 1/2 baudrate. State is set before, as echo is handled by Rx ISR
+  \return     current state of LIN state machine
+*/
+inline LIN_Master_Base::state_t LIN_Master_NeoHWSerial_AVR::_sendBreak(void)
+{
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master_Base::STATE_IDLE)
+  {
+    // print debug message
+    DEBUG_PRINT(1, "wrong state 0x%02X", this->state);
+
+    // set error state and return immediately
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_STATE);
+    this->state = LIN_Master_Base::STATE_DONE;
+    this->_disableTransmitter();
+    return this->state;
+  }
+
+  // wait until transmitter is idle, just in case...
+  this->pSerial->flush();
+
+  // set half baudrate for BREAK
+  this->_setBaudRegister(this->baudRegBreak);
+
+  // optionally enable transmitter
+  this->_enableTransmitter();
+
+  // progress state, then send BREAK (>=13 bit low)
+  this->state = LIN_Master_Base::STATE_BREAK;
+  this->pSerial->write(this->bufTx[0]);
+
+  // print debug message
+  DEBUG_PRINT(3, " ");
+
+  // return state
+  return this->state;
+
+} // LIN_Master_NeoHWSerial_AVR::_sendBreak()
+
+
+
+/**
+  \brief      Check BREAK timeout
+  \details    Check BREAK timeout. Rest of frame is sent by Rx ISR after BREAK echo
+  \return     current state of LIN state machine
+*/
+inline LIN_Master_Base::state_t LIN_Master_NeoHWSerial_AVR::_sendFrame(void)
+{
+  this->_checkTimeout();
+  return this->state;
+
+} // LIN_Master_NeoHWSerial_AVR::_sendFrame()
+
+
+
+/**
+  \brief      Check frame timeout
+  \details    Check frame timeout. Frame is received and checked byte by byte by Rx ISR
+  \return     current state of LIN state machine
+*/
+inline LIN_Master_Base::state_t LIN_Master_NeoHWSerial_AVR::_receiveFrame(void)
+{
+  this->_checkTimeout();
+  return this->state;
+
+} // LIN_Master_NeoHWSerial_AVR::_receiveFrame()
+
+
+
+/**
+  \brief      Open serial interface and attach Rx ISR
+  \details    Open serial interface with specified baudrate, get baudrate register and attach Rx ISR. Interface is kept
+              closed, if the index passed to the constructor is invalid or 1/2 baudrate exceeds the register range
+  \param[in]  Baudrate    communication speed [Baud] (default = 19200)
+*/
+inline void LIN_Master_NeoHWSerial_AVR::begin(uint32_t Baudrate)
+{
+  // call base class method
+  LIN_Master_Base::begin(Baudrate);
+
+  // open serial interface
+  this->pSerial->begin(this->baudrate);
+  while(!(*(this->pSerial))) { }
+
+  // get baudrate register and calculate value for 1/2 baudrate
+  #if defined(ARDUINO_ARCH_HOST)
+    this->pBaudReg = this->pSerial->getBaudRegister();
+  #else
+    this->pBaudRegH = ((LIN_Master_NeoSerialAccess*) this->pSerial)->getBaudRegisterH();
+    this->pBaudReg  = ((LIN_Master_NeoSerialAccess*) this->pSerial)->getBaudRegister();
+  #endif
+  if (this->pBaudReg != NULL)
+  {
+    #if defined(LIN_MASTER_NEOSERIAL_BAUDREG_SPLIT)
+      this->baudRegNominal = ((uint16_t) (*(this->pBaudRegH) & 0x0F) << 8) | *(this->pBaudReg);
+    #else
+      this->baudRegNominal = *(this->pBaudReg);
+    #endif
+    if ((this->baudRegNominal == 0) || (this->baudRegNominal > (LIN_MASTER_NEOSERIAL_BAUDREG_MAX - 1) / 2))
+      this->pBaudReg = NULL;
+    #if defined(ARDUINO_ARCH_AVR)
+      this->baudRegBreak = 2 * this->baudRegNominal + 1;      // baud = F_CPU / (16 or 8 * (UBRR+1))
+    #else
+      this->baudRegBreak = 2 * this->baudRegNominal;          // baud = clock / value
+    #endif
+  }
+
+  // invalid index or no baudrate register -> keep closed
+  if ((this->idxSerial >= LIN_MASTER_NEOSERIAL_NUM) || (this->pBaudReg == NULL))
+  {
+    // print debug message
+    DEBUG_PRINT(1, "interface not supported");
+
+    // close interface
+    this->pSerial->end();
+    LIN_Master_Base::end();
+    return;
+  }
+
+  // attach Rx ISR of this NeoSerialN
+  noInterrupts();
+  LIN_Master_NeoHWSerial_AVR::_nodes()[this->idxSerial] = this;
+  interrupts();
+  switch (this->idxSerial)
+  {
+    case 0:  this->pSerial->attachInterrupt(LIN_Master_NeoHWSerial_AVR::_isrRx<0>); break;
+    case 1:  this->pSerial->attachInterrupt(LIN_Master_NeoHWSerial_AVR::_isrRx<1>); break;
+    case 2:  this->pSerial->attachInterrupt(LIN_Master_NeoHWSerial_AVR::_isrRx<2>); break;
+    default: this->pSerial->attachInterrupt(LIN_Master_NeoHWSerial_AVR::_isrRx<3>); break;
+  }
+
+  // print debug message
+  DEBUG_PRINT(2, "ok");
+
+} // LIN_Master_NeoHWSerial_AVR::begin()
+
+
+
+/**
+  \brief      Detach Rx ISR and close serial interface
+  \details    Detach Rx ISR and close serial interface
+*/
+inline void LIN_Master_NeoHWSerial_AVR::end(void)
+{
+  // call base class method
+  LIN_Master_Base::end();
+
+  // detach Rx ISR, if attached by this node
+  if ((this->idxSerial < LIN_MASTER_NEOSERIAL_NUM) && (LIN_Master_NeoHWSerial_AVR::_nodes()[this->idxSerial] == this))
+  {
+    this->pSerial->detachInterrupt();
+    noInterrupts();
+    LIN_Master_NeoHWSerial_AVR::_nodes()[this->idxSerial] = NULL;
+    interrupts();
+  }
+
+  // close serial interface
+  this->pSerial->end();
+
+  // print debug message
+  DEBUG_PRINT(2, " ");
+
+} // LIN_Master_NeoHWSerial_AVR::end()
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_NEOHWSERIAL_AVR_H_
+
+#endif // ARDUINO_ARCH_AVR || ARDUINO_ARCH_HOST
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,204 @@
+/**
+  \file     LIN_master_Signal.h
+  \brief    Compile-time packing and unpacking of LIN signals in frame data
+  \details  Bit offset and width of a signal are template parameters, i.e. get() and set() compile to straight-line
+            mask/shift code per affected byte without loops or runtime layout data. This is much faster than bit loops
+            especially on 8-bit AVR. A layout of several signals unpacks a complete frame into a struct and packs it back,
+            e.g. after getFrame() or before sendMasterRequest(). Signals are packed little endian like specified by LIN,
+            i.e. bit 0 is the LSB of the 1st data byte. Scalar signals have max. 32 bit. For layouts generated from an LDF
+            see LIN_master_LDF.h
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_SIGNAL_H_
+#define _LIN_MASTER_SIGNAL_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <Arduino.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL MACROS
+-----------------------------------------------------------------------------*/
+
+/// struct member of a layout, see LIN_Master_Layout. Parameters: struct, member, bit offset, width
+#define LIN_MASTER_FIELD(Struct, Member, Start, Width) \
+  LIN_Master_Field<Struct, decltype(Struct::Member), &Struct::Member, LIN_Master_Signal<Start, Width> >
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASSES
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Smallest unsigned type for a signal width. No <type_traits> on AVR
+
+  \details Smallest unsigned type for a signal width (1..32).
+  \tparam  Width   signal width [bit]
+*/
+template <uint8_t Width, bool Byte = (Width <= 8), bool Word = (Width <= 16)> struct LIN_Master_Signal_Type
+  { typedef uint32_t type; typedef uint32_t calc; };
+template <uint8_t Width> struct LIN_Master_Signal_Type<Width, true, true>
+  { typedef uint8_t type; typedef unsigned int calc; };
+template <uint8_t Width> struct LIN_Master_Signal_Type<Width, false, true>
+  { typedef uint16_t type; typedef unsigned int calc; };
+
+
+
+/**
+  \brief  Scalar LIN signal with compile-time bit layout
+
+  \details Scalar LIN signal with compile-time bit layout. All methods are static.
+  \tparam  Start   bit offset in frame data (0..63)
+  \tparam  Width   signal width [bit] (1..32)
+*/
+template <uint8_t Start, uint8_t Width> class LIN_Master_Signal
+{
+  static_assert((Width > 0) && (Width <= 32), "Width must be 1..32");
+  static_assert(Start + Width <= 64, "signal exceeds 8 data bytes");
+
+  // PUBLIC TYPEDEFS
+  public:
+
+    typedef typename LIN_Master_Signal_Type<Width>::type  value_t;    //!< smallest type holding the raw value
+    typedef typename LIN_Master_Signal_Type<Width>::calc  calc_t;     //!< type for shifts w/o overflow or sign
+
+
+  // PUBLIC CONSTANTS
+  public:
+
+    static constexpr uint8_t  first  = Start >> 3;                  //!< index of 1st data byte
+    static constexpr uint8_t  last   = (Start + Width - 1) >> 3;    //!< index of last data byte
+    static constexpr uint8_t  shift  = Start & 0x07;                //!< bit position in 1st data byte
+    static constexpr uint32_t mask   = (Width >= 32) ? 0xFFFFFFFFUL : ((1UL << Width) - 1);  //!< mask of raw value
+
+
+  // PROTECTED TYPES
+  protected:
+
+    /// access to a single data byte. Recursion over bytes is resolved at compile time
+    template <uint8_t Idx, bool End = (Idx > last)> struct _Byte
+    {
+      /// shift of frame byte into raw value. Only one of both is non-zero
+      static constexpr uint8_t rsh = (Idx == first) ? shift : 0;
+      static constexpr uint8_t lsh = (Idx == first) ? 0 : 8 * (Idx - first) - shift;
+
+      /// mask of signal bits in this byte
+      static constexpr uint8_t bits = (uint8_t) ((mask << rsh) >> lsh);
+
+      /// collect bits of this and following bytes
+      static inline calc_t get(const uint8_t Data[])
+      {
+        return (((calc_t) Data[Idx] >> rsh) << lsh) | _Byte<Idx+1>::get(Data);
+      }
+
+      /// write bits of this and following bytes. Other bits are kept, full bytes are stored directly
+      static inline void set(uint8_t Data[], value_t Value)
+      {
+        uint8_t val = (uint8_t) (((calc_t) Value << rsh) >> lsh);
+        if (bits == 0xFF)
+          Data[Idx] = val;
+        else
+          Data[Idx] = (uint8_t) ((Data[Idx] & (uint8_t) ~bits) | (val & bits));
+        _Byte<Idx+1>::set(Data, Value);
+      }
+    };
+
+    /// end of recursion
+    template <uint8_t Idx> struct _Byte<Idx, true>
+    {
+      static inline calc_t get(const uint8_t Data[]) { (void) Data; return 0; }
+      static inline void set(uint8_t Data[], value_t Value) { (void) Data; (void) Value; }
+    };
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Raw value of signal from frame data
+    static inline value_t get(const uint8_t Data[])
+    {
+      // mask only if last byte contains other signals
+      if (((Start + Width) & 0x07) == 0)
+        return (value_t) _Byte<first>::get(Data);
+      return (value_t) (_Byte<first>::get(Data) & (calc_t) mask);
+
+    } // get()
+
+    /// @brief Set raw value of signal in frame data. Other signals are not changed, excess bits of Value are ignored
+    static inline void set(uint8_t Data[], value_t Value)
+    {
+      _Byte<first>::set(Data, Value);
+
+    } // set()
+
+}; // class LIN_Master_Signal
+
+
+
+/**
+  \brief  Struct member mapped to a LIN signal, see LIN_MASTER_FIELD()
+
+  \details Struct member mapped to a LIN signal. All methods are static.
+  \tparam  Struct  struct holding the unpacked signals
+  \tparam  Type    type of struct member
+  \tparam  Member  pointer to struct member
+  \tparam  Signal  LIN_Master_Signal with bit layout
+*/
+template <typename Struct, typename Type, Type Struct::*Member, class Signal> struct LIN_Master_Field
+{
+  /// copy signal from frame data to struct member
+  static inline void unpack(const uint8_t Data[], Struct &Values) { Values.*Member = (Type) Signal::get(Data); }
+
+  /// copy struct member to signal in frame data
+  static inline void pack(uint8_t Data[], const Struct &Values) { Signal::set(Data, (typename Signal::value_t) (Values.*Member)); }
+};
+
+
+
+/**
+  \brief  Layout of a LIN frame for bulk unpacking into a struct and packing back
+
+  \details Layout of a LIN frame for bulk unpacking into a struct and packing back. All methods are static.
+  \tparam  Struct  struct holding the unpacked signals
+  \tparam  Fields  struct members with bit layout, see LIN_MASTER_FIELD()
+*/
+template <typename Struct, class... Fields> class LIN_Master_Layout
+{
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Unpack all signals from frame data into struct
+    static inline void unpack(const uint8_t Data[], Struct &Values)
+    {
+      // expand parameter pack in order (no fold expressions in C++11)
+      int expand[] = { 0, (Fields::unpack(Data, Values), 0)... };
+      (void) expand;
+
+    } // unpack()
+
+    /// @brief Pack all signals from struct into frame data. Bits w/o signal are not changed
+    static inline void pack(uint8_t Data[], const Struct &Values)
+    {
+      int expand[] = { 0, (Fields::pack(Data, Values), 0)... };
+      (void) expand;
+
+    } // pack()
+
+}; // class LIN_Master_Layout
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_SIGNAL_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -93,7 +93,7 @@ LIN_Master_Base::state_t LIN_master_SoftwareSerial::_sendFrame(void)
     digitalWrite(this->pinTx, this->inverseLogic ? LOW : HIGH);
 
     // assert >=1b BREAK delimiter
-    delayMicroseconds(50);
+    delayMicroseconds(this->durationDelimiter);
         
     // For STM32, listen must be before write
     #if defined(ARDUINO_ARCH_STM32)
@@ -112,9 +112,18 @@ LIN_Master_Base::state_t LIN_master_SoftwareSerial::_sendFrame(void)
     #if !defined(ARDUINO_ARCH_RENESAS) && !defined(ARDUINO_ARCH_STM32)
       this->SWSerial.listen(); 
     #endif
+
+    // emulate echo of bytes which the core doesn't receive, see _receiveFrame(). Completes a master request
+    #if defined(ARDUINO_ARCH_STM32)
+      this->_receiveByte(this->bufTx[0]);
+    #elif !defined(ARDUINO_ARCH_RENESAS)
+      while ((this->state == LIN_Master_Base::STATE_BREAK) && (this->idxRx < this->lenTx))
+        this->_receiveByte(this->bufTx[this->idxRx]);
+    #endif
     
-    // progress state
-    this->state = LIN_Master_Base::STATE_BODY;
+    // progress state, unless frame is already completed
+    if (this->state == LIN_Master_Base::STATE_BREAK)
+      this->state = LIN_Master_Base::STATE_BODY;
   
   } // after BREAK elapsed
 
@@ -130,7 +139,8 @@ LIN_Master_Base::state_t LIN_master_SoftwareSerial::_sendFrame(void)
 
 /**
   \brief      Receive and check LIN frame
-  \details    Receive and check LIN frame (request frame: check echo; response frame: check header echo & checksum)
+  \details    Receive and check LIN frame byte by byte via _receiveByte() (request frame: check echo; response frame:
+              check header echo & checksum)
   \return     current state of LIN state machine
 */
 LIN_Master_Base::state_t LIN_master_SoftwareSerial::_receiveFrame(void)
@@ -148,66 +158,23 @@ LIN_Master_Base::state_t LIN_master_SoftwareSerial::_receiveFrame(void)
     return this->state;
   }
 
-// Renesas core does not support listen()/stopListening() --> receive echo & response
-#if defined(ARDUINO_ARCH_RENESAS)
-
-  // echo + frame body received
-  if (this->SWSerial.available() >= this->lenRx)
-  {  
-    // read into buffer
-    this->SWSerial.readBytes(this->bufRx, this->lenRx);
-
-// STM32 core receives echo w/o BREAK & response
-#elif defined(ARDUINO_ARCH_STM32)
-
-  // echo (w/o BREAK) + frame body received
-  if (this->SWSerial.available() >= this->lenRx-1)
-  {  
-    // read into buffer
-    this->SWSerial.readBytes(this->bufRx+1, this->lenRx-1);
-
-    // emulate only ignored BREAK
-    this->bufRx[0] = this->bufTx[0];
+  // store and check received bytes one by one. Renesas core receives echo & response, STM32 core echo w/o BREAK
+  // & response, other cores only the response. Echo of other bytes is emulated in _sendFrame()
+  while ((this->state == LIN_Master_Base::STATE_BODY) && (this->SWSerial.available()))
+    this->_receiveByte(this->SWSerial.read());
 
-// other cores only receive slave response
-#else
-
-  // only response received
-  if (this->SWSerial.available() >= this->lenRx - this->lenTx) {
-      
-    // read into buffer
-    this->SWSerial.readBytes(this->bufRx + this->lenTx, this->lenRx - this->lenTx);
-
-    // emulate ignored echo for sent bytes (incl. BREAK)
-    memcpy(this->bufRx, this->bufTx, this->lenTx);
-
-#endif // ARDUINO_ARCH_RENESAS
-
-    // check frame for errors
-    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) this->_checkFrame());
+  // frame not yet completed -> check for timeout
+  if ((this->state == LIN_Master_Base::STATE_BODY) && (micros() - this->timeStart > this->timeoutFrame))
+  {
+    // print debug message
+    DEBUG_PRINT(1, "Rx timeout");
 
-    // progress state
+    // set error state and return immediately
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_TIMEOUT);
     this->state = LIN_Master_Base::STATE_DONE;
-
-  } // frame body received
-  
-  // frame body received not yet received
-  else
-  {
-    // check for timeout
-    if (micros() - this->timeStart > this->timeoutFrame)
-    {
-      // print debug message
-      DEBUG_PRINT(1, "Rx timeout");
-
-      // set error state and return immediately
-      this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_TIMEOUT);
-      this->state = LIN_Master_Base::STATE_DONE;
-      this->_disableTransmitter();
-      return this->state;
-    }
-
-  } // not enough bytes received
+    this->_disableTransmitter();
+    return this->state;
+  }
   
   // print debug message
   DEBUG_PRINT(2, " ");
@@ -256,7 +223,7 @@ LIN_Master_Base::state_t LIN_master_SoftwareSerial::_receiveFrame(void)
   \details    Open serial interface with specified baudrate
   \param[in]  Baudrate    communication speed [Baud] (default = 19200)
 */
-void LIN_master_SoftwareSerial::begin(uint16_t Baudrate)
+void LIN_master_SoftwareSerial::begin(uint32_t Baudrate)
 {
   // call base class method
   LIN_Master_Base::begin(Baudrate);
@@ -269,8 +236,17 @@ void LIN_master_SoftwareSerial::begin(uint16_t Baudrate)
     this->SWSerial.begin(this->baudrate);
   #endif
 
-  // calculate duration of BREAK
-  this->durationBreak = this->timePerByte * 16 / 10;
+  // calculate duration of BREAK and delimiter. Fast profile: min. 13 bit BREAK and 1 bit delimiter
+  if (this->profile == LIN_Master_Base::PROFILE_FAST)
+  {
+    this->durationBreak     = this->timePerByte * 13 / 10;
+    this->durationDelimiter = (this->timePerByte + 9) / 10;
+  }
+  else
+  {
+    this->durationBreak     = this->timePerByte * 16 / 10;
+    this->durationDelimiter = 50;
+  }
  
   // print debug message
   DEBUG_PRINT(2, "ok");
@@ -8,7 +8,7 @@
 
 // assert platform which supports SoftwareSerial. Note: ARDUINO_ARCH_ESP32 requires library ESPSoftwareSerial
 #if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_ESP8266) || defined(ARDUINO_ARCH_ESP32) || \
-  defined(ARDUINO_ARCH_MEGAAVR) || defined(ARDUINO_ARCH_STM32) || defined(ARDUINO_ARCH_RENESAS)
+  defined(ARDUINO_ARCH_MEGAAVR) || defined(ARDUINO_ARCH_STM32) || defined(ARDUINO_ARCH_RENESAS) || defined(ARDUINO_ARCH_HOST)
 
 /*-----------------------------------------------------------------------------
   MODULE DEFINITION FOR MULTIPLE INCLUSION
@@ -45,6 +45,7 @@ class LIN_master_SoftwareSerial : public LIN_Master_Base
     bool                  inverseLogic;       //!< use inverse logic
     uint32_t              startBreak;         //!< start time [us] of sync break
     uint32_t              durationBreak;      //!< duration [us] of sync break
+    uint32_t              durationDelimiter;  //!< duration [us] of break delimiter
 
 
   // PROTECTED METHODS
@@ -68,7 +69,7 @@ class LIN_master_SoftwareSerial : public LIN_Master_Base
 
     
     /// @brief Open serial interface
-    void begin(uint16_t Baudrate = 19200);
+    void begin(uint32_t Baudrate = 19200);
     
     /// @brief Close serial interface
     void end(void);
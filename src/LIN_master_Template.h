@@ -0,0 +1,614 @@
+/**
+  \file     LIN_master_Template.h
+  \brief    Compile-time LIN master emulation using a HardwareSerial compatible interface
+  \details  This library provides a lean LIN master node without virtual methods. Serial interface type, max. number of
+            data bytes and request queue size are template parameters, i.e. buffers are sized and all state transitions
+            are inlined at compile time. Use it if the interface is known at compile time and flash/RAM are scarce.
+            Frame, state and error types are shared with LIN_Master_Base, i.e. application code can switch between both.
+            Compared to LIN_Master_Base there is no schedule table, callback, timing statistics, trace or debug output.
+            Break generation uses a reduced baudrate like LIN_Master_HardwareSerial, i.e. is suited e.g. for AVR, megaAVR,
+            SAM and Renesas cores and NeoHWSerial. For ESP32, ESP8266 and STM32 use the respective LIN_Master_HardwareSerial_xxx.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_TEMPLATE_H_
+#define _LIN_MASTER_TEMPLATE_H_
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries. Only types are used from base class
+#include <LIN_master_Base.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Compile-time LIN master node w/o virtual methods
+
+  \details Compile-time LIN master node w/o virtual methods.
+  \tparam  SerialType  serial interface class, e.g. HardwareSerial or NeoHWSerial
+  \tparam  MaxData     max. number of data bytes per frame (1..8). Reduces buffer sizes
+  \tparam  QueueSize   max. number of pending frames in request queue (0 = no queue)
+*/
+template <class SerialType = HardwareSerial, uint8_t MaxData = 8, uint8_t QueueSize = 0>
+class LIN_Master_Template
+{
+  static_assert((MaxData > 0) && (MaxData <= 8), "MaxData must be 1..8");
+
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// pending frame in request queue, see queueFrame()
+    typedef struct
+    {
+      LIN_Master_Base::descriptor_t frame;      //!< prepared frame
+      uint8_t                     data[MaxData];  //!< master request data (not used for slave response)
+    } request_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    // node properties
+    SerialType              *pSerial;           //!< serial interface used for LIN
+    int8_t                  pinTxEN;            //!< optional Tx direction pin, e.g. for LIN via RS485
+    uint32_t                baudrate;           //!< communication baudrate [Baud]
+    LIN_Master_Base::state_t  state;            //!< status of LIN state machine
+    LIN_Master_Base::error_t  error;            //!< error state. Is latched until cleared
+    uint32_t                timePerByte;        //!< time [us] per byte at specified baudrate
+
+    // frame properties
+    LIN_Master_Base::frame_t  type;             //!< LIN frame type
+    uint8_t                 id;                 //!< LIN frame identifier (protected or unprotected)
+    uint8_t                 lenTx;              //!< send buffer length
+    uint8_t                 lenRx;              //!< receive buffer length
+    uint8_t                 idxRx;              //!< index of next received byte in bufRx
+    uint16_t                chkRx;              //!< checksum accumulator of received bytes
+    uint8_t                 bufTx[MaxData+4];   //!< send buffer incl. BREAK, SYNC, DATA and CHK
+    uint8_t                 bufRx[MaxData+4];   //!< receive buffer incl. BREAK, SYNC, DATA and CHK
+    uint32_t                timeStart;          //!< starting time [us] for frame timeout
+    uint32_t                timeoutFrame;       //!< max. frame duration [us]
+
+    // frame request queue (single producer, single consumer)
+    request_t               queueBuf[QueueSize+1];  //!< ring buffer of pending frames (1 entry always unused)
+    volatile uint8_t        queueHead;          //!< index of next free entry. Only written by producer, see queueFrame()
+    volatile uint8_t        queueTail;          //!< index of oldest pending entry. Only written by consumer, see handler()
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Calculate protected frame ID
+    static inline uint8_t _calculatePID(uint8_t Id)
+    {
+      uint8_t pid = Id & 0x3F;
+      uint8_t p0 = ((pid >> 0) ^ (pid >> 1) ^ (pid >> 2) ^ (pid >> 4)) & 0x01;
+      uint8_t p1 = (~((pid >> 1) ^ (pid >> 3) ^ (pid >> 4) ^ (pid >> 5))) & 0x01;
+      return (uint8_t) (pid | (p0 << 6) | (p1 << 7));
+
+    } // _calculatePID()
+
+    /// @brief Add carries to checksum sum and invert
+    static inline uint8_t _foldChecksum(uint16_t Sum)
+    {
+      Sum = (Sum & 0xFF) + (Sum >> 8);
+      Sum = (Sum & 0xFF) + (Sum >> 8);
+      return (uint8_t) (0xFF - ((uint8_t) Sum));
+
+    } // _foldChecksum()
+
+    /// @brief Enable RS485 transmitter (DE=high)
+    inline void _enableTransmitter(void)
+    {
+      if (this->pinTxEN >= 0)
+        digitalWrite(this->pinTxEN, HIGH);
+
+    } // _enableTransmitter()
+
+    /// @brief Disable RS485 transmitter (DE=low)
+    inline void _disableTransmitter(void)
+    {
+      if (this->pinTxEN >= 0)
+        digitalWrite(this->pinTxEN, LOW);
+
+    } // _disableTransmitter()
+
+    /// @brief Finish frame with error
+    inline void _abort(LIN_Master_Base::error_t Error)
+    {
+      this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) Error);
+      this->state = LIN_Master_Base::STATE_DONE;
+      this->_disableTransmitter();
+
+    } // _abort()
+
+    /// @brief Check if prepared frame fits buffers and master request data is given, e.g. for descriptor of LIN_Master_Base
+    static inline bool _isValid(const LIN_Master_Base::descriptor_t &Frame, const uint8_t Data[])
+    {
+      if ((Frame.lenRx < 4) || (Frame.lenRx > MaxData+4) || (Frame.lenTx > Frame.lenRx))
+        return false;
+      return ((Frame.type != LIN_Master_Base::MASTER_REQUEST) || ((Frame.lenTx == Frame.lenRx) &&
+        ((Frame.lenTx == 4) || (Data != NULL))));
+
+    } // _isValid()
+
+    /// @brief Store and check a single received byte, finish frame after last byte
+    inline void _receiveByte(uint8_t Data);
+
+    /// @brief Send LIN break
+    inline void _sendBreak(void);
+
+    /// @brief Send LIN bytes after BREAK echo
+    inline void _sendFrame(void);
+
+    /// @brief Receive and check LIN frame byte by byte
+    inline void _receiveFrame(void);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_Template(SerialType &Interface, const int8_t PinTxEN = INT8_MIN)
+    {
+      this->pSerial   = &Interface;
+      this->pinTxEN   = PinTxEN;
+      this->baudrate  = 19200;
+      this->state     = LIN_Master_Base::STATE_OFF;
+      this->error     = LIN_Master_Base::NO_ERROR;
+      this->queueHead = 0;
+      this->queueTail = 0;
+
+    } // LIN_Master_Template()
+
+    /// @brief Open serial interface
+    inline void begin(uint32_t Baudrate = 19200);
+
+    /// @brief Close serial interface
+    inline void end(void);
+
+    /// @brief Reset LIN state machine
+    inline void resetStateMachine(void) { this->state = LIN_Master_Base::STATE_IDLE; }
+
+    /// @brief Getter for LIN state machine state
+    inline LIN_Master_Base::state_t getState(void) { return this->state; }
+
+    /// @brief Clear error of LIN state machine
+    inline void resetError(void) { this->error = LIN_Master_Base::NO_ERROR; }
+
+    /// @brief Getter for LIN state machine error
+    inline LIN_Master_Base::error_t getError(void) { return this->error; }
+
+    /// @brief Getter for LIN frame
+    inline void getFrame(LIN_Master_Base::frame_t &Type, uint8_t &Id, uint8_t &NumData, uint8_t Data[])
+    {
+      noInterrupts();                         // for data consistency temporarily disable ISRs
+      Type    = this->type;                   // frame type
+      Id      = this->id;                     // frame ID
+      NumData = this->lenRx - 4;              // number of data bytes (excl. BREAK, SYNC, ID, CHK)
+      memcpy(Data, this->bufRx+3, NumData);   // copy data bytes
+      interrupts();                           // re-enable ISRs
+
+    } // getFrame()
+
+    /// @brief Precompute PID, checksum seed, lengths and timeout of a LIN frame (call after begin())
+    inline void prepareFrame(LIN_Master_Base::descriptor_t &Frame, LIN_Master_Base::frame_t Type,
+      LIN_Master_Base::version_t Version = LIN_Master_Base::LIN_V2, uint8_t Id = 0x00, uint8_t NumData = 0);
+
+    /// @brief Start a prepared LIN frame in background
+    inline LIN_Master_Base::state_t startFrame(const LIN_Master_Base::descriptor_t &Frame, const uint8_t Data[] = NULL);
+
+    /// @brief Start sending a LIN master request frame in background
+    inline LIN_Master_Base::state_t sendMasterRequest(LIN_Master_Base::version_t Version = LIN_Master_Base::LIN_V2,
+      uint8_t Id = 0x00, uint8_t NumData = 0, uint8_t Data[] = NULL)
+    {
+      LIN_Master_Base::descriptor_t   frame;
+      this->prepareFrame(frame, LIN_Master_Base::MASTER_REQUEST, Version, Id, NumData);
+      return this->startFrame(frame, Data);
+
+    } // sendMasterRequest()
+
+    /// @brief Send a blocking LIN master request frame
+    inline LIN_Master_Base::error_t sendMasterRequestBlocking(LIN_Master_Base::version_t Version = LIN_Master_Base::LIN_V2,
+      uint8_t Id = 0x00, uint8_t NumData = 0, uint8_t Data[] = NULL)
+    {
+      this->sendMasterRequest(Version, Id, NumData, Data);
+      while (this->handler() != LIN_Master_Base::STATE_DONE);
+      return this->error;
+
+    } // sendMasterRequestBlocking()
+
+    /// @brief Start receiving a LIN slave response frame in background
+    inline LIN_Master_Base::state_t receiveSlaveResponse(LIN_Master_Base::version_t Version = LIN_Master_Base::LIN_V2,
+      uint8_t Id = 0x00, uint8_t NumData = 0)
+    {
+      LIN_Master_Base::descriptor_t   frame;
+      this->prepareFrame(frame, LIN_Master_Base::SLAVE_RESPONSE, Version, Id, NumData);
+      return this->startFrame(frame);
+
+    } // receiveSlaveResponse()
+
+    /// @brief Receive a blocking LIN slave response frame
+    inline LIN_Master_Base::error_t receiveSlaveResponseBlocking(LIN_Master_Base::version_t Version = LIN_Master_Base::LIN_V2,
+      uint8_t Id = 0x00, uint8_t NumData = 0, uint8_t *Data = NULL)
+    {
+      this->receiveSlaveResponse(Version, Id, NumData);
+      while (this->handler() != LIN_Master_Base::STATE_DONE);
+      this->getFrame(this->type, this->id, NumData, Data);
+      return this->error;
+
+    } // receiveSlaveResponseBlocking()
+
+    /// @brief Handle LIN background operation (call until STATE_DONE is returned)
+    inline LIN_Master_Base::state_t handler(void);
+
+    /// @brief Add prepared frame to request queue (only if QueueSize > 0). Safe to call from ISR
+    inline bool queueFrame(const LIN_Master_Base::descriptor_t &Frame, const uint8_t Data[] = NULL);
+
+    /// @brief Number of pending frames in request queue
+    inline uint8_t queueCount(void)
+    {
+      int16_t num = (int16_t) this->queueHead - (int16_t) this->queueTail;
+      return (uint8_t) ((num < 0) ? num + QueueSize + 1 : num);
+
+    } // queueCount()
+
+}; // class LIN_Master_Template
+
+
+
+/*-----------------------------------------------------------------------------
+  TEMPLATE METHODS
+-----------------------------------------------------------------------------*/
+
+/**
+  \brief      Store and check a single received byte
+  \details    Store and check a single received byte (echo or slave response), see LIN_Master_Base::_receiveByte()
+  \param[in]  Data      received byte
+*/
+template <class SerialType, uint8_t MaxData, uint8_t QueueSize>
+inline void LIN_Master_Template<SerialType, MaxData, QueueSize>::_receiveByte(uint8_t Data)
+{
+  uint8_t   idx = this->idxRx;
+
+  // frame already completed or aborted -> ignore byte
+  if ((!(this->state & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY))) || (idx >= this->lenRx))
+    return;
+
+  // store byte
+  this->bufRx[idx] = Data;
+  this->idxRx = idx + 1;
+
+  // echo of sent byte -> check immediately
+  if (idx < this->lenTx)
+  {
+    if (Data != this->bufTx[idx])
+    {
+      this->_abort(LIN_Master_Base::ERROR_ECHO);
+      return;
+    }
+
+    // header of slave response sent -> optionally disable RS485 transmitter
+    if ((idx == this->lenTx-1) && (this->type == LIN_Master_Base::SLAVE_RESPONSE))
+      this->_disableTransmitter();
+  }
+
+  // data byte -> accumulate checksum
+  if ((idx >= 3) && (idx < this->lenRx-1))
+    this->chkRx += (uint16_t) Data;
+
+  // checksum received -> check and finish frame
+  else if (idx == this->lenRx-1)
+  {
+    if (Data != _foldChecksum(this->chkRx))
+      this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_CHK);
+    this->_disableTransmitter();
+    this->state = LIN_Master_Base::STATE_DONE;
+  }
+
+} // LIN_Master_Template::_receiveByte()
+
+
+
+/**
+  \brief      Send LIN break
+  \details    Send LIN break (=1 byte at half baudrate)
+*/
+template <class SerialType, uint8_t MaxData, uint8_t QueueSize>
+inline void LIN_Master_Template<SerialType, MaxData, QueueSize>::_sendBreak(void)
+{
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master_Base::STATE_IDLE)
+  {
+    this->_abort(LIN_Master_Base::ERROR_STATE);
+    return;
+  }
+
+  // empty buffers, just in case...
+  this->pSerial->flush();
+  while (this->pSerial->available())
+    this->pSerial->read();
+
+  // set half baudrate for BREAK
+  this->pSerial->begin(this->baudrate >> 1);
+  while(!(*(this->pSerial)));
+
+  // send BREAK
+  this->_enableTransmitter();
+  this->pSerial->write(this->bufTx[0]);
+  this->state = LIN_Master_Base::STATE_BREAK;
+
+} // LIN_Master_Template::_sendBreak()
+
+
+
+/**
+  \brief      Send LIN bytes after BREAK echo
+  \details    Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID) after BREAK echo was received
+*/
+template <class SerialType, uint8_t MaxData, uint8_t QueueSize>
+inline void LIN_Master_Template<SerialType, MaxData, QueueSize>::_sendFrame(void)
+{
+  // BREAK echo received
+  if (this->pSerial->available())
+  {
+    // store and check BREAK echo. Exit on error
+    this->_receiveByte((uint8_t) this->pSerial->read());
+    if (this->state == LIN_Master_Base::STATE_DONE)
+      return;
+
+    // restore nominal baudrate and send rest of frame
+    this->pSerial->begin(this->baudrate);
+    while(!(*(this->pSerial)));
+    this->pSerial->write(this->bufTx+1, this->lenTx-1);
+    this->state = LIN_Master_Base::STATE_BODY;
+  }
+
+  // check for timeout
+  else if (micros() - this->timeStart > this->timeoutFrame)
+    this->_abort(LIN_Master_Base::ERROR_TIMEOUT);
+
+} // LIN_Master_Template::_sendFrame()
+
+
+
+/**
+  \brief      Receive and check LIN frame byte by byte
+  \details    Receive and check LIN frame byte by byte (request frame: check echo; response frame: check header echo & checksum)
+*/
+template <class SerialType, uint8_t MaxData, uint8_t QueueSize>
+inline void LIN_Master_Template<SerialType, MaxData, QueueSize>::_receiveFrame(void)
+{
+  // process received bytes one at a time
+  int num = this->pSerial->available();
+  while ((num-- > 0) && (this->state == LIN_Master_Base::STATE_BODY))
+    this->_receiveByte((uint8_t) this->pSerial->read());
+
+  // frame not yet completed -> check for timeout
+  if ((this->state == LIN_Master_Base::STATE_BODY) && (micros() - this->timeStart > this->timeoutFrame))
+    this->_abort(LIN_Master_Base::ERROR_TIMEOUT);
+
+} // LIN_Master_Template::_receiveFrame()
+
+
+
+/**
+  \brief      Open serial interface
+  \details    Open serial interface with specified baudrate
+  \param[in]  Baudrate    communication speed [Baud] (default = 19200)
+*/
+template <class SerialType, uint8_t MaxData, uint8_t QueueSize>
+inline void LIN_Master_Template<SerialType, MaxData, QueueSize>::begin(uint32_t Baudrate)
+{
+  // initialize master node properties
+  this->baudrate    = Baudrate;
+  this->error       = LIN_Master_Base::NO_ERROR;
+  this->state       = LIN_Master_Base::STATE_IDLE;
+  this->timePerByte = (10000000L + this->baudrate - 1) / this->baudrate;
+
+  // initialize optional TxEN pin to low (=transmitter off)
+  if (this->pinTxEN >= 0)
+  {
+    digitalWrite(this->pinTxEN, LOW);
+    pinMode(this->pinTxEN, OUTPUT);
+  }
+
+  // open serial interface with optional timeout
+  this->pSerial->begin(this->baudrate);
+  #if defined(LIN_MASTER_LIN_PORT_TIMEOUT) && (LIN_MASTER_LIN_PORT_TIMEOUT > 0)
+    uint32_t startMillis = millis();
+    while ((!(*(this->pSerial))) && (millis() - startMillis < LIN_MASTER_LIN_PORT_TIMEOUT));
+  #else
+    while(!(*(this->pSerial)));
+  #endif
+
+} // LIN_Master_Template::begin()
+
+
+
+/**
+  \brief      Close serial interface
+  \details    Close serial interface and discard pending frames
+*/
+template <class SerialType, uint8_t MaxData, uint8_t QueueSize>
+inline void LIN_Master_Template<SerialType, MaxData, QueueSize>::end(void)
+{
+  this->error     = LIN_Master_Base::NO_ERROR;
+  this->state     = LIN_Master_Base::STATE_OFF;
+  this->queueTail = this->queueHead;
+  this->_disableTransmitter();
+  this->pSerial->end();
+
+} // LIN_Master_Template::end()
+
+
+
+/**
+  \brief      Precompute properties of a LIN frame
+  \details    Precompute PID, checksum seed, buffer lengths and timeout of a LIN frame, see LIN_Master_Base::prepareFrame()
+  \param[out] Frame     prepared frame
+  \param[in]  Type      LIN frame type
+  \param[in]  Version   LIN protocol version (default = v2)
+  \param[in]  Id        frame idendifier (protected or unprotected)
+  \param[in]  NumData   number of data bytes (0..MaxData)
+*/
+template <class SerialType, uint8_t MaxData, uint8_t QueueSize>
+inline void LIN_Master_Template<SerialType, MaxData, QueueSize>::prepareFrame(LIN_Master_Base::descriptor_t &Frame,
+  LIN_Master_Base::frame_t Type, LIN_Master_Base::version_t Version, uint8_t Id, uint8_t NumData)
+{
+  // limit to buffer size
+  if (NumData > MaxData)
+    NumData = MaxData;
+
+  // frame properties
+  Frame.type    = Type;
+  Frame.version = Version;
+  Frame.id      = Id;
+  Frame.pid     = _calculatePID(Id);
+
+  // classic checksum for LIN1.x and diagnostic frames, else enhanced checksum incl. PID
+  Frame.chkSeed = ((Version == LIN_Master_Base::LIN_V1) || (Id == 0x3C) || (Id == 0x3D)) ? 0x00 : Frame.pid;
+
+  // buffer lengths and timeout (= 200% nominal)
+  Frame.lenRx   = NumData + 4;
+  Frame.lenTx   = (Type == LIN_Master_Base::MASTER_REQUEST) ? Frame.lenRx : 3;
+  Frame.timeout = ((Frame.lenRx + 1) * this->timePerByte) * 2;
+
+} // LIN_Master_Template::prepareFrame()
+
+
+
+/**
+  \brief      Start a prepared LIN frame in background
+  \details    Start a prepared LIN frame in background. Background handling is handling by handler().
+              A frame with more than MaxData data bytes, or a master request w/o data, is rejected with ERROR_MISC
+  \param[in]  Frame     frame prepared via prepareFrame()
+  \param[in]  Data      data bytes for master request (not used for slave response)
+  \return     LIN state machine state
+*/
+template <class SerialType, uint8_t MaxData, uint8_t QueueSize>
+inline LIN_Master_Base::state_t LIN_Master_Template<SerialType, MaxData, QueueSize>::startFrame(const LIN_Master_Base::descriptor_t &Frame,
+  const uint8_t Data[])
+{
+  // frame exceeds buffers or data is missing -> reject
+  if (!_isValid(Frame, Data))
+  {
+    this->_abort(LIN_Master_Base::ERROR_MISC);
+    return this->state;
+  }
+
+  // copy frame properties
+  this->type  = Frame.type;
+  this->id    = Frame.id;
+  this->lenTx = Frame.lenTx;
+  this->lenRx = Frame.lenRx;
+
+  // construct Tx frame. Response frame only has header
+  this->bufTx[0] = 0x00;
+  this->bufTx[1] = 0x55;
+  this->bufTx[2] = Frame.pid;
+  if (Frame.type == LIN_Master_Base::MASTER_REQUEST)
+  {
+    uint16_t chk = Frame.chkSeed;
+    for (uint8_t i = 0; i < this->lenTx-4; i++)
+    {
+      this->bufTx[3+i] = Data[i];
+      chk += Data[i];
+    }
+    this->bufTx[this->lenTx-1] = _foldChecksum(chk);
+  }
+
+  // init receive buffer, checksum accumulator and timeout
+  memset(this->bufRx, 0, sizeof(this->bufRx));
+  this->idxRx        = 0;
+  this->chkRx        = Frame.chkSeed;
+  this->timeStart    = micros();
+  this->timeoutFrame = Frame.timeout;
+
+  // start LIN frame by sending a Sync Break
+  this->_sendBreak();
+  return this->state;
+
+} // LIN_Master_Template::startFrame()
+
+
+
+/**
+  \brief      Handle LIN background operation (call until STATE_DONE is returned)
+  \details    Handle LIN background operation. If a request queue is used, the next queued frame is started in the
+              same call in which the previous frame is completed
+  \return     LIN state machine state
+*/
+template <class SerialType, uint8_t MaxData, uint8_t QueueSize>
+inline LIN_Master_Base::state_t LIN_Master_Template<SerialType, MaxData, QueueSize>::handler(void)
+{
+  // act according to current state
+  if (this->state == LIN_Master_Base::STATE_BREAK)
+    this->_sendFrame();
+  else if (this->state == LIN_Master_Base::STATE_BODY)
+    this->_receiveFrame();
+
+  // no frame ongoing -> start next queued frame back-to-back. Is removed at compile time w/o queue
+  if ((QueueSize > 0) && (this->state & (LIN_Master_Base::STATE_IDLE | LIN_Master_Base::STATE_DONE)) && (this->queueTail != this->queueHead))
+  {
+    uint8_t tail = this->queueTail;
+    LIN_MASTER_MEMORY_BARRIER();
+    this->state = LIN_Master_Base::STATE_IDLE;
+    this->error = LIN_Master_Base::NO_ERROR;
+    this->startFrame(this->queueBuf[tail].frame, this->queueBuf[tail].data);
+    LIN_MASTER_MEMORY_BARRIER();
+    this->queueTail = (tail >= QueueSize) ? 0 : tail + 1;
+  }
+
+  // return state machine state
+  return this->state;
+
+} // LIN_Master_Template::handler()
+
+
+
+/**
+  \brief      Add prepared frame to request queue
+  \details    Add prepared frame to lock-free single producer/single consumer request queue, see LIN_Master_Base::queueFrame()
+  \param[in]  Frame     frame prepared via prepareFrame()
+  \param[in]  Data      data bytes for master request (not used for slave response)
+  \return     true if frame was queued, false if queue is full or not used, or frame is rejected (see startFrame())
+*/
+template <class SerialType, uint8_t MaxData, uint8_t QueueSize>
+inline bool LIN_Master_Template<SerialType, MaxData, QueueSize>::queueFrame(const LIN_Master_Base::descriptor_t &Frame, const uint8_t Data[])
+{
+  uint8_t   head = this->queueHead;
+  uint8_t   next = (head >= QueueSize) ? 0 : head + 1;
+
+  // queue full or not used, frame exceeds buffers or data is missing -> return immediately
+  if ((next == this->queueTail) || (!_isValid(Frame, Data)))
+    return false;
+
+  // copy frame to free entry and publish it
+  this->queueBuf[head].frame = Frame;
+  if ((Frame.type == LIN_Master_Base::MASTER_REQUEST) && (Frame.lenTx > 4))
+    memcpy(this->queueBuf[head].data, Data, Frame.lenTx-4);
+  LIN_MASTER_MEMORY_BARRIER();
+  this->queueHead = next;
+
+  return true;
+
+} // LIN_Master_Template::queueFrame()
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_TEMPLATE_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
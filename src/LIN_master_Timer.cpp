@@ -0,0 +1,445 @@
+/**
+  \file     LIN_master_Timer.cpp
+  \brief    Timer interrupt driven background operation of a LIN master node
+  \details  This library calls LIN_Master_Base::handler() from a one-shot hardware timer, which is re-armed at the next
+            deadline of the node (end of BREAK, end of frame, timeout, next schedule slot). Frames are thus completed
+            independent of loop() latency, e.g. during Serial prints or SD writes.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// assert platform with supported hardware timer
+#if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_STM32) || defined(ARDUINO_ARCH_HOST)
+
+// include files
+#include <LIN_master_Timer.h>
+
+
+/**************************
+ * LOCAL MACROS
+**************************/
+
+// AVR Timer1 interrupt registers: TIMSK1/TIFR1 (e.g. ATmega328P, ATmega2560) or TIMSK/TIFR (e.g. ATmega8/16/32)
+#if defined(ARDUINO_ARCH_AVR) && defined(TCCR1B) && defined(OCIE1A)
+  #if defined(TIMSK1)
+    #define TIMER1_TIMSK      TIMSK1
+    #define TIMER1_TIFR       TIFR1
+  #elif defined(TIMSK)
+    #define TIMER1_TIMSK      TIMSK
+    #define TIMER1_TIFR       TIFR
+  #endif
+#endif
+
+
+/**************************
+ * STATIC VARIABLES
+**************************/
+
+LIN_Master_Timer *LIN_Master_Timer::pInstance = NULL;
+
+
+
+/**************************
+ * LOCAL FUNCTIONS
+**************************/
+
+#if defined(TIMER1_TIMSK)
+
+  /**
+    \brief      AVR Timer1 compare match ISR
+    \details    AVR Timer1 compare match ISR. As the library is linked as archive, Timer1 is only claimed if
+                LIN_Master_Timer is used, i.e. it doesn't conflict e.g. with Servo otherwise
+  */
+  ISR(TIMER1_COMPA_vect)
+  {
+    LIN_Master_Timer::isr(LIN_Master_Timer::pInstance);
+
+  } // ISR(TIMER1_COMPA_vect)
+
+#elif defined(ARDUINO_ARCH_STM32) && defined(LIN_MASTER_TIMER_STM32)
+
+  /**
+    \brief      STM32 timer callback
+    \details    STM32 timer callback. HardwareTimer doesn't pass an argument, therefore use active instance
+  */
+  static void _isrSTM32(void)
+  {
+    LIN_Master_Timer::isr(LIN_Master_Timer::pInstance);
+
+  } // _isrSTM32()
+
+#endif // TIMER1_TIMSK / ARDUINO_ARCH_STM32
+
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Start one-shot timer
+  \details    Start one-shot timer, replacing a pending expiry
+  \param[in]  Delay     delay [us] until ISR is called (0 = as soon as possible)
+*/
+void LIN_Master_Timer::_start(uint32_t Delay)
+{
+  // AVR Timer1 is free running with prescaler 64 -> compare match after delay. Max. 65535 ticks (262ms @ 16MHz), then re-arm
+  #if defined(ARDUINO_ARCH_AVR)
+    #if defined(TIMER1_TIMSK)
+      uint32_t  ticks = (Delay * (F_CPU / 1000000L)) >> 6;
+      if (ticks < 2)
+        ticks = 2;
+      else if (ticks > 65535)
+        ticks = 65535;
+      OCR1A   = TCNT1 + (uint16_t) ticks;
+      TIMER1_TIFR   = (1 << OCF1A);
+      TIMER1_TIMSK |= (1 << OCIE1A);
+    #else
+      (void) Delay;
+    #endif
+
+  // ESP32 high resolution timer
+  #elif defined(ARDUINO_ARCH_ESP32)
+    esp_timer_stop(this->timer);
+    esp_timer_start_once(this->timer, (Delay > 0) ? Delay : 1);
+
+  // STM32 HardwareTimer in microseconds
+  #elif defined(ARDUINO_ARCH_STM32)
+    if (this->pTimer == NULL)
+      return;
+    this->pTimer->pause();
+    this->pTimer->setOverflow((Delay > 0) ? Delay : 1, MICROSEC_FORMAT);
+    this->pTimer->setCount(0);
+    this->pTimer->resume();
+
+  // simulated timer of host build
+  #elif defined(ARDUINO_ARCH_HOST)
+    startTimer(micros() + Delay);
+
+  #endif
+
+} // LIN_Master_Timer::_start()
+
+
+
+/**
+  \brief      Stop one-shot timer
+  \details    Stop one-shot timer, i.e. a pending expiry is discarded
+*/
+void LIN_Master_Timer::_stop(void)
+{
+  #if defined(ARDUINO_ARCH_AVR)
+    #if defined(TIMER1_TIMSK)
+      TIMER1_TIMSK &= ~(1 << OCIE1A);
+    #endif
+  #elif defined(ARDUINO_ARCH_ESP32)
+    esp_timer_stop(this->timer);
+  #elif defined(ARDUINO_ARCH_STM32)
+    if (this->pTimer != NULL)
+      this->pTimer->pause();
+  #elif defined(ARDUINO_ARCH_HOST)
+    stopTimer();
+  #endif
+
+} // LIN_Master_Timer::_stop()
+
+
+
+/**
+  \brief      Re-arm timer at next deadline of LIN node
+  \details    Re-arm timer at next deadline of LIN node, see LIN_Master_Base::getDeadline(). W/o pending deadline,
+              the timer expires after the idle period (e.g. to start queued frames) or is stopped
+*/
+void LIN_Master_Timer::_arm(void)
+{
+  uint32_t  deadline;
+
+  // timer operation stopped -> do nothing
+  if (!this->active)
+    return;
+
+  // next deadline of node. Passed deadline -> as soon as possible
+  if (this->pLIN->getDeadline(deadline))
+  {
+    int32_t   delay = (int32_t) (deadline - micros());
+    this->_start((delay > 0) ? (uint32_t) delay : 0);
+  }
+
+  // no deadline -> poll with idle period or stop
+  else if (this->periodIdle > 0)
+    this->_start(this->periodIdle);
+  else
+    this->_stop();
+
+} // LIN_Master_Timer::_arm()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for timer operation of a LIN node
+  \details    Constructor for timer operation of a LIN node. Timer is started via begin()
+  \param[in]  LIN       LIN node serviced by timer ISR
+*/
+LIN_Master_Timer::LIN_Master_Timer(LIN_Master_Base &LIN)
+{
+  // Debug serial initialized in begin() of node -> no debug output here
+
+  // initialize variables
+  this->pLIN       = &LIN;
+  this->periodIdle = LIN_MASTER_TIMER_IDLE;
+  this->active     = false;
+  this->lockDepth  = 0;
+  this->numCalls   = 0;
+  #if defined(ARDUINO_ARCH_ESP32)
+    this->timer    = NULL;
+    this->mutex    = NULL;
+  #elif defined(ARDUINO_ARCH_STM32)
+    this->pTimer   = NULL;
+  #endif
+
+} // LIN_Master_Timer::LIN_Master_Timer()
+
+
+
+/**
+  \brief      Start timer operation
+  \details    Start timer operation of the LIN node (call after LIN begin()). Afterwards, don't call handler() or
+              start frames directly from loop(), but use queueFrame() or setSchedule(), followed by an optional update().
+  \param[in]  PeriodIdle  timer period [us] w/o pending deadline, i.e. max. latency of queued frames (0 = only via update())
+  \return     true if timer was started, false if hardware timer is not available or used by another instance
+*/
+bool LIN_Master_Timer::begin(uint32_t PeriodIdle)
+{
+  // timer used by other instance
+  if ((LIN_Master_Timer::pInstance != NULL) && (LIN_Master_Timer::pInstance != this))
+  {
+    // print debug message
+    DEBUG_PRINT_STATIC(1, "timer busy");
+
+    return false;
+  }
+
+  // stop pending timer operation
+  this->end();
+  this->periodIdle = PeriodIdle;
+  this->numCalls   = 0;
+
+  // AVR: Timer1 free running with prescaler 64 (normal mode). Not available e.g. on ATtiny.
+  // Note: normal mode disables PWM via Timer1, i.e. analogWrite() on pins 9/10 (ATmega328P) or 11/12 (ATmega2560)
+  #if defined(ARDUINO_ARCH_AVR)
+    #if defined(TIMER1_TIMSK)
+      TCCR1A = 0;
+      TCCR1B = (1 << CS11) | (1 << CS10);
+    #else
+      DEBUG_PRINT_STATIC(1, "no Timer1");
+      return false;
+    #endif
+
+  // ESP32: one-shot timer dispatched from esp_timer task. Mutex instead of noInterrupts(), as task may run on other core
+  #elif defined(ARDUINO_ARCH_ESP32)
+    if ((this->mutex == NULL) && ((this->mutex = xSemaphoreCreateRecursiveMutex()) == NULL))
+    {
+      DEBUG_PRINT_STATIC(1, "xSemaphoreCreateRecursiveMutex() failed");
+      return false;
+    }
+    esp_timer_create_args_t   args;
+    memset(&args, 0, sizeof(args));
+    args.callback        = LIN_Master_Timer::isr;
+    args.arg             = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name            = "LIN";
+    if (esp_timer_create(&args, &(this->timer)) != ESP_OK)
+    {
+      DEBUG_PRINT_STATIC(1, "esp_timer_create() failed");
+      return false;
+    }
+
+  // STM32: hardware timer with update interrupt. Timer can be changed via LIN_MASTER_TIMER_STM32
+  #elif defined(ARDUINO_ARCH_STM32)
+    #if defined(LIN_MASTER_TIMER_STM32)
+      if (this->pTimer == NULL)
+        this->pTimer = new HardwareTimer(LIN_MASTER_TIMER_STM32);
+      this->pTimer->pause();
+      this->pTimer->attachInterrupt(_isrSTM32);
+    #else
+      DEBUG_PRINT_STATIC(1, "no LIN_MASTER_TIMER_STM32");
+      return false;
+    #endif
+
+  // host: simulated timer
+  #elif defined(ARDUINO_ARCH_HOST)
+    attachTimer(LIN_Master_Timer::isr, this);
+
+  #endif
+
+  // activate and arm at next deadline
+  LIN_Master_Timer::pInstance = this;
+  this->active = true;
+  this->update();
+
+  // print debug message
+  DEBUG_PRINT_STATIC(2, "period=%ld", (long) PeriodIdle);
+
+  return true;
+
+} // LIN_Master_Timer::begin()
+
+
+
+/**
+  \brief      Stop timer operation
+  \details    Stop timer operation. An ongoing frame must be completed by calling LIN_Master_Base::handler() from loop()
+*/
+void LIN_Master_Timer::end(void)
+{
+  // not active -> do nothing
+  if (!this->active)
+    return;
+
+  // stop timer
+  this->lock();
+  this->active = false;
+  this->_stop();
+  this->unlock();
+
+  // release timer
+  #if defined(ARDUINO_ARCH_ESP32)
+    esp_timer_delete(this->timer);
+    this->timer = NULL;
+  #elif defined(ARDUINO_ARCH_HOST)
+    attachTimer(NULL, NULL);
+  #endif
+  LIN_Master_Timer::pInstance = NULL;
+
+  // print debug message
+  DEBUG_PRINT_STATIC(2, "calls=%ld", (long) this->numCalls);
+
+} // LIN_Master_Timer::end()
+
+
+
+/**
+  \brief      Re-arm timer at next deadline
+  \details    Re-arm timer at next deadline of the LIN node, e.g. after queueFrame() or setSchedule() to start the
+              frame immediately instead of after the idle period
+*/
+void LIN_Master_Timer::update(void)
+{
+  // for data consistency lock against timer ISR
+  this->lock();
+  this->_arm();
+  this->unlock();
+
+} // LIN_Master_Timer::update()
+
+
+
+/**
+  \brief      Lock LIN node against timer ISR
+  \details    Lock LIN node against timer ISR, e.g. to call setSchedule(), attachCallback() or subscribe() while the
+              timer is active. On ESP32 a recursive mutex is used, as noInterrupts() only masks the current core, while
+              the esp_timer task may run on the other one. Otherwise interrupts are disabled and the previous interrupt
+              state is restored by the outermost unlock(), i.e. locks may be nested and used with interrupts disabled,
+              e.g. in another ISR. Keep locked sections short
+*/
+void LIN_Master_Timer::lock(void)
+{
+  #if defined(ARDUINO_ARCH_ESP32)
+    if (this->mutex != NULL)
+      xSemaphoreTakeRecursive(this->mutex, portMAX_DELAY);
+  #else
+
+    // store interrupt state, then disable interrupts
+    #if defined(ARDUINO_ARCH_AVR)
+      uint8_t state = SREG;
+      cli();
+    #elif defined(ARDUINO_ARCH_STM32)
+      uint32_t state = __get_PRIMASK();
+      __disable_irq();
+    #elif defined(ARDUINO_ARCH_HOST)
+      bool state = interruptsEnabled();
+      noInterrupts();
+    #endif
+
+    // outermost lock stores interrupt state for unlock()
+    if ((this->lockDepth)++ == 0)
+      this->lockState = state;
+
+  #endif
+
+} // LIN_Master_Timer::lock()
+
+
+
+/**
+  \brief      Release lock of LIN node
+  \details    Release lock of LIN node, see lock()
+*/
+void LIN_Master_Timer::unlock(void)
+{
+  #if defined(ARDUINO_ARCH_ESP32)
+    if (this->mutex != NULL)
+      xSemaphoreGiveRecursive(this->mutex);
+  #else
+
+    // not locked or nested lock -> keep interrupts disabled
+    if ((this->lockDepth == 0) || (--(this->lockDepth) > 0))
+      return;
+
+    // outermost lock -> restore interrupt state
+    #if defined(ARDUINO_ARCH_AVR)
+      SREG = this->lockState;
+    #elif defined(ARDUINO_ARCH_STM32)
+      __set_PRIMASK(this->lockState);
+    #elif defined(ARDUINO_ARCH_HOST)
+      if (this->lockState)
+        interrupts();
+    #endif
+
+  #endif
+
+} // LIN_Master_Timer::unlock()
+
+
+
+/**
+  \brief      Timer ISR
+  \details    Timer ISR. Calls handler() of the LIN node and re-arms the timer at the next deadline. Don't call directly.
+              On ESP32 it runs in the esp_timer task and takes the mutex, see lock()
+  \param[in]  Arg       timer instance
+*/
+void LIN_Master_Timer::isr(void *Arg)
+{
+  LIN_Master_Timer  *timer = (LIN_Master_Timer*) Arg;
+
+  // no active instance -> ignore
+  if ((timer == NULL) || (!timer->active))
+    return;
+
+  // service LIN node and re-arm timer. ESP32: lock against loop() on other core
+  #if defined(ARDUINO_ARCH_ESP32)
+    timer->lock();
+    if (timer->active)
+    {
+      timer->pLIN->handler();
+      timer->numCalls++;
+      timer->_arm();
+    }
+    timer->unlock();
+  #else
+    timer->pLIN->handler();
+    timer->numCalls++;
+    timer->_arm();
+  #endif
+
+} // LIN_Master_Timer::isr()
+
+#endif // ARDUINO_ARCH_AVR || ARDUINO_ARCH_ESP32 || ARDUINO_ARCH_STM32 || ARDUINO_ARCH_HOST
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
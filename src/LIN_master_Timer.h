@@ -0,0 +1,147 @@
+/**
+  \file     LIN_master_Timer.h
+  \brief    Timer interrupt driven background operation of a LIN master node
+  \details  This library calls LIN_Master_Base::handler() from a one-shot hardware timer, which is re-armed at the next
+            deadline of the node (end of BREAK, end of frame, timeout, next schedule slot). Frames are thus completed
+            independent of loop() latency, e.g. during Serial prints or SD writes.
+            Timers are 16-bit Timer1 (AVR, conflicts e.g. with Servo and disables PWM on pins 9/10 of ATmega328P),
+            esp_timer (ESP32), HardwareTimer (STM32, default TIM2) or a simulated timer (host build). Timer1 and its
+            ISR are only linked if LIN_Master_Timer is used, as the library is linked as archive (dot_a_linkage).
+            As handler() runs in interrupt context (ESP32: esp_timer task, possibly on the other core), only the
+            lock-free queueFrame() may be used from loop() while the timer is active. Other methods which modify the
+            node, e.g. setSchedule(), attachCallback() or subscribe(), must be enclosed in lock() and unlock().
+            All calls of handler() to the backend are in interrupt context, e.g. flush(), write() and for the BREAK
+            fallback of LIN_Master_HardwareSerial begin(). Therefore don't use LIN_master_SoftwareSerial, whose
+            blocking write() and pin change Rx interrupt don't work from an ISR.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// assert platform with supported hardware timer
+#if defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_STM32) || defined(ARDUINO_ARCH_HOST)
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_TIMER_H_
+#define _LIN_MASTER_TIMER_H_
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#if !defined(LIN_MASTER_TIMER_IDLE)
+  #define LIN_MASTER_TIMER_IDLE         1000          //!< default timer period [us] w/o pending deadline, e.g. to start queued frames
+#endif
+#if !defined(LIN_MASTER_TIMER_STM32) && defined(TIM2)
+  #define LIN_MASTER_TIMER_STM32        TIM2          //!< hardware timer used on STM32. Not all devices have TIM2, e.g. STM32F030
+#endif
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <LIN_master_Base.h>
+#if defined(ARDUINO_ARCH_ESP32)
+  #include <esp_timer.h>
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/semphr.h>
+#endif
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  Timer interrupt driven background operation of a LIN master node
+
+  \details Timer interrupt driven background operation of a LIN master node. Only one instance can be active, as
+           it uses a single hardware timer. Callbacks of the node are called in interrupt context.
+*/
+class LIN_Master_Timer
+{
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Master_Base         *pLIN;              //!< serviced LIN node
+    uint32_t                periodIdle;         //!< timer period [us] w/o pending deadline (0 = stop timer)
+    volatile bool           active;             //!< timer operation is active
+    uint8_t                 lockDepth;          //!< nesting depth of lock()
+    #if defined(ARDUINO_ARCH_AVR)
+      uint8_t               lockState;          //!< SREG before outermost lock()
+    #elif defined(ARDUINO_ARCH_STM32)
+      uint32_t              lockState;          //!< PRIMASK before outermost lock()
+    #elif defined(ARDUINO_ARCH_HOST)
+      bool                  lockState;          //!< interrupts enabled before outermost lock()
+    #endif
+    #if defined(ARDUINO_ARCH_ESP32)
+      esp_timer_handle_t    timer;              //!< ESP32 high resolution timer
+      SemaphoreHandle_t     mutex;              //!< ESP32 lock of node between esp_timer task and loop(), see lock()
+    #elif defined(ARDUINO_ARCH_STM32)
+      HardwareTimer         *pTimer;            //!< STM32 hardware timer
+    #endif
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Start one-shot timer with delay [us]
+    void _start(uint32_t Delay);
+
+    /// @brief Stop one-shot timer
+    void _stop(void);
+
+    /// @brief Re-arm timer at next deadline of LIN node
+    void _arm(void);
+
+
+  // PUBLIC VARIABLES
+  public:
+
+    static LIN_Master_Timer *pInstance;         //!< active instance, used by ISR
+    volatile uint32_t       numCalls;           //!< number of handler() calls from ISR
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_Timer(LIN_Master_Base &LIN);
+
+    /// @brief Start timer operation (call after LIN begin())
+    bool begin(uint32_t PeriodIdle = LIN_MASTER_TIMER_IDLE);
+
+    /// @brief Stop timer operation. Afterwards handler() must be called from loop() again
+    void end(void);
+
+    /// @brief Re-arm timer at next deadline, e.g. after queueFrame() to start the frame immediately
+    void update(void);
+
+    /// @brief Timer operation is active
+    inline bool isActive(void) { return this->active; }
+
+    /// @brief Lock LIN node against timer ISR, e.g. around setSchedule() or attachCallback(). May be nested. Keep short!
+    void lock(void);
+
+    /// @brief Release lock of LIN node, see lock()
+    void unlock(void);
+
+    /// @brief Timer ISR: service LIN node and re-arm timer (don't call directly)
+    static void isr(void *Arg);
+
+}; // class LIN_Master_Timer
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_TIMER_H_
+
+#endif // ARDUINO_ARCH_AVR || ARDUINO_ARCH_ESP32 || ARDUINO_ARCH_STM32 || ARDUINO_ARCH_HOST
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
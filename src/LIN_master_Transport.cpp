@@ -0,0 +1,444 @@
+/**
+  \file     LIN_master_Transport.cpp
+  \brief    LIN diagnostic transport layer on top of a LIN master node
+  \details  This library provides a non-blocking transport layer for diagnostic requests (ID 0x3C) and responses (ID 0x3D)
+            with single, first and consecutive frames and NAD addressing like specified by LIN 2.x.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_master_Transport.h>
+
+
+/**************************
+ * PROTECTED METHODS
+**************************/
+
+/**
+  \brief      Start next master request frame
+  \details    Start next master request frame, i.e. single frame for requests of max. 6 bytes, else first frame
+              followed by consecutive frames. Unused bytes are 0xFF
+*/
+void LIN_Master_Transport::_sendFrame(void)
+{
+  uint16_t  num;
+
+  // NAD and padding
+  memset(this->buf, 0xFF, sizeof(this->buf));
+  this->buf[0] = this->nad;
+
+  // single frame: PCI=0x0L
+  if ((this->idxTx == 0) && (this->lenTx <= 6))
+  {
+    this->buf[1] = (uint8_t) this->lenTx;
+    memcpy(this->buf+2, this->dataTx, this->lenTx);
+    this->idxTx = this->lenTx;
+  }
+
+  // first frame: PCI=0x1L, LEN
+  else if (this->idxTx == 0)
+  {
+    this->buf[1] = 0x10 | (uint8_t) (this->lenTx >> 8);
+    this->buf[2] = (uint8_t) this->lenTx;
+    memcpy(this->buf+3, this->dataTx, 5);
+    this->idxTx = 5;
+    this->seq   = 1;
+  }
+
+  // consecutive frame: PCI=0x2N
+  else
+  {
+    num = this->lenTx - this->idxTx;
+    if (num > 6)
+      num = 6;
+    this->buf[1] = 0x20 | this->seq;
+    memcpy(this->buf+2, this->dataTx + this->idxTx, num);
+    this->idxTx += num;
+    this->seq = (this->seq + 1) & 0x0F;
+  }
+
+  // start frame
+  this->pLIN->resetStateMachine();
+  this->pLIN->resetError();
+  this->frameActive = true;
+  this->pLIN->startFrame(this->frameReq, this->buf);
+
+} // LIN_Master_Transport::_sendFrame()
+
+
+
+/**
+  \brief      Start next slave response frame
+  \details    Start next slave response frame, i.e. poll for the next part of the response
+*/
+void LIN_Master_Transport::_pollFrame(void)
+{
+  this->pLIN->resetStateMachine();
+  this->pLIN->resetError();
+  this->frameActive = true;
+  this->pLIN->startFrame(this->frameResp);
+
+} // LIN_Master_Transport::_pollFrame()
+
+
+
+/**
+  \brief      Evaluate completed LIN frame
+  \details    Evaluate completed LIN frame. After the last request frame switch to response after P2_min.
+              Slave response w/o answer (timeout) means "not ready", i.e. is polled again until timeout
+  \param[in]  Now       micros() of frame completion
+*/
+void LIN_Master_Transport::_evaluateFrame(uint32_t Now)
+{
+  LIN_Master_Base::error_t  err = this->pLIN->getError();
+  LIN_Master_Base::frame_t  type;
+  uint8_t                   id, num;
+  uint8_t                   data[8];
+
+  // request frame sent
+  if (this->state == LIN_Master_Transport::TP_TX)
+  {
+    if (err != LIN_Master_Base::NO_ERROR)
+    {
+      // print debug message
+      DEBUG_PRINT_STATIC(1, "request error 0x%02X", (int) err);
+
+      this->_abort(LIN_Master_Transport::TP_ERROR_FRAME);
+      return;
+    }
+
+    // next consecutive frame after separation time
+    this->timeNext = Now + this->timing.STmin;
+    if (this->idxTx < this->lenTx)
+      return;
+
+    // request complete. Without response buffer done, else wait P2_min before polling response
+    if (this->dataRx == NULL)
+    {
+      this->state = LIN_Master_Transport::TP_DONE;
+      return;
+    }
+    this->state    = LIN_Master_Transport::TP_RX;
+    this->timeNext = Now + this->timing.P2min;
+    this->timeout  = Now + this->timing.P2max;
+    return;
+  }
+
+  // no answer, e.g. slave not ready -> poll again until timeout
+  if (err == LIN_Master_Base::ERROR_TIMEOUT)
+  {
+    if ((int32_t) (Now - this->timeout) >= 0)
+    {
+      // print debug message
+      DEBUG_PRINT_STATIC(1, "response timeout");
+
+      this->_abort(LIN_Master_Transport::TP_ERROR_TIMEOUT);
+    }
+    return;
+  }
+
+  // erroneous response
+  if (err != LIN_Master_Base::NO_ERROR)
+  {
+    // print debug message
+    DEBUG_PRINT_STATIC(1, "response error 0x%02X", (int) err);
+
+    this->_abort(LIN_Master_Transport::TP_ERROR_FRAME);
+    return;
+  }
+
+  // evaluate response
+  this->pLIN->getFrame(type, id, num, data);
+  this->_receiveFrame(data, Now);
+
+} // LIN_Master_Transport::_evaluateFrame()
+
+
+
+/**
+  \brief      Evaluate received slave response frame
+  \details    Evaluate received slave response frame, i.e. check NAD, PCI and sequence number and copy data to
+              response buffer. "Response pending" (NRC 0x78) extends the timeout to P2ext
+  \param[in]  Data      frame data (8 bytes)
+  \param[in]  Now       micros() of frame completion
+*/
+void LIN_Master_Transport::_receiveFrame(const uint8_t Data[], uint32_t Now)
+{
+  uint8_t   pci = Data[1];
+  uint16_t  num;
+
+  // response from wrong NAD
+  if ((Data[0] != this->nad) && (this->nad != LIN_MASTER_TP_NAD_BROADCAST))
+  {
+    // print debug message
+    DEBUG_PRINT_STATIC(1, "wrong NAD 0x%02X", (int) Data[0]);
+
+    this->_abort(LIN_Master_Transport::TP_ERROR_NAD);
+    return;
+  }
+
+  // act according to PCI type
+  switch (pci >> 4)
+  {
+    // single frame: PCI=0x0L
+    case 0x0:
+      num = pci & 0x0F;
+      if ((this->lenRx != 0) || (num == 0) || (num > 6))
+        break;
+
+      // response pending -> wait longer
+      if ((num >= 3) && (Data[2] == 0x7F) && (Data[4] == 0x78))
+      {
+        this->timeout = Now + this->timing.P2ext;
+        return;
+      }
+
+      // copy complete response
+      if (num > this->sizeRx)
+      {
+        this->_abort(LIN_Master_Transport::TP_ERROR_LENGTH);
+        return;
+      }
+      memcpy(this->dataRx, Data+2, num);
+      this->lenRx = num;
+      this->idxRx = num;
+      this->state = LIN_Master_Transport::TP_DONE;
+      return;
+
+    // first frame: PCI=0x1L, LEN
+    case 0x1:
+      num = ((uint16_t) (pci & 0x0F) << 8) | Data[2];
+      if ((this->lenRx != 0) || (num < 7))
+        break;
+      if (num > this->sizeRx)
+      {
+        this->_abort(LIN_Master_Transport::TP_ERROR_LENGTH);
+        return;
+      }
+      memcpy(this->dataRx, Data+3, 5);
+      this->lenRx   = num;
+      this->idxRx   = 5;
+      this->seq     = 1;
+      this->timeout = Now + this->timing.NCr;
+      return;
+
+    // consecutive frame: PCI=0x2N
+    case 0x2:
+      if ((this->lenRx == 0) || ((pci & 0x0F) != this->seq))
+        break;
+      num = this->lenRx - this->idxRx;
+      if (num > 6)
+        num = 6;
+      memcpy(this->dataRx + this->idxRx, Data+2, num);
+      this->idxRx  += num;
+      this->seq     = (this->seq + 1) & 0x0F;
+      this->timeout = Now + this->timing.NCr;
+      if (this->idxRx >= this->lenRx)
+        this->state = LIN_Master_Transport::TP_DONE;
+      return;
+
+    // unknown PCI
+    default:
+      break;
+
+  } // switch (PCI type)
+
+  // print debug message
+  DEBUG_PRINT_STATIC(1, "wrong PCI 0x%02X", (int) pci);
+
+  // invalid PCI or sequence
+  this->_abort(LIN_Master_Transport::TP_ERROR_PCI);
+
+} // LIN_Master_Transport::_receiveFrame()
+
+
+
+/**************************
+ * PUBLIC METHODS
+**************************/
+
+/**
+  \brief      Constructor for LIN transport layer
+  \details    Constructor for LIN transport layer. Timing is initialized from LIN_MASTER_TP_xxx
+  \param[in]  LIN       LIN node used for transfers. Must remain valid as long as transport layer is used
+*/
+LIN_Master_Transport::LIN_Master_Transport(LIN_Master_Base &LIN)
+{
+  // Debug serial initialized in begin() of node -> no debug output here
+
+  // store node and default timing
+  this->pLIN         = &LIN;
+  this->timing.P2min = LIN_MASTER_TP_P2MIN;
+  this->timing.P2max = LIN_MASTER_TP_P2MAX;
+  this->timing.P2ext = LIN_MASTER_TP_P2EXT;
+  this->timing.STmin = LIN_MASTER_TP_STMIN;
+  this->timing.NCr   = LIN_MASTER_TP_NCR;
+
+  // no transfer
+  this->state        = LIN_Master_Transport::TP_IDLE;
+  this->error        = LIN_Master_Transport::TP_NO_ERROR;
+  this->frameActive  = false;
+  this->dataTx       = NULL;
+  this->lenTx        = 0;
+  this->idxTx        = 0;
+  this->dataRx       = NULL;
+  this->sizeRx       = 0;
+  this->lenRx        = 0;
+  this->idxRx        = 0;
+
+} // LIN_Master_Transport::LIN_Master_Transport()
+
+
+
+/**
+  \brief      Start diagnostic transfer
+  \details    Start diagnostic transfer, i.e. send request and optionally receive response. Transfer is handled by
+              handler(). Request and response buffer must remain valid until TP_DONE. Call after begin() of LIN node
+  \param[in]  NAD           node address of slave (LIN_MASTER_TP_NAD_BROADCAST = all)
+  \param[in]  Request       request incl. SID
+  \param[in]  LenRequest    request length (1..4095)
+  \param[out] Response      response buffer for response incl. RSID (NULL = no response, e.g. broadcast)
+  \param[in]  SizeResponse  size of response buffer (max. 4095)
+  \return     true if transfer was started, false if a transfer is ongoing or on invalid length
+*/
+bool LIN_Master_Transport::request(uint8_t NAD, const uint8_t Request[], uint16_t LenRequest, uint8_t Response[], uint16_t SizeResponse)
+{
+  // transfer ongoing -> return immediately
+  if (this->state & (LIN_Master_Transport::TP_TX | LIN_Master_Transport::TP_RX))
+  {
+    // print debug message
+    DEBUG_PRINT_STATIC(1, "transfer ongoing");
+
+    return false;
+  }
+
+  // reset state
+  this->error = LIN_Master_Transport::TP_NO_ERROR;
+  this->lenRx = 0;
+  this->idxRx = 0;
+
+  // check length
+  if ((LenRequest == 0) || (LenRequest > LIN_MASTER_TP_MAX_LEN) || ((Response != NULL) && (SizeResponse == 0)))
+  {
+    // print debug message
+    DEBUG_PRINT_STATIC(1, "invalid length %d", (int) LenRequest);
+
+    this->_abort(LIN_Master_Transport::TP_ERROR_LENGTH);
+    return false;
+  }
+
+  // print debug message
+  DEBUG_PRINT_STATIC(2, "NAD=0x%02X, len=%d", (int) NAD, (int) LenRequest);
+
+  // prepare diagnostic frames. Checksum is always classic
+  this->pLIN->prepareFrame(this->frameReq, LIN_Master_Base::MASTER_REQUEST, LIN_Master_Base::LIN_V2, 0x3C, 8);
+  this->pLIN->prepareFrame(this->frameResp, LIN_Master_Base::SLAVE_RESPONSE, LIN_Master_Base::LIN_V2, 0x3D, 8);
+
+  // start transfer with next handler() call
+  this->nad         = NAD;
+  this->dataTx      = Request;
+  this->lenTx       = LenRequest;
+  this->idxTx       = 0;
+  this->dataRx      = Response;
+  this->sizeRx      = (SizeResponse > LIN_MASTER_TP_MAX_LEN) ? LIN_MASTER_TP_MAX_LEN : SizeResponse;
+  this->frameActive = false;
+  this->timeNext    = micros();
+  this->state       = LIN_Master_Transport::TP_TX;
+
+  return true;
+
+} // LIN_Master_Transport::request()
+
+
+
+/**
+  \brief      Abort ongoing transfer
+  \details    Abort ongoing transfer. An ongoing LIN frame must be completed via LIN_Master_Base::handler()
+*/
+void LIN_Master_Transport::abort(void)
+{
+  // print debug message
+  DEBUG_PRINT_STATIC(2, " ");
+
+  // stop transfer
+  this->frameActive = false;
+  this->state       = LIN_Master_Transport::TP_IDLE;
+
+} // LIN_Master_Transport::abort()
+
+
+
+/**
+  \brief      Handle transfer in background
+  \details    Handle transfer in background (call until TP_DONE is returned). Services the LIN node and starts the next
+              request or response frame in the same call in which the previous frame is completed, i.e. back-to-back
+              unless limited by ST_min or P2_min. Call as often as possible or at the time returned by getDeadline().
+  \return     state of transport layer
+*/
+LIN_Master_Transport::state_t LIN_Master_Transport::handler(void)
+{
+  // no transfer ongoing -> nothing to do
+  if (!(this->state & (LIN_Master_Transport::TP_TX | LIN_Master_Transport::TP_RX)))
+    return this->state;
+
+  // service LIN node. Frame ongoing -> wait
+  if (this->pLIN->handler() & (LIN_Master_Base::STATE_BREAK | LIN_Master_Base::STATE_BODY))
+    return this->state;
+  uint32_t now = micros();
+
+  // own frame finished -> evaluate
+  if (this->frameActive)
+  {
+    this->frameActive = false;
+    this->_evaluateFrame(now);
+    if (!(this->state & (LIN_Master_Transport::TP_TX | LIN_Master_Transport::TP_RX)))
+      return this->state;
+  }
+
+  // start next frame when allowed
+  if ((int32_t) (now - this->timeNext) >= 0)
+  {
+    if (this->state == LIN_Master_Transport::TP_TX)
+      this->_sendFrame();
+    else
+      this->_pollFrame();
+  }
+
+  // return state
+  return this->state;
+
+} // LIN_Master_Transport::handler()
+
+
+
+/**
+  \brief      Get micros() of next timing deadline
+  \details    Get micros() of next timing deadline, at which handler() has to be called, i.e. deadline of the ongoing
+              LIN frame, or start of the next frame after ST_min or P2_min
+  \param[out] Deadline  micros() of next deadline (only valid if true is returned)
+  \return     true if a deadline is pending, false if no transfer is ongoing
+*/
+bool LIN_Master_Transport::getDeadline(uint32_t &Deadline)
+{
+  // no transfer ongoing
+  if (!(this->state & (LIN_Master_Transport::TP_TX | LIN_Master_Transport::TP_RX)))
+    return false;
+
+  // own frame ongoing -> deadline of LIN node. Finished -> immediately
+  if (this->frameActive)
+  {
+    if (!this->pLIN->getDeadline(Deadline))
+      Deadline = micros();
+    return true;
+  }
+
+  // start of next frame
+  Deadline = this->timeNext;
+  return true;
+
+} // LIN_Master_Transport::getDeadline()
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,197 @@
+/**
+  \file     LIN_master_Transport.h
+  \brief    LIN diagnostic transport layer on top of a LIN master node
+  \details  This library provides a non-blocking transport layer for diagnostic requests (ID 0x3C) and responses (ID 0x3D)
+            with single, first and consecutive frames and NAD addressing like specified by LIN 2.x. Payloads of up to
+            4095 bytes (incl. SID) are segmented into master requests and reassembled from slave responses. Consecutive
+            frames are started in the same handler() call in which the previous frame is completed, i.e. back-to-back
+            unless a min. separation time is configured. Request and response buffers are provided by the application.
+            The LIN node must not be used otherwise (frames, schedule table, request queue) during a transfer.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_TRANSPORT_H_
+#define _LIN_MASTER_TRANSPORT_H_
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+// default timing [us]. Can be changed at runtime via setTiming()
+#if !defined(LIN_MASTER_TP_P2MIN)
+  #define LIN_MASTER_TP_P2MIN           50000         //!< min. time between end of request and 1st slave response header (P2_min)
+#endif
+#if !defined(LIN_MASTER_TP_P2MAX)
+  #define LIN_MASTER_TP_P2MAX           1000000       //!< max. time between end of request and 1st response frame
+#endif
+#if !defined(LIN_MASTER_TP_P2EXT)
+  #define LIN_MASTER_TP_P2EXT           5000000       //!< max. time after "response pending" (NRC 0x78) until next response frame
+#endif
+#if !defined(LIN_MASTER_TP_STMIN)
+  #define LIN_MASTER_TP_STMIN           0             //!< min. separation time between consecutive request frames (ST_min)
+#endif
+#if !defined(LIN_MASTER_TP_NCR)
+  #define LIN_MASTER_TP_NCR             1000000       //!< max. time between consecutive response frames (N_Cr)
+#endif
+
+#define LIN_MASTER_TP_MAX_LEN           4095          //!< max. length of diagnostic request or response incl. SID
+#define LIN_MASTER_TP_NAD_BROADCAST     0x7F          //!< wildcard NAD, i.e. all slaves
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <LIN_master_Base.h>
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN diagnostic transport layer
+
+  \details LIN diagnostic transport layer. handler() services the LIN node and starts the next request or response frame.
+*/
+class LIN_Master_Transport
+{
+  // PUBLIC TYPEDEFS
+  public:
+
+    /// state of transport layer. Use bitmasks for fast checking multiple states
+    typedef enum : uint8_t
+    {
+      TP_IDLE               = 0x01,             //!< no transfer started
+      TP_TX                 = 0x02,             //!< request is being sent
+      TP_RX                 = 0x04,             //!< response is being received
+      TP_DONE               = 0x08              //!< transfer completed (check getError())
+    } state_t;
+
+
+    /// transport layer error codes. Use bitmasks, as error is latched
+    typedef enum : uint8_t
+    {
+      TP_NO_ERROR           = 0x00,             //!< no error
+      TP_ERROR_FRAME        = 0x01,             //!< error of LIN frame (echo, checksum, ...), see LIN_Master_Base::getError()
+      TP_ERROR_TIMEOUT      = 0x02,             //!< no response within P2 or consecutive frame within N_Cr
+      TP_ERROR_NAD          = 0x04,             //!< response from wrong NAD
+      TP_ERROR_PCI          = 0x08,             //!< invalid PCI or wrong sequence number
+      TP_ERROR_LENGTH       = 0x10              //!< invalid request length or response exceeds buffer
+    } error_t;
+
+
+    /// transport layer timing [us], see setTiming()
+    typedef struct
+    {
+      uint32_t                    P2min;        //!< min. time between end of request and 1st slave response header
+      uint32_t                    P2max;        //!< max. time between end of request and 1st response frame
+      uint32_t                    P2ext;        //!< max. time after "response pending" (NRC 0x78) until next response frame
+      uint32_t                    STmin;        //!< min. separation time between consecutive request frames (0 = back-to-back)
+      uint32_t                    NCr;          //!< max. time between consecutive response frames
+    } timing_t;
+
+
+  // PROTECTED VARIABLES
+  protected:
+
+    LIN_Master_Base         *pLIN;              //!< LIN node used for transfers
+    LIN_Master_Transport::timing_t  timing;     //!< transport layer timing
+    LIN_Master_Transport::state_t   state;      //!< state of transport layer
+    LIN_Master_Transport::error_t   error;      //!< error of transport layer. Is latched until next request()
+
+    // frames
+    LIN_Master_Base::descriptor_t frameReq;     //!< prepared master request frame (ID 0x3C)
+    LIN_Master_Base::descriptor_t frameResp;    //!< prepared slave response frame (ID 0x3D)
+    bool                    frameActive;        //!< own LIN frame is ongoing
+    uint8_t                 buf[8];             //!< data of current master request frame
+    uint8_t                 nad;                //!< node address of transfer
+    uint8_t                 seq;                //!< sequence number of next consecutive frame
+    uint32_t                timeNext;           //!< micros() when next frame may be started
+    uint32_t                timeout;            //!< micros() of response timeout
+
+    // request
+    const uint8_t           *dataTx;            //!< request data incl. SID
+    uint16_t                lenTx;              //!< request length
+    uint16_t                idxTx;              //!< number of sent request bytes
+
+    // response
+    uint8_t                 *dataRx;            //!< response buffer (NULL = no response expected)
+    uint16_t                sizeRx;             //!< size of response buffer
+    uint16_t                lenRx;              //!< response length incl. RSID (0 = not yet known)
+    uint16_t                idxRx;              //!< number of received response bytes
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Finish transfer with error
+    inline void _abort(LIN_Master_Transport::error_t Error)
+    {
+      this->error = (LIN_Master_Transport::error_t) ((int) this->error | (int) Error);
+      this->state = LIN_Master_Transport::TP_DONE;
+
+    } // _abort()
+
+    /// @brief Start next master request frame (single, first or consecutive frame)
+    void _sendFrame(void);
+
+    /// @brief Start next slave response frame
+    void _pollFrame(void);
+
+    /// @brief Evaluate completed LIN frame
+    void _evaluateFrame(uint32_t Now);
+
+    /// @brief Evaluate received slave response frame
+    void _receiveFrame(const uint8_t Data[], uint32_t Now);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_Transport(LIN_Master_Base &LIN);
+
+    /// @brief Set transport layer timing
+    inline void setTiming(const LIN_Master_Transport::timing_t &Timing) { this->timing = Timing; }
+
+    /// @brief Getter for transport layer timing
+    inline const LIN_Master_Transport::timing_t &getTiming(void) { return this->timing; }
+
+    /// @brief Start diagnostic transfer (call after LIN begin())
+    bool request(uint8_t NAD, const uint8_t Request[], uint16_t LenRequest, uint8_t Response[] = NULL, uint16_t SizeResponse = 0);
+
+    /// @brief Abort ongoing transfer. An ongoing LIN frame must be completed via LIN_Master_Base::handler()
+    void abort(void);
+
+    /// @brief Handle transfer in background (call until TP_DONE is returned)
+    LIN_Master_Transport::state_t handler(void);
+
+    /// @brief Get micros() of next timing deadline, at which handler() has to be called
+    bool getDeadline(uint32_t &Deadline);
+
+    /// @brief Getter for transport layer state
+    inline LIN_Master_Transport::state_t getState(void) { return this->state; }
+
+    /// @brief Getter for transport layer error
+    inline LIN_Master_Transport::error_t getError(void) { return this->error; }
+
+    /// @brief Getter for received response length incl. RSID
+    inline uint16_t getLength(void) { return this->idxRx; }
+
+}; // class LIN_Master_Transport
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_TRANSPORT_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
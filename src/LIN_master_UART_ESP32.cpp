@@ -0,0 +1,372 @@
+/**
+  \file     LIN_master_UART_ESP32.cpp
+  \brief    LIN master emulation library using the ESP-IDF UART driver of ESP32
+  \details  This library provides a master node emulation for a LIN bus via the ESP-IDF UART driver of ESP32, optionally via RS485.
+            Unlike LIN_Master_HardwareSerial_ESP32, the Rx FIFO full threshold and Rx timeout are set to 1, and received
+            bytes are taken from the UART_DATA events of the driver queue. Bytes are therefore available ~immediately
+            instead of >1ms later, and the end of the BREAK is detected via its echo.
+            The UART must not be used via HardwareSerial at the same time. The host build uses a mocked UART driver.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \note     uart_write_bytes_with_break() sends the BREAK after the data and blocks until it is done, i.e. it can't
+            precede the SYNC. Therefore the BREAK is sent as 0x00 at 1/2 baudrate via uart_set_baudrate()
+  \author   Georg Icking-Konert
+*/
+
+// include files
+#include <LIN_master_UART_ESP32.h>
+
+// assert ESP32 platform
+#if defined(_LIN_MASTER_UART_ESP32_H_)
+
+
+/**
+  \brief      Number of received, unread bytes
+  \details    Number of received, unread bytes. Only processes pending events of the UART driver, i.e. doesn't
+              block or lock the ring buffer. On Rx overflow, received bytes are discarded, i.e. the frame fails via timeout
+  \return     number of bytes available via _read()
+*/
+int LIN_Master_UART_ESP32::_available(void)
+{
+  uart_event_t  event;
+
+  // process pending events w/o waiting
+  while (xQueueReceive(this->queue, &event, 0) == pdTRUE)
+  {
+    // bytes moved to ring buffer by driver ISR
+    if (event.type == UART_DATA)
+      this->numRx += event.size;
+
+    // Rx overflow -> discard bytes and events
+    else if ((event.type == UART_FIFO_OVF) || (event.type == UART_BUFFER_FULL))
+    {
+      // print debug message
+      DEBUG_PRINT(1, "Rx overflow");
+
+      uart_flush_input(this->port);
+      xQueueReset(this->queue);
+      this->numRx = 0;
+    }
+  }
+
+  // return number of bytes
+  return (int) this->numRx;
+
+} // LIN_Master_UART_ESP32::_available()
+
+
+
+/**
+  \brief      Read received byte
+  \details    Read received byte from ring buffer of UART driver. Only call if _available() > 0.
+              On failure, e.g. ring buffer was flushed, the pending event count is discarded.
+  \return     received byte (0..255) or -1 on failure
+*/
+int LIN_Master_UART_ESP32::_read(void)
+{
+  uint8_t   data;
+
+  // byte is in ring buffer -> don't wait
+  if (uart_read_bytes(this->port, &data, 1, 0) != 1)
+  {
+    // print debug message
+    DEBUG_PRINT(1, "read failed");
+
+    // events don't match ring buffer -> discard them
+    this->numRx = 0;
+    return -1;
+  }
+  this->numRx--;
+
+  return (int) data;
+
+} // LIN_Master_UART_ESP32::_read()
+
+
+
+/**
+  \brief      Send LIN break
+  \details    Send LIN break (=16bit low)
+  \return     current state of LIN state machine
+*/
+LIN_Master_Base::state_t LIN_Master_UART_ESP32::_sendBreak(void)
+{
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master_Base::STATE_IDLE)
+  {
+    // print debug message
+    DEBUG_PRINT(1, "wrong state 0x%02X", this->state);
+
+    // set error state and return immediately
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_STATE);
+    this->state = LIN_Master_Base::STATE_DONE;
+    this->_disableTransmitter();
+    return this->state;
+  }
+
+  // wait for end of previous transmission, max. 2 bytes + 1 tick. Avoid blocking on a stuck transmitter
+  if (uart_wait_tx_done(this->port, pdMS_TO_TICKS(((this->timePerByte << 1) + 999) / 1000) + 1) != ESP_OK)
+  {
+    // print debug message
+    DEBUG_PRINT(1, "Tx busy");
+
+    // set error state and return immediately
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_STATE);
+    this->state = LIN_Master_Base::STATE_DONE;
+    this->_disableTransmitter();
+    return this->state;
+  }
+
+  // empty buffers and pending events, just in case...
+  uart_flush_input(this->port);
+  xQueueReset(this->queue);
+  this->numRx = 0;
+
+  // set half baudrate for BREAK. Doesn't re-initialize UART
+  uart_set_baudrate(this->port, this->baudrate >> 1);
+
+  // optionally enable transmitter
+  this->_enableTransmitter();
+
+  // send BREAK (>=13 bit low)
+  uart_write_bytes(this->port, this->bufTx, 1);
+
+  // progress state
+  this->state = LIN_Master_Base::STATE_BREAK;
+
+  // print debug message
+  DEBUG_PRINT(3, " ");
+
+  // return state
+  return this->state;
+
+} // LIN_Master_UART_ESP32::_sendBreak()
+
+
+
+/**
+  \brief      Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+  \details    Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+  \return     current state of LIN state machine
+*/
+LIN_Master_Base::state_t LIN_Master_UART_ESP32::_sendFrame(void)
+{
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master_Base::STATE_BREAK)
+  {
+    // print debug message
+    DEBUG_PRINT(1, "wrong state 0x%02X", this->state);
+
+    // set error state and return immediately
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_STATE);
+    this->state = LIN_Master_Base::STATE_DONE;
+    this->_disableTransmitter();
+    return this->state;
+  }
+
+  // byte(s) received (likely BREAK echo)
+  if (this->_available() > 0)
+  {
+    // read failed -> wait for next event or timeout
+    int data = this->_read();
+    if (data < 0)
+      return this->state;
+
+    // store and check BREAK echo. Exit on error
+    if (this->_receiveByte((uint8_t) data) == LIN_Master_Base::STATE_DONE)
+      return this->state;
+
+    // restore nominal baudrate
+    uart_set_baudrate(this->port, this->baudrate);
+
+    // send rest of frame (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+    uart_write_bytes(this->port, this->bufTx+1, this->lenTx-1);
+
+    // progress state
+    this->state = LIN_Master_Base::STATE_BODY;
+
+  } // BREAK echo received
+
+  // no byte(s) received
+  else
+  {
+    // check for timeout
+    if (micros() - this->timeStart > this->timeoutFrame)
+    {
+      // print debug message
+      DEBUG_PRINT(1, "Rx timeout");
+
+      // set error state and return immediately
+      this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_TIMEOUT);
+      this->state = LIN_Master_Base::STATE_DONE;
+      this->_disableTransmitter();
+      return this->state;
+    }
+
+  } // no byte(s) received
+
+  // print debug message
+  DEBUG_PRINT(2, " ");
+
+  // return state
+  return this->state;
+
+} // LIN_Master_UART_ESP32::_sendFrame()
+
+
+
+/**
+  \brief      Receive and check LIN frame
+  \details    Receive and check LIN frame byte by byte (request frame: check echo; response frame: check header echo & checksum)
+  \return     current state of LIN state machine
+*/
+LIN_Master_Base::state_t LIN_Master_UART_ESP32::_receiveFrame(void)
+{
+  // if state is wrong, exit immediately
+  if (this->state != LIN_Master_Base::STATE_BODY)
+  {
+    // print debug message
+    DEBUG_PRINT(1, "wrong state 0x%02X", this->state);
+
+    // set error state and return immediately
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_STATE);
+    this->state = LIN_Master_Base::STATE_DONE;
+    this->_disableTransmitter();
+    return this->state;
+  }
+
+  // process received bytes one at a time. Frame is completed or aborted on 1st error, see _receiveByte().
+  // Stop on read failure, then frame completes with next events or times out
+  int num = this->_available();
+  int data;
+  while ((num-- > 0) && (this->state == LIN_Master_Base::STATE_BODY) && ((data = this->_read()) >= 0))
+    this->_receiveByte((uint8_t) data);
+
+  // frame not yet completed -> check for timeout
+  if ((this->state == LIN_Master_Base::STATE_BODY) && (micros() - this->timeStart > this->timeoutFrame))
+  {
+    // print debug message
+    DEBUG_PRINT(1, "Rx timeout");
+
+    // set error state and return immediately
+    this->error = (LIN_Master_Base::error_t) ((int) this->error | (int) LIN_Master_Base::ERROR_TIMEOUT);
+    this->state = LIN_Master_Base::STATE_DONE;
+    this->_disableTransmitter();
+    return this->state;
+
+  } // timeout
+
+  // print debug message
+  DEBUG_PRINT(2, " ");
+
+  // return state
+  return this->state;
+
+} // LIN_Master_UART_ESP32::_receiveFrame()
+
+
+
+/**
+  \brief      Constructor for LIN node class using ESP-IDF UART driver
+  \details    Constructor for LIN node class using ESP-IDF UART driver. Store UART and pins.
+  \param[in]  Port        UART used for LIN, e.g. UART_NUM_1. Must not be used via HardwareSerial
+  \param[in]  PinRx       GPIO used for reception
+  \param[in]  PinTx       GPIO used for transmission
+  \param[in]  NameLIN     LIN node name (default = "Master")
+  \param[in]  PinTxEN     optional Tx enable pin (high active) e.g. for LIN via RS485 (default = -127/none)
+*/
+LIN_Master_UART_ESP32::LIN_Master_UART_ESP32(uart_port_t Port, uint8_t PinRx, uint8_t PinTx, const char NameLIN[], const int8_t PinTxEN) :
+  LIN_Master_Base::LIN_Master_Base(NameLIN, PinTxEN)
+{
+  // Debug serial initialized in begin() -> no debug output here
+
+  // store UART and pins
+  this->port       = Port;                                    // used UART
+  this->pinRx      = PinRx;                                   // receive pin
+  this->pinTx      = PinTx;                                   // transmit pin
+  this->queue      = NULL;                                    // driver installed in begin()
+  this->numRx      = 0;
+
+  // must not install driver here, else system resets
+
+} // LIN_Master_UART_ESP32::LIN_Master_UART_ESP32()
+
+
+
+/**
+  \brief      Install UART driver and open interface
+  \details    Install UART driver with event queue and open interface with specified baudrate. Rx FIFO full threshold
+              and Rx timeout are set to 1, i.e. each received byte is moved to the ring buffer with a UART_DATA event
+  \param[in]  Baudrate    communication speed [Baud] (default = 19200)
+*/
+void LIN_Master_UART_ESP32::begin(uint32_t Baudrate)
+{
+  uart_config_t   config;
+
+  // call base class method
+  LIN_Master_Base::begin(Baudrate);
+
+  // just to be sure
+  if (this->queue != NULL)
+    uart_driver_delete(this->port);
+  this->queue = NULL;
+
+  // configure UART 8N1 w/o flow control and default clock
+  memset(&config, 0, sizeof(config));
+  config.baud_rate = (int) this->baudrate;
+  config.data_bits = UART_DATA_8_BITS;
+  config.parity    = UART_PARITY_DISABLE;
+  config.stop_bits = UART_STOP_BITS_1;
+  config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+
+  // install driver w/o Tx buffer (frame fits into FIFO, i.e. write doesn't block) and with event queue
+  if ((uart_param_config(this->port, &config) != ESP_OK) ||
+      (uart_set_pin(this->port, this->pinTx, this->pinRx, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) ||
+      (uart_driver_install(this->port, LIN_MASTER_UART_ESP32_RXBUF, 0, LIN_MASTER_UART_ESP32_QUEUE, &(this->queue), 0) != ESP_OK))
+  {
+    // print debug message
+    DEBUG_PRINT(1, "UART driver failed");
+
+    // keep interface closed
+    this->queue = NULL;
+    LIN_Master_Base::end();
+    return;
+  }
+
+  // move each received byte to ring buffer immediately, i.e. don't wait for FIFO threshold or Rx timeout
+  uart_set_rx_full_threshold(this->port, 1);
+  uart_set_rx_timeout(this->port, 1);
+  this->numRx = 0;
+
+  // print debug message
+  DEBUG_PRINT(2, "ok");
+
+} // LIN_Master_UART_ESP32::begin()
+
+
+
+/**
+  \brief      Close interface and remove UART driver
+  \details    Close interface and remove UART driver
+*/
+void LIN_Master_UART_ESP32::end()
+{
+  // call base class method
+  LIN_Master_Base::end();
+
+  // remove driver incl. event queue
+  if (this->queue != NULL)
+  {
+    uart_driver_delete(this->port);
+    this->queue = NULL;
+  }
+
+  // print debug message
+  DEBUG_PRINT(2, " ");
+
+} // LIN_Master_UART_ESP32::end()
+
+#endif // _LIN_MASTER_UART_ESP32_H_
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,112 @@
+/**
+  \file     LIN_master_UART_ESP32.h
+  \brief    LIN master emulation library using the ESP-IDF UART driver of ESP32
+  \details  This library provides a master node emulation for a LIN bus via the ESP-IDF UART driver of ESP32, optionally via RS485.
+            Unlike LIN_Master_HardwareSerial_ESP32, the Rx FIFO full threshold and Rx timeout are set to 1, and received
+            bytes are taken from the UART_DATA events of the driver queue. Bytes are therefore available ~immediately
+            instead of >1ms later, and the end of the BREAK is detected via its echo.
+            The UART must not be used via HardwareSerial at the same time. The host build uses a mocked UART driver.
+            For an explanation of the LIN bus and protocol e.g. see https://en.wikipedia.org/wiki/Local_Interconnect_Network
+  \author   Georg Icking-Konert
+*/
+
+// assert ESP32 platform (or host build with mocked UART driver)
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_HOST)
+
+/*-----------------------------------------------------------------------------
+  MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LIN_MASTER_UART_ESP32_H_
+#define _LIN_MASTER_UART_ESP32_H_
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL DEFINES
+-----------------------------------------------------------------------------*/
+
+#if !defined(LIN_MASTER_UART_ESP32_RXBUF)
+  #define LIN_MASTER_UART_ESP32_RXBUF   256           //!< size of Rx ring buffer of UART driver (>128)
+#endif
+#if !defined(LIN_MASTER_UART_ESP32_QUEUE)
+  #define LIN_MASTER_UART_ESP32_QUEUE   20            //!< size of UART event queue (>=13 for 1 event per byte of a frame)
+#endif
+
+
+/*-----------------------------------------------------------------------------
+  INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+// include required libraries
+#include <LIN_master_Base.h>
+#if defined(ARDUINO_ARCH_ESP32)
+  #include <driver/uart.h>
+#else
+  #include <esp32_uart.h>
+#endif
+
+
+/*-----------------------------------------------------------------------------
+  GLOBAL CLASS
+-----------------------------------------------------------------------------*/
+/**
+  \brief  LIN master node class via ESP-IDF UART driver
+
+  \details LIN master node class via ESP-IDF UART driver with event queue.
+*/
+class LIN_Master_UART_ESP32 : public LIN_Master_Base
+{
+  // PROTECTED VARIABLES
+  protected:
+
+    uart_port_t           port;               //!< UART used for LIN
+    uint8_t               pinRx;              //!< pin used for receive
+    uint8_t               pinTx;              //!< pin used for transmit
+    QueueHandle_t         queue;              //!< event queue of UART driver (NULL = driver not installed)
+    size_t                numRx;              //!< number of bytes reported by UART_DATA events, but not yet read
+
+
+  // PROTECTED METHODS
+  protected:
+
+    /// @brief Number of received, unread bytes via UART events
+    int _available(void);
+
+    /// @brief Read received byte from ring buffer of UART driver. Returns -1 on failure
+    int _read(void);
+
+    /// @brief Send LIN break
+    LIN_Master_Base::state_t _sendBreak(void);
+
+    /// @brief Send LIN bytes (request frame: SYNC+ID+DATA[]+CHK; response frame: SYNC+ID)
+    LIN_Master_Base::state_t _sendFrame(void);
+
+    /// @brief Read and check LIN frame
+    LIN_Master_Base::state_t _receiveFrame(void);
+
+
+  // PUBLIC METHODS
+  public:
+
+    /// @brief Class constructor
+    LIN_Master_UART_ESP32(uart_port_t Port, uint8_t PinRx, uint8_t PinTx,
+      const char NameLIN[] = "Master", const int8_t PinTxEN = INT8_MIN);
+
+    /// @brief Install UART driver and open interface
+    void begin(uint32_t Baudrate = 19200);
+
+    /// @brief Close interface and remove UART driver
+    void end(void);
+
+}; // class LIN_Master_UART_ESP32
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LIN_MASTER_UART_ESP32_H_
+
+#endif // ARDUINO_ARCH_ESP32 || ARDUINO_ARCH_HOST
+
+/*-----------------------------------------------------------------------------
+    END OF FILE
+-----------------------------------------------------------------------------*/